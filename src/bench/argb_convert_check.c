@@ -0,0 +1,177 @@
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+#include "../core/types.h"
+#include "../core/memory.h"
+#include "../core/image.h"
+#include "../gui/argb_convert.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+/* Scalar versus SIMD ARGB conversion / 스칼라 대 SIMD ARGB 변환 비교
+ *
+ * Converts every source format through mp_argb_convert_span and the scalar reference and
+ * requires identical words for every count up to MP_CHECK_MAX_SPAN, which covers each
+ * kernel's main loop and every tail length, and for a few long odd spans. Sources end
+ * against an inaccessible page, so a kernel reading past its span faults, and a guard word
+ * after the output catches writes past it. mp_argb_convert_rect is checked against the same
+ * reference over odd rectangles of a padded buffer. MP_SIMD caps the kernels in use, so
+ * `make test` runs this once per level. Exits non-zero on the first mismatch.
+ * 모든 형식과 길이에 대해 SIMD 변환이 스칼라 기준 구현과 같은 결과를 내는지 검사합니다.
+ */
+
+#define MP_CHECK_MAX_SPAN 80
+#define MP_CHECK_GUARD 0xDEADBEEFu
+
+static const mp_color_format g_mp_check_formats[] = {
+    MP_COLOR_FORMAT_RGB, MP_COLOR_FORMAT_BGR, MP_COLOR_FORMAT_RGBA,
+    MP_COLOR_FORMAT_BGRA, MP_COLOR_FORMAT_GRAYSCALE, MP_COLOR_FORMAT_GRAYSCALE_ALPHA
+};
+static const char* const g_mp_check_names[] = { "RGB", "BGR", "RGBA", "BGRA", "GRAYSCALE", "GRAYSCALE_ALPHA" };
+#define MP_CHECK_FORMAT_COUNT (sizeof(g_mp_check_formats) / sizeof(g_mp_check_formats[0]))
+
+/* Long spans: odd, and not a multiple of any kernel step / 긴 구간 (홀수, 어떤 커널 단계의 배수도 아님) */
+static const u32 g_mp_check_long_spans[] = { 1001, 4099 };
+
+/* x, y, width, height inside an MP_CHECK_RECT_W x MP_CHECK_RECT_H buffer / 버퍼 안의 사각형 */
+#define MP_CHECK_RECT_W 1283
+#define MP_CHECK_RECT_H 131
+static const u32 g_mp_check_rects[][4] = { { 0, 0, 1283, 131 }, { 1, 3, 1281, 127 }, { 7, 0, 19, 5 }, { 1270, 130, 13, 1 } };
+#define MP_CHECK_RECT_COUNT (sizeof(g_mp_check_rects) / sizeof(g_mp_check_rects[0]))
+
+static u32 mp_check_bpp(mp_color_format format) {
+    switch (format) {
+        case MP_COLOR_FORMAT_RGBA:
+        case MP_COLOR_FORMAT_BGRA: return 4;
+        case MP_COLOR_FORMAT_GRAYSCALE: return 1;
+        case MP_COLOR_FORMAT_GRAYSCALE_ALPHA: return 2;
+        default: return 3;
+    }
+}
+
+static u32 mp_check_next(u32* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/* Random pixels; alpha is 0, 255 or anything, or always 255 when `opaque` so the
+ * premultiply fast path runs / 임의 픽셀 (알파는 0, 255 또는 임의 값, `opaque`면 항상 255) */
+static void mp_check_fill(u8* src, mp_color_format format, u32 count, u32 seed, mp_bool opaque) {
+    u32 bpp = mp_check_bpp(format);
+    mp_bool alpha = bpp == 2 || bpp == 4;
+    u32 state = seed | 1;
+    for (u32 x = 0; x < count; x++) {
+        for (u32 c = 0; c < bpp; c++) src[x * bpp + c] = (u8)mp_check_next(&state);
+        if (alpha) {
+            u32 pick = mp_check_next(&state) % 3;
+            src[x * bpp + bpp - 1] = opaque || pick == 1 ? 255 : pick == 0 ? 0 : src[x * bpp + bpp - 1];
+        }
+    }
+}
+
+/* Convert `count` pixels ending at `src_end` both ways and compare / 두 방식으로 변환 후 비교 */
+static mp_bool mp_check_span(u8* src_end, mp_color_format format, const char* name, u32 count, u32 seed,
+                             mp_bool opaque, u32* out, u32* ref) {
+    u8* src = src_end - (size_t)count * mp_check_bpp(format);
+    mp_check_fill(src, format, count, seed, opaque);
+    out[count] = MP_CHECK_GUARD;
+    
+    mp_argb_convert_span(src, format, out, count);
+    mp_argb_convert_span_scalar(src, format, ref, count);
+    
+    for (u32 x = 0; x < count; x++) {
+        if (out[x] != ref[x]) {
+            fprintf(stderr, "FAIL %s span %u pixel %u: got %08x, scalar %08x\n", name, count, x, out[x], ref[x]);
+            return MP_FALSE;
+        }
+    }
+    if (out[count] != MP_CHECK_GUARD) {
+        fprintf(stderr, "FAIL %s span %u: wrote past the end\n", name, count);
+        return MP_FALSE;
+    }
+    return MP_TRUE;
+}
+
+/* Odd rectangles of a padded buffer, converted by rows across threads / 패딩된 버퍼의 홀수 사각형 */
+static mp_bool mp_check_rect(mp_color_format format, const char* name) {
+    const u32 width = MP_CHECK_RECT_W, height = MP_CHECK_RECT_H;
+    mp_image_buffer* buffer = mp_image_buffer_create(width, height, format);
+    u32* dst = (u32*)malloc((size_t)(width + 3) * height * sizeof(u32));
+    u32* ref = (u32*)malloc((size_t)width * sizeof(u32));
+    mp_bool ok = buffer && dst && ref;
+    for (u32 y = 0; ok && y < height; y++) {
+        mp_check_fill(buffer->data + (size_t)y * buffer->stride, format, width, 0x9E3779B9u * (y + 1), y % 5 == 0);
+    }
+    
+    for (u32 r = 0; ok && r < MP_CHECK_RECT_COUNT; r++) {
+        u32 rx = g_mp_check_rects[r][0], ry = g_mp_check_rects[r][1];
+        u32 rw = g_mp_check_rects[r][2], rh = g_mp_check_rects[r][3];
+        u32 dst_stride = (rw + 3) * 4;
+        mp_argb_convert_rect(buffer, rx, ry, rw, rh, (u8*)dst, dst_stride);
+        for (u32 y = 0; ok && y < rh; y++) {
+            const u8* row = buffer->data + (size_t)(ry + y) * buffer->stride + (size_t)rx * buffer->bpp;
+            mp_argb_convert_span_scalar(row, format, ref, rw);
+            if (memcmp((const u8*)dst + (size_t)y * dst_stride, ref, (size_t)rw * 4) != 0) {
+                fprintf(stderr, "FAIL %s rect %u,%u %ux%u row %u\n", name, rx, ry, rw, rh, y);
+                ok = MP_FALSE;
+            }
+        }
+    }
+    
+    if (!buffer || !dst || !ref) fprintf(stderr, "FAIL %s rect: out of memory\n", name);
+    if (buffer) mp_image_buffer_destroy(buffer);
+    free(dst);
+    free(ref);
+    return ok;
+}
+
+int main(void) {
+    long page = sysconf(_SC_PAGESIZE);
+    size_t longest = 4099 * 4;
+    size_t area = ((longest + (size_t)page - 1) / (size_t)page) * (size_t)page;
+    u8* region = (u8*)mmap(NULL, area + (size_t)page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    u32* out = (u32*)malloc((longest / 4 + 1) * sizeof(u32));
+    u32* ref = (u32*)malloc((longest / 4 + 1) * sizeof(u32));
+    if (region == MAP_FAILED || !out || !ref || mprotect(region + area, (size_t)page, PROT_NONE) != 0) {
+        fprintf(stderr, "Error: cannot set up guard page\n");
+        return 2;
+    }
+    u8* src_end = region + area;
+    
+    mp_memory_init();
+    const char* level = getenv("MP_SIMD");
+    u32 checked = 0;
+    mp_bool ok = MP_TRUE;
+    for (u32 f = 0; f < MP_CHECK_FORMAT_COUNT && ok; f++) {
+        mp_color_format format = g_mp_check_formats[f];
+        const char* name = g_mp_check_names[f];
+        for (u32 count = 0; count <= MP_CHECK_MAX_SPAN && ok; count++) {
+            ok = mp_check_span(src_end, format, name, count, count * 2654435761u + f, MP_FALSE, out, ref) &&
+                 mp_check_span(src_end, format, name, count, count * 40503u + f, MP_TRUE, out, ref);
+            checked += 2;
+        }
+        for (u32 i = 0; i < sizeof(g_mp_check_long_spans) / sizeof(g_mp_check_long_spans[0]) && ok; i++) {
+            ok = mp_check_span(src_end, format, name, g_mp_check_long_spans[i], 0xA5A5A5A5u + i, MP_FALSE, out, ref);
+            checked++;
+        }
+        if (ok) ok = mp_check_rect(format, name);
+    }
+    mp_memory_shutdown();
+    
+    free(out);
+    free(ref);
+    munmap(region, area + (size_t)page);
+    if (!ok) return 1;
+    printf("argb_convert: %u spans and %u rectangles over %u formats match the scalar reference (MP_SIMD=%s)\n",
+           checked, (u32)(MP_CHECK_RECT_COUNT * MP_CHECK_FORMAT_COUNT), (u32)MP_CHECK_FORMAT_COUNT,
+           level ? level : "auto");
+    return 0;
+}
@@ -0,0 +1,555 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../core/types.h"
+#include "../core/memory.h"
+#include "../core/image.h"
+#include "../core/fast_io.h"
+#include "../core/parallel.h"
+#include "../codecs/deflate.h"
+#include "../codecs/lz.h"
+#include "../codecs/jpeg.h"
+#include "../operations/color_ops.h"
+#include "../operations/edit_ops.h"
+#include "corpus.h"
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* manypictures-bench: codec and operation throughput / 코덱 및 연산 처리량 벤치마크
+ *
+ * Runs every codec and operation over the synthetic corpus (noise, gradient, photo, text at
+ * each size, as RGB, grayscale and RGBA), with warmup runs first, and reports wall time and
+ * throughput in megapixels per second of source image: the median over samples, where a
+ * sample of short calls is the mean of a batch, and the p95 over individual calls, each
+ * timed on its own inside the batch. Only the call under test is timed; copies of
+ * the source for in-place operations and cleanup happen between runs. Results can be saved
+ * as a JSON baseline, and a later run compared against one fails when a case's median
+ * throughput drops by more than the threshold.
+ * 합성 코퍼스(RGB/회색조/RGBA)에 대해 모든 코덱과 연산을 워밍업 후 반복 실행하고 처리량(MP/s)을
+ * 보고합니다. 중앙값은 표본(짧은 호출은 묶음 평균) 기준, p95는 개별 호출 기준입니다.
+ * 기준 JSON과 비교해 임계값 이상 느려진 경우 실패합니다.
+ */
+
+#define MP_BENCH_DEFAULT_RUNS 7
+#define MP_BENCH_DEFAULT_WARMUP 1
+#define MP_BENCH_DEFAULT_THRESHOLD 10.0   /* Percent / 퍼센트 */
+#define MP_BENCH_MAX_RUNS 1000
+#define MP_BENCH_MAX_RESULTS 1024
+#define MP_BENCH_NAME_SIZE 64
+#define MP_BENCH_MIN_SAMPLE_MS 2.0        /* Shorter calls are batched per sample / 짧은 호출은 묶어서 측정 */
+#define MP_BENCH_MAX_BATCH 64
+#define MP_BENCH_CONFIRM 2                /* Re-measurements before a regression counts / 회귀 확정 전 재측정 횟수 */
+
+typedef struct {
+    const mp_image* source;
+    /* Per-call slots of one batch, filled or freed outside the timed region
+     * / 한 묶음의 호출별 슬롯 (측정 구간 밖에서 준비/해제) */
+    mp_image* work[MP_BENCH_MAX_BATCH];      /* In-place targets / 제자리 연산 대상 */
+    mp_image* decoded[MP_BENCH_MAX_BATCH];
+    u8* output[MP_BENCH_MAX_BATCH];          /* Buffers a call allocated / 호출이 할당한 버퍼 */
+    char png_path[64], bmp_path[64], out_path[64];
+    u8* raw;                   /* Source rows without padding / 패딩 없는 원본 행 */
+    size_t raw_size;
+    u8* deflated;              /* zlib stream from mp_deflate_compress / zlib 스트림 */
+    size_t deflated_size;
+    u8* lz;
+    size_t lz_size;
+    u8* scratch;               /* Decompression and LZ output / 압축 해제 및 LZ 출력 */
+    size_t scratch_size;
+    i16* blocks;               /* Green channel as 8x8 coefficient blocks / 녹색 채널 8x8 블록 */
+    u32 block_count;
+} mp_bench_ctx;
+
+typedef struct {
+    const char* name;
+    mp_bool (*run)(mp_bench_ctx* ctx, u32 slot);
+    mp_bool in_place;          /* Needs a fresh copy of the source / 원본 복사본 필요 */
+    mp_bool color_only;        /* A no-op on grayscale sources, so skipped there / 회색조 원본에서는 무동작이라 생략 */
+} mp_bench_case;
+
+typedef struct {
+    char name[MP_BENCH_NAME_SIZE];
+    f64 median_mps;
+    f64 p95_mps;
+} mp_bench_result;
+
+static FILE* g_mp_bench_out;
+
+static f64 mp_bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static int mp_bench_compare(const void* a, const void* b) {
+    f64 x = *(const f64*)a, y = *(const f64*)b;
+    return (x > y) - (x < y);
+}
+
+/* Codecs / 코덱 */
+
+static mp_bool mp_bench_png_encode(mp_bench_ctx* ctx, u32 slot) {
+    (void)slot;
+    return mp_image_save((mp_image*)ctx->source, ctx->out_path, MP_FORMAT_PNG) == MP_SUCCESS;
+}
+
+static mp_bool mp_bench_png_decode(mp_bench_ctx* ctx, u32 slot) {
+    return (ctx->decoded[slot] = mp_image_load(ctx->png_path)) != NULL;
+}
+
+static mp_bool mp_bench_bmp_encode(mp_bench_ctx* ctx, u32 slot) {
+    (void)slot;
+    return mp_image_save((mp_image*)ctx->source, ctx->out_path, MP_FORMAT_BMP) == MP_SUCCESS;
+}
+
+static mp_bool mp_bench_bmp_decode(mp_bench_ctx* ctx, u32 slot) {
+    return (ctx->decoded[slot] = mp_image_load(ctx->bmp_path)) != NULL;
+}
+
+static mp_bool mp_bench_deflate(mp_bench_ctx* ctx, u32 slot) {
+    size_t size;
+    return mp_deflate_compress(ctx->raw, ctx->raw_size, &ctx->output[slot], &size) == MP_SUCCESS;
+}
+
+static mp_bool mp_bench_inflate(mp_bench_ctx* ctx, u32 slot) {
+    (void)slot;
+    mp_deflate_stream stream;
+    mp_deflate_init(&stream, ctx->deflated + 2, ctx->deflated_size - 2, ctx->scratch, ctx->raw_size);
+    return mp_deflate_decompress(&stream) == MP_SUCCESS;
+}
+
+static mp_bool mp_bench_lz_compress(mp_bench_ctx* ctx, u32 slot) {
+    (void)slot;
+    return mp_lz_compress(ctx->raw, ctx->raw_size, ctx->scratch, ctx->scratch_size) != 0;
+}
+
+static mp_bool mp_bench_lz_decompress(mp_bench_ctx* ctx, u32 slot) {
+    (void)slot;
+    return mp_lz_decompress(ctx->lz, ctx->lz_size, ctx->scratch, ctx->raw_size) == MP_SUCCESS;
+}
+
+static mp_bool mp_bench_jpeg_idct(mp_bench_ctx* ctx, u32 slot) {
+    (void)slot;
+    i16 out[64];
+    u32 sum = 0;
+    for (u32 b = 0; b < ctx->block_count; b++) {
+        mp_jpeg_idct(ctx->blocks + (size_t)b * 64, out);
+        sum += (u16)out[b & 63];
+    }
+    ctx->scratch[0] = (u8)sum;
+    return MP_TRUE;
+}
+
+/* Operations / 연산 */
+
+#define MP_BENCH_OP(fn, call) \
+    static mp_bool fn(mp_bench_ctx* ctx, u32 slot) { \
+        mp_image* work = ctx->work[slot]; \
+        return (call) == MP_SUCCESS; \
+    }
+
+MP_BENCH_OP(mp_bench_grayscale, mp_op_to_grayscale(work))
+MP_BENCH_OP(mp_bench_invert, mp_op_invert(work))
+MP_BENCH_OP(mp_bench_brightness, mp_op_brightness(work, 24))
+MP_BENCH_OP(mp_bench_contrast, mp_op_contrast(work, 1.3f))
+MP_BENCH_OP(mp_bench_saturation, mp_op_saturation(work, 1.4f))
+MP_BENCH_OP(mp_bench_hue, mp_op_hue(work, 30))
+MP_BENCH_OP(mp_bench_colorize, mp_op_to_color(work))
+MP_BENCH_OP(mp_bench_invert_gray, mp_op_invert_grayscale(work))
+MP_BENCH_OP(mp_bench_rotate90, mp_op_rotate(work, 90))
+MP_BENCH_OP(mp_bench_rotate180, mp_op_rotate(work, 180))
+MP_BENCH_OP(mp_bench_flip_h, mp_op_flip_horizontal(work))
+MP_BENCH_OP(mp_bench_flip_v, mp_op_flip_vertical(work))
+MP_BENCH_OP(mp_bench_crop, mp_op_crop(work, work->buffer->width / 4, work->buffer->height / 4,
+                                      work->buffer->width / 2, work->buffer->height / 2))
+MP_BENCH_OP(mp_bench_resize_bilinear,
+            mp_op_resize_ex(work, work->buffer->width / 2, work->buffer->height / 2, MP_RESIZE_BILINEAR))
+MP_BENCH_OP(mp_bench_resize_nearest,
+            mp_op_resize_ex(work, work->buffer->width / 2, work->buffer->height / 2, MP_RESIZE_NEAREST))
+
+/* JPEG files cannot be produced or decoded yet (the bitstream writer and entropy decoder
+ * are skeletons), so the JPEG codec is measured through its IDCT kernel; GIF, TIFF and
+ * WebP have no codec behind their loaders.
+ * / JPEG 비트스트림은 아직 골격뿐이라 IDCT 커널로 측정 (GIF/TIFF/WebP는 코덱 없음) */
+static const mp_bench_case g_mp_bench_cases[] = {
+    { "png.encode", mp_bench_png_encode, MP_FALSE, MP_FALSE },
+    { "png.decode", mp_bench_png_decode, MP_FALSE, MP_FALSE },
+    { "bmp.encode", mp_bench_bmp_encode, MP_FALSE, MP_FALSE },
+    { "bmp.decode", mp_bench_bmp_decode, MP_FALSE, MP_FALSE },
+    { "deflate.compress", mp_bench_deflate, MP_FALSE, MP_FALSE },
+    { "deflate.decompress", mp_bench_inflate, MP_FALSE, MP_FALSE },
+    { "lz.compress", mp_bench_lz_compress, MP_FALSE, MP_FALSE },
+    { "lz.decompress", mp_bench_lz_decompress, MP_FALSE, MP_FALSE },
+    { "jpeg.idct", mp_bench_jpeg_idct, MP_FALSE, MP_FALSE },
+    { "op.grayscale", mp_bench_grayscale, MP_TRUE, MP_TRUE },
+    { "op.invert", mp_bench_invert, MP_TRUE, MP_FALSE },
+    { "op.brightness", mp_bench_brightness, MP_TRUE, MP_FALSE },
+    { "op.contrast", mp_bench_contrast, MP_TRUE, MP_FALSE },
+    { "op.saturation", mp_bench_saturation, MP_TRUE, MP_TRUE },
+    { "op.hue", mp_bench_hue, MP_TRUE, MP_TRUE },
+    { "op.colorize", mp_bench_colorize, MP_TRUE, MP_FALSE },
+    { "op.invert_grayscale", mp_bench_invert_gray, MP_TRUE, MP_FALSE },
+    { "op.rotate90", mp_bench_rotate90, MP_TRUE, MP_FALSE },
+    { "op.rotate180", mp_bench_rotate180, MP_TRUE, MP_FALSE },
+    { "op.flip_horizontal", mp_bench_flip_h, MP_TRUE, MP_FALSE },
+    { "op.flip_vertical", mp_bench_flip_v, MP_TRUE, MP_FALSE },
+    { "op.crop", mp_bench_crop, MP_TRUE, MP_FALSE },
+    { "op.resize_bilinear", mp_bench_resize_bilinear, MP_TRUE, MP_FALSE },
+    { "op.resize_nearest", mp_bench_resize_nearest, MP_TRUE, MP_FALSE },
+};
+#define MP_BENCH_CASE_COUNT (sizeof(g_mp_bench_cases) / sizeof(g_mp_bench_cases[0]))
+
+static mp_image* mp_bench_copy(const mp_image* source) {
+    const mp_image_buffer* src = source->buffer;
+    mp_image* copy = mp_image_create(src->width, src->height, src->format);
+    if (!copy) return NULL;
+    for (u32 y = 0; y < src->height; y++) {
+        memcpy(copy->buffer->data + (size_t)y * copy->buffer->stride, src->data + (size_t)y * src->stride,
+               (size_t)src->width * src->bpp);
+    }
+    return copy;
+}
+
+/* Inputs shared by every case of one corpus image / 한 코퍼스 이미지의 모든 케이스가 공유하는 입력 */
+static mp_bool mp_bench_prepare(mp_bench_ctx* ctx, const mp_image* source) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->source = source;
+    int pid = (int)getpid();
+    snprintf(ctx->png_path, sizeof(ctx->png_path), "/tmp/mp-bench-%d.png", pid);
+    snprintf(ctx->bmp_path, sizeof(ctx->bmp_path), "/tmp/mp-bench-%d.bmp", pid);
+    snprintf(ctx->out_path, sizeof(ctx->out_path), "/tmp/mp-bench-%d-out", pid);
+    if (mp_image_save((mp_image*)source, ctx->png_path, MP_FORMAT_PNG) != MP_SUCCESS ||
+        mp_image_save((mp_image*)source, ctx->bmp_path, MP_FORMAT_BMP) != MP_SUCCESS) {
+        return MP_FALSE;
+    }
+    
+    const mp_image_buffer* buffer = source->buffer;
+    size_t row_bytes = (size_t)buffer->width * buffer->bpp;
+    ctx->raw_size = row_bytes * buffer->height;
+    ctx->scratch_size = mp_lz_bound(ctx->raw_size);
+    ctx->raw = (u8*)mp_malloc(ctx->raw_size);
+    ctx->scratch = (u8*)mp_malloc(ctx->scratch_size);
+    ctx->lz = (u8*)mp_malloc(ctx->scratch_size);
+    if (!ctx->raw || !ctx->scratch || !ctx->lz) return MP_FALSE;
+    for (u32 y = 0; y < buffer->height; y++) {
+        memcpy(ctx->raw + y * row_bytes, buffer->data + (size_t)y * buffer->stride, row_bytes);
+    }
+    if (mp_deflate_compress(ctx->raw, ctx->raw_size, &ctx->deflated, &ctx->deflated_size) != MP_SUCCESS) {
+        return MP_FALSE;
+    }
+    ctx->lz_size = mp_lz_compress(ctx->raw, ctx->raw_size, ctx->lz, ctx->scratch_size);
+    if (!ctx->lz_size) return MP_FALSE;
+    
+    /* Level-shifted green (or gray) samples stand in for dequantized coefficients
+     * / 레벨 이동한 녹색(회색조) 샘플을 역양자화 계수 대신 사용 */
+    u32 channel = buffer->bpp >= 3 ? 1 : 0;
+    u32 bx = buffer->width / 8, by = buffer->height / 8;
+    ctx->block_count = bx * by;
+    ctx->blocks = (i16*)mp_malloc((size_t)ctx->block_count * 64 * sizeof(i16) + sizeof(i16));
+    if (!ctx->blocks) return MP_FALSE;
+    for (u32 b = 0; b < ctx->block_count; b++) {
+        i16* block = ctx->blocks + (size_t)b * 64;
+        u32 x0 = (b % bx) * 8, y0 = (b / bx) * 8;
+        for (u32 i = 0; i < 64; i++) {
+            block[i] = (i16)(buffer->data[(size_t)(y0 + i / 8) * buffer->stride + (x0 + i % 8) * buffer->bpp + channel] - 128);
+        }
+    }
+    return MP_TRUE;
+}
+
+static void mp_bench_release(mp_bench_ctx* ctx) {
+    unlink(ctx->png_path);
+    unlink(ctx->bmp_path);
+    unlink(ctx->out_path);
+    mp_free(ctx->raw);
+    mp_free(ctx->scratch);
+    mp_free(ctx->lz);
+    mp_free(ctx->deflated);
+    mp_free(ctx->blocks);
+}
+
+static void mp_bench_cleanup(mp_bench_ctx* ctx, u32 batch) {
+    for (u32 i = 0; i < batch; i++) {
+        if (ctx->work[i]) mp_image_destroy(ctx->work[i]);
+        if (ctx->decoded[i]) mp_image_destroy(ctx->decoded[i]);
+        if (ctx->output[i]) mp_free(ctx->output[i]);
+        ctx->work[i] = ctx->decoded[i] = NULL;
+        ctx->output[i] = NULL;
+    }
+}
+
+/* One sample: `batch` back-to-back calls, with their mean in `elapsed_ms` and each call's own time in
+ * `call_ms` when given / 연속 호출 `batch`회를 한 표본으로 측정 (평균과 호출별 시간) */
+static mp_bool mp_bench_sample(mp_bench_ctx* ctx, const mp_bench_case* bench, u32 batch, f64* elapsed_ms,
+                               f64* call_ms) {
+    for (u32 i = 0; i < batch && bench->in_place; i++) {
+        if (!(ctx->work[i] = mp_bench_copy(ctx->source))) {
+            mp_bench_cleanup(ctx, batch);
+            return MP_FALSE;
+        }
+    }
+    mp_bool ok = MP_TRUE;
+    f64 start = mp_bench_now_ms(), previous = start;
+    for (u32 i = 0; i < batch && ok; i++) {
+        ok = bench->run(ctx, i);
+        f64 now = mp_bench_now_ms();
+        if (call_ms) call_ms[i] = now - previous;
+        previous = now;
+    }
+    *elapsed_ms = (previous - start) / batch;
+    mp_bench_cleanup(ctx, batch);
+    return ok;
+}
+
+/* Time one case; the first of at least one warmup calls sizes the batch so each sample lasts at least
+ * MP_BENCH_MIN_SAMPLE_MS. The median is over sample means, which batching keeps above the clock's
+ * noise; the p95 is over every timed call, since a percentile of batch means would hide slow calls.
+ * Returns MP_FALSE if a call fails.
+ * / 첫 워밍업 호출로 묶음 크기를 정함. 중앙값은 표본 평균, p95는 개별 호출 기준 (호출 실패 시 MP_FALSE) */
+static mp_bool mp_bench_measure(mp_bench_ctx* ctx, const mp_bench_case* bench, u32 warmup, u32 runs,
+                                f64* median_ms, f64* p95_ms) {
+    static f64 calls[MP_BENCH_MAX_RUNS * MP_BENCH_MAX_BATCH];
+    f64 samples[MP_BENCH_MAX_RUNS];
+    f64 single_ms;
+    if (!mp_bench_sample(ctx, bench, 1, &single_ms, NULL)) return MP_FALSE;
+    u32 batch = single_ms >= MP_BENCH_MIN_SAMPLE_MS ? 1 : (u32)(MP_BENCH_MIN_SAMPLE_MS / (single_ms + 1e-6)) + 1;
+    if (batch > MP_BENCH_MAX_BATCH) batch = MP_BENCH_MAX_BATCH;
+    
+    for (u32 run = 1; run < warmup + runs; run++) {
+        f64 elapsed;
+        f64* call_ms = run >= warmup ? calls + (size_t)(run - warmup) * batch : NULL;
+        if (!mp_bench_sample(ctx, bench, batch, &elapsed, call_ms)) return MP_FALSE;
+        if (run >= warmup) samples[run - warmup] = elapsed;
+    }
+    u32 call_count = runs * batch;
+    qsort(samples, runs, sizeof(f64), mp_bench_compare);
+    qsort(calls, call_count, sizeof(f64), mp_bench_compare);
+    *median_ms = samples[runs / 2];
+    *p95_ms = calls[(call_count * 95 + 99) / 100 - 1];   /* Nearest rank / 최근접 순위 */
+    return MP_TRUE;
+}
+
+/* Reads the format mp_bench_save writes, one case per line / mp_bench_save 형식을 줄 단위로 읽음 */
+static mp_result mp_bench_load_baseline(const char* path, mp_bench_result* results, u32* count) {
+    FILE* file = fopen(path, "r");
+    if (!file) return MP_ERROR_FILE_NOT_FOUND;
+    char line[256];
+    *count = 0;
+    while (fgets(line, sizeof(line), file) && *count < MP_BENCH_MAX_RESULTS) {
+        mp_bench_result* r = &results[*count];
+        if (sscanf(line, " \"%63[^\"]\": {\"median_mps\": %lf, \"p95_mps\": %lf", r->name, &r->median_mps,
+                   &r->p95_mps) == 3) {
+            (*count)++;
+        }
+    }
+    fclose(file);
+    return *count ? MP_SUCCESS : MP_ERROR_CORRUPTED;
+}
+
+static mp_result mp_bench_save(const char* path, const mp_bench_result* results, u32 count, u32 runs) {
+    FILE* file = fopen(path, "w");
+    if (!file) return MP_ERROR_IO;
+    fprintf(file, "{\n  \"unit\": \"MP/s\",\n  \"runs\": %u,\n  \"cases\": {\n", runs);
+    for (u32 i = 0; i < count; i++) {
+        fprintf(file, "    \"%s\": {\"median_mps\": %.3f, \"p95_mps\": %.3f}%s\n", results[i].name,
+                results[i].median_mps, results[i].p95_mps, i + 1 < count ? "," : "");
+    }
+    fputs("  }\n}\n", file);
+    mp_bool ok = !ferror(file);
+    if (fclose(file) != 0) ok = MP_FALSE;
+    return ok ? MP_SUCCESS : MP_ERROR_IO;
+}
+
+static const mp_bench_result* mp_bench_find(const mp_bench_result* results, u32 count, const char* name) {
+    for (u32 i = 0; i < count; i++) {
+        if (strcmp(results[i].name, name) == 0) return &results[i];
+    }
+    return NULL;
+}
+
+static void mp_bench_usage(const char* program) {
+    mp_fast_fprintf(2, "Usage: %s [options]\n"
+                       "  --runs <n>          Timed runs per case (default %d)\n"
+                       "  --warmup <n>        Untimed runs first, at least 1 (default %d)\n"
+                       "  --large             Add 3840x2160 images to the corpus\n"
+                       "  --filter <text>     Only cases whose name contains text\n"
+                       "  --baseline <file>   Compare against a saved baseline\n"
+                       "  --threshold <pct>   Allowed median slowdown (default %.0f)\n"
+                       "  --save <file>       Save results as a baseline\n",
+                    program, MP_BENCH_DEFAULT_RUNS, MP_BENCH_DEFAULT_WARMUP, MP_BENCH_DEFAULT_THRESHOLD);
+}
+
+int main(int argc, char** argv) {
+    u32 runs = MP_BENCH_DEFAULT_RUNS, warmup = MP_BENCH_DEFAULT_WARMUP;
+    f64 threshold = MP_BENCH_DEFAULT_THRESHOLD;
+    mp_bool large = MP_FALSE;
+    const char* filter = NULL;
+    const char* baseline_path = NULL;
+    const char* save_path = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        mp_bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--runs") == 0 && has_value) {
+            runs = (u32)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && has_value) {
+            warmup = (u32)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--large") == 0) {
+            large = MP_TRUE;
+        } else if (strcmp(argv[i], "--filter") == 0 && has_value) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && has_value) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && has_value) {
+            threshold = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--save") == 0 && has_value) {
+            save_path = argv[++i];
+        } else {
+            mp_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (runs == 0 || runs > MP_BENCH_MAX_RUNS || warmup == 0 || threshold < 0.0) {
+        mp_bench_usage(argv[0]);
+        return 2;
+    }
+    
+    static mp_bench_result baseline[MP_BENCH_MAX_RESULTS];
+    static mp_bench_result results[MP_BENCH_MAX_RESULTS];
+    u32 baseline_count = 0, result_count = 0;
+    if (baseline_path && mp_bench_load_baseline(baseline_path, baseline, &baseline_count) != MP_SUCCESS) {
+        mp_fast_fprintf(2, "Error: cannot read baseline %s\n", baseline_path);
+        return 2;
+    }
+    
+    /* Codecs and ops print progress to stdout; it would interleave with the report and be
+     * timed with the call, so the report keeps its own copy of stdout and fd 1 is discarded
+     * / 코덱 진행 메시지가 보고서에 섞이고 측정에 포함되지 않도록 stdout을 복제 후 fd 1은 버림 */
+    int report_fd = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (report_fd < 0 || null_fd < 0 || !(g_mp_bench_out = fdopen(report_fd, "w"))) {
+        mp_fast_fprintf(2, "Error: cannot set up report output\n");
+        return 2;
+    }
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+    
+    mp_memory_init();
+    FILE* out = g_mp_bench_out;
+    fprintf(out, "manypictures-bench: %u runs after %u warmup, %u threads, MP/s of source pixels\n",
+            runs, warmup, mp_parallel_thread_count());
+    fprintf(out, "%-44s %10s %10s %10s %10s %9s\n", "case", "median ms", "p95 ms", "median", "p95", "vs base");
+    
+    static const u32 sizes[][2] = { { 640, 480 }, { 1920, 1080 }, { 3840, 2160 } };
+    /* RGB cases keep their unsuffixed names so older baselines still match
+     * / 이전 기준 파일과 맞도록 RGB 케이스는 접미사 없는 이름 유지 */
+    static const mp_color_format formats[] = { MP_COLOR_FORMAT_RGB, MP_COLOR_FORMAT_GRAYSCALE, MP_COLOR_FORMAT_RGBA };
+    u32 variant_count = MP_CORPUS_KIND_COUNT * (u32)(sizeof(formats) / sizeof(formats[0]));
+    u32 size_count = large ? 3 : 2;
+    u32 regressions = 0, compared = 0;
+    f64 log_ratio_sum = 0.0;   /* For the geometric mean speedup / 기하 평균 속도 향상용 */
+    int status = 0;
+    
+    for (u32 s = 0; s < size_count && !status; s++) {
+        for (u32 k = 0; k < variant_count && !status; k++) {
+            u32 width = sizes[s][0], height = sizes[s][1];
+            mp_corpus_kind kind = (mp_corpus_kind)(k % MP_CORPUS_KIND_COUNT);
+            mp_color_format format = formats[k / MP_CORPUS_KIND_COUNT];
+            char variant[32];
+            if (format == MP_COLOR_FORMAT_RGB) {
+                snprintf(variant, sizeof(variant), "%s", mp_corpus_kind_name(kind));
+            } else {
+                snprintf(variant, sizeof(variant), "%s.%s", mp_corpus_kind_name(kind), mp_corpus_format_name(format));
+            }
+            f64 pixels = (f64)width * height;
+            mp_image* source = mp_corpus_image(kind, width, height, format);
+            mp_bench_ctx ctx;
+            if (!source || !mp_bench_prepare(&ctx, source)) {
+                mp_fast_fprintf(2, "Error: cannot prepare %s %ux%u\n", variant, width, height);
+                if (source) mp_bench_release(&ctx);
+                mp_image_destroy(source);
+                status = 1;
+                break;
+            }
+            
+            for (u32 c = 0; c < MP_BENCH_CASE_COUNT; c++) {
+                const mp_bench_case* bench = &g_mp_bench_cases[c];
+                char name[MP_BENCH_NAME_SIZE];
+                snprintf(name, sizeof(name), "%s %s %ux%u", bench->name, variant, width, height);
+                if (filter && !strstr(name, filter)) continue;
+                if (bench->color_only && format == MP_COLOR_FORMAT_GRAYSCALE) continue;
+                
+                /* A slowdown is measured again before it counts, so one noisy sample set
+                 * does not fail the run; the fastest median is kept
+                 * / 잡음 한 번으로 실패하지 않도록 느려진 케이스는 다시 측정하고 가장 빠른 중앙값 사용 */
+                const mp_bench_result* base = mp_bench_find(baseline, baseline_count, name);
+                f64 median_ms = 0.0, p95_ms = 0.0;
+                mp_bool measured = MP_TRUE;
+                for (u32 attempt = 0; attempt <= MP_BENCH_CONFIRM && measured; attempt++) {
+                    f64 m, p;
+                    measured = mp_bench_measure(&ctx, bench, warmup, runs, &m, &p);
+                    if (measured && (attempt == 0 || m < median_ms)) {
+                        median_ms = m;
+                        p95_ms = p;
+                    }
+                    if (!base || pixels / (median_ms * 1e3) >= base->median_mps * (1.0 - threshold / 100.0)) break;
+                }
+                if (!measured) {
+                    mp_fast_fprintf(2, "Error: %s failed\n", name);
+                    status = 1;
+                    break;
+                }
+                mp_bench_result* result = &results[result_count++];
+                snprintf(result->name, sizeof(result->name), "%s", name);
+                result->median_mps = pixels / (median_ms * 1e3);
+                result->p95_mps = pixels / (p95_ms * 1e3);
+                
+                char delta[32] = "";
+                if (base && base->median_mps > 0.0) {
+                    f64 change = (result->median_mps / base->median_mps - 1.0) * 100.0;
+                    log_ratio_sum += log(result->median_mps / base->median_mps);
+                    compared++;
+                    mp_bool regressed = change < -threshold;
+                    regressions += regressed;
+                    snprintf(delta, sizeof(delta), "%+.1f%%%s", change, regressed ? " !" : "");
+                } else if (baseline_path) {
+                    snprintf(delta, sizeof(delta), "new");
+                }
+                fprintf(out, "%-44s %10.3f %10.3f %10.1f %10.1f %9s\n", name, median_ms, p95_ms,
+                        result->median_mps, result->p95_mps, delta);
+                fflush(out);
+            }
+            
+            mp_bench_release(&ctx);
+            mp_image_destroy(source);
+        }
+    }
+    
+    if (!status && save_path) {
+        if (mp_bench_save(save_path, results, result_count, runs) != MP_SUCCESS) {
+            mp_fast_fprintf(2, "Error: cannot write %s\n", save_path);
+            status = 1;
+        } else {
+            fprintf(out, "Baseline saved: %s\n", save_path);
+        }
+    }
+    if (!status && compared) {
+        fprintf(out, "Geometric mean speedup: %.3fx over %u case(s) against %s\n",
+                exp(log_ratio_sum / compared), compared, baseline_path);
+    }
+    if (!status && baseline_path) {
+        if (regressions) {
+            fprintf(out, "%u case(s) regressed by more than %.1f%% against %s\n", regressions, threshold,
+                    baseline_path);
+            status = 1;
+        } else {
+            fprintf(out, "No regressions beyond %.1f%% against %s\n", threshold, baseline_path);
+        }
+    }
+    
+    mp_memory_shutdown();
+    fclose(out);
+    return status;
+}
@@ -0,0 +1,175 @@
+#include "corpus.h"
+#include <stdint.h>
+
+#define MP_CORPUS_BLOBS 12
+
+static const char* const g_mp_corpus_names[MP_CORPUS_KIND_COUNT] = { "noise", "gradient", "photo", "text" };
+
+const char* mp_corpus_kind_name(mp_corpus_kind kind) {
+    return kind < MP_CORPUS_KIND_COUNT ? g_mp_corpus_names[kind] : "unknown";
+}
+
+/* Integer hash with full avalanche; pixels are a pure function of their inputs
+ * / 완전 눈사태 정수 해시 (픽셀은 입력만의 함수) */
+static u32 mp_corpus_hash(u32 x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+static u8 mp_corpus_clamp(f32 value) {
+    return value <= 0.0f ? 0 : value >= 255.0f ? 255 : (u8)(value + 0.5f);
+}
+
+static void mp_corpus_noise(mp_image_buffer* buffer, u32 seed) {
+    for (u32 y = 0; y < buffer->height; y++) {
+        u8* row = buffer->data + (size_t)y * buffer->stride;
+        u32 state = mp_corpus_hash(seed ^ (y * 0x9E3779B9u));
+        for (u32 x = 0; x < buffer->width * 3; x++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            row[x] = (u8)(state >> 24);
+        }
+    }
+}
+
+static void mp_corpus_gradient(mp_image_buffer* buffer) {
+    u32 w = buffer->width > 1 ? buffer->width - 1 : 1;
+    u32 h = buffer->height > 1 ? buffer->height - 1 : 1;
+    for (u32 y = 0; y < buffer->height; y++) {
+        u8* row = buffer->data + (size_t)y * buffer->stride;
+        for (u32 x = 0; x < buffer->width; x++) {
+            row[x * 3] = (u8)(x * 255 / w);
+            row[x * 3 + 1] = (u8)(y * 255 / h);
+            row[x * 3 + 2] = (u8)((x + y) * 255 / (w + h));
+        }
+    }
+}
+
+/* Sky-to-ground backdrop, soft shapes and low-amplitude sensor noise
+ * / 하늘-지면 배경, 부드러운 도형, 저진폭 센서 노이즈 */
+static void mp_corpus_photo(mp_image_buffer* buffer, u32 seed) {
+    f32 cx[MP_CORPUS_BLOBS], cy[MP_CORPUS_BLOBS], inv_r2[MP_CORPUS_BLOBS], color[MP_CORPUS_BLOBS][3];
+    f32 scale = (f32)(buffer->width < buffer->height ? buffer->width : buffer->height);
+    for (u32 i = 0; i < MP_CORPUS_BLOBS; i++) {
+        u32 h = mp_corpus_hash(seed + i * 0x632BE5ABu);
+        cx[i] = (f32)(h & 0xFFFF) / 65535.0f * (f32)buffer->width;
+        cy[i] = (f32)(h >> 16) / 65535.0f * (f32)buffer->height;
+        f32 r = scale * (0.05f + (f32)(mp_corpus_hash(h) & 0xFF) / 255.0f * 0.25f);
+        inv_r2[i] = 1.0f / (r * r);
+        u32 c = mp_corpus_hash(h ^ 0xA5A5A5A5u);
+        for (u32 k = 0; k < 3; k++) color[i][k] = (f32)((c >> (k * 8)) & 0xFF) - 128.0f;
+    }
+    
+    for (u32 y = 0; y < buffer->height; y++) {
+        u8* row = buffer->data + (size_t)y * buffer->stride;
+        f32 t = (f32)y / (f32)(buffer->height > 1 ? buffer->height - 1 : 1);
+        f32 base[3] = { 110.0f + 60.0f * t, 150.0f - 30.0f * t, 210.0f - 130.0f * t };
+        u32 state = mp_corpus_hash(seed ^ ~(y * 0x9E3779B9u));
+        for (u32 x = 0; x < buffer->width; x++) {
+            f32 px[3] = { base[0], base[1], base[2] };
+            for (u32 i = 0; i < MP_CORPUS_BLOBS; i++) {
+                f32 dx = (f32)x - cx[i], dy = (f32)y - cy[i];
+                f32 weight = 1.0f / (1.0f + (dx * dx + dy * dy) * inv_r2[i]);
+                px[0] += color[i][0] * weight;
+                px[1] += color[i][1] * weight;
+                px[2] += color[i][2] * weight;
+            }
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            f32 grain = (f32)(state & 7) - 3.5f;
+            row[x * 3] = mp_corpus_clamp(px[0] + grain);
+            row[x * 3 + 1] = mp_corpus_clamp(px[1] + grain);
+            row[x * 3 + 2] = mp_corpus_clamp(px[2] + grain);
+        }
+    }
+}
+
+/* Lines of 5x7 dot glyphs on paper; about one cell in six is a word gap
+ * / 종이 위 5x7 점 글리프 줄 (약 6칸 중 1칸은 단어 간격) */
+static void mp_corpus_text(mp_image_buffer* buffer, u32 seed) {
+    u32 dot = buffer->height / 360 ? buffer->height / 360 : 1;
+    u32 margin = dot * 8;
+    for (u32 y = 0; y < buffer->height; y++) {
+        u8* row = buffer->data + (size_t)y * buffer->stride;
+        u32 line = y < margin ? UINT32_MAX : (y - margin) / (dot * 10);
+        u32 glyph_row = y < margin ? 0 : (y - margin) / dot % 10;
+        for (u32 x = 0; x < buffer->width; x++) {
+            mp_bool ink = MP_FALSE;
+            if (line != UINT32_MAX && glyph_row < 7 && x >= margin && x + margin < buffer->width) {
+                u32 cell = (x - margin) / (dot * 6);
+                u32 glyph_col = (x - margin) / dot % 6;
+                u32 bits = mp_corpus_hash(seed ^ (line * 0x01000193u + cell * 0x9E3779B9u));
+                if (glyph_col < 5 && bits % 6 != 0) {
+                    u64 mask = (u64)bits | ((u64)mp_corpus_hash(bits) << 32);
+                    ink = (mask >> (glyph_row * 5 + glyph_col)) & 1;
+                }
+            }
+            row[x * 3] = ink ? 32 : 244;
+            row[x * 3 + 1] = ink ? 32 : 241;
+            row[x * 3 + 2] = ink ? 40 : 232;
+        }
+    }
+}
+
+const char* mp_corpus_format_name(mp_color_format format) {
+    switch (format) {
+        case MP_COLOR_FORMAT_RGB: return "rgb";
+        case MP_COLOR_FORMAT_GRAYSCALE: return "gray";
+        case MP_COLOR_FORMAT_RGBA: return "rgba";
+        default: return "unknown";
+    }
+}
+
+/* Luma or RGB plus vignette alpha from an RGB corpus image / RGB 코퍼스 이미지에서 휘도 또는 알파 추가 */
+static void mp_corpus_convert(const mp_image_buffer* src, mp_image_buffer* dst) {
+    f32 cx = (f32)(src->width - 1) * 0.5f, cy = (f32)(src->height - 1) * 0.5f;
+    f32 inv_r2 = 1.0f / (cx * cx + cy * cy + 1.0f);
+    for (u32 y = 0; y < src->height; y++) {
+        const u8* in = src->data + (size_t)y * src->stride;
+        u8* out = dst->data + (size_t)y * dst->stride;
+        f32 dy = (f32)y - cy;
+        for (u32 x = 0; x < src->width; x++) {
+            const u8* px = in + x * 3;
+            if (dst->format == MP_COLOR_FORMAT_GRAYSCALE) {
+                out[x] = (u8)((77 * px[0] + 150 * px[1] + 29 * px[2]) >> 8);
+            } else {
+                f32 dx = (f32)x - cx;
+                f32 d2 = (dx * dx + dy * dy) * inv_r2;
+                out[x * 4] = px[0];
+                out[x * 4 + 1] = px[1];
+                out[x * 4 + 2] = px[2];
+                out[x * 4 + 3] = mp_corpus_clamp(d2 < 0.25f ? 255.0f : 255.0f * (1.0f - d2) / 0.75f);
+            }
+        }
+    }
+}
+
+mp_image* mp_corpus_image(mp_corpus_kind kind, u32 width, u32 height, mp_color_format format) {
+    if (kind >= MP_CORPUS_KIND_COUNT || width == 0 || height == 0) return NULL;
+    if (format != MP_COLOR_FORMAT_RGB && format != MP_COLOR_FORMAT_GRAYSCALE && format != MP_COLOR_FORMAT_RGBA) {
+        return NULL;
+    }
+    mp_image* image = mp_image_create(width, height, MP_COLOR_FORMAT_RGB);
+    if (!image) return NULL;
+    
+    u32 seed = mp_corpus_hash(0x4D504943u ^ ((u32)kind << 28) ^ (width << 14) ^ height);
+    switch (kind) {
+        case MP_CORPUS_NOISE: mp_corpus_noise(image->buffer, seed); break;
+        case MP_CORPUS_GRADIENT: mp_corpus_gradient(image->buffer); break;
+        case MP_CORPUS_PHOTO: mp_corpus_photo(image->buffer, seed); break;
+        case MP_CORPUS_TEXT: mp_corpus_text(image->buffer, seed); break;
+        default: break;
+    }
+    if (format == MP_COLOR_FORMAT_RGB) return image;
+    
+    mp_image* converted = mp_image_create(width, height, format);
+    if (converted) mp_corpus_convert(image->buffer, converted->buffer);
+    mp_image_destroy(image);
+    return converted;
+}
@@ -0,0 +1,37 @@
+#ifndef MANYPICTURES_CORPUS_H
+#define MANYPICTURES_CORPUS_H
+
+#include "../core/types.h"
+#include "../core/image.h"
+
+/* Synthetic benchmark corpus / 합성 벤치마크 코퍼스
+ *
+ * Deterministic images that stress codecs and operations the way real inputs do:
+ * noise defeats prediction and compression, gradients are smooth and highly compressible,
+ * photo-like images mix low-frequency shapes with sensor noise, and text-like images are
+ * flat paper with sharp glyph edges. Pixels depend only on the kind and size, so runs on
+ * different machines and builds process identical bytes. Grayscale variants are the luma of
+ * the RGB image, and RGBA variants add a smooth vignette alpha, opaque in the middle and
+ * fading towards the corners like a cut-out or overlay.
+ * 실제 입력처럼 코덱과 연산에 부하를 주는 결정적 이미지 (종류와 크기만으로 픽셀이 결정됨).
+ * 회색조 변형은 RGB의 휘도, RGBA 변형은 가장자리로 갈수록 투명해지는 알파를 추가.
+ */
+
+typedef enum {
+    MP_CORPUS_NOISE,
+    MP_CORPUS_GRADIENT,
+    MP_CORPUS_PHOTO,
+    MP_CORPUS_TEXT,
+    MP_CORPUS_KIND_COUNT
+} mp_corpus_kind;
+
+const char* mp_corpus_kind_name(mp_corpus_kind kind);
+
+/* New RGB, RGBA or grayscale image, or NULL on allocation failure or another format
+ * / 새 RGB/RGBA/회색조 이미지 (할당 실패나 다른 형식이면 NULL) */
+mp_image* mp_corpus_image(mp_corpus_kind kind, u32 width, u32 height, mp_color_format format);
+
+/* Short name of a corpus format: "rgb", "gray" or "rgba" / 코퍼스 형식의 짧은 이름 */
+const char* mp_corpus_format_name(mp_color_format format);
+
+#endif /* MANYPICTURES_CORPUS_H */
@@ -0,0 +1,127 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../core/types.h"
+#include "../core/memory.h"
+#include "../core/image.h"
+#include "../core/arena.h"
+#include "../core/fast_io.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Heap versus arena PNG decode / 힙 대 아레나 PNG 디코딩
+ *
+ * Decodes the same files through the real loader twice per run: once with arenas in heap
+ * mode (mp_arena_set_heap_mode: every codec temporary is its own heap allocation, grown by
+ * resizing, as before arenas) and once with per-decode arenas. Runs alternate so both modes
+ * see the same cache and page-fault conditions, and the medians are compared. Files given
+ * on the command line are used as they are; without arguments synthetic PNGs of several
+ * sizes are written first.
+ * 같은 파일을 실제 로더로 힙 방식과 아레나 방식으로 번갈아 디코딩해 중앙값을 비교합니다.
+ */
+
+#define MP_BENCH_RUNS 15
+
+static double mp_bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static int mp_bench_compare(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double mp_bench_median(double* samples, u32 count) {
+    qsort(samples, count, sizeof(double), mp_bench_compare);
+    return samples[count / 2];
+}
+
+/* Photo-like content: gradients with low-amplitude noise / 저진폭 노이즈가 섞인 그라디언트 */
+static mp_image* mp_bench_image(u32 width, u32 height) {
+    mp_image* image = mp_image_create(width, height, MP_COLOR_FORMAT_RGB);
+    if (!image) return NULL;
+    u32 seed = 0x12345678u;
+    for (u32 y = 0; y < height; y++) {
+        u8* row = image->buffer->data + (size_t)y * image->buffer->stride;
+        for (u32 x = 0; x < width; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            u8 noise = (u8)(seed >> 28);
+            row[x * 3] = (u8)(x * 255 / width + noise);
+            row[x * 3 + 1] = (u8)(y * 255 / height + noise);
+            row[x * 3 + 2] = (u8)((x + y) * 127 / (width + height) + noise);
+        }
+    }
+    return image;
+}
+
+/* Median decode time of `path` in both modes; MP_FALSE if it does not decode
+ * / 두 방식의 디코딩 시간 중앙값 (디코딩 실패 시 MP_FALSE) */
+static mp_bool mp_bench_file(const char* path, double* heap_ms, double* arena_ms) {
+    double heap[MP_BENCH_RUNS], arena[MP_BENCH_RUNS];
+    for (u32 run = 0; run <= MP_BENCH_RUNS; run++) {
+        /* Run 0 warms caches and the large-buffer pool / 첫 실행은 워밍업 */
+        for (u32 mode = 0; mode < 2; mode++) {
+            mp_arena_set_heap_mode(mode == 0);
+            double t0 = mp_bench_now_ms();
+            mp_image* image = mp_image_load(path);
+            double t1 = mp_bench_now_ms();
+            if (!image) {
+                mp_arena_set_heap_mode(MP_FALSE);
+                return MP_FALSE;
+            }
+            mp_image_destroy(image);
+            if (run > 0) (mode == 0 ? heap : arena)[run - 1] = t1 - t0;
+        }
+    }
+    mp_arena_set_heap_mode(MP_FALSE);
+    *heap_ms = mp_bench_median(heap, MP_BENCH_RUNS);
+    *arena_ms = mp_bench_median(arena, MP_BENCH_RUNS);
+    return MP_TRUE;
+}
+
+static void mp_bench_report(const char* label, double heap_ms, double arena_ms) {
+    printf("%-24s %10.2f %10.2f %+8.1f%%\n", label, heap_ms, arena_ms, 100.0 * (arena_ms - heap_ms) / heap_ms);
+}
+
+int main(int argc, char** argv) {
+    static const u32 sizes[][2] = { { 640, 480 }, { 1920, 1080 }, { 4000, 3000 } };
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/mp-alloc-bench-%d.png", (int)getpid());
+    
+    mp_memory_init();
+    printf("%-24s %10s %10s %9s\n", "file", "heap ms", "arena ms", "change");
+    
+    double heap_ms, arena_ms;
+    for (int i = 1; i < argc; i++) {
+        if (!mp_bench_file(argv[i], &heap_ms, &arena_ms)) {
+            mp_fast_fprintf(2, "Error: cannot decode %s\n", argv[i]);
+            return 1;
+        }
+        const char* name = strrchr(argv[i], '/');
+        mp_bench_report(name ? name + 1 : argv[i], heap_ms, arena_ms);
+    }
+    
+    for (u32 s = 0; argc == 1 && s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        u32 width = sizes[s][0], height = sizes[s][1];
+        mp_image* source = mp_bench_image(width, height);
+        if (!source || mp_image_save(source, path, MP_FORMAT_PNG) != MP_SUCCESS) {
+            mp_fast_fprintf(2, "Error: cannot write %s\n", path);
+            return 1;
+        }
+        mp_image_destroy(source);
+        if (!mp_bench_file(path, &heap_ms, &arena_ms)) {
+            mp_fast_fprintf(2, "Error: cannot decode %s\n", path);
+            return 1;
+        }
+        char label[32];
+        snprintf(label, sizeof(label), "%ux%u", width, height);
+        mp_bench_report(label, heap_ms, arena_ms);
+    }
+    
+    unlink(path);
+    mp_memory_shutdown();
+    return 0;
+}
@@ -0,0 +1,205 @@
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+#include "../core/types.h"
+#include "../core/row_convert.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+/* Row converters versus scalar loops / 행 변환기 대 스칼라 루프 비교
+ *
+ * Runs every converter mp_row_converter_for hands out, and mp_row_expand_palette at 1, 3
+ * and 4 bytes per pixel, against a plain per-pixel loop written here, for every count up
+ * to MP_CHECK_MAX_COUNT and a few long odd rows. Both the source and the destination end
+ * against an inaccessible page, so a kernel reading or writing past its row faults.
+ * MP_SIMD=0 forces the scalar paths, so `make test` runs this once with and once without
+ * the SSSE3 kernels. Exits non-zero on the first mismatch.
+ * 모든 변환기와 팔레트 확장이 스칼라 루프와 같은 결과를 내는지 보호 페이지와 함께 검사합니다.
+ */
+
+#define MP_CHECK_MAX_COUNT 64
+#define MP_CHECK_LONGEST 1001
+
+static const mp_color_format g_mp_check_formats[] = {
+    MP_COLOR_FORMAT_RGB, MP_COLOR_FORMAT_BGR, MP_COLOR_FORMAT_RGBA,
+    MP_COLOR_FORMAT_BGRA, MP_COLOR_FORMAT_GRAYSCALE, MP_COLOR_FORMAT_GRAYSCALE_ALPHA
+};
+static const char* const g_mp_check_names[] = { "RGB", "BGR", "RGBA", "BGRA", "GRAYSCALE", "GRAYSCALE_ALPHA" };
+#define MP_CHECK_FORMAT_COUNT (sizeof(g_mp_check_formats) / sizeof(g_mp_check_formats[0]))
+
+/* Long rows: odd, and not a multiple of any kernel step / 긴 행 (홀수, 어떤 커널 단계의 배수도 아님) */
+static const u32 g_mp_check_long_counts[] = { 333, MP_CHECK_LONGEST };
+#define MP_CHECK_LONG_COUNT (sizeof(g_mp_check_long_counts) / sizeof(g_mp_check_long_counts[0]))
+
+/* A region whose last byte sits right before a PROT_NONE page / 끝이 접근 불가 페이지에 붙은 영역 */
+typedef struct {
+    u8* base;
+    u8* end;
+    size_t size;
+} mp_check_region;
+
+static mp_bool mp_check_region_map(mp_check_region* region, size_t bytes) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t area = ((bytes + page - 1) / page) * page;
+    u8* base = (u8*)mmap(NULL, area + page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return MP_FALSE;
+    if (mprotect(base + area, page, PROT_NONE) != 0) {
+        munmap(base, area + page);
+        return MP_FALSE;
+    }
+    region->base = base;
+    region->end = base + area;
+    region->size = area + page;
+    return MP_TRUE;
+}
+
+static void mp_check_region_unmap(mp_check_region* region) {
+    if (region->base) munmap(region->base, region->size);
+}
+
+static u32 mp_check_bpp(mp_color_format format) {
+    switch (format) {
+        case MP_COLOR_FORMAT_RGBA:
+        case MP_COLOR_FORMAT_BGRA: return 4;
+        case MP_COLOR_FORMAT_GRAYSCALE: return 1;
+        case MP_COLOR_FORMAT_GRAYSCALE_ALPHA: return 2;
+        default: return 3;
+    }
+}
+
+static u32 mp_check_next(u32* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void mp_check_fill(u8* dst, size_t bytes, u32 seed) {
+    u32 state = seed | 1;
+    for (size_t i = 0; i < bytes; i++) dst[i] = (u8)mp_check_next(&state);
+}
+
+/* Reference: read RGBA, write it back in the target layout; gray expands to equal
+ * channels and a missing alpha becomes 255 / 기준 구현: RGBA로 읽어 대상 배치로 기록 */
+static void mp_check_reference(const u8* src, mp_color_format from, u8* dst, mp_color_format to, u32 count) {
+    u32 from_bpp = mp_check_bpp(from), to_bpp = mp_check_bpp(to);
+    for (u32 x = 0; x < count; x++) {
+        const u8* s = src + (size_t)x * from_bpp;
+        u8* d = dst + (size_t)x * to_bpp;
+        u8 r, g, b, a = 255;
+        switch (from) {
+            case MP_COLOR_FORMAT_BGR: b = s[0]; g = s[1]; r = s[2]; break;
+            case MP_COLOR_FORMAT_BGRA: b = s[0]; g = s[1]; r = s[2]; a = s[3]; break;
+            case MP_COLOR_FORMAT_RGBA: r = s[0]; g = s[1]; b = s[2]; a = s[3]; break;
+            case MP_COLOR_FORMAT_GRAYSCALE: r = g = b = s[0]; break;
+            case MP_COLOR_FORMAT_GRAYSCALE_ALPHA: r = g = b = s[0]; a = s[1]; break;
+            default: r = s[0]; g = s[1]; b = s[2]; break;
+        }
+        switch (to) {
+            case MP_COLOR_FORMAT_BGR: d[0] = b; d[1] = g; d[2] = r; break;
+            case MP_COLOR_FORMAT_BGRA: d[0] = b; d[1] = g; d[2] = r; d[3] = a; break;
+            case MP_COLOR_FORMAT_RGBA: d[0] = r; d[1] = g; d[2] = b; d[3] = a; break;
+            case MP_COLOR_FORMAT_GRAYSCALE: d[0] = r; break;
+            case MP_COLOR_FORMAT_GRAYSCALE_ALPHA: d[0] = r; d[1] = a; break;
+            default: d[0] = r; d[1] = g; d[2] = b; break;
+        }
+    }
+}
+
+/* Convert `count` pixels, each row ending at its guard page, and compare / 변환 후 비교 */
+static mp_bool mp_check_convert(mp_row_converter convert, u32 f, u32 t, u32 count, const mp_check_region* src_region,
+                                const mp_check_region* dst_region, u8* ref) {
+    mp_color_format from = g_mp_check_formats[f], to = g_mp_check_formats[t];
+    u32 to_bpp = mp_check_bpp(to);
+    u8* src = src_region->end - (size_t)count * mp_check_bpp(from);
+    u8* dst = dst_region->end - (size_t)count * to_bpp;
+    mp_check_fill(src, (size_t)count * mp_check_bpp(from), count * 2654435761u + f * 7 + t);
+    mp_check_fill(dst, (size_t)count * to_bpp, 0xA5A5A5A5u + count);
+    
+    convert(src, dst, count);
+    mp_check_reference(src, from, ref, to, count);
+    
+    for (u32 x = 0; x < count; x++) {
+        if (memcmp(dst + (size_t)x * to_bpp, ref + (size_t)x * to_bpp, to_bpp) != 0) {
+            fprintf(stderr, "FAIL %s -> %s count %u pixel %u\n", g_mp_check_names[f], g_mp_check_names[t], count, x);
+            return MP_FALSE;
+        }
+    }
+    return MP_TRUE;
+}
+
+/* Palette expansion: the first `bpp` bytes of each entry / 팔레트 확장 (항목의 앞 `bpp` 바이트) */
+static mp_bool mp_check_palette(const u32 table[256], u32 bpp, u32 count, const mp_check_region* src_region,
+                                const mp_check_region* dst_region, u8* ref) {
+    u8* indices = src_region->end - count;
+    u8* dst = dst_region->end - (size_t)count * bpp;
+    mp_check_fill(indices, count, count * 40503u + bpp);
+    
+    mp_row_expand_palette(indices, table, dst, count, bpp);
+    for (u32 x = 0; x < count; x++) {
+        const u8* entry = (const u8*)&table[indices[x]];
+        for (u32 c = 0; c < bpp; c++) ref[(size_t)x * bpp + c] = entry[c];
+    }
+    
+    for (u32 x = 0; x < count; x++) {
+        if (memcmp(dst + (size_t)x * bpp, ref + (size_t)x * bpp, bpp) != 0) {
+            fprintf(stderr, "FAIL palette bpp %u count %u pixel %u\n", bpp, count, x);
+            return MP_FALSE;
+        }
+    }
+    return MP_TRUE;
+}
+
+int main(void) {
+    size_t longest = (size_t)MP_CHECK_LONGEST * 4;
+    mp_check_region src_region = { 0 }, dst_region = { 0 };
+    u8* ref = (u8*)malloc(longest);
+    if (!mp_check_region_map(&src_region, longest) || !mp_check_region_map(&dst_region, longest) || !ref) {
+        fprintf(stderr, "Error: cannot set up guard pages\n");
+        return 2;
+    }
+    
+    const char* level = getenv("MP_SIMD");
+    u32 pairs = 0, checked = 0;
+    mp_bool ok = MP_TRUE;
+    for (u32 f = 0; f < MP_CHECK_FORMAT_COUNT && ok; f++) {
+        for (u32 t = 0; t < MP_CHECK_FORMAT_COUNT && ok; t++) {
+            mp_row_converter convert = mp_row_converter_for(g_mp_check_formats[f], g_mp_check_formats[t]);
+            if (!convert) continue;
+            pairs++;
+            for (u32 count = 0; count <= MP_CHECK_MAX_COUNT && ok; count++, checked++) {
+                ok = mp_check_convert(convert, f, t, count, &src_region, &dst_region, ref);
+            }
+            for (u32 i = 0; i < MP_CHECK_LONG_COUNT && ok; i++, checked++) {
+                ok = mp_check_convert(convert, f, t, g_mp_check_long_counts[i], &src_region, &dst_region, ref);
+            }
+        }
+    }
+    
+    u32 table[256];
+    u32 state = 0x9E3779B9u;
+    for (u32 i = 0; i < 256; i++) table[i] = mp_check_next(&state);
+    static const u32 palette_bpps[] = { 1, 3, 4 };
+    for (u32 b = 0; b < sizeof(palette_bpps) / sizeof(palette_bpps[0]) && ok; b++) {
+        for (u32 count = 0; count <= MP_CHECK_MAX_COUNT && ok; count++, checked++) {
+            ok = mp_check_palette(table, palette_bpps[b], count, &src_region, &dst_region, ref);
+        }
+        for (u32 i = 0; i < MP_CHECK_LONG_COUNT && ok; i++, checked++) {
+            ok = mp_check_palette(table, palette_bpps[b], g_mp_check_long_counts[i], &src_region, &dst_region, ref);
+        }
+    }
+    
+    free(ref);
+    mp_check_region_unmap(&src_region);
+    mp_check_region_unmap(&dst_region);
+    if (!ok) return 1;
+    printf("row_convert: %u rows over %u converters and 3 palette depths match the scalar loops (MP_SIMD=%s)\n",
+           checked, pairs, level ? level : "auto");
+    return 0;
+}
@@ -41,6 +41,14 @@ static const u8 g_jpeg_quant_chroma[64] = {
     53, 60, 61, 54, 47, 55, 62, 63
 }; */
 
+/* Huffman table as stored in DHT: code counts per length and symbols in code order
+ * / DHT 형식의 허프만 테이블 (길이별 코드 수와 코드 순서의 심볼) */
+typedef struct {
+    u8 counts[16];
+    u8 symbols[256];
+    u32 symbol_count;
+} jpeg_huffman_table;
+
 /* High-performance integer-based Discrete Cosine Transform (DCT)
  * Using fixed-point arithmetic for extreme speed and accuracy.
  * Implementation based on Arai, Agui, and Nakajima (AAN) algorithm.
@@ -77,6 +85,7 @@ jpeg_decoder* mp_jpeg_decoder_create(const u8* data, size_t size) {
     /* Initialize metadata */
     decoder->num_components = 0;
     memset(decoder->quant_table_defined, 0, sizeof(decoder->quant_table_defined));
+    mp_arena_init(&decoder->arena, 4096, MP_ALLOC_CODEC);
     
     return decoder;
 }
@@ -84,11 +93,8 @@ jpeg_decoder* mp_jpeg_decoder_create(const u8* data, size_t size) {
 void mp_jpeg_decoder_destroy(jpeg_decoder* decoder) {
     if (!decoder) return;
     
-    for (int i = 0; i < 4; i++) {
-        if (decoder->huffman_dc_tables[i]) mp_free(decoder->huffman_dc_tables[i]);
-        if (decoder->huffman_ac_tables[i]) mp_free(decoder->huffman_ac_tables[i]);
-    }
-    
+    /* Huffman tables and scratch go back together / 허프만 테이블과 임시 버퍼를 함께 반환 */
+    mp_arena_release(&decoder->arena);
     mp_free(decoder);
 }
 
@@ -137,6 +143,37 @@ mp_result mp_jpeg_decode(jpeg_decoder* decoder, mp_image_buffer** out_buffer) {
                 }
                 break;
             }
+            case JPEG_MARKER_DHT: {
+                u16 len = mp_jpeg_read_u16(decoder);
+                if (len < 2 || decoder->pos + len - 2 > decoder->size) return MP_ERROR_CORRUPTED;
+                size_t end = decoder->pos + len - 2;
+                while (decoder->pos + 17 <= end) {
+                    u8 info = decoder->data[decoder->pos++];
+                    u8 table_class = info >> 4;
+                    u8 id = info & 0x0F;
+                    if (table_class > 1 || id >= 4) return MP_ERROR_CORRUPTED;
+                    
+                    void** slot = table_class ? &decoder->huffman_ac_tables[id] : &decoder->huffman_dc_tables[id];
+                    jpeg_huffman_table* table = (jpeg_huffman_table*)*slot;
+                    if (!table) {
+                        /* Redefinitions reuse the slot / 재정의는 같은 공간 재사용 */
+                        table = (jpeg_huffman_table*)mp_arena_alloc(&decoder->arena, sizeof(jpeg_huffman_table));
+                        if (!table) return MP_ERROR_MEMORY;
+                        *slot = table;
+                    }
+                    u32 total = 0;
+                    for (int i = 0; i < 16; i++) {
+                        table->counts[i] = decoder->data[decoder->pos++];
+                        total += table->counts[i];
+                    }
+                    if (total > 256 || decoder->pos + total > end) return MP_ERROR_CORRUPTED;
+                    memcpy(table->symbols, &decoder->data[decoder->pos], total);
+                    table->symbol_count = total;
+                    decoder->pos += total;
+                }
+                decoder->pos = end;
+                break;
+            }
             /* Other markers handled in full implementation... */
             case JPEG_MARKER_SOS: goto start_scan;
             default: {
@@ -192,7 +229,7 @@ void mp_jpeg_idct(const i16 input[64], i16 output[64]) {
         MP_FIX(0.353553391f), MP_FIX(0.490392640f), MP_FIX(0.461939766f), MP_FIX(0.415734806f),
         MP_FIX(0.353553391f), MP_FIX(0.277785117f), MP_FIX(0.191341716f), MP_FIX(0.097545161f)
     };
-
+    
     /* Butterfly Row-Column decomposition for monster performance / 성능 극대화를 위한 버터플라이 행-열 분해 */
     for (int i = 0; i < 8; i++) {
         /* Row pass / 행 단위 패스 */
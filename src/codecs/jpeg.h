@@ -2,6 +2,7 @@
 #define MANYPICTURES_JPEG_H
 
 #include "../core/types.h"
+#include "../core/arena.h"
 
 /* JPEG codec implementation */
 
@@ -45,11 +46,13 @@ typedef struct {
     u8 quant_tables[4][64];
     mp_bool quant_table_defined[4];
     
-    void* huffman_dc_tables[4];
+    void* huffman_dc_tables[4];   /* From `arena` / `arena`에서 할당 */
     void* huffman_ac_tables[4];
     
     u16 restart_interval;
     u32 restart_count;
+    
+    mp_arena arena;               /* Per-decode tables and scratch / 디코딩 단위 테이블과 임시 버퍼 */
 } jpeg_decoder;
 
 /* JPEG encoder context */
@@ -0,0 +1,145 @@
+#include "lz.h"
+#include <string.h>
+
+#define MP_LZ_HASH_BITS 12
+#define MP_LZ_MIN_MATCH 4
+#define MP_LZ_MAX_OFFSET 65535
+#define MP_LZ_END_LITERALS 5 /* Tail always emitted as literals / 꼬리 부분은 항상 리터럴로 출력 */
+
+static inline u32 mp_lz_read32(const u8* p) {
+    u32 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline u32 mp_lz_hash(u32 v) {
+    /* Fibonacci hashing of the next four bytes / 다음 4바이트의 피보나치 해싱 */
+    return (v * 2654435761u) >> (32 - MP_LZ_HASH_BITS);
+}
+
+size_t mp_lz_bound(size_t input_size) {
+    return input_size + input_size / 255 + 16;
+}
+
+static mp_bool mp_lz_write_length(u8* output, size_t capacity, size_t* op, size_t length) {
+    while (length >= 255) {
+        if (*op >= capacity) return MP_FALSE;
+        output[(*op)++] = 255;
+        length -= 255;
+    }
+    if (*op >= capacity) return MP_FALSE;
+    output[(*op)++] = (u8)length;
+    return MP_TRUE;
+}
+
+/* Emit one sequence; match_length == 0 marks the literal-only tail / 시퀀스 하나 출력 */
+static mp_bool mp_lz_emit(u8* output, size_t capacity, size_t* op,
+                          const u8* literals, size_t literal_length,
+                          size_t offset, size_t match_length) {
+    if (*op >= capacity) return MP_FALSE;
+    
+    size_t ml = match_length ? match_length - MP_LZ_MIN_MATCH : 0;
+    u8* token = &output[(*op)++];
+    *token = (u8)(((literal_length < 15 ? literal_length : 15) << 4) | (ml < 15 ? ml : 15));
+    
+    if (literal_length >= 15 && !mp_lz_write_length(output, capacity, op, literal_length - 15)) return MP_FALSE;
+    if (literal_length > capacity - *op) return MP_FALSE;
+    memcpy(output + *op, literals, literal_length);
+    *op += literal_length;
+    
+    if (match_length) {
+        if (capacity - *op < 2) return MP_FALSE;
+        output[(*op)++] = (u8)(offset & 0xFF);
+        output[(*op)++] = (u8)(offset >> 8);
+        if (ml >= 15 && !mp_lz_write_length(output, capacity, op, ml - 15)) return MP_FALSE;
+    }
+    return MP_TRUE;
+}
+
+size_t mp_lz_compress(const u8* input, size_t input_size, u8* output, size_t output_capacity) {
+    if (!input || !output) return 0;
+    
+    /* Positions are stored +1 so that 0 means empty / 위치는 +1로 저장 (0은 빈 슬롯) */
+    size_t table[1 << MP_LZ_HASH_BITS];
+    memset(table, 0, sizeof(table));
+    
+    size_t ip = 0, anchor = 0, op = 0;
+    size_t match_limit = input_size > MP_LZ_END_LITERALS ? input_size - MP_LZ_END_LITERALS : 0;
+    
+    while (ip + MP_LZ_MIN_MATCH <= match_limit) {
+        u32 seq = mp_lz_read32(input + ip);
+        u32 h = mp_lz_hash(seq);
+        size_t candidate = table[h];
+        table[h] = ip + 1;
+        
+        if (candidate && ip - (candidate - 1) <= MP_LZ_MAX_OFFSET &&
+            mp_lz_read32(input + candidate - 1) == seq) {
+            size_t ref = candidate - 1;
+            size_t length = MP_LZ_MIN_MATCH;
+            while (ip + length < match_limit && input[ref + length] == input[ip + length]) length++;
+            
+            if (!mp_lz_emit(output, output_capacity, &op, input + anchor, ip - anchor, ip - ref, length)) return 0;
+            ip += length;
+            anchor = ip;
+        } else {
+            ip++;
+        }
+    }
+    
+    if (!mp_lz_emit(output, output_capacity, &op, input + anchor, input_size - anchor, 0, 0)) return 0;
+    return op;
+}
+
+mp_result mp_lz_decompress(const u8* input, size_t input_size, u8* output, size_t output_size) {
+    if (!input || !output) return MP_ERROR_INVALID_PARAM;
+    
+    size_t ip = 0, op = 0;
+    while (ip < input_size) {
+        u8 token = input[ip++];
+        
+        size_t literal_length = token >> 4;
+        if (literal_length == 15) {
+            u8 b;
+            do {
+                if (ip >= input_size) return MP_ERROR_CORRUPTED;
+                b = input[ip++];
+                literal_length += b;
+            } while (b == 255);
+        }
+        if (literal_length > input_size - ip || literal_length > output_size - op) return MP_ERROR_CORRUPTED;
+        memcpy(output + op, input + ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+        
+        if (ip == input_size) break; /* Literal-only tail / 리터럴 전용 꼬리 */
+        
+        if (input_size - ip < 2) return MP_ERROR_CORRUPTED;
+        size_t offset = (size_t)input[ip] | ((size_t)input[ip + 1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) return MP_ERROR_CORRUPTED;
+        
+        size_t match_length = (token & 0x0F);
+        if (match_length == 15) {
+            u8 b;
+            do {
+                if (ip >= input_size) return MP_ERROR_CORRUPTED;
+                b = input[ip++];
+                match_length += b;
+            } while (b == 255);
+        }
+        match_length += MP_LZ_MIN_MATCH;
+        if (match_length > output_size - op) return MP_ERROR_CORRUPTED;
+        
+        u8* d = output + op;
+        const u8* r = d - offset;
+        if (offset >= match_length) {
+            memcpy(d, r, match_length);
+        } else {
+            /* Overlapping copy replicates short runs / 중첩 복사로 짧은 반복 패턴 복제 */
+            for (size_t i = 0; i < match_length; i++) d[i] = r[i];
+        }
+        op += match_length;
+    }
+    
+    return op == output_size ? MP_SUCCESS : MP_ERROR_CORRUPTED;
+}
@@ -0,0 +1,24 @@
+#ifndef MANYPICTURES_LZ_H
+#define MANYPICTURES_LZ_H
+
+#include "../core/types.h"
+
+/* Fast byte-oriented LZ77 block codec (LZ4-style sequences) for in-memory caches
+ * / 메모리 내 캐시용 고속 바이트 단위 LZ77 블록 코덱 (LZ4 스타일 시퀀스)
+ *
+ * Sequence: token (literal length << 4 | match length - 4), extra literal length bytes,
+ * literals, 16-bit little-endian offset, extra match length bytes. The final sequence
+ * carries literals only. / 마지막 시퀀스는 리터럴만 포함합니다.
+ */
+
+/* Worst-case compressed size / 최악의 경우 압축 크기 */
+size_t mp_lz_bound(size_t input_size);
+
+/* Compress into `output`; returns the compressed size, or 0 if it does not fit
+ * / 압축 후 크기 반환 (용량 초과 시 0) */
+size_t mp_lz_compress(const u8* input, size_t input_size, u8* output, size_t output_capacity);
+
+/* Decompress exactly `output_size` bytes / 정확히 `output_size` 바이트로 압축 해제 */
+mp_result mp_lz_decompress(const u8* input, size_t input_size, u8* output, size_t output_size);
+
+#endif /* MANYPICTURES_LZ_H */
@@ -0,0 +1,543 @@
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+#include "alloc.h"
+#include "fast_io.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#define MP_ALLOC_MAGIC_LIVE 0x4D50414Cu     /* "MPAL" */
+#define MP_ALLOC_MAGIC_CACHED 0x4D504643u   /* "MPFC" */
+#define MP_ALLOC_LARGE 0xFFFF                /* size_class of system blocks / 시스템 블록 표시 */
+#define MP_ALLOC_SPAN 0xFFFE                 /* size_class of pooled mappings / 풀 매핑 표시 */
+#define MP_ALLOC_CACHE_BYTES (64u << 10)     /* Cached bytes per class per thread / 스레드별 클래스당 캐시 바이트 */
+#define MP_ALLOC_SPAN_PREFIX 64              /* Pooled blocks start 64 bytes into their mapping / 풀 블록 시작 오프셋 */
+#define MP_ALLOC_POOL_BUCKETS 96             /* Four per power of two from 256KB / 256KB부터 2의 거듭제곱마다 4개 */
+#define MP_ALLOC_HUGE_PAGE (2u << 20)
+
+/* Block prefix; 16 bytes keeps the system alignment / 블록 접두부 (16바이트로 정렬 유지) */
+typedef struct {
+    u64 size;            /* Requested bytes / 요청 바이트 */
+    u16 category;
+    u16 size_class;
+    u32 magic;
+} mp_alloc_header;
+
+_Static_assert(sizeof(mp_alloc_header) == 16, "allocation prefix must stay 16 bytes");
+
+/* Block sizes including the prefix / 접두부를 포함한 블록 크기 */
+static const u32 g_mp_alloc_classes[] = { 32, 48, 64, 80, 96, 128, 160, 192, 256, 320, 384, 512, 640, 768, 1024 };
+#define MP_ALLOC_CLASS_COUNT (sizeof(g_mp_alloc_classes) / sizeof(g_mp_alloc_classes[0]))
+
+/* Class of every block size in 16-byte units / 16바이트 단위 블록 크기별 클래스 */
+static u8 g_mp_alloc_class_of[1024 / 16 + 1];
+
+typedef struct mp_alloc_thread {
+    /* Written only by the owning thread with relaxed stores, read by stats
+     * / 소유 스레드만 relaxed 저장으로 기록하고 통계가 읽음 */
+    atomic_llong pending[MP_ALLOC_CATEGORY_COUNT];     /* Bytes not yet folded / 아직 합산되지 않은 바이트 */
+    atomic_ullong allocations[MP_ALLOC_CATEGORY_COUNT];
+    atomic_ullong frees[MP_ALLOC_CATEGORY_COUNT];
+    atomic_size_t cached_bytes;
+    
+    long long drift;                                   /* |pending| since the last fold / 마지막 합산 이후 변화량 */
+    mp_alloc_header* free_list[MP_ALLOC_CLASS_COUNT];
+    u32 free_count[MP_ALLOC_CLASS_COUNT];
+    mp_bool registered;
+    struct mp_alloc_thread* prev;
+    struct mp_alloc_thread* next;
+} mp_alloc_thread;
+
+static _Thread_local mp_alloc_thread t_mp_alloc;
+
+static pthread_once_t g_mp_alloc_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_mp_alloc_key;
+static pthread_mutex_t g_mp_alloc_lock = PTHREAD_MUTEX_INITIALIZER;   /* Thread list, retired counts / 스레드 목록 */
+static mp_alloc_thread* g_mp_alloc_threads;
+static u64 g_mp_alloc_retired_allocations[MP_ALLOC_CATEGORY_COUNT];
+static u64 g_mp_alloc_retired_frees[MP_ALLOC_CATEGORY_COUNT];
+
+/* Folded byte counters / 합산된 바이트 카운터 */
+static atomic_llong g_mp_alloc_current[MP_ALLOC_CATEGORY_COUNT];
+static atomic_llong g_mp_alloc_peak[MP_ALLOC_CATEGORY_COUNT];
+static atomic_llong g_mp_alloc_total_current;
+static atomic_llong g_mp_alloc_total_peak;
+
+/* Owner-only update of a counter other threads may read / 다른 스레드가 읽는 카운터의 소유자 전용 갱신 */
+#define MP_ALLOC_ADD(counter, delta) \
+    atomic_store_explicit(&(counter), atomic_load_explicit(&(counter), memory_order_relaxed) + (delta), \
+                          memory_order_relaxed)
+
+static void mp_alloc_raise(atomic_llong* peak, long long value) {
+    long long seen = atomic_load_explicit(peak, memory_order_relaxed);
+    while (value > seen && !atomic_compare_exchange_weak_explicit(peak, &seen, value, memory_order_relaxed,
+                                                                  memory_order_relaxed)) {
+    }
+}
+
+/* Move a thread's pending bytes into the global counters / 스레드의 미합산 바이트를 전역 카운터로 이동 */
+static void mp_alloc_fold(mp_alloc_thread* t) {
+    long long total = 0;
+    for (u32 c = 0; c < MP_ALLOC_CATEGORY_COUNT; c++) {
+        long long delta = atomic_load_explicit(&t->pending[c], memory_order_relaxed);
+        if (!delta) continue;
+        long long now = atomic_fetch_add_explicit(&g_mp_alloc_current[c], delta, memory_order_relaxed) + delta;
+        atomic_store_explicit(&t->pending[c], 0, memory_order_relaxed);
+        mp_alloc_raise(&g_mp_alloc_peak[c], now);
+        total += delta;
+    }
+    if (total) {
+        long long now = atomic_fetch_add_explicit(&g_mp_alloc_total_current, total, memory_order_relaxed) + total;
+        mp_alloc_raise(&g_mp_alloc_total_peak, now);
+    }
+    t->drift = 0;
+}
+
+static void mp_alloc_release_cache(mp_alloc_thread* t) {
+    for (u32 i = 0; i < MP_ALLOC_CLASS_COUNT; i++) {
+        mp_alloc_header* h = t->free_list[i];
+        while (h) {
+            mp_alloc_header* next = *(mp_alloc_header**)(h + 1);
+            free(h);
+            h = next;
+        }
+        t->free_list[i] = NULL;
+        t->free_count[i] = 0;
+    }
+    atomic_store_explicit(&t->cached_bytes, 0, memory_order_relaxed);
+}
+
+/* pthread key destructor: runs when a thread that allocated exits / 할당한 스레드 종료 시 실행 */
+static void mp_alloc_thread_exit(void* arg) {
+    mp_alloc_thread* t = (mp_alloc_thread*)arg;
+    mp_alloc_release_cache(t);
+    mp_alloc_fold(t);
+    
+    pthread_mutex_lock(&g_mp_alloc_lock);
+    for (u32 c = 0; c < MP_ALLOC_CATEGORY_COUNT; c++) {
+        g_mp_alloc_retired_allocations[c] += atomic_load_explicit(&t->allocations[c], memory_order_relaxed);
+        g_mp_alloc_retired_frees[c] += atomic_load_explicit(&t->frees[c], memory_order_relaxed);
+        atomic_store_explicit(&t->allocations[c], 0, memory_order_relaxed);
+        atomic_store_explicit(&t->frees[c], 0, memory_order_relaxed);
+    }
+    if (t->prev) t->prev->next = t->next;
+    else g_mp_alloc_threads = t->next;
+    if (t->next) t->next->prev = t->prev;
+    pthread_mutex_unlock(&g_mp_alloc_lock);
+    
+    t->prev = t->next = NULL;
+    t->registered = MP_FALSE;
+}
+
+/* Large-buffer pool / 대형 버퍼 풀 */
+
+/* Bookkeeping in front of the header of a pooled mapping / 풀 매핑의 헤더 앞 관리 정보 */
+typedef struct mp_alloc_span {
+    struct mp_alloc_span* bucket_prev;   /* Free spans of one bucket, latest first / 같은 버킷의 빈 매핑 */
+    struct mp_alloc_span* bucket_next;
+    struct mp_alloc_span* newer;         /* All free spans in free order / 해제 순서 */
+    struct mp_alloc_span* older;
+    size_t length;                       /* Mapping length / 매핑 길이 */
+    u32 bucket;
+} mp_alloc_span;
+
+_Static_assert(sizeof(mp_alloc_span) + sizeof(mp_alloc_header) <= MP_ALLOC_SPAN_PREFIX,
+               "span bookkeeping must fit in front of the block");
+
+static pthread_mutex_t g_mp_alloc_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static mp_alloc_span* g_mp_alloc_pool_buckets[MP_ALLOC_POOL_BUCKETS];
+static mp_alloc_span* g_mp_alloc_pool_newest;
+static mp_alloc_span* g_mp_alloc_pool_oldest;
+static size_t g_mp_alloc_pool_bytes;
+static size_t g_mp_alloc_pool_limit;
+static u64 g_mp_alloc_pool_reuses;
+static u64 g_mp_alloc_pool_maps;
+static atomic_int g_mp_alloc_pool_huge;
+
+static mp_alloc_span* mp_alloc_span_of(mp_alloc_header* h) {
+    return (mp_alloc_span*)((u8*)(h + 1) - MP_ALLOC_SPAN_PREFIX);
+}
+
+/* Mapping length for `bytes`, rounded up to a quarter of its power of two (at most 25%
+ * slack), and its bucket / 2의 거듭제곱의 1/4 단위로 올림한 매핑 길이와 버킷 */
+static u32 mp_alloc_bucket(size_t bytes, size_t* length) {
+    u64 m = (u64)bytes - 1;
+    u32 p = 63 - (u32)__builtin_clzll(m);       /* bytes > 256KB, so p >= 18 */
+    u64 step = (u64)1 << (p - 2);
+    u64 rounded = (m / step + 1) * step;
+    *length = (size_t)rounded;
+    return (p - 18) * 4 + (u32)(rounded >> (p - 2)) - 5;
+}
+
+/* Anonymous mapping of at least `length` bytes; `mapped` receives the real length
+ * / 최소 `length` 바이트의 익명 매핑 */
+static void* mp_alloc_map(size_t length, size_t* mapped) {
+    int huge = atomic_load_explicit(&g_mp_alloc_pool_huge, memory_order_relaxed);
+#ifdef MAP_HUGETLB
+    if (huge == MP_ALLOC_HUGEPAGES_RESERVED) {
+        size_t rounded = (length + MP_ALLOC_HUGE_PAGE - 1) & ~(size_t)(MP_ALLOC_HUGE_PAGE - 1);
+        void* p = mmap(NULL, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            *mapped = rounded;
+            return p;
+        }
+        /* No reserved huge pages; stop asking / 예약된 대형 페이지 없음, 이후 요청 중단 */
+        atomic_store_explicit(&g_mp_alloc_pool_huge, MP_ALLOC_HUGEPAGES_TRANSPARENT, memory_order_relaxed);
+        huge = MP_ALLOC_HUGEPAGES_TRANSPARENT;
+    }
+#endif
+    if (huge != MP_ALLOC_HUGEPAGES_OFF && length >= MP_ALLOC_HUGE_PAGE) {
+        /* Over-map and trim so the span starts on a huge page boundary
+         * / 대형 페이지 경계에서 시작하도록 여유 있게 매핑한 뒤 잘라냄 */
+        u8* p = (u8*)mmap(NULL, length + MP_ALLOC_HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == (u8*)MAP_FAILED) return NULL;
+        u8* start = (u8*)(((uintptr_t)p + MP_ALLOC_HUGE_PAGE - 1) & ~(uintptr_t)(MP_ALLOC_HUGE_PAGE - 1));
+        size_t head = (size_t)(start - p);
+        if (head) munmap(p, head);
+        if (MP_ALLOC_HUGE_PAGE - head) munmap(start + length, MP_ALLOC_HUGE_PAGE - head);
+#ifdef MADV_HUGEPAGE
+        madvise(start, length, MADV_HUGEPAGE);
+#endif
+        *mapped = length;
+        return start;
+    }
+    void* p = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return NULL;
+    *mapped = length;
+    return p;
+}
+
+/* Pool lock held / 풀 잠금 상태에서 호출 */
+static void mp_alloc_pool_unlink(mp_alloc_span* span) {
+    if (span->bucket_prev) span->bucket_prev->bucket_next = span->bucket_next;
+    else g_mp_alloc_pool_buckets[span->bucket] = span->bucket_next;
+    if (span->bucket_next) span->bucket_next->bucket_prev = span->bucket_prev;
+    if (span->newer) span->newer->older = span->older;
+    else g_mp_alloc_pool_newest = span->older;
+    if (span->older) span->older->newer = span->newer;
+    else g_mp_alloc_pool_oldest = span->newer;
+    g_mp_alloc_pool_bytes -= span->length;
+}
+
+/* Pool lock held; unlinks the least recently freed spans until at most `limit` bytes stay
+ * and returns them chained through bucket_next / 잠금 상태에서 오래된 매핑부터 한도까지 분리 */
+static mp_alloc_span* mp_alloc_pool_evict(size_t limit) {
+    mp_alloc_span* evicted = NULL;
+    while (g_mp_alloc_pool_bytes > limit) {
+        mp_alloc_span* victim = g_mp_alloc_pool_oldest;
+        mp_alloc_pool_unlink(victim);
+        victim->bucket_next = evicted;
+        evicted = victim;
+    }
+    return evicted;
+}
+
+static void mp_alloc_pool_unmap(mp_alloc_span* spans) {
+    while (spans) {
+        mp_alloc_span* next = spans->bucket_next;
+        munmap(spans, spans->length);
+        spans = next;
+    }
+}
+
+static mp_alloc_header* mp_alloc_span_acquire(size_t size, mp_bool zero) {
+    size_t length;
+    u32 bucket = mp_alloc_bucket(size + MP_ALLOC_SPAN_PREFIX, &length);
+    mp_alloc_span* span = NULL;
+    
+    pthread_mutex_lock(&g_mp_alloc_pool_lock);
+    if (bucket < MP_ALLOC_POOL_BUCKETS) span = g_mp_alloc_pool_buckets[bucket];
+    if (span) {
+        mp_alloc_pool_unlink(span);
+        g_mp_alloc_pool_reuses++;
+    } else {
+        g_mp_alloc_pool_maps++;
+    }
+    pthread_mutex_unlock(&g_mp_alloc_pool_lock);
+    
+    if (span) {
+        /* Recycled pages are already faulted in, only zero requests pay for clearing
+         * / 재사용 페이지는 이미 할당되어 있으며 0 요청만 지움 */
+        if (zero) memset((u8*)span + MP_ALLOC_SPAN_PREFIX, 0, size);
+    } else {
+        /* Fresh anonymous memory reads as zero / 새 익명 매핑은 0으로 채워져 있음 */
+        size_t mapped;
+        span = (mp_alloc_span*)mp_alloc_map(length, &mapped);
+        if (!span) return NULL;
+        span->length = mapped;
+        span->bucket = bucket;
+    }
+    return (mp_alloc_header*)((u8*)span + MP_ALLOC_SPAN_PREFIX) - 1;
+}
+
+static void mp_alloc_span_release(mp_alloc_span* span) {
+    mp_alloc_span* evicted = span;
+    span->bucket_next = NULL;
+    
+    pthread_mutex_lock(&g_mp_alloc_pool_lock);
+    if (span->bucket < MP_ALLOC_POOL_BUCKETS && span->length <= g_mp_alloc_pool_limit) {
+        mp_alloc_span* head = g_mp_alloc_pool_buckets[span->bucket];
+        span->bucket_prev = NULL;
+        span->bucket_next = head;
+        if (head) head->bucket_prev = span;
+        g_mp_alloc_pool_buckets[span->bucket] = span;
+        span->newer = NULL;
+        span->older = g_mp_alloc_pool_newest;
+        if (g_mp_alloc_pool_newest) g_mp_alloc_pool_newest->newer = span;
+        else g_mp_alloc_pool_oldest = span;
+        g_mp_alloc_pool_newest = span;
+        g_mp_alloc_pool_bytes += span->length;
+        evicted = mp_alloc_pool_evict(g_mp_alloc_pool_limit);
+    }
+    pthread_mutex_unlock(&g_mp_alloc_pool_lock);
+    mp_alloc_pool_unmap(evicted);
+}
+
+static void mp_alloc_init(void) {
+    pthread_key_create(&g_mp_alloc_key, mp_alloc_thread_exit);
+    u32 cls = 0;
+    for (u32 units = 0; units < sizeof(g_mp_alloc_class_of); units++) {
+        while (g_mp_alloc_classes[cls] < units * 16) cls++;
+        g_mp_alloc_class_of[units] = (u8)cls;
+    }
+    
+    g_mp_alloc_pool_limit = (size_t)MP_ALLOC_POOL_RETAIN_MB << 20;
+    const char* retain = getenv("MP_POOL_RETAIN_MB");
+    if (retain && atoi(retain) >= 0) g_mp_alloc_pool_limit = (size_t)atoi(retain) << 20;
+    int huge = MP_ALLOC_HUGEPAGES_TRANSPARENT;
+    const char* pages = getenv("MP_HUGEPAGES");
+    if (pages && (strcmp(pages, "off") == 0 || strcmp(pages, "0") == 0)) huge = MP_ALLOC_HUGEPAGES_OFF;
+    else if (pages && strcmp(pages, "hugetlb") == 0) huge = MP_ALLOC_HUGEPAGES_RESERVED;
+    atomic_store_explicit(&g_mp_alloc_pool_huge, huge, memory_order_relaxed);
+}
+
+static mp_alloc_thread* mp_alloc_self(void) {
+    mp_alloc_thread* t = &t_mp_alloc;
+    if (t->registered) return t;
+    
+    pthread_once(&g_mp_alloc_once, mp_alloc_init);
+    pthread_mutex_lock(&g_mp_alloc_lock);
+    t->prev = NULL;
+    t->next = g_mp_alloc_threads;
+    if (g_mp_alloc_threads) g_mp_alloc_threads->prev = t;
+    g_mp_alloc_threads = t;
+    pthread_mutex_unlock(&g_mp_alloc_lock);
+    
+    t->registered = MP_TRUE;
+    pthread_setspecific(g_mp_alloc_key, t);
+    return t;
+}
+
+static void mp_alloc_account(mp_alloc_thread* t, u32 category, size_t bytes, mp_bool allocation) {
+    if (allocation) {
+        MP_ALLOC_ADD(t->pending[category], (long long)bytes);
+        MP_ALLOC_ADD(t->allocations[category], 1);
+    } else {
+        MP_ALLOC_ADD(t->pending[category], -(long long)bytes);
+        MP_ALLOC_ADD(t->frees[category], 1);
+    }
+    
+    t->drift += (long long)bytes;
+    if (t->drift >= (long long)MP_ALLOC_SYNC_BYTES) mp_alloc_fold(t);
+}
+
+static mp_alloc_header* mp_alloc_header_of(const void* ptr) {
+    mp_alloc_header* h = (mp_alloc_header*)ptr - 1;
+    if (h->magic != MP_ALLOC_MAGIC_LIVE) {
+        mp_fast_fprintf(2, "mp_alloc: %s block %p / 잘못된 블록\n",
+                        h->magic == MP_ALLOC_MAGIC_CACHED ? "double free of" : "foreign or corrupted", ptr);
+        abort();
+    }
+    return h;
+}
+
+static void* mp_alloc_block(size_t size, mp_alloc_category category, mp_bool zero) {
+    if ((u32)category >= MP_ALLOC_CATEGORY_COUNT) category = MP_ALLOC_GENERAL;
+    mp_alloc_thread* t = mp_alloc_self();
+    mp_alloc_header* h = NULL;
+    u32 cls = MP_ALLOC_LARGE;
+    
+    if (size <= MP_ALLOC_SMALL_MAX) {
+        cls = g_mp_alloc_class_of[(size + sizeof(mp_alloc_header) + 15) / 16];
+        h = t->free_list[cls];
+        if (h) {
+            t->free_list[cls] = *(mp_alloc_header**)(h + 1);
+            t->free_count[cls]--;
+            MP_ALLOC_ADD(t->cached_bytes, -(size_t)g_mp_alloc_classes[cls]);
+            if (zero) memset(h + 1, 0, size);
+        } else {
+            h = (mp_alloc_header*)(zero ? calloc(1, g_mp_alloc_classes[cls]) : malloc(g_mp_alloc_classes[cls]));
+        }
+    } else if (size < MP_ALLOC_POOL_MIN) {
+        h = (mp_alloc_header*)(zero ? calloc(1, sizeof(mp_alloc_header) + size)
+                                    : malloc(sizeof(mp_alloc_header) + size));
+    } else if (size <= SIZE_MAX / 4) {
+        h = mp_alloc_span_acquire(size, zero);
+        cls = MP_ALLOC_SPAN;
+    }
+    if (!h) return NULL;
+    
+    h->size = size;
+    h->category = (u16)category;
+    h->size_class = (u16)cls;
+    h->magic = MP_ALLOC_MAGIC_LIVE;
+    mp_alloc_account(t, category, size, MP_TRUE);
+    return h + 1;
+}
+
+void* mp_alloc(size_t size, mp_alloc_category category) {
+    return mp_alloc_block(size, category, MP_FALSE);
+}
+
+void* mp_alloc_zero(size_t count, size_t size, mp_alloc_category category) {
+    if (size && count > SIZE_MAX / size) return NULL;
+    return mp_alloc_block(count * size, category, MP_TRUE);
+}
+
+void mp_alloc_free(void* ptr) {
+    if (!ptr) return;
+    mp_alloc_header* h = mp_alloc_header_of(ptr);
+    mp_alloc_thread* t = mp_alloc_self();
+    mp_alloc_account(t, h->category, (size_t)h->size, MP_FALSE);
+    
+    u32 cls = h->size_class;
+    if (cls == MP_ALLOC_SPAN) {
+        h->magic = MP_ALLOC_MAGIC_CACHED;
+        mp_alloc_span_release(mp_alloc_span_of(h));
+        return;
+    }
+    if (cls != MP_ALLOC_LARGE && t->free_count[cls] < MP_ALLOC_CACHE_BYTES / g_mp_alloc_classes[cls]) {
+        /* The freeing thread keeps the block, whoever allocated it / 해제한 스레드가 블록을 보관 */
+        h->magic = MP_ALLOC_MAGIC_CACHED;
+        *(mp_alloc_header**)(h + 1) = t->free_list[cls];
+        t->free_list[cls] = h;
+        t->free_count[cls]++;
+        MP_ALLOC_ADD(t->cached_bytes, (size_t)g_mp_alloc_classes[cls]);
+        return;
+    }
+    h->magic = 0;
+    free(h);
+}
+
+void* mp_alloc_resize(void* ptr, size_t size, mp_alloc_category category) {
+    if (!ptr) return mp_alloc(size, category);
+    if (size == 0) {
+        mp_alloc_free(ptr);
+        return NULL;
+    }
+    
+    mp_alloc_header* h = mp_alloc_header_of(ptr);
+    size_t old_size = (size_t)h->size;
+    mp_alloc_thread* t = mp_alloc_self();
+    
+    if (h->size_class == MP_ALLOC_LARGE && size > MP_ALLOC_SMALL_MAX && size < MP_ALLOC_POOL_MIN) {
+        mp_alloc_header* grown = (mp_alloc_header*)realloc(h, sizeof(mp_alloc_header) + size);
+        if (!grown) return NULL;
+        grown->size = size;
+        MP_ALLOC_ADD(t->pending[grown->category], (long long)size - (long long)old_size);
+        return grown + 1;
+    }
+    mp_bool fits = MP_FALSE;
+    if (h->size_class == MP_ALLOC_SPAN) {
+        fits = size >= MP_ALLOC_POOL_MIN && size + MP_ALLOC_SPAN_PREFIX <= mp_alloc_span_of(h)->length;
+    } else if (h->size_class != MP_ALLOC_LARGE) {
+        fits = size + sizeof(mp_alloc_header) <= g_mp_alloc_classes[h->size_class];
+    }
+    if (fits) {
+        /* Still fits its class or mapping / 같은 클래스나 매핑에 들어감 */
+        h->size = size;
+        MP_ALLOC_ADD(t->pending[h->category], (long long)size - (long long)old_size);
+        return ptr;
+    }
+    
+    void* moved = mp_alloc(size, (mp_alloc_category)h->category);
+    if (!moved) return NULL;
+    memcpy(moved, ptr, old_size < size ? old_size : size);
+    mp_alloc_free(ptr);
+    return moved;
+}
+
+size_t mp_alloc_size(const void* ptr) {
+    return ptr ? (size_t)mp_alloc_header_of(ptr)->size : 0;
+}
+
+void mp_alloc_trim(void) {
+    mp_alloc_release_cache(mp_alloc_self());
+}
+
+void mp_alloc_configure_pool(size_t retain_bytes, mp_alloc_hugepages hugepages) {
+    pthread_once(&g_mp_alloc_once, mp_alloc_init);
+    atomic_store_explicit(&g_mp_alloc_pool_huge, (int)hugepages, memory_order_relaxed);
+    pthread_mutex_lock(&g_mp_alloc_pool_lock);
+    g_mp_alloc_pool_limit = retain_bytes;
+    mp_alloc_span* evicted = mp_alloc_pool_evict(retain_bytes);
+    pthread_mutex_unlock(&g_mp_alloc_pool_lock);
+    mp_alloc_pool_unmap(evicted);
+}
+
+void mp_alloc_pool_trim(void) {
+    pthread_mutex_lock(&g_mp_alloc_pool_lock);
+    mp_alloc_span* evicted = mp_alloc_pool_evict(0);
+    pthread_mutex_unlock(&g_mp_alloc_pool_lock);
+    mp_alloc_pool_unmap(evicted);
+}
+
+static size_t mp_alloc_clamp(long long bytes) {
+    return bytes > 0 ? (size_t)bytes : 0;
+}
+
+void mp_alloc_get_stats(mp_alloc_stats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    long long current[MP_ALLOC_CATEGORY_COUNT];
+    long long total = 0;
+    
+    pthread_mutex_lock(&g_mp_alloc_lock);
+    for (u32 c = 0; c < MP_ALLOC_CATEGORY_COUNT; c++) {
+        current[c] = atomic_load_explicit(&g_mp_alloc_current[c], memory_order_relaxed);
+        stats->category[c].allocations = g_mp_alloc_retired_allocations[c];
+        stats->category[c].frees = g_mp_alloc_retired_frees[c];
+    }
+    for (mp_alloc_thread* t = g_mp_alloc_threads; t; t = t->next) {
+        for (u32 c = 0; c < MP_ALLOC_CATEGORY_COUNT; c++) {
+            current[c] += atomic_load_explicit(&t->pending[c], memory_order_relaxed);
+            stats->category[c].allocations += atomic_load_explicit(&t->allocations[c], memory_order_relaxed);
+            stats->category[c].frees += atomic_load_explicit(&t->frees[c], memory_order_relaxed);
+        }
+        stats->cached_bytes += atomic_load_explicit(&t->cached_bytes, memory_order_relaxed);
+        stats->threads++;
+    }
+    pthread_mutex_unlock(&g_mp_alloc_lock);
+    
+    pthread_mutex_lock(&g_mp_alloc_pool_lock);
+    stats->pooled_bytes = g_mp_alloc_pool_bytes;
+    stats->pool_reuses = g_mp_alloc_pool_reuses;
+    stats->pool_maps = g_mp_alloc_pool_maps;
+    pthread_mutex_unlock(&g_mp_alloc_pool_lock);
+    
+    /* Unfolded bytes may put the current level above the recorded peak / 미합산분이 기록된 최대치를 넘을 수 있음 */
+    for (u32 c = 0; c < MP_ALLOC_CATEGORY_COUNT; c++) {
+        mp_alloc_raise(&g_mp_alloc_peak[c], current[c]);
+        mp_alloc_counters* counters = &stats->category[c];
+        counters->current_bytes = mp_alloc_clamp(current[c]);
+        counters->peak_bytes = mp_alloc_clamp(atomic_load_explicit(&g_mp_alloc_peak[c], memory_order_relaxed));
+        stats->total.allocations += counters->allocations;
+        stats->total.frees += counters->frees;
+        total += current[c];
+    }
+    mp_alloc_raise(&g_mp_alloc_total_peak, total);
+    stats->total.current_bytes = mp_alloc_clamp(total);
+    stats->total.peak_bytes = mp_alloc_clamp(atomic_load_explicit(&g_mp_alloc_total_peak, memory_order_relaxed));
+}
+
+const char* mp_alloc_category_name(mp_alloc_category category) {
+    static const char* const names[MP_ALLOC_CATEGORY_COUNT] = { "general", "pixels", "codec", "cache", "undo", "ui" };
+    return (u32)category < MP_ALLOC_CATEGORY_COUNT ? names[category] : "unknown";
+}
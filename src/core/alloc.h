@@ -0,0 +1,92 @@
+#ifndef MANYPICTURES_ALLOC_H
+#define MANYPICTURES_ALLOC_H
+
+#include "types.h"
+#include <stddef.h>
+
+/* Thread-caching tracked allocator / 스레드 캐시 기반 추적 할당기
+ *
+ * Every block carries a 16-byte prefix with its size and category, so frees are tracked
+ * exactly and need no lookup. Blocks up to MP_ALLOC_SMALL_MAX bytes come from per-thread
+ * size-class free lists; larger ones go straight to the system. Counters are kept per
+ * thread with plain relaxed stores and folded into the global totals only every
+ * MP_ALLOC_SYNC_BYTES of drift or when stats are read, so no allocation takes a lock or
+ * an atomic read-modify-write. Peaks are exact up to that drift per thread.
+ * Blocks may be freed on any thread; a thread's cache is returned when it exits.
+ * Requests of MP_ALLOC_POOL_MIN bytes and more (pixel planes, codec scratch) are served
+ * from a shared pool of recycled anonymous mappings bucketed by size, optionally backed by
+ * huge pages, so repeated loads and edits reuse already-faulted memory instead of paying
+ * mmap/munmap and first-touch zeroing for every buffer. The pool keeps at most its
+ * retention cap of free mappings and drops the least recently freed first.
+ * 모든 블록은 크기와 분류를 담은 16바이트 접두부를 가지며, 작은 블록은 스레드별 크기 클래스
+ * 목록에서 할당합니다. 카운터는 스레드별로 기록되어 필요할 때만 합산되므로 잠금이나 원자적 RMW가 없습니다.
+ * 큰 요청은 크기별로 재활용되는 익명 매핑 풀(선택적 대형 페이지)에서 할당되어 페이지 폴트와 0 채우기를 피합니다.
+ */
+
+#define MP_ALLOC_SMALL_MAX 1008            /* Largest cached request / 캐시되는 최대 요청 크기 */
+#define MP_ALLOC_SYNC_BYTES (256u << 10)   /* Per-thread drift before counters fold / 합산 전 스레드별 허용 변화량 */
+#define MP_ALLOC_POOL_MIN (256u << 10)     /* Smallest pooled request / 풀에서 할당하는 최소 요청 크기 */
+#define MP_ALLOC_POOL_RETAIN_MB 256        /* Default cap on free pooled memory (MP_POOL_RETAIN_MB) / 기본 보관 한도 */
+
+/* Huge page backing of pooled mappings (MP_HUGEPAGES=off|thp|hugetlb) / 풀 매핑의 대형 페이지 사용 */
+typedef enum {
+    MP_ALLOC_HUGEPAGES_OFF,
+    MP_ALLOC_HUGEPAGES_TRANSPARENT,   /* 2MB-aligned mappings with madvise(MADV_HUGEPAGE) (default) / 기본값 */
+    MP_ALLOC_HUGEPAGES_RESERVED       /* MAP_HUGETLB; falls back to transparent when none are reserved / 예약 대형 페이지 */
+} mp_alloc_hugepages;
+
+/* Call site categories / 호출 위치 분류 */
+typedef enum {
+    MP_ALLOC_GENERAL,
+    MP_ALLOC_PIXELS,       /* Pixel buffers and working copies / 픽셀 버퍼와 작업 사본 */
+    MP_ALLOC_CODEC,        /* Decoder and encoder state / 디코더, 인코더 상태 */
+    MP_ALLOC_CACHE,        /* Decoded, display and thumbnail caches / 각종 캐시 */
+    MP_ALLOC_UNDO,         /* Undo snapshots / 실행 취소 스냅샷 */
+    MP_ALLOC_UI,
+    MP_ALLOC_CATEGORY_COUNT
+} mp_alloc_category;
+
+typedef struct {
+    size_t current_bytes;  /* Requested bytes live now / 현재 사용 중인 요청 바이트 */
+    size_t peak_bytes;
+    u64 allocations;
+    u64 frees;
+} mp_alloc_counters;
+
+typedef struct {
+    mp_alloc_counters total;
+    mp_alloc_counters category[MP_ALLOC_CATEGORY_COUNT];
+    size_t cached_bytes;   /* Free small blocks held by thread caches / 스레드 캐시가 보관 중인 블록 */
+    u32 threads;           /* Threads with live counters / 카운터가 있는 스레드 수 */
+    size_t pooled_bytes;   /* Free mappings kept by the large-buffer pool / 풀이 보관 중인 매핑 */
+    u64 pool_reuses;       /* Large requests served from the pool / 풀에서 재사용한 횟수 */
+    u64 pool_maps;         /* Large requests that needed a new mapping / 새 매핑이 필요했던 횟수 */
+} mp_alloc_stats;
+
+/* malloc / calloc / realloc / free counterparts; mp_alloc_resize keeps the category.
+ * Blocks are 16-byte aligned, pooled ones 64-byte aligned / 표준 할당 함수 대응 (16바이트, 풀 블록은 64바이트 정렬) */
+void* mp_alloc(size_t size, mp_alloc_category category);
+void* mp_alloc_zero(size_t count, size_t size, mp_alloc_category category);
+void* mp_alloc_resize(void* ptr, size_t size, mp_alloc_category category);
+void mp_alloc_free(void* ptr);
+
+/* Requested size of a live block / 사용 중인 블록의 요청 크기 */
+size_t mp_alloc_size(const void* ptr);
+
+/* Merge every thread's counters; exact when no other thread is allocating
+ * / 모든 스레드의 카운터 합산 (다른 스레드가 할당 중이 아니면 정확) */
+void mp_alloc_get_stats(mp_alloc_stats* stats);
+
+const char* mp_alloc_category_name(mp_alloc_category category);
+
+/* Return the calling thread's cached blocks to the system / 호출 스레드의 캐시 블록 반환 */
+void mp_alloc_trim(void);
+
+/* Large-buffer pool settings; the defaults come from the environment. Lowering the cap
+ * releases the excess at once. / 대형 버퍼 풀 설정 (기본값은 환경 변수, 한도를 낮추면 즉시 반환) */
+void mp_alloc_configure_pool(size_t retain_bytes, mp_alloc_hugepages hugepages);
+
+/* Unmap every free pooled mapping / 풀이 보관 중인 모든 매핑 해제 */
+void mp_alloc_pool_trim(void);
+
+#endif /* MANYPICTURES_ALLOC_H */
@@ -0,0 +1,156 @@
+#include "arena.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Block header padded so data in pooled blocks keeps the 64-byte row alignment
+ * / 풀 블록의 데이터가 64바이트 정렬을 유지하도록 채운 헤더 */
+#define MP_ARENA_HEADER 64
+
+_Static_assert(sizeof(mp_arena_block) <= MP_ARENA_HEADER, "arena block header must fit its padding");
+
+static atomic_bool g_mp_arena_heap;
+
+static u8* mp_arena_data(mp_arena_block* block) {
+    return (u8*)block + MP_ARENA_HEADER;
+}
+
+static mp_arena_block* mp_arena_block_create(mp_arena* arena, size_t size) {
+    if (size > SIZE_MAX - MP_ARENA_HEADER) return NULL;
+    mp_arena_block* block = (mp_arena_block*)mp_alloc(MP_ARENA_HEADER + size, arena->category);
+    if (!block) return NULL;
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    arena->block_count++;
+    return block;
+}
+
+void mp_arena_init(mp_arena* arena, size_t block_size, mp_alloc_category category) {
+    memset(arena, 0, sizeof(*arena));
+    arena->block_size = block_size ? block_size : MP_ARENA_BLOCK_SIZE;
+    arena->category = category;
+    arena->heap = atomic_load_explicit(&g_mp_arena_heap, memory_order_relaxed);
+}
+
+void mp_arena_set_heap_mode(mp_bool heap) {
+    atomic_store_explicit(&g_mp_arena_heap, heap, memory_order_relaxed);
+}
+
+void* mp_arena_alloc(mp_arena* arena, size_t size) {
+    if (!arena) return NULL;
+    size_t aligned = (size + MP_ARENA_ALIGN - 1) & ~(size_t)(MP_ARENA_ALIGN - 1);
+    if (aligned < size) return NULL;
+    
+    mp_arena_block* block = arena->blocks;
+    if (!block || arena->heap || block->size - block->used < aligned) {
+        if (aligned > arena->block_size / 2 || arena->heap) {
+            /* A block of its own behind the current one, which keeps its free space
+             * / 현재 블록의 남은 공간을 유지하도록 그 뒤에 단독 블록 연결 */
+            block = mp_arena_block_create(arena, aligned);
+            if (!block) return NULL;
+            if (arena->blocks) {
+                block->next = arena->blocks->next;
+                arena->blocks->next = block;
+            } else {
+                arena->blocks = block;
+            }
+        } else {
+            block = mp_arena_block_create(arena, arena->block_size);
+            if (!block) return NULL;
+            block->next = arena->blocks;
+            arena->blocks = block;
+        }
+    }
+    
+    void* ptr = mp_arena_data(block) + block->used;
+    block->used += aligned;
+    arena->allocated += aligned;
+    if (arena->allocated > arena->peak) arena->peak = arena->allocated;
+    arena->last = ptr;
+    arena->last_block = block;
+    return ptr;
+}
+
+void* mp_arena_zero(mp_arena* arena, size_t count, size_t size) {
+    if (size && count > SIZE_MAX / size) return NULL;
+    void* ptr = mp_arena_alloc(arena, count * size);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void* mp_arena_grow(mp_arena* arena, void* ptr, size_t old_size, size_t new_size) {
+    if (!ptr) return mp_arena_alloc(arena, new_size);
+    if (new_size <= old_size) return ptr;
+    
+    size_t aligned = (new_size + MP_ARENA_ALIGN - 1) & ~(size_t)(MP_ARENA_ALIGN - 1);
+    if (aligned < new_size || aligned > SIZE_MAX - MP_ARENA_HEADER) return NULL;
+    
+    mp_arena_block* block = arena->last_block;
+    size_t offset = ptr == arena->last ? (size_t)((u8*)ptr - mp_arena_data(block)) : SIZE_MAX;
+    if (offset == 0 || (offset != SIZE_MAX && aligned <= block->size - offset)) {
+        size_t grown = offset + aligned - block->used;
+        if (aligned > block->size - offset) {
+            /* Sole allocation of its block: resize the whole block / 블록의 유일한 할당이면 블록째 확장 */
+            mp_arena_block* moved = (mp_arena_block*)mp_alloc_resize(block, MP_ARENA_HEADER + aligned, arena->category);
+            if (!moved) return NULL;
+            if (moved != block) {
+                mp_arena_block** link = &arena->blocks;
+                while (*link != block) link = &(*link)->next;
+                *link = moved;
+                block = moved;
+            }
+            block->size = aligned;
+            arena->last = ptr = mp_arena_data(block);
+            arena->last_block = block;
+        }
+        block->used = offset + aligned;
+        arena->allocated += grown;
+        if (arena->allocated > arena->peak) arena->peak = arena->allocated;
+        return ptr;
+    }
+    
+    void* moved = mp_arena_alloc(arena, new_size);
+    if (!moved) return NULL;
+    memcpy(moved, ptr, old_size);
+    return moved;
+}
+
+void mp_arena_reset(mp_arena* arena) {
+    if (!arena) return;
+    mp_arena_block* keep = NULL;
+    mp_arena_block* block = arena->blocks;
+    while (block) {
+        mp_arena_block* next = block->next;
+        if (!keep && !arena->heap && block->size == arena->block_size) {
+            keep = block;
+        } else {
+            mp_alloc_free(block);
+        }
+        block = next;
+    }
+    if (keep) {
+        keep->next = NULL;
+        keep->used = 0;
+    }
+    arena->blocks = keep;
+    arena->block_count = keep ? 1 : 0;
+    arena->allocated = 0;
+    arena->last = NULL;
+    arena->last_block = NULL;
+}
+
+void mp_arena_release(mp_arena* arena) {
+    if (!arena) return;
+    mp_arena_block* block = arena->blocks;
+    while (block) {
+        mp_arena_block* next = block->next;
+        mp_alloc_free(block);
+        block = next;
+    }
+    arena->blocks = NULL;
+    arena->block_count = 0;
+    arena->allocated = 0;
+    arena->last = NULL;
+    arena->last_block = NULL;
+}
@@ -0,0 +1,63 @@
+#ifndef MANYPICTURES_ARENA_H
+#define MANYPICTURES_ARENA_H
+
+#include "types.h"
+#include "alloc.h"
+
+/* Per-decode arenas / 디코딩 단위 아레나
+ *
+ * Codec temporaries (palette scratch, compressed data accumulators, inflated scanlines,
+ * entropy tables) live exactly as long as one decode or encode. An arena hands them out by
+ * bumping an offset through blocks taken from mp_alloc and gives all of them back in one
+ * mp_arena_reset or mp_arena_release, so a decode costs a few block allocations instead of
+ * a malloc/free pair per temporary. Requests larger than half a block get a block of their
+ * own, which the large-buffer pool recycles across decodes. An arena belongs to one decode
+ * and is not thread-safe.
+ * 코덱 임시 데이터를 블록 안에서 오프셋 증가로 할당하고 reset/release 한 번으로 모두 반환합니다.
+ */
+
+#define MP_ARENA_BLOCK_SIZE (64u << 10)   /* Default block size / 기본 블록 크기 */
+#define MP_ARENA_ALIGN 16                 /* Allocation alignment / 할당 정렬 */
+
+typedef struct mp_arena_block {
+    struct mp_arena_block* next;   /* Older block / 이전 블록 */
+    size_t size;                   /* Usable bytes / 사용 가능 바이트 */
+    size_t used;
+} mp_arena_block;
+
+typedef struct {
+    mp_arena_block* blocks;        /* Current block first / 현재 블록이 처음 */
+    size_t block_size;
+    mp_alloc_category category;
+    u32 block_count;
+    size_t allocated;              /* Bytes handed out since the last reset / 마지막 reset 이후 할당량 */
+    size_t peak;                   /* Most bytes handed out between resets / reset 사이 최대 할당량 */
+    void* last;                    /* Latest allocation, which can grow in place / 제자리 확장 가능한 마지막 할당 */
+    mp_arena_block* last_block;
+    mp_bool heap;                  /* One heap allocation per request / 요청마다 힙 할당 */
+} mp_arena;
+
+/* Benchmark switch: arenas initialised while it is on give every request its own heap
+ * allocation, grown by resizing and freed at reset or release, which is the allocation
+ * pattern codecs had before arenas / 벤치마크용: 켜진 동안 초기화된 아레나는 요청마다 힙 할당 */
+void mp_arena_set_heap_mode(mp_bool heap);
+
+/* Arenas need no creation; blocks are taken on first use / 첫 사용 시 블록 할당 */
+void mp_arena_init(mp_arena* arena, size_t block_size, mp_alloc_category category);
+
+/* MP_ARENA_ALIGN-aligned memory valid until the next reset / 다음 reset까지 유효한 메모리 */
+void* mp_arena_alloc(mp_arena* arena, size_t size);
+void* mp_arena_zero(mp_arena* arena, size_t count, size_t size);
+
+/* Grow an allocation of `old_size` bytes; the latest allocation grows in place when it fits,
+ * and one that has a block to itself resizes that block. Never shrinks.
+ * / 할당 확장 (마지막 할당은 가능하면 제자리에서, 단독 블록은 블록째 확장) */
+void* mp_arena_grow(mp_arena* arena, void* ptr, size_t old_size, size_t new_size);
+
+/* Drop every allocation, keeping one standard block for reuse / 모든 할당 해제 (표준 블록 하나는 재사용) */
+void mp_arena_reset(mp_arena* arena);
+
+/* Drop every allocation and return all blocks / 모든 할당과 블록 반환 */
+void mp_arena_release(mp_arena* arena);
+
+#endif /* MANYPICTURES_ARENA_H */
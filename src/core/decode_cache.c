@@ -0,0 +1,567 @@
+#define _POSIX_C_SOURCE 200809L
+#include "decode_cache.h"
+#include "memory.h"
+#include "image.h"
+#include "image_layout.h"
+#include "../exif/exif.h"
+#include <pthread.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define MP_DECODE_CACHE_MAGIC "MPRAW002"
+#define MP_DECODE_CACHE_BOM 0x01020304u       /* Header fields are host-endian / 헤더 필드는 호스트 엔디언 */
+#define MP_DECODE_CACHE_DATA_OFFSET 4096      /* Pixels start on a page boundary / 픽셀은 페이지 경계에서 시작 */
+#define MP_DECODE_CACHE_SUFFIX ".mpraw"
+
+/* Raw file layout: header, zero padding up to data_offset, height rows of stride bytes,
+ * then exif_size bytes of EXIF record / 원시 파일 구조: 헤더, data_offset까지 0 채움,
+ * stride 바이트 행 height개, 이후 exif_size 바이트의 EXIF 기록 */
+typedef struct {
+    char magic[8];
+    u32 bom;
+    u32 data_offset;
+    u64 content_hash;
+    u64 source_size;
+    u32 width;
+    u32 height;
+    u32 stride;
+    u32 bpp;
+    u32 color_format;
+    u32 source_format;        /* mp_image_format of the source file / 원본 파일 포맷 */
+    u32 bit_depth;
+    u32 has_alpha;
+    u32 has_exif;
+    u32 reserved;
+    u64 data_size;
+    u64 exif_size;
+} mp_decode_cache_header;
+
+/* EXIF record after the pixels: the structures as this build lays them out, sizes first
+ * so another build's record is rejected / 픽셀 뒤의 EXIF 기록 (구조체 크기를 먼저 기록해 다른 빌드의 기록은 거부) */
+typedef struct {
+    u32 exif_bytes;           /* sizeof(mp_exif_data) */
+    u32 chain_bytes;          /* sizeof(mp_history_chain), 0 without history / 히스토리 없으면 0 */
+    u32 entry_bytes;          /* sizeof(mp_history_entry) */
+    u32 entry_count;
+    u64 raw_size;
+} mp_decode_cache_exif_head;
+
+/* A live image backed by a mapping / 매핑을 사용하는 이미지 */
+typedef struct mp_decode_mapping {
+    mp_image* image;
+    void* map;
+    size_t length;
+    struct mp_decode_mapping* next;
+} mp_decode_mapping;
+
+struct mp_decode_cache {
+    char* dir;
+    size_t limit;
+    pthread_mutex_t lock;
+    mp_decode_mapping* mappings;
+    size_t total;             /* Directory size as of the last scan plus stores since / 마지막 검사 이후 추정 크기 */
+    mp_bool total_known;
+};
+
+/* Four independent multiply-rotate lanes keep several multiplies in flight
+ * / 독립된 네 개의 곱셈-회전 레인으로 곱셈을 겹쳐 실행 */
+static u64 mp_decode_cache_hash(const u8* data, size_t size) {
+    static const u64 k1 = 0x9E3779B185EBCA87ull;
+    static const u64 k2 = 0xC2B2AE3D27D4EB4Full;
+    u64 lane[4] = { k1 ^ size, k2, 0x165667B19E3779F9ull, 0x27D4EB2F165667C5ull };
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        for (int j = 0; j < 4; j++) {
+            u64 word;
+            memcpy(&word, data + i + j * 8, 8);
+            u64 h = lane[j] + word * k2;
+            lane[j] = ((h << 31) | (h >> 33)) * k1;
+        }
+    }
+    
+    u64 hash = lane[0] ^ ((lane[1] << 7) | (lane[1] >> 57)) ^
+               ((lane[2] << 12) | (lane[2] >> 52)) ^ ((lane[3] << 18) | (lane[3] >> 46));
+    for (; i < size; i++) hash = (hash ^ data[i]) * 0x100000001B3ull;
+    
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/* `$XDG_CACHE_HOME/manypictures/decoded`, falling back to `~/.cache` / 기본 캐시 디렉터리 */
+static char* mp_decode_cache_default_dir(void) {
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    char base[4096];
+    if (xdg && xdg[0] == '/') snprintf(base, sizeof(base), "%s", xdg);
+    else if (home && home[0]) snprintf(base, sizeof(base), "%s/.cache", home);
+    else return NULL;
+    
+    char dir[4096];
+    int n = snprintf(dir, sizeof(dir), "%s/manypictures", base);
+    if (n < 0 || (size_t)n >= sizeof(dir) - 16) return NULL;
+    if (mkdir(base, 0700) != 0 && errno != EEXIST) return NULL;
+    if (mkdir(dir, 0700) != 0 && errno != EEXIST) return NULL;
+    memcpy(dir + n, "/decoded", 9);
+    return mp_strdup(dir);
+}
+
+mp_decode_cache* mp_decode_cache_open(const char* dir) {
+    char* path = NULL;
+    const char* env = getenv("MP_DECODE_CACHE_DIR");
+    if (dir) path = mp_strdup(dir);
+    else if (env && env[0]) path = mp_strdup(env);
+    else path = mp_decode_cache_default_dir();
+    if (!path) return NULL;
+    
+    if (mkdir(path, 0700) != 0 && errno != EEXIST) {
+        mp_free(path);
+        return NULL;
+    }
+    
+    mp_decode_cache* cache = (mp_decode_cache*)mp_calloc(1, sizeof(mp_decode_cache));
+    if (!cache) {
+        mp_free(path);
+        return NULL;
+    }
+    cache->dir = path;
+    cache->limit = (size_t)MP_DECODE_CACHE_LIMIT_MB << 20;
+    const char* limit = getenv("MP_DECODE_CACHE_MB");
+    if (limit && atoi(limit) > 0) cache->limit = (size_t)atoi(limit) << 20;
+    pthread_mutex_init(&cache->lock, NULL);
+    return cache;
+}
+
+void mp_decode_cache_close(mp_decode_cache* cache) {
+    if (!cache) return;
+    mp_decode_mapping* m = cache->mappings;
+    while (m) {
+        mp_decode_mapping* next = m->next;
+        munmap(m->map, m->length);
+        mp_free(m);
+        m = next;
+    }
+    pthread_mutex_destroy(&cache->lock);
+    mp_free(cache->dir);
+    mp_free(cache);
+}
+
+/* Hash of the source file's contents, read through a private mapping
+ * / 원본 파일 내용의 해시 (매핑으로 읽음) */
+static mp_bool mp_decode_cache_key(const char* filepath, u64* out_hash, u64* out_size) {
+    int fd = open(filepath, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return MP_FALSE;
+    
+    struct stat st;
+    mp_bool ok = fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0;
+    if (ok) {
+        void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ok = map != MAP_FAILED;
+        if (ok) {
+            posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+            *out_hash = mp_decode_cache_hash((const u8*)map, (size_t)st.st_size);
+            *out_size = (u64)st.st_size;
+            munmap(map, (size_t)st.st_size);
+        }
+    }
+    close(fd);
+    return ok;
+}
+
+static char* mp_decode_cache_entry_path(const mp_decode_cache* cache, u64 hash) {
+    size_t len = strlen(cache->dir) + 1 + 16 + sizeof(MP_DECODE_CACHE_SUFFIX);
+    char* path = (char*)mp_malloc(len);
+    if (path) snprintf(path, len, "%s/%016llx" MP_DECODE_CACHE_SUFFIX, cache->dir, (unsigned long long)hash);
+    return path;
+}
+
+static mp_bool mp_decode_cache_header_valid(const mp_decode_cache_header* h, u64 hash, u64 source_size, size_t file_size) {
+    if (memcmp(h->magic, MP_DECODE_CACHE_MAGIC, 8) != 0 || h->bom != MP_DECODE_CACHE_BOM) return MP_FALSE;
+    if (h->content_hash != hash || h->source_size != source_size) return MP_FALSE;
+    if (h->data_offset != MP_DECODE_CACHE_DATA_OFFSET || h->width == 0 || h->height == 0) return MP_FALSE;
+    if (h->bpp == 0 || h->bpp != mp_image_layout_bpp((mp_color_format)h->color_format)) return MP_FALSE;
+    if (h->stride / h->bpp < h->width) return MP_FALSE;
+    return h->data_size == (u64)h->stride * h->height && h->data_size <= file_size && h->exif_size <= file_size &&
+           h->data_offset + h->data_size + h->exif_size == file_size;
+}
+
+/* Flatten EXIF, its raw block and history chain into one record; pointers are rebuilt
+ * on unpacking / EXIF, 원시 블록, 히스토리 체인을 하나의 기록으로 평탄화 (포인터는 복원 시 재구성) */
+static u8* mp_decode_cache_pack_exif(const mp_exif_data* exif, size_t* out_size) {
+    mp_decode_cache_exif_head head;
+    memset(&head, 0, sizeof(head));
+    head.exif_bytes = (u32)sizeof(mp_exif_data);
+    head.entry_bytes = (u32)sizeof(mp_history_entry);
+    if (exif->history) {
+        head.chain_bytes = (u32)sizeof(mp_history_chain);
+        for (const mp_history_entry* e = exif->history->head; e; e = e->next) head.entry_count++;
+    }
+    head.raw_size = exif->raw_data ? (u64)exif->raw_size : 0;
+    
+    size_t size = sizeof(head) + head.exif_bytes + head.chain_bytes + (size_t)head.entry_count * head.entry_bytes +
+                  (size_t)head.raw_size;
+    u8* record = (u8*)mp_calloc(1, size);
+    if (!record) return NULL;
+    
+    u8* p = record;
+    memcpy(p, &head, sizeof(head));
+    p += sizeof(head);
+    mp_exif_data copy = *exif;
+    copy.history = NULL;
+    copy.raw_data = NULL;
+    memcpy(p, &copy, sizeof(copy));
+    p += sizeof(copy);
+    if (exif->history) {
+        mp_history_chain chain = *exif->history;
+        chain.head = chain.tail = NULL;
+        memcpy(p, &chain, sizeof(chain));
+        p += sizeof(chain);
+        for (const mp_history_entry* e = exif->history->head; e; e = e->next) {
+            mp_history_entry entry = *e;
+            entry.next = entry.prev = NULL;
+            memcpy(p, &entry, sizeof(entry));
+            p += sizeof(entry);
+        }
+    }
+    if (head.raw_size) memcpy(p, exif->raw_data, (size_t)head.raw_size);
+    
+    *out_size = size;
+    return record;
+}
+
+/* Rebuild EXIF owned the way mp_exif_destroy frees it; NULL if the record does not fit
+ * / mp_exif_destroy로 해제할 수 있는 EXIF 재구성 (기록이 맞지 않으면 NULL) */
+static mp_exif_data* mp_decode_cache_unpack_exif(const u8* record, u64 size) {
+    mp_decode_cache_exif_head head;
+    if (size < sizeof(head)) return NULL;
+    memcpy(&head, record, sizeof(head));
+    if (head.exif_bytes != sizeof(mp_exif_data) || head.entry_bytes != sizeof(mp_history_entry) ||
+        (head.chain_bytes != 0 && head.chain_bytes != sizeof(mp_history_chain)) ||
+        (head.chain_bytes == 0 && head.entry_count != 0)) {
+        return NULL;
+    }
+    u64 expected = sizeof(head) + (u64)head.exif_bytes + head.chain_bytes + (u64)head.entry_count * head.entry_bytes;
+    if (expected > size || size - expected != head.raw_size) return NULL;
+    
+    const u8* p = record + sizeof(head);
+    mp_exif_data* exif = (mp_exif_data*)mp_malloc(sizeof(mp_exif_data));
+    if (!exif) return NULL;
+    memcpy(exif, p, sizeof(mp_exif_data));
+    p += sizeof(mp_exif_data);
+    exif->history = NULL;
+    exif->raw_data = NULL;
+    exif->raw_size = 0;
+    
+    if (head.chain_bytes) {
+        exif->history = (mp_history_chain*)mp_malloc(sizeof(mp_history_chain));
+        if (!exif->history) {
+            mp_exif_destroy(exif);
+            return NULL;
+        }
+        memcpy(exif->history, p, sizeof(mp_history_chain));
+        p += sizeof(mp_history_chain);
+        exif->history->head = exif->history->tail = NULL;
+        exif->history->count = 0;
+        for (u32 i = 0; i < head.entry_count; i++, p += sizeof(mp_history_entry)) {
+            mp_history_entry* entry = (mp_history_entry*)mp_malloc(sizeof(mp_history_entry));
+            if (!entry) {
+                mp_exif_destroy(exif);
+                return NULL;
+            }
+            memcpy(entry, p, sizeof(mp_history_entry));
+            entry->next = NULL;
+            entry->prev = exif->history->tail;
+            if (exif->history->tail) exif->history->tail->next = entry;
+            else exif->history->head = entry;
+            exif->history->tail = entry;
+            exif->history->count++;
+        }
+    }
+    if (head.raw_size) {
+        exif->raw_data = (u8*)mp_malloc((size_t)head.raw_size);
+        if (!exif->raw_data) {
+            mp_exif_destroy(exif);
+            return NULL;
+        }
+        memcpy(exif->raw_data, p, (size_t)head.raw_size);
+        exif->raw_size = (size_t)head.raw_size;
+    }
+    return exif;
+}
+
+/* Map a cached entry as a new image; NULL on any mismatch / 캐시 항목을 매핑해 이미지 생성 */
+static mp_image* mp_decode_cache_map(mp_decode_cache* cache, const char* path, u64 hash, u64 source_size) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return NULL;
+    
+    struct stat st;
+    mp_decode_cache_header header;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < MP_DECODE_CACHE_DATA_OFFSET ||
+        pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+        !mp_decode_cache_header_valid(&header, hash, source_size, (size_t)st.st_size)) {
+        close(fd);
+        return NULL;
+    }
+    
+    /* Private and writable: edits copy the touched pages, the file never changes
+     * / 비공개 쓰기 가능 매핑: 편집 시 해당 페이지만 복사되고 파일은 변하지 않음 */
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+    
+    mp_image* image = (mp_image*)mp_calloc(1, sizeof(mp_image));
+    mp_image_buffer* buffer = (mp_image_buffer*)mp_calloc(1, sizeof(mp_image_buffer));
+    mp_image_metadata* metadata = (mp_image_metadata*)mp_calloc(1, sizeof(mp_image_metadata));
+    mp_decode_mapping* mapping = (mp_decode_mapping*)mp_malloc(sizeof(mp_decode_mapping));
+    if (!image || !buffer || !metadata || !mapping) {
+        mp_free(image);
+        mp_free(buffer);
+        mp_free(metadata);
+        mp_free(mapping);
+        munmap(map, (size_t)st.st_size);
+        return NULL;
+    }
+    
+    buffer->width = header.width;
+    buffer->height = header.height;
+    buffer->stride = header.stride;
+    buffer->bpp = header.bpp;
+    buffer->format = (mp_color_format)header.color_format;
+    buffer->data = (u8*)map + header.data_offset;
+    buffer->data_size = (size_t)header.data_size;
+    buffer->owns_data = MP_FALSE;
+    
+    metadata->format = (mp_image_format)header.source_format;
+    metadata->width = header.width;
+    metadata->height = header.height;
+    metadata->bit_depth = header.bit_depth;
+    metadata->color_format = (mp_color_format)header.color_format;
+    metadata->has_alpha = header.has_alpha ? MP_TRUE : MP_FALSE;
+    metadata->has_exif = header.has_exif ? MP_TRUE : MP_FALSE;
+    if (header.exif_size) {
+        metadata->exif = mp_decode_cache_unpack_exif((const u8*)map + header.data_offset + header.data_size, header.exif_size);
+        if (!metadata->exif) {
+            mp_free(image);
+            mp_free(buffer);
+            mp_free(metadata);
+            mp_free(mapping);
+            munmap(map, (size_t)st.st_size);
+            return NULL;
+        }
+    }
+    
+    image->buffer = buffer;
+    image->metadata = metadata;
+    
+    mapping->image = image;
+    mapping->map = map;
+    mapping->length = (size_t)st.st_size;
+    pthread_mutex_lock(&cache->lock);
+    mapping->next = cache->mappings;
+    cache->mappings = mapping;
+    pthread_mutex_unlock(&cache->lock);
+    
+    /* The modification time doubles as the last use for eviction / 수정 시각을 마지막 사용 시각으로 사용 */
+    utimensat(AT_FDCWD, path, NULL, 0);
+    return image;
+}
+
+typedef struct {
+    char* path;
+    size_t size;
+    struct timespec used;
+} mp_decode_cache_file;
+
+static int mp_decode_cache_compare_used(const void* a, const void* b) {
+    const mp_decode_cache_file* x = (const mp_decode_cache_file*)a;
+    const mp_decode_cache_file* y = (const mp_decode_cache_file*)b;
+    if (x->used.tv_sec != y->used.tv_sec) return x->used.tv_sec < y->used.tv_sec ? -1 : 1;
+    if (x->used.tv_nsec != y->used.tv_nsec) return x->used.tv_nsec < y->used.tv_nsec ? -1 : 1;
+    return 0;
+}
+
+/* Scan the directory, deleting least recently used files until it fits the limit, and
+ * return what is left / 디렉터리를 검사해 용량 제한에 맞을 때까지 가장 오래 사용하지 않은 파일을 삭제하고 남은 크기 반환 */
+static size_t mp_decode_cache_evict(mp_decode_cache* cache) {
+    DIR* dir = opendir(cache->dir);
+    if (!dir) return 0;
+    
+    size_t dir_len = strlen(cache->dir);
+    u32 capacity = 64, count = 0;
+    size_t total = 0;
+    mp_decode_cache_file* files = (mp_decode_cache_file*)mp_malloc(sizeof(mp_decode_cache_file) * capacity);
+    struct dirent* ent;
+    while (files && (ent = readdir(dir)) != NULL) {
+        if (ent->d_name[0] == '.') continue;
+        if (count == capacity) {
+            mp_decode_cache_file* grown = (mp_decode_cache_file*)mp_realloc(files, sizeof(mp_decode_cache_file) * capacity * 2);
+            if (!grown) break;
+            files = grown;
+            capacity *= 2;
+        }
+        size_t len = dir_len + 1 + strlen(ent->d_name) + 1;
+        char* path = (char*)mp_malloc(len);
+        if (!path) break;
+        snprintf(path, len, "%s/%s", cache->dir, ent->d_name);
+        
+        struct stat st;
+        if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) {
+            mp_free(path);
+            continue;
+        }
+        files[count].path = path;
+        files[count].size = (size_t)st.st_size;
+        files[count].used = st.st_mtim;
+        total += (size_t)st.st_size;
+        count++;
+    }
+    closedir(dir);
+    if (!files) return total;
+    
+    if (total > cache->limit) {
+        qsort(files, count, sizeof(mp_decode_cache_file), mp_decode_cache_compare_used);
+        for (u32 i = 0; i < count && total > cache->limit; i++) {
+            if (unlink(files[i].path) == 0) total -= files[i].size;
+        }
+    }
+    for (u32 i = 0; i < count; i++) mp_free(files[i].path);
+    mp_free(files);
+    return total;
+}
+
+/* Count a new file, scanning the directory only on the first store and whenever the
+ * running total passes the limit. Other processes' stores are picked up by those scans.
+ * / 새 파일을 합산하며, 첫 저장과 합계가 제한을 넘을 때만 디렉터리를 검사 */
+static void mp_decode_cache_account(mp_decode_cache* cache, size_t size) {
+    pthread_mutex_lock(&cache->lock);
+    mp_bool scan = !cache->total_known || cache->total + size > cache->limit;
+    cache->total += size;
+    pthread_mutex_unlock(&cache->lock);
+    if (!scan) return;
+    
+    size_t total = mp_decode_cache_evict(cache);
+    pthread_mutex_lock(&cache->lock);
+    cache->total = total;
+    cache->total_known = MP_TRUE;
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/* Write through a temporary name and rename, so readers only ever see complete files
+ * / 임시 이름으로 쓴 뒤 rename하여 완전한 파일만 보이도록 함 */
+static void mp_decode_cache_store(mp_decode_cache* cache, const char* path, const mp_image* image, u64 hash, u64 source_size) {
+    const mp_image_buffer* buffer = image->buffer;
+    u64 data_size = (u64)buffer->stride * buffer->height;
+    if (!buffer->data || buffer->data_size < data_size ||
+        buffer->bpp != mp_image_layout_bpp((mp_color_format)buffer->format) ||
+        MP_DECODE_CACHE_DATA_OFFSET + data_size > cache->limit) {
+        return;
+    }
+    
+    const mp_exif_data* exif = image->metadata ? image->metadata->exif : NULL;
+    size_t exif_size = 0;
+    u8* exif_record = exif ? mp_decode_cache_pack_exif(exif, &exif_size) : NULL;
+    u8* head = (u8*)mp_calloc(1, MP_DECODE_CACHE_DATA_OFFSET);
+    size_t temp_len = strlen(path) + 32;
+    char* temp = (char*)mp_malloc(temp_len);
+    if (!head || !temp || (exif && !exif_record)) {
+        mp_free(exif_record);
+        mp_free(head);
+        mp_free(temp);
+        return;
+    }
+    snprintf(temp, temp_len, "%s.%ld.tmp", path, (long)getpid());
+    
+    mp_decode_cache_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MP_DECODE_CACHE_MAGIC, 8);
+    header.bom = MP_DECODE_CACHE_BOM;
+    header.data_offset = MP_DECODE_CACHE_DATA_OFFSET;
+    header.content_hash = hash;
+    header.source_size = source_size;
+    header.width = buffer->width;
+    header.height = buffer->height;
+    header.stride = buffer->stride;
+    header.bpp = buffer->bpp;
+    header.color_format = (u32)buffer->format;
+    header.source_format = image->metadata ? (u32)image->metadata->format : 0;
+    header.bit_depth = image->metadata ? image->metadata->bit_depth : 8;
+    header.has_alpha = image->metadata && image->metadata->has_alpha;
+    header.has_exif = image->metadata && image->metadata->has_exif;
+    header.data_size = data_size;
+    header.exif_size = exif_size;
+    memcpy(head, &header, sizeof(header));
+    
+    int fd = open(temp, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd != -1) {
+        mp_bool written = write(fd, head, MP_DECODE_CACHE_DATA_OFFSET) == MP_DECODE_CACHE_DATA_OFFSET;
+        for (u64 done = 0; written && done < data_size;) {
+            ssize_t n = write(fd, buffer->data + done, (size_t)(data_size - done));
+            if (n <= 0) written = MP_FALSE;
+            else done += (u64)n;
+        }
+        if (written && exif_size) written = write(fd, exif_record, exif_size) == (ssize_t)exif_size;
+        if (close(fd) != 0) written = MP_FALSE;
+        if (!written || rename(temp, path) != 0) unlink(temp);
+        else mp_decode_cache_account(cache, MP_DECODE_CACHE_DATA_OFFSET + (size_t)data_size + exif_size);
+    }
+    mp_free(exif_record);
+    mp_free(head);
+    mp_free(temp);
+}
+
+mp_image* mp_decode_cache_load(mp_decode_cache* cache, const char* filepath) {
+    if (!cache || !filepath) return filepath ? mp_image_load(filepath) : NULL;
+    
+    u64 hash, source_size;
+    if (!mp_decode_cache_key(filepath, &hash, &source_size)) return mp_image_load(filepath);
+    char* path = mp_decode_cache_entry_path(cache, hash);
+    if (!path) return mp_image_load(filepath);
+    
+    mp_image* image = mp_decode_cache_map(cache, path, hash, source_size);
+    if (image) {
+        image->filepath = mp_strdup(filepath);
+        mp_free(path);
+        return image;
+    }
+    
+    /* The image-level history chain has no owner outside mp_image and is not cached
+     * / 이미지 단위 히스토리 체인은 캐시하지 않음 */
+    image = mp_image_load(filepath);
+    if (image && image->buffer && !image->history) {
+        mp_decode_cache_store(cache, path, image, hash, source_size);
+    }
+    mp_free(path);
+    return image;
+}
+
+void mp_decode_cache_release(mp_decode_cache* cache, mp_image* image) {
+    if (!image) return;
+    mp_decode_mapping* mapping = NULL;
+    if (cache) {
+        pthread_mutex_lock(&cache->lock);
+        for (mp_decode_mapping** link = &cache->mappings; *link; link = &(*link)->next) {
+            if ((*link)->image == image) {
+                mapping = *link;
+                *link = mapping->next;
+                break;
+            }
+        }
+        pthread_mutex_unlock(&cache->lock);
+    }
+    
+    mp_image_destroy(image);
+    if (mapping) {
+        munmap(mapping->map, mapping->length);
+        mp_free(mapping);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef MANYPICTURES_DECODE_CACHE_H
+#define MANYPICTURES_DECODE_CACHE_H
+
+#include "types.h"
+
+/* Persistent cache of decoded pixels / 디코딩된 픽셀의 영구 캐시
+ *
+ * Each decoded image is kept as one raw file named after a hash of the source file's
+ * contents: a fixed header (dimensions, color format, stride) followed by the pixel rows
+ * at a page-aligned offset and, for images that carry it, a flat copy of their EXIF. A hit
+ * maps that file copy-on-write and hands the mapping to mp_image_buffer as-is, so no pixels
+ * are decoded or copied (only the EXIF record is rebuilt); edits only touch private pages.
+ * The directory (`MP_DECODE_CACHE_DIR`, default `$XDG_CACHE_HOME/manypictures/decoded`)
+ * is kept under `MP_DECODE_CACHE_MB` by deleting the least recently used files; it is only
+ * rescanned when the running total of stores passes the limit.
+ * Only the CLI reads through the cache. The GUI keeps calling mp_image_load: its images
+ * are handed between the prefetcher, the worker and the viewer and freed with
+ * mp_image_destroy, and a mapped image has to go back through mp_decode_cache_release.
+ * 원본 내용 해시로 이름 붙인 원시 파일에 디코딩 결과를 저장하며, 적중 시 파일을 Copy-on-Write로
+ * 매핑해 파싱이나 복사 없이 그대로 버퍼로 사용합니다. 용량 초과 시 가장 오래 사용하지 않은 파일부터 삭제합니다.
+ */
+
+#define MP_DECODE_CACHE_LIMIT_MB 2048
+
+typedef struct mp_decode_cache mp_decode_cache;
+
+/* `dir` NULL uses the default location, creating its directories; NULL if unusable
+ * / `dir`이 NULL이면 기본 위치 사용 (사용할 수 없으면 NULL) */
+mp_decode_cache* mp_decode_cache_open(const char* dir);
+
+/* Unmaps every image still mapped, so those must be released first
+ * / 아직 매핑된 이미지를 모두 해제하므로 그 전에 release 필요 */
+void mp_decode_cache_close(mp_decode_cache* cache);
+
+/* mp_image_load through the cache; a NULL cache loads directly. EXIF, including its edit
+ * history, is stored with the pixels; an image with its own history chain is never stored.
+ * / 캐시를 거치는 mp_image_load (NULL이면 직접 로드, EXIF는 픽셀과 함께 저장하며 이미지 자체
+ * 히스토리가 있는 이미지는 저장하지 않음) */
+mp_image* mp_decode_cache_load(mp_decode_cache* cache, const char* filepath);
+
+/* Destroy an image from mp_decode_cache_load and unmap its file
+ * / mp_decode_cache_load로 얻은 이미지를 파괴하고 매핑 해제 */
+void mp_decode_cache_release(mp_decode_cache* cache, mp_image* image);
+
+#endif /* MANYPICTURES_DECODE_CACHE_H */
@@ -0,0 +1,30 @@
+#include "image_layout.h"
+#include "fast_io.h"
+#include <stdlib.h>
+
+void mp_image_layout_check(const mp_image_buffer* buffer, const char* file, int line) {
+    const char* problem = NULL;
+    if (!buffer) {
+        problem = "NULL buffer";
+    } else if (buffer->width == 0 || buffer->height == 0 || !buffer->data) {
+        problem = "empty buffer";
+    } else if (buffer->bpp != mp_image_layout_bpp(buffer->format)) {
+        problem = "bpp does not match the color format";
+    } else if (buffer->stride / buffer->bpp < buffer->width) {
+        problem = "stride shorter than a row";
+    } else if (buffer->data_size < (size_t)buffer->stride * buffer->height) {
+        problem = "data_size shorter than stride * height";
+    }
+#ifdef MP_IMAGE_LAYOUT_STRICT
+    else if (buffer->owns_data) {
+        /* Only owning buffers come from mp_image_buffer_create / 소유 버퍼만 규약 대상 */
+        if (((uintptr_t)buffer->data & (MP_IMAGE_ROW_ALIGN - 1)) != 0) problem = "rows not 64-byte aligned";
+        else if ((buffer->stride & (MP_IMAGE_ROW_ALIGN - 1)) != 0) problem = "stride not a multiple of 64";
+        else if (buffer->data_size < mp_image_layout_size(buffer->stride, buffer->height)) problem = "no readable tail";
+    }
+#endif
+    if (!problem) return;
+    
+    mp_fast_fprintf(2, "%s:%d: image buffer layout violated: %s / 이미지 버퍼 레이아웃 위반\n", file, line, problem);
+    abort();
+}
@@ -0,0 +1,66 @@
+#ifndef MANYPICTURES_IMAGE_LAYOUT_H
+#define MANYPICTURES_IMAGE_LAYOUT_H
+
+#include "types.h"
+#include <stdint.h>
+
+/* Pixel layout contract of owning image buffers / 소유 이미지 버퍼의 픽셀 레이아웃 규약
+ *
+ * mp_image_buffer_create is to place row 0 on an MP_IMAGE_ROW_ALIGN boundary, pad every row
+ * to a multiple of MP_IMAGE_ROW_ALIGN bytes and leave MP_IMAGE_TAIL_PAD readable bytes
+ * after the last row (data_size = stride * height + MP_IMAGE_TAIL_PAD). A kernel can
+ * then run whole-vector loads across the full stride of every row with no scalar
+ * remainder. Kernels test mp_image_layout_padded before relying on the padding, since
+ * non-owning buffers may have any stride and the allocator may not have adopted the
+ * contract yet.
+ * 행 0은 64바이트 경계에서 시작하고 모든 행은 64바이트 배수로 패딩되며 마지막 행 뒤에 읽기 가능한
+ * 여유 바이트가 있어, 커널이 나머지 루프 없이 행 전체를 벡터로 처리할 수 있습니다.
+ */
+
+#define MP_IMAGE_ROW_ALIGN 64
+#define MP_IMAGE_TAIL_PAD 64
+
+/* Bytes per pixel of a color format, 0 if unknown / 색상 포맷의 픽셀당 바이트 (알 수 없으면 0) */
+static inline u32 mp_image_layout_bpp(mp_color_format format) {
+    switch (format) {
+        case MP_COLOR_FORMAT_RGB:
+        case MP_COLOR_FORMAT_BGR: return 3;
+        case MP_COLOR_FORMAT_RGBA:
+        case MP_COLOR_FORMAT_BGRA: return 4;
+        case MP_COLOR_FORMAT_GRAYSCALE: return 1;
+        case MP_COLOR_FORMAT_GRAYSCALE_ALPHA: return 2;
+        default: return 0;
+    }
+}
+
+/* Padded stride for a row of `width` pixels / `width` 픽셀 행의 패딩된 스트라이드 */
+static inline u32 mp_image_layout_stride(u32 width, u32 bpp) {
+    return (width * bpp + (MP_IMAGE_ROW_ALIGN - 1)) & ~(u32)(MP_IMAGE_ROW_ALIGN - 1);
+}
+
+/* Allocation size including the tail / 꼬리 여유분을 포함한 할당 크기 */
+static inline size_t mp_image_layout_size(u32 stride, u32 height) {
+    return (size_t)stride * height + MP_IMAGE_TAIL_PAD;
+}
+
+/* True when the full stride of every row may be read and written: aligned rows whose
+ * padding is only the rounding of one row / 정렬된 행이며 패딩이 한 행의 올림뿐이면 참 */
+static inline mp_bool mp_image_layout_padded(const mp_image_buffer* buffer) {
+    return ((uintptr_t)buffer->data & (MP_IMAGE_ROW_ALIGN - 1)) == 0 &&
+           buffer->stride == mp_image_layout_stride(buffer->width, buffer->bpp) &&
+           buffer->data_size >= (size_t)buffer->stride * buffer->height;
+}
+
+/* Aborts with the caller's location when `buffer` is malformed (bpp, stride or size do not
+ * add up). Alignment and padding of owning buffers are only enforced with
+ * MP_IMAGE_LAYOUT_STRICT, for an allocator known to meet the contract.
+ * / 버퍼가 잘못되면 호출 위치와 함께 중단 (정렬·패딩 검사는 MP_IMAGE_LAYOUT_STRICT에서만) */
+void mp_image_layout_check(const mp_image_buffer* buffer, const char* file, int line);
+
+#ifdef DEBUG
+#define MP_IMAGE_CHECK_LAYOUT(buffer) mp_image_layout_check((buffer), __FILE__, __LINE__)
+#else
+#define MP_IMAGE_CHECK_LAYOUT(buffer) ((void)0)
+#endif
+
+#endif /* MANYPICTURES_IMAGE_LAYOUT_H */
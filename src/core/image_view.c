@@ -0,0 +1,104 @@
+#include "image_view.h"
+#include "memory.h"
+#include "image.h"
+#include "image_layout.h"
+#include <string.h>
+
+mp_image_view mp_image_view_of(mp_image_buffer* buffer) {
+    mp_image_view view;
+    memset(&view, 0, sizeof(view));
+    if (!buffer) return view;
+    
+    view.owner = buffer;
+    view.origin = buffer->data;
+    view.stride = (i64)buffer->stride;
+    view.width = buffer->width;
+    view.height = buffer->height;
+    view.bpp = buffer->bpp;
+    view.format = buffer->format;
+    return view;
+}
+
+mp_result mp_image_view_crop(mp_image_view* view, u32 x, u32 y, u32 width, u32 height) {
+    if (!view || !view->owner) return MP_ERROR_INVALID_PARAM;
+    if (width == 0 || height == 0 ||
+        x > view->width || width > view->width - x ||
+        y > view->height || height > view->height - y) {
+        return MP_ERROR_INVALID_PARAM;
+    }
+    
+    view->origin = mp_image_view_row(view, y) + (size_t)x * view->bpp;
+    view->width = width;
+    view->height = height;
+    return MP_SUCCESS;
+}
+
+void mp_image_view_flip_vertical(mp_image_view* view) {
+    if (!view || !view->owner || view->height == 0) return;
+    view->origin = mp_image_view_row(view, view->height - 1);
+    view->stride = -view->stride;
+}
+
+mp_bool mp_image_view_is_identity(const mp_image_view* view) {
+    if (!view || !view->owner) return MP_FALSE;
+    return view->origin == view->owner->data &&
+           view->stride == (i64)view->owner->stride &&
+           view->width == view->owner->width &&
+           view->height == view->owner->height;
+}
+
+mp_image_buffer* mp_image_view_materialize(const mp_image_view* view) {
+    if (!view || !view->owner) return NULL;
+    
+    mp_image_buffer* buffer = mp_image_buffer_create(view->width, view->height, view->format);
+    if (!buffer) return NULL;
+    
+    size_t row_bytes = (size_t)view->width * view->bpp;
+    for (u32 y = 0; y < view->height; y++) {
+        memcpy(buffer->data + (size_t)y * buffer->stride, mp_image_view_row(view, y), row_bytes);
+    }
+    return buffer;
+}
+
+mp_result mp_image_view_commit(mp_image_view* view) {
+    if (!view || !view->owner) return MP_ERROR_INVALID_PARAM;
+    if (mp_image_view_is_identity(view)) return MP_SUCCESS;
+    
+    mp_image_buffer* owner = view->owner;
+    size_t row_bytes = (size_t)view->width * view->bpp;
+    mp_bool flipped = view->stride < 0;
+    
+    /* Walk rows in ascending address order so every move goes towards the front of the
+     * allocation; memmove covers the overlap / 주소 오름차순으로 행을 앞으로 이동 (memmove로 중첩 처리) */
+    u8* top = flipped ? mp_image_view_row(view, view->height - 1) : view->origin;
+    size_t pitch = (size_t)(flipped ? -view->stride : view->stride);
+    if (top != owner->data || pitch != owner->stride) {
+        for (u32 y = 0; y < view->height; y++) {
+            memmove(owner->data + (size_t)y * owner->stride, top + (size_t)y * pitch, row_bytes);
+        }
+    }
+    
+    if (flipped) {
+        /* Row-level swap to realise the negative stride / 음수 스트라이드를 행 스왑으로 실현 */
+        u8* temp_row = (u8*)mp_malloc(row_bytes);
+        if (!temp_row) return MP_ERROR_MEMORY;
+        for (u32 y = 0; y < view->height / 2; y++) {
+            u8* a = owner->data + (size_t)y * owner->stride;
+            u8* b = owner->data + (size_t)(view->height - 1 - y) * owner->stride;
+            memcpy(temp_row, a, row_bytes);
+            memcpy(a, b, row_bytes);
+            memcpy(b, temp_row, row_bytes);
+        }
+        mp_free(temp_row);
+    }
+    
+    /* The owner keeps its allocation and stride; the logical size shrinks and data_size
+     * covers the kept rows plus the tail, which stays inside the old allocation
+     * / 소유자는 할당과 스트라이드를 유지하고, data_size는 남은 행과 꼬리 여유분을 덮도록 축소 */
+    size_t data_size = mp_image_layout_size(owner->stride, view->height);
+    if (data_size < owner->data_size) owner->data_size = data_size;
+    owner->width = view->width;
+    owner->height = view->height;
+    *view = mp_image_view_of(owner);
+    return MP_SUCCESS;
+}
@@ -0,0 +1,51 @@
+#ifndef MANYPICTURES_IMAGE_VIEW_H
+#define MANYPICTURES_IMAGE_VIEW_H
+
+#include "types.h"
+
+/* Non-owning strided window onto an mp_image_buffer / mp_image_buffer에 대한 비소유 스트라이드 창
+ *
+ * Crop and vertical flip are O(1) on the view itself: crop moves the origin, flip points
+ * the origin at the last row and negates the stride. Pixels move when the view is committed
+ * back into its owner or materialized. mp_image has no slot for a pending view, so
+ * mp_op_crop and mp_op_flip_vertical commit at once: one in-place pass over the kept rows
+ * with no new allocation, not O(1).
+ * 뷰 자체의 자르기와 상하 반전은 O(1)이지만, mp_image에 보류 중인 뷰를 둘 곳이 없어 연산은 즉시
+ * 커밋합니다 (새 할당 없이 남는 행을 제자리에서 한 번 처리).
+ */
+typedef struct {
+    mp_image_buffer* owner; /* Backing storage (not owned) / 백킹 저장소 (비소유) */
+    u8* origin;             /* First byte of row 0 / 0번 행의 첫 바이트 */
+    i64 stride;             /* Signed row pitch, negative when flipped / 부호 있는 행 간격 */
+    u32 width;
+    u32 height;
+    u32 bpp;
+    mp_color_format format;
+} mp_image_view;
+
+/* View covering a whole buffer / 버퍼 전체를 덮는 뷰 */
+mp_image_view mp_image_view_of(mp_image_buffer* buffer);
+
+/* Narrow a view to a sub-rectangle (O(1)) / 뷰를 부분 사각형으로 축소 (O(1)) */
+mp_result mp_image_view_crop(mp_image_view* view, u32 x, u32 y, u32 width, u32 height);
+
+/* Flip a view vertically by negating its stride (O(1)) / 스트라이드 부호 반전으로 상하 반전 (O(1)) */
+void mp_image_view_flip_vertical(mp_image_view* view);
+
+/* Row pointer for row y / y번 행 포인터 */
+static inline u8* mp_image_view_row(const mp_image_view* view, u32 y) {
+    return view->origin + (i64)y * view->stride;
+}
+
+/* True when the view is exactly its owner's layout / 뷰가 소유자 레이아웃과 동일하면 참 */
+mp_bool mp_image_view_is_identity(const mp_image_view* view);
+
+/* Copy a view into a new contiguous owning buffer / 뷰를 새로운 연속 소유 버퍼로 복사 */
+mp_image_buffer* mp_image_view_materialize(const mp_image_view* view);
+
+/* Rewrite the owner in place so it holds exactly the view (no allocation beyond one row).
+ * The owner keeps its allocation and stride; data_size is recomputed for the new height
+ * / 소유자 버퍼를 제자리에서 뷰 내용으로 재배치 (할당과 스트라이드 유지, data_size 재계산) */
+mp_result mp_image_view_commit(mp_image_view* view);
+
+#endif /* MANYPICTURES_IMAGE_VIEW_H */
@@ -0,0 +1,88 @@
+#define _POSIX_C_SOURCE 200809L
+#include "parallel.h"
+#include "trace.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define MP_PARALLEL_MAX_THREADS 32
+
+typedef struct {
+    mp_parallel_fn fn;
+    void* ctx;
+    u32 begin;
+    u32 end;
+} mp_parallel_task;
+
+static void* mp_parallel_worker(void* arg) {
+    mp_parallel_task* task = (mp_parallel_task*)arg;
+    MP_TRACE_SCOPE("parallel.chunk");
+    task->fn(task->ctx, task->begin, task->end);
+    return NULL;
+}
+
+static pthread_once_t g_thread_count_once = PTHREAD_ONCE_INIT;
+static u32 g_thread_count = 1;
+
+/* Runs once even when several threads ask at the same time / 동시 호출에도 한 번만 실행 */
+static void mp_parallel_init_thread_count(void) {
+    long n = 0;
+    const char* env = getenv("MP_THREADS");
+    if (env) n = strtol(env, NULL, 10);
+    if (n <= 0) n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1) n = 1;
+    if (n > MP_PARALLEL_MAX_THREADS) n = MP_PARALLEL_MAX_THREADS;
+    g_thread_count = (u32)n;
+}
+
+u32 mp_parallel_thread_count(void) {
+    pthread_once(&g_thread_count_once, mp_parallel_init_thread_count);
+    return g_thread_count;
+}
+
+void mp_parallel_for(u32 count, u32 grain, mp_parallel_fn fn, void* ctx) {
+    if (!fn || count == 0) return;
+    if (grain == 0) grain = 1;
+    
+    u32 tasks = (count + grain - 1) / grain;
+    u32 threads = mp_parallel_thread_count();
+    if (tasks > threads) tasks = threads;
+    
+    if (tasks <= 1) {
+        fn(ctx, 0, count);
+        return;
+    }
+    
+    pthread_t handles[MP_PARALLEL_MAX_THREADS];
+    mp_parallel_task work[MP_PARALLEL_MAX_THREADS];
+    mp_bool spawned[MP_PARALLEL_MAX_THREADS];
+    
+    /* Even split: the first (count % tasks) chunks get one extra item / 균등 분할 */
+    u32 base = count / tasks;
+    u32 extra = count % tasks;
+    u32 pos = 0;
+    for (u32 t = 0; t < tasks; t++) {
+        u32 len = base + (t < extra ? 1 : 0);
+        work[t].fn = fn;
+        work[t].ctx = ctx;
+        work[t].begin = pos;
+        work[t].end = pos + len;
+        pos += len;
+    }
+    
+    for (u32 t = 0; t + 1 < tasks; t++) {
+        spawned[t] = pthread_create(&handles[t], NULL, mp_parallel_worker, &work[t]) == 0;
+        if (!spawned[t]) {
+            /* Thread creation failed: degrade to inline execution / 스레드 생성 실패 시 인라인 실행 */
+            fn(ctx, work[t].begin, work[t].end);
+        }
+    }
+    
+    MP_TRACE_BEGIN(chunk_start);
+    fn(ctx, work[tasks - 1].begin, work[tasks - 1].end);
+    MP_TRACE_END(chunk_start, "parallel.chunk");
+    
+    for (u32 t = 0; t + 1 < tasks; t++) {
+        if (spawned[t]) pthread_join(handles[t], NULL);
+    }
+}
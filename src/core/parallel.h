@@ -0,0 +1,19 @@
+#ifndef MANYPICTURES_PARALLEL_H
+#define MANYPICTURES_PARALLEL_H
+
+#include "types.h"
+
+/* Fork-join row/tile parallelism for pixel kernels / 픽셀 커널용 포크-조인 행/타일 병렬 처리 */
+
+/* Work callback: process items [begin, end) / 작업 콜백: [begin, end) 항목 처리 */
+typedef void (*mp_parallel_fn)(void* ctx, u32 begin, u32 end);
+
+/* Number of worker threads (MP_THREADS env overrides CPU count) / 작업 스레드 수 (MP_THREADS 환경 변수 우선) */
+u32 mp_parallel_thread_count(void);
+
+/* Split [0, count) into contiguous chunks of at least `grain` items and run them
+ * concurrently; the caller thread takes the last chunk. Runs inline when only one
+ * chunk results. / [0, count)를 최소 `grain` 단위로 나누어 병렬 실행 (호출 스레드가 마지막 청크 처리) */
+void mp_parallel_for(u32 count, u32 grain, mp_parallel_fn fn, void* ctx);
+
+#endif /* MANYPICTURES_PARALLEL_H */
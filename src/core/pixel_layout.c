@@ -0,0 +1,317 @@
+#include "pixel_layout.h"
+#include "image_layout.h"
+#include "alloc.h"
+#include "parallel.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MP_LAYOUT_X86 1
+#include <immintrin.h>
+#endif
+
+/* Minimum pixels per parallel chunk / 병렬 청크당 최소 픽셀 수 */
+#define MP_LAYOUT_PARALLEL_PIXELS 65536
+
+/* Single allocation rounded up to the row alignment / 행 정렬에 맞춘 단일 할당 */
+static u8* mp_layout_alloc(size_t size, void** block) {
+    *block = mp_alloc(size + MP_IMAGE_ROW_ALIGN - 1, MP_ALLOC_PIXELS);
+    if (!*block) return NULL;
+    return (u8*)(((uintptr_t)*block + MP_IMAGE_ROW_ALIGN - 1) & ~(uintptr_t)(MP_IMAGE_ROW_ALIGN - 1));
+}
+
+/* ---------------------------------------------------------------------------------------
+ * Row converters / 행 변환기
+ *
+ * split: interleaved row -> one row per plane, merge: the reverse. Each SIMD helper returns
+ * how many pixels it handled; the scalar loop finishes the row.
+ * split은 인터리브 행을 평면별 행으로, merge는 그 반대로 변환합니다.
+ * ------------------------------------------------------------------------------------- */
+
+#if defined(__SSE2__)
+/* One channel of 16 4-byte pixels: shift it to the low byte of each lane, then narrow
+ * / 4바이트 픽셀 16개 중 한 채널 추출 */
+static inline __m128i mp_layout_narrow32(__m128i v0, __m128i v1, __m128i v2, __m128i v3, int shift) {
+    const __m128i low = _mm_set1_epi32(0xFF);
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    __m128i a = _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(v0, count), low),
+                                _mm_and_si128(_mm_srl_epi32(v1, count), low));
+    __m128i b = _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(v2, count), low),
+                                _mm_and_si128(_mm_srl_epi32(v3, count), low));
+    return _mm_packus_epi16(a, b);
+}
+
+static u32 mp_layout_split4_sse2(const u8* src, u8* const* dst, u32 count) {
+    u32 x = 0;
+    for (; x + 16 <= count; x += 16) {
+        const u8* s = src + (size_t)x * 4;
+        __m128i v0 = _mm_loadu_si128((const __m128i*)s);
+        __m128i v1 = _mm_loadu_si128((const __m128i*)(s + 16));
+        __m128i v2 = _mm_loadu_si128((const __m128i*)(s + 32));
+        __m128i v3 = _mm_loadu_si128((const __m128i*)(s + 48));
+        for (int c = 0; c < 4; c++) {
+            _mm_storeu_si128((__m128i*)(dst[c] + x), mp_layout_narrow32(v0, v1, v2, v3, c * 8));
+        }
+    }
+    return x;
+}
+
+static u32 mp_layout_merge4_sse2(u8* const* src, u8* dst, u32 count) {
+    u32 x = 0;
+    for (; x + 16 <= count; x += 16) {
+        __m128i r = _mm_loadu_si128((const __m128i*)(src[0] + x));
+        __m128i g = _mm_loadu_si128((const __m128i*)(src[1] + x));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src[2] + x));
+        __m128i a = _mm_loadu_si128((const __m128i*)(src[3] + x));
+        __m128i rg_lo = _mm_unpacklo_epi8(r, g);
+        __m128i rg_hi = _mm_unpackhi_epi8(r, g);
+        __m128i ba_lo = _mm_unpacklo_epi8(b, a);
+        __m128i ba_hi = _mm_unpackhi_epi8(b, a);
+        u8* d = dst + (size_t)x * 4;
+        _mm_storeu_si128((__m128i*)d, _mm_unpacklo_epi16(rg_lo, ba_lo));
+        _mm_storeu_si128((__m128i*)(d + 16), _mm_unpackhi_epi16(rg_lo, ba_lo));
+        _mm_storeu_si128((__m128i*)(d + 32), _mm_unpacklo_epi16(rg_hi, ba_hi));
+        _mm_storeu_si128((__m128i*)(d + 48), _mm_unpackhi_epi16(rg_hi, ba_hi));
+    }
+    return x;
+}
+
+static u32 mp_layout_split2_sse2(const u8* src, u8* const* dst, u32 count) {
+    const __m128i low = _mm_set1_epi16(0xFF);
+    u32 x = 0;
+    for (; x + 16 <= count; x += 16) {
+        __m128i v0 = _mm_loadu_si128((const __m128i*)(src + (size_t)x * 2));
+        __m128i v1 = _mm_loadu_si128((const __m128i*)(src + (size_t)x * 2 + 16));
+        _mm_storeu_si128((__m128i*)(dst[0] + x), _mm_packus_epi16(_mm_and_si128(v0, low), _mm_and_si128(v1, low)));
+        _mm_storeu_si128((__m128i*)(dst[1] + x), _mm_packus_epi16(_mm_srli_epi16(v0, 8), _mm_srli_epi16(v1, 8)));
+    }
+    return x;
+}
+
+static u32 mp_layout_merge2_sse2(u8* const* src, u8* dst, u32 count) {
+    u32 x = 0;
+    for (; x + 16 <= count; x += 16) {
+        __m128i y = _mm_loadu_si128((const __m128i*)(src[0] + x));
+        __m128i a = _mm_loadu_si128((const __m128i*)(src[1] + x));
+        _mm_storeu_si128((__m128i*)(dst + (size_t)x * 2), _mm_unpacklo_epi8(y, a));
+        _mm_storeu_si128((__m128i*)(dst + (size_t)x * 2 + 16), _mm_unpackhi_epi8(y, a));
+    }
+    return x;
+}
+#endif
+
+#if defined(MP_LAYOUT_X86)
+/* pshufb tables for 16 3-byte pixels (48 bytes, three vectors); -128 yields zero
+ * / 3바이트 픽셀 16개용 pshufb 테이블 (-128은 0) */
+
+/* split[c][v]: bytes of channel c found in input vector v / 입력 벡터 v에 있는 채널 c 바이트 */
+static const signed char g_mp_layout_split3[3][3][16] = {
+    { { 0, 3, 6, 9, 12, 15, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128 },
+      { -128, -128, -128, -128, -128, -128, 2, 5, 8, 11, 14, -128, -128, -128, -128, -128 },
+      { -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 1, 4, 7, 10, 13 } },
+    { { 1, 4, 7, 10, 13, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128 },
+      { -128, -128, -128, -128, -128, 0, 3, 6, 9, 12, 15, -128, -128, -128, -128, -128 },
+      { -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 2, 5, 8, 11, 14 } },
+    { { 2, 5, 8, 11, 14, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128 },
+      { -128, -128, -128, -128, -128, 1, 4, 7, 10, 13, -128, -128, -128, -128, -128, -128 },
+      { -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 0, 3, 6, 9, 12, 15 } },
+};
+
+/* merge[v][c]: bytes of output vector v taken from plane c / 출력 벡터 v가 평면 c에서 가져오는 바이트 */
+static const signed char g_mp_layout_merge3[3][3][16] = {
+    { { 0, -128, -128, 1, -128, -128, 2, -128, -128, 3, -128, -128, 4, -128, -128, 5 },
+      { -128, 0, -128, -128, 1, -128, -128, 2, -128, -128, 3, -128, -128, 4, -128, -128 },
+      { -128, -128, 0, -128, -128, 1, -128, -128, 2, -128, -128, 3, -128, -128, 4, -128 } },
+    { { -128, -128, 6, -128, -128, 7, -128, -128, 8, -128, -128, 9, -128, -128, 10, -128 },
+      { 5, -128, -128, 6, -128, -128, 7, -128, -128, 8, -128, -128, 9, -128, -128, 10 },
+      { -128, 5, -128, -128, 6, -128, -128, 7, -128, -128, 8, -128, -128, 9, -128, -128 } },
+    { { -128, 11, -128, -128, 12, -128, -128, 13, -128, -128, 14, -128, -128, 15, -128, -128 },
+      { -128, -128, 11, -128, -128, 12, -128, -128, 13, -128, -128, 14, -128, -128, 15, -128 },
+      { 10, -128, -128, 11, -128, -128, 12, -128, -128, 13, -128, -128, 14, -128, -128, 15 } },
+};
+
+#define MP_LAYOUT_MASK(table, i, j) _mm_loadu_si128((const __m128i*)(table)[i][j])
+
+__attribute__((target("ssse3")))
+static u32 mp_layout_split3_ssse3(const u8* src, u8* const* dst, u32 count) {
+    u32 x = 0;
+    for (; x + 16 <= count; x += 16) {
+        const u8* s = src + (size_t)x * 3;
+        __m128i v[3];
+        v[0] = _mm_loadu_si128((const __m128i*)s);
+        v[1] = _mm_loadu_si128((const __m128i*)(s + 16));
+        v[2] = _mm_loadu_si128((const __m128i*)(s + 32));
+        for (int c = 0; c < 3; c++) {
+            __m128i plane = _mm_or_si128(_mm_shuffle_epi8(v[0], MP_LAYOUT_MASK(g_mp_layout_split3, c, 0)),
+                                         _mm_shuffle_epi8(v[1], MP_LAYOUT_MASK(g_mp_layout_split3, c, 1)));
+            plane = _mm_or_si128(plane, _mm_shuffle_epi8(v[2], MP_LAYOUT_MASK(g_mp_layout_split3, c, 2)));
+            _mm_storeu_si128((__m128i*)(dst[c] + x), plane);
+        }
+    }
+    return x;
+}
+
+__attribute__((target("ssse3")))
+static u32 mp_layout_merge3_ssse3(u8* const* src, u8* dst, u32 count) {
+    u32 x = 0;
+    for (; x + 16 <= count; x += 16) {
+        __m128i p[3];
+        p[0] = _mm_loadu_si128((const __m128i*)(src[0] + x));
+        p[1] = _mm_loadu_si128((const __m128i*)(src[1] + x));
+        p[2] = _mm_loadu_si128((const __m128i*)(src[2] + x));
+        u8* d = dst + (size_t)x * 3;
+        for (int v = 0; v < 3; v++) {
+            __m128i out = _mm_or_si128(_mm_shuffle_epi8(p[0], MP_LAYOUT_MASK(g_mp_layout_merge3, v, 0)),
+                                       _mm_shuffle_epi8(p[1], MP_LAYOUT_MASK(g_mp_layout_merge3, v, 1)));
+            out = _mm_or_si128(out, _mm_shuffle_epi8(p[2], MP_LAYOUT_MASK(g_mp_layout_merge3, v, 2)));
+            _mm_storeu_si128((__m128i*)(d + v * 16), out);
+        }
+    }
+    return x;
+}
+
+/* Resolved once; MP_SIMD=0 forces the scalar 3-byte path / 한 번만 판별 (MP_SIMD=0이면 스칼라) */
+static mp_bool mp_layout_has_ssse3(void) {
+    static atomic_int g_ssse3 = -1;
+    int ssse3 = atomic_load_explicit(&g_ssse3, memory_order_relaxed);
+    if (ssse3 >= 0) return ssse3 != 0;
+    
+    __builtin_cpu_init();
+    ssse3 = __builtin_cpu_supports("ssse3") ? 1 : 0;
+    const char* cap = getenv("MP_SIMD");
+    if (cap && *cap == '0') ssse3 = 0;
+    
+    atomic_store_explicit(&g_ssse3, ssse3, memory_order_relaxed);
+    return ssse3 != 0;
+}
+#endif
+
+static void mp_layout_split_row(const u8* src, u32 bpp, u8* const* dst, u32 count) {
+    u32 x = 0;
+    if (bpp == 1) {
+        memcpy(dst[0], src, count);
+        return;
+    }
+#if defined(__SSE2__)
+    if (bpp == 4) x = mp_layout_split4_sse2(src, dst, count);
+    else if (bpp == 2) x = mp_layout_split2_sse2(src, dst, count);
+#endif
+#if defined(MP_LAYOUT_X86)
+    if (bpp == 3 && mp_layout_has_ssse3()) x = mp_layout_split3_ssse3(src, dst, count);
+#endif
+    for (const u8* s = src + (size_t)x * bpp; x < count; x++) {
+        for (u32 c = 0; c < bpp; c++) dst[c][x] = *s++;
+    }
+}
+
+static void mp_layout_merge_row(u8* const* src, u32 bpp, u8* dst, u32 count) {
+    u32 x = 0;
+    if (bpp == 1) {
+        memcpy(dst, src[0], count);
+        return;
+    }
+#if defined(__SSE2__)
+    if (bpp == 4) x = mp_layout_merge4_sse2(src, dst, count);
+    else if (bpp == 2) x = mp_layout_merge2_sse2(src, dst, count);
+#endif
+#if defined(MP_LAYOUT_X86)
+    if (bpp == 3 && mp_layout_has_ssse3()) x = mp_layout_merge3_ssse3(src, dst, count);
+#endif
+    for (u8* d = dst + (size_t)x * bpp; x < count; x++) {
+        for (u32 c = 0; c < bpp; c++) *d++ = src[c][x];
+    }
+}
+
+/* ---------------------------------------------------------------------------------------
+ * Planar buffers / 평면 버퍼
+ * ------------------------------------------------------------------------------------- */
+
+mp_planar_buffer* mp_planar_buffer_create(u32 width, u32 height, mp_color_format format) {
+    u32 channels = mp_image_layout_bpp(format);
+    if (width == 0 || height == 0 || channels == 0) return NULL;
+    
+    mp_planar_buffer* planar = (mp_planar_buffer*)mp_alloc_zero(1, sizeof(mp_planar_buffer), MP_ALLOC_PIXELS);
+    if (!planar) return NULL;
+    
+    planar->width = width;
+    planar->height = height;
+    planar->channels = channels;
+    planar->stride = mp_image_layout_stride(width, 1);
+    planar->format = format;
+    
+    /* Plane sizes are multiples of 64, so every plane starts aligned / 평면 크기가 64 배수라 모든 평면이 정렬됨 */
+    size_t plane_size = (size_t)planar->stride * height;
+    u8* data = mp_layout_alloc(plane_size * channels + MP_IMAGE_TAIL_PAD, &planar->block);
+    if (!data) {
+        mp_alloc_free(planar);
+        return NULL;
+    }
+    for (u32 c = 0; c < channels; c++) planar->planes[c] = data + plane_size * c;
+    
+    return planar;
+}
+
+void mp_planar_buffer_destroy(mp_planar_buffer* planar) {
+    if (!planar) return;
+    mp_alloc_free(planar->block);
+    mp_alloc_free(planar);
+}
+
+typedef struct {
+    mp_image_buffer* buffer;
+    const mp_planar_buffer* planar;
+} mp_planar_job;
+
+static void mp_planar_split_rows(void* ctx, u32 begin, u32 end) {
+    const mp_planar_job* job = (const mp_planar_job*)ctx;
+    const mp_planar_buffer* planar = job->planar;
+    u8* rows[MP_LAYOUT_MAX_PLANES];
+    
+    for (u32 y = begin; y < end; y++) {
+        for (u32 c = 0; c < planar->channels; c++) rows[c] = planar->planes[c] + (size_t)y * planar->stride;
+        mp_layout_split_row(job->buffer->data + (size_t)y * job->buffer->stride, planar->channels, rows, planar->width);
+    }
+}
+
+static void mp_planar_merge_rows(void* ctx, u32 begin, u32 end) {
+    const mp_planar_job* job = (const mp_planar_job*)ctx;
+    const mp_planar_buffer* planar = job->planar;
+    u8* rows[MP_LAYOUT_MAX_PLANES];
+    
+    for (u32 y = begin; y < end; y++) {
+        for (u32 c = 0; c < planar->channels; c++) rows[c] = planar->planes[c] + (size_t)y * planar->stride;
+        mp_layout_merge_row(rows, planar->channels, job->buffer->data + (size_t)y * job->buffer->stride, planar->width);
+    }
+}
+
+static mp_bool mp_layout_matches(const mp_image_buffer* buffer, u32 width, u32 height, u32 bpp) {
+    return buffer && buffer->data && buffer->width == width && buffer->height == height && buffer->bpp == bpp;
+}
+
+static void mp_planar_split_into(const mp_image_buffer* buffer, mp_planar_buffer* planar) {
+    mp_planar_job job = { (mp_image_buffer*)buffer, planar };
+    mp_parallel_for(planar->height, MP_LAYOUT_PARALLEL_PIXELS / planar->width + 1, mp_planar_split_rows, &job);
+}
+
+mp_planar_buffer* mp_planar_from_interleaved(const mp_image_buffer* buffer) {
+    if (!buffer || !buffer->data || buffer->bpp != mp_image_layout_bpp(buffer->format)) return NULL;
+    
+    mp_planar_buffer* planar = mp_planar_buffer_create(buffer->width, buffer->height, buffer->format);
+    if (planar) mp_planar_split_into(buffer, planar);
+    return planar;
+}
+
+mp_result mp_planar_to_interleaved(const mp_planar_buffer* planar, mp_image_buffer* buffer) {
+    if (!planar || !mp_layout_matches(buffer, planar->width, planar->height, planar->channels)) {
+        return MP_ERROR_INVALID_PARAM;
+    }
+    
+    mp_planar_job job = { buffer, planar };
+    mp_parallel_for(planar->height, MP_LAYOUT_PARALLEL_PIXELS / planar->width + 1, mp_planar_merge_rows, &job);
+    return MP_SUCCESS;
+}
@@ -0,0 +1,40 @@
+#ifndef MANYPICTURES_PIXEL_LAYOUT_H
+#define MANYPICTURES_PIXEL_LAYOUT_H
+
+#include "types.h"
+
+/* Planar working layout / 평면 작업 레이아웃
+ *
+ * mp_image_buffer always holds interleaved pixels. Per-channel kernels such as separable
+ * resampling vectorize better on one plane per channel, so a planar working copy exists
+ * with SIMD converters to and from the interleaved buffer. Planes follow the same 64-byte
+ * alignment as mp_image_buffer (see image_layout.h).
+ * 이미지 버퍼는 항상 인터리브 형식이며, 채널별 커널을 위한 평면 작업 사본을 SIMD 변환기와 함께 제공합니다.
+ */
+
+#define MP_LAYOUT_MAX_PLANES 4
+
+/* One plane per channel in the byte order of `format` (R, G, B, A for RGBA; B, G, R, A for
+ * BGRA; Y, A for gray+alpha) / 포맷의 바이트 순서대로 채널마다 하나의 평면 */
+typedef struct {
+    u32 width;
+    u32 height;
+    u32 channels;
+    u32 stride;                          /* Bytes per plane row, multiple of 64 / 평면 행 바이트 */
+    mp_color_format format;
+    u8* planes[MP_LAYOUT_MAX_PLANES];    /* 64-byte aligned / 64바이트 정렬 */
+    void* block;                         /* Single allocation behind the planes / 평면 전체 할당 */
+} mp_planar_buffer;
+
+/* Planar buffers / 평면 버퍼 */
+mp_planar_buffer* mp_planar_buffer_create(u32 width, u32 height, mp_color_format format);
+void mp_planar_buffer_destroy(mp_planar_buffer* planar);
+
+/* Split an interleaved buffer into planes / 인터리브 버퍼를 평면으로 분리 */
+mp_planar_buffer* mp_planar_from_interleaved(const mp_image_buffer* buffer);
+
+/* Interleave planes into `buffer`, which must match in size and format
+ * / 평면을 `buffer`에 인터리브 (크기와 포맷이 같아야 함) */
+mp_result mp_planar_to_interleaved(const mp_planar_buffer* planar, mp_image_buffer* buffer);
+
+#endif /* MANYPICTURES_PIXEL_LAYOUT_H */
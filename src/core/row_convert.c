@@ -0,0 +1,268 @@
+#include "row_convert.h"
+#include "image_layout.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MP_ROW_X86 1
+#include <immintrin.h>
+#endif
+
+/* ---------------------------------------------------------------------------------------
+ * SIMD kernels / SIMD 커널
+ *
+ * Each returns how many pixels it converted; the scalar loop of the caller finishes the
+ * row. 3-byte loops stop while the last 16-byte load and store still fall inside the row.
+ * 변환한 픽셀 수를 반환하며 나머지는 스칼라 루프가 처리합니다.
+ * ------------------------------------------------------------------------------------- */
+
+#if defined(__SSE2__)
+/* Swap bytes 0 and 2 of every 4-byte pixel / 4바이트 픽셀의 0번과 2번 바이트 교환 */
+static u32 mp_row_swap32_sse2(const u8* src, u8* dst, u32 count) {
+    const __m128i keep = _mm_set1_epi32((int)0xFF00FF00);
+    const __m128i low = _mm_set1_epi32(0xFF);
+    u32 x = 0;
+    for (; x + 4 <= count; x += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + (size_t)x * 4));
+        __m128i swapped = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(v, 16), low),
+                                       _mm_slli_epi32(_mm_and_si128(v, low), 16));
+        _mm_storeu_si128((__m128i*)(dst + (size_t)x * 4), _mm_or_si128(_mm_and_si128(v, keep), swapped));
+    }
+    return x;
+}
+
+/* Y -> Y Y Y 255 / 회색을 불투명 4채널로 */
+static u32 mp_row_gray_to_rgba_sse2(const u8* src, u8* dst, u32 count) {
+    const __m128i opaque = _mm_set1_epi8((char)0xFF);
+    u32 x = 0;
+    for (; x + 16 <= count; x += 16) {
+        __m128i y = _mm_loadu_si128((const __m128i*)(src + x));
+        __m128i yy_lo = _mm_unpacklo_epi8(y, y);
+        __m128i yy_hi = _mm_unpackhi_epi8(y, y);
+        __m128i ya_lo = _mm_unpacklo_epi8(y, opaque);
+        __m128i ya_hi = _mm_unpackhi_epi8(y, opaque);
+        u8* d = dst + (size_t)x * 4;
+        _mm_storeu_si128((__m128i*)d, _mm_unpacklo_epi16(yy_lo, ya_lo));
+        _mm_storeu_si128((__m128i*)(d + 16), _mm_unpackhi_epi16(yy_lo, ya_lo));
+        _mm_storeu_si128((__m128i*)(d + 32), _mm_unpacklo_epi16(yy_hi, ya_hi));
+        _mm_storeu_si128((__m128i*)(d + 48), _mm_unpackhi_epi16(yy_hi, ya_hi));
+    }
+    return x;
+}
+#endif
+
+#if defined(MP_ROW_X86)
+/* pshufb patterns; -128 yields zero / pshufb 패턴 (-128은 0) */
+#define MP_ROW_SHUFFLE_SWAP24 2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15
+#define MP_ROW_SHUFFLE_24_32 0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128
+#define MP_ROW_SHUFFLE_24_32_SWAP 2, 1, 0, -128, 5, 4, 3, -128, 8, 7, 6, -128, 11, 10, 9, -128
+#define MP_ROW_SHUFFLE_32_24 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -128, -128, -128, -128
+#define MP_ROW_SHUFFLE_32_24_SWAP 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -128, -128, -128, -128
+
+/* Five pixels per step; byte 15 is copied unchanged and rewritten by the next step
+ * / 단계마다 5픽셀 (15번 바이트는 그대로 복사되어 다음 단계에서 다시 씀) */
+__attribute__((target("ssse3")))
+static u32 mp_row_swap24_ssse3(const u8* src, u8* dst, u32 count) {
+    const __m128i shuffle = _mm_setr_epi8(MP_ROW_SHUFFLE_SWAP24);
+    u32 x = 0;
+    for (; x + 6 <= count; x += 5) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + (size_t)x * 3));
+        _mm_storeu_si128((__m128i*)(dst + (size_t)x * 3), _mm_shuffle_epi8(v, shuffle));
+    }
+    return x;
+}
+
+__attribute__((target("ssse3")))
+static u32 mp_row_24_to_32_ssse3(const u8* src, u8* dst, u32 count, mp_bool swap) {
+    const __m128i shuffle = swap ? _mm_setr_epi8(MP_ROW_SHUFFLE_24_32_SWAP) : _mm_setr_epi8(MP_ROW_SHUFFLE_24_32);
+    const __m128i opaque = _mm_set1_epi32((int)0xFF000000);
+    u32 x = 0;
+    for (; x + 6 <= count; x += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + (size_t)x * 3));
+        _mm_storeu_si128((__m128i*)(dst + (size_t)x * 4), _mm_or_si128(_mm_shuffle_epi8(v, shuffle), opaque));
+    }
+    return x;
+}
+
+/* The 4 zero bytes after each store are rewritten by the next step / 저장 뒤 0 바이트 4개는 다음 단계에서 덮어씀 */
+__attribute__((target("ssse3")))
+static u32 mp_row_32_to_24_ssse3(const u8* src, u8* dst, u32 count, mp_bool swap) {
+    const __m128i shuffle = swap ? _mm_setr_epi8(MP_ROW_SHUFFLE_32_24_SWAP) : _mm_setr_epi8(MP_ROW_SHUFFLE_32_24);
+    u32 x = 0;
+    for (; x + 6 <= count; x += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + (size_t)x * 4));
+        _mm_storeu_si128((__m128i*)(dst + (size_t)x * 3), _mm_shuffle_epi8(v, shuffle));
+    }
+    return x;
+}
+
+/* Resolved once; MP_SIMD=0 forces the scalar paths / 한 번만 판별 (MP_SIMD=0이면 스칼라) */
+static mp_bool mp_row_has_ssse3(void) {
+    static atomic_int g_ssse3 = -1;
+    int ssse3 = atomic_load_explicit(&g_ssse3, memory_order_relaxed);
+    if (ssse3 >= 0) return ssse3 != 0;
+    
+    __builtin_cpu_init();
+    ssse3 = __builtin_cpu_supports("ssse3") ? 1 : 0;
+    const char* cap = getenv("MP_SIMD");
+    if (cap && *cap == '0') ssse3 = 0;
+    
+    atomic_store_explicit(&g_ssse3, ssse3, memory_order_relaxed);
+    return ssse3 != 0;
+}
+#endif
+
+/* ---------------------------------------------------------------------------------------
+ * Converters / 변환기
+ * ------------------------------------------------------------------------------------- */
+
+static void mp_row_copy1(const u8* src, u8* dst, u32 count) { memmove(dst, src, count); }
+static void mp_row_copy2(const u8* src, u8* dst, u32 count) { memmove(dst, src, (size_t)count * 2); }
+static void mp_row_copy3(const u8* src, u8* dst, u32 count) { memmove(dst, src, (size_t)count * 3); }
+static void mp_row_copy4(const u8* src, u8* dst, u32 count) { memmove(dst, src, (size_t)count * 4); }
+
+/* RGB <-> BGR */
+static void mp_row_swap24(const u8* src, u8* dst, u32 count) {
+    u32 x = 0;
+#if defined(MP_ROW_X86)
+    if (mp_row_has_ssse3()) x = mp_row_swap24_ssse3(src, dst, count);
+#endif
+    for (; x < count; x++) {
+        const u8* s = src + (size_t)x * 3;
+        u8* d = dst + (size_t)x * 3;
+        u8 b0 = s[0], b2 = s[2];
+        d[0] = b2; d[1] = s[1]; d[2] = b0;
+    }
+}
+
+/* RGBA <-> BGRA */
+static void mp_row_swap32(const u8* src, u8* dst, u32 count) {
+    u32 x = 0;
+#if defined(__SSE2__)
+    x = mp_row_swap32_sse2(src, dst, count);
+#endif
+    for (; x < count; x++) {
+        const u8* s = src + (size_t)x * 4;
+        u8* d = dst + (size_t)x * 4;
+        u8 b0 = s[0], b2 = s[2];
+        d[0] = b2; d[1] = s[1]; d[2] = b0; d[3] = s[3];
+    }
+}
+
+static inline void mp_row_24_to_32(const u8* restrict src, u8* restrict dst, u32 count, mp_bool swap) {
+    u32 x = 0;
+#if defined(MP_ROW_X86)
+    if (mp_row_has_ssse3()) x = mp_row_24_to_32_ssse3(src, dst, count, swap);
+#endif
+    u32 r = swap ? 2 : 0;
+    for (; x < count; x++) {
+        const u8* s = src + (size_t)x * 3;
+        u8* d = dst + (size_t)x * 4;
+        d[0] = s[r]; d[1] = s[1]; d[2] = s[2 - r]; d[3] = 255;
+    }
+}
+
+static inline void mp_row_32_to_24(const u8* restrict src, u8* restrict dst, u32 count, mp_bool swap) {
+    u32 x = 0;
+#if defined(MP_ROW_X86)
+    if (mp_row_has_ssse3()) x = mp_row_32_to_24_ssse3(src, dst, count, swap);
+#endif
+    u32 r = swap ? 2 : 0;
+    for (; x < count; x++) {
+        const u8* s = src + (size_t)x * 4;
+        u8* d = dst + (size_t)x * 3;
+        d[0] = s[r]; d[1] = s[1]; d[2] = s[2 - r];
+    }
+}
+
+static void mp_row_rgb_to_rgba(const u8* src, u8* dst, u32 count) { mp_row_24_to_32(src, dst, count, MP_FALSE); }
+static void mp_row_rgb_to_bgra(const u8* src, u8* dst, u32 count) { mp_row_24_to_32(src, dst, count, MP_TRUE); }
+static void mp_row_rgba_to_rgb(const u8* src, u8* dst, u32 count) { mp_row_32_to_24(src, dst, count, MP_FALSE); }
+static void mp_row_rgba_to_bgr(const u8* src, u8* dst, u32 count) { mp_row_32_to_24(src, dst, count, MP_TRUE); }
+
+static void mp_row_gray_to_rgb(const u8* restrict src, u8* restrict dst, u32 count) {
+    for (u32 x = 0; x < count; x++) {
+        u8* d = dst + (size_t)x * 3;
+        d[0] = d[1] = d[2] = src[x];
+    }
+}
+
+static void mp_row_gray_to_rgba(const u8* restrict src, u8* restrict dst, u32 count) {
+    u32 x = 0;
+#if defined(__SSE2__)
+    x = mp_row_gray_to_rgba_sse2(src, dst, count);
+#endif
+    for (; x < count; x++) {
+        u8* d = dst + (size_t)x * 4;
+        d[0] = d[1] = d[2] = src[x];
+        d[3] = 255;
+    }
+}
+
+static void mp_row_gray_to_graya(const u8* restrict src, u8* restrict dst, u32 count) {
+    for (u32 x = 0; x < count; x++) {
+        dst[x * 2] = src[x];
+        dst[x * 2 + 1] = 255;
+    }
+}
+
+static void mp_row_graya_to_gray(const u8* restrict src, u8* restrict dst, u32 count) {
+    for (u32 x = 0; x < count; x++) dst[x] = src[x * 2];
+}
+
+static void mp_row_graya_to_rgb(const u8* restrict src, u8* restrict dst, u32 count) {
+    for (u32 x = 0; x < count; x++) {
+        u8* d = dst + (size_t)x * 3;
+        d[0] = d[1] = d[2] = src[x * 2];
+    }
+}
+
+static void mp_row_graya_to_rgba(const u8* restrict src, u8* restrict dst, u32 count) {
+    for (u32 x = 0; x < count; x++) {
+        u8* d = dst + (size_t)x * 4;
+        d[0] = d[1] = d[2] = src[x * 2];
+        d[3] = src[x * 2 + 1];
+    }
+}
+
+static mp_bool mp_row_is_bgr(mp_color_format format) {
+    return format == MP_COLOR_FORMAT_BGR || format == MP_COLOR_FORMAT_BGRA;
+}
+
+mp_row_converter mp_row_converter_for(mp_color_format from, mp_color_format to) {
+    static const mp_row_converter copies[5] = { NULL, mp_row_copy1, mp_row_copy2, mp_row_copy3, mp_row_copy4 };
+    u32 from_bpp = mp_image_layout_bpp(from);
+    u32 to_bpp = mp_image_layout_bpp(to);
+    if (from_bpp == 0 || to_bpp == 0) return NULL;
+    if (from == to) return copies[from_bpp];
+    
+    /* 1 and 2 bytes per pixel are the gray formats / 1, 2바이트는 회색 포맷 */
+    if (to_bpp <= 2) {
+        if (from_bpp > 2) return NULL;
+        return from_bpp == 1 ? mp_row_gray_to_graya : mp_row_graya_to_gray;
+    }
+    if (from_bpp == 1) return to_bpp == 3 ? mp_row_gray_to_rgb : mp_row_gray_to_rgba;
+    if (from_bpp == 2) return to_bpp == 3 ? mp_row_graya_to_rgb : mp_row_graya_to_rgba;
+    
+    mp_bool swap = mp_row_is_bgr(from) != mp_row_is_bgr(to);
+    if (from_bpp == to_bpp) return from_bpp == 3 ? mp_row_swap24 : mp_row_swap32;
+    if (from_bpp == 3) return swap ? mp_row_rgb_to_bgra : mp_row_rgb_to_rgba;
+    return swap ? mp_row_rgba_to_bgr : mp_row_rgba_to_rgb;
+}
+
+void mp_row_expand_palette(const u8* indices, const u32 table[256], u8* dst, u32 count, u32 bpp) {
+    u32 x = 0;
+    /* Whole 4-byte entries while the spill stays inside the row; each spill is then
+     * overwritten by the following pixels / 넘치는 바이트가 행 안에 있는 동안 4바이트 단위로 기록 */
+    for (; (size_t)x * bpp + 4 <= (size_t)count * bpp; x++) {
+        memcpy(dst + (size_t)x * bpp, &table[indices[x]], 4);
+    }
+    for (; x < count; x++) {
+        memcpy(dst + (size_t)x * bpp, &table[indices[x]], bpp);
+    }
+}
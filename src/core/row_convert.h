@@ -0,0 +1,36 @@
+#ifndef MANYPICTURES_ROW_CONVERT_H
+#define MANYPICTURES_ROW_CONVERT_H
+
+#include "types.h"
+
+/* Specialized row converters between color formats / 색상 포맷 간 특화 행 변환기
+ *
+ * Loaders, savers and operations pick one converter per image with mp_row_converter_for
+ * and run it on whole rows, instead of switching on the format for every pixel through
+ * mp_image_get_pixel / mp_image_set_pixel. Channel swaps and alpha insertion or removal
+ * use SSE2/SSSE3 where available. Gray expands to equal color channels and a missing
+ * alpha becomes 255, matching the per-pixel accessors; color to gray is not a row
+ * conversion and has no converter.
+ * 포맷 분기를 픽셀마다 하지 않고 이미지마다 한 번 변환기를 골라 행 단위로 실행합니다.
+ */
+
+/* Convert `count` pixels; src and dst must not overlap unless both formats have the same
+ * bytes per pixel / `count` 픽셀 변환 (픽셀 크기가 같을 때만 제자리 변환 가능) */
+typedef void (*mp_row_converter)(const u8* src, u8* dst, u32 count);
+
+/* NULL when `from` cannot be converted to `to` row-wise / 행 단위 변환이 불가능하면 NULL */
+mp_row_converter mp_row_converter_for(mp_color_format from, mp_color_format to);
+
+/* Expand 8-bit palette indices through a 256-entry table whose entries hold the
+ * destination pixel's bytes in memory order (first byte lowest); `bpp` is 1 to 4
+ * / 256개 항목 테이블로 팔레트 인덱스 확장 (항목은 대상 픽셀 바이트를 메모리 순서로 보관) */
+void mp_row_expand_palette(const u8* indices, const u32 table[256], u8* dst, u32 count, u32 bpp);
+
+/* Table entry for mp_row_expand_palette from bytes in memory order
+ * / 메모리 순서 바이트로 팔레트 테이블 항목 생성 */
+static inline u32 mp_row_palette_entry(u8 b0, u8 b1, u8 b2, u8 b3) {
+    union { u8 bytes[4]; u32 value; } entry = { { b0, b1, b2, b3 } };
+    return entry.value;
+}
+
+#endif /* MANYPICTURES_ROW_CONVERT_H */
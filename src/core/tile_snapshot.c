@@ -0,0 +1,402 @@
+#include "tile_snapshot.h"
+#include "alloc.h"
+#include "image.h"
+#include "../codecs/lz.h"
+#include <string.h>
+
+/* Immutable tile: tightly packed rows of (w * bpp) bytes, optionally LZ-packed
+ * / 불변 타일: (w * bpp) 바이트 행의 밀집 배치, 선택적으로 LZ 압축 */
+struct mp_tile {
+    atomic_uint refs;
+    u32 w;
+    u32 h;
+    u32 packed_size;       /* 0 = raw pixels / 0이면 원본 픽셀 */
+    mp_bool incompressible; /* Compression already tried and rejected / 압축 시도 후 거부됨 */
+    u8* data;
+    /* Packed copy of a shared raw tile, published once and owned by this tile; snapshots
+     * that compress switch to it instead of rewriting the shared pixels
+     * / 공유 원본 타일의 압축 사본 (한 번만 게시, 이 타일이 소유) */
+    _Atomic(struct mp_tile*) packed;
+};
+
+static size_t mp_tile_raw_bytes(const mp_tile* tile, u32 bpp) {
+    return (size_t)tile->w * tile->h * bpp;
+}
+
+/* Raw pixels of a tile, unpacking into `scratch` if needed / 필요 시 `scratch`에 풀어 원본 픽셀 반환 */
+static const u8* mp_tile_pixels(const mp_tile* tile, u32 bpp, u8* scratch) {
+    if (!tile->packed_size) return tile->data;
+    if (mp_lz_decompress(tile->data, tile->packed_size, scratch, mp_tile_raw_bytes(tile, bpp)) != MP_SUCCESS) {
+        return NULL;
+    }
+    return scratch;
+}
+
+/* Tiles may be packed through any snapshot sharing them, so always scan / 공유 타일은 다른 스냅샷에서 압축될 수 있으므로 항상 검사 */
+static mp_bool mp_tile_snapshot_has_packed(const mp_tile_snapshot* snapshot) {
+    size_t count = (size_t)snapshot->tiles_x * snapshot->tiles_y;
+    for (size_t i = 0; i < count; i++) {
+        if (snapshot->tiles[i]->packed_size) return MP_TRUE;
+    }
+    return MP_FALSE;
+}
+
+static mp_tile* mp_tile_retain(mp_tile* tile) {
+    atomic_fetch_add_explicit(&tile->refs, 1, memory_order_relaxed);
+    return tile;
+}
+
+static void mp_tile_release(mp_tile* tile) {
+    if (tile && atomic_fetch_sub_explicit(&tile->refs, 1, memory_order_acq_rel) == 1) {
+        mp_tile_release(atomic_load_explicit(&tile->packed, memory_order_acquire));
+        mp_alloc_free(tile->data);
+        mp_alloc_free(tile);
+    }
+}
+
+/* Same pixels: one tile, or a raw tile and its packed copy / 동일 픽셀: 같은 타일이거나 원본과 압축 사본 */
+static mp_bool mp_tile_same(const mp_tile* a, const mp_tile* b) {
+    return a == b ||
+           atomic_load_explicit(&((mp_tile*)a)->packed, memory_order_acquire) == b ||
+           atomic_load_explicit(&((mp_tile*)b)->packed, memory_order_acquire) == a;
+}
+
+/* Does `tile` hold exactly the buffer region at (x0, y0)? / 타일이 버퍼 영역과 동일한지 비교 */
+static mp_bool mp_tile_matches(const mp_tile* tile, const mp_image_buffer* buffer, u32 x0, u32 y0,
+                               u8* scratch) {
+    size_t row_bytes = (size_t)tile->w * buffer->bpp;
+    const u8* t = mp_tile_pixels(tile, buffer->bpp, scratch);
+    if (!t) return MP_FALSE;
+    const u8* b = buffer->data + (size_t)y0 * buffer->stride + (size_t)x0 * buffer->bpp;
+    for (u32 y = 0; y < tile->h; y++) {
+        if (memcmp(t, b, row_bytes) != 0) return MP_FALSE;
+        t += row_bytes;
+        b += buffer->stride;
+    }
+    return MP_TRUE;
+}
+
+static mp_tile* mp_tile_copy_from(const mp_image_buffer* buffer, u32 x0, u32 y0, u32 w, u32 h) {
+    size_t row_bytes = (size_t)w * buffer->bpp;
+    mp_tile* tile = (mp_tile*)mp_alloc_zero(1, sizeof(mp_tile), MP_ALLOC_UNDO);
+    if (!tile) return NULL;
+    tile->data = (u8*)mp_alloc(row_bytes * h, MP_ALLOC_UNDO);
+    if (!tile->data) {
+        mp_alloc_free(tile);
+        return NULL;
+    }
+    
+    atomic_init(&tile->refs, 1);
+    atomic_init(&tile->packed, NULL);
+    tile->w = w;
+    tile->h = h;
+    
+    u8* t = tile->data;
+    const u8* b = buffer->data + (size_t)y0 * buffer->stride + (size_t)x0 * buffer->bpp;
+    for (u32 y = 0; y < h; y++) {
+        memcpy(t, b, row_bytes);
+        t += row_bytes;
+        b += buffer->stride;
+    }
+    return tile;
+}
+
+static mp_bool mp_tile_snapshot_same_geometry(const mp_tile_snapshot* a, const mp_image_buffer* b) {
+    return a && b && a->width == b->width && a->height == b->height && a->bpp == b->bpp && a->format == b->format;
+}
+
+mp_tile_snapshot* mp_tile_snapshot_capture(const mp_image_buffer* buffer, const mp_tile_snapshot* base) {
+    if (!buffer || !buffer->data) return NULL;
+    
+    mp_tile_snapshot* snapshot = (mp_tile_snapshot*)mp_alloc_zero(1, sizeof(mp_tile_snapshot), MP_ALLOC_UNDO);
+    if (!snapshot) return NULL;
+    
+    snapshot->width = buffer->width;
+    snapshot->height = buffer->height;
+    snapshot->bpp = buffer->bpp;
+    snapshot->format = buffer->format;
+    snapshot->tiles_x = (buffer->width + MP_TILE_SIZE - 1) / MP_TILE_SIZE;
+    snapshot->tiles_y = (buffer->height + MP_TILE_SIZE - 1) / MP_TILE_SIZE;
+    atomic_init(&snapshot->refs, 1);
+    
+    size_t count = (size_t)snapshot->tiles_x * snapshot->tiles_y;
+    snapshot->tiles = (mp_tile**)mp_alloc_zero(count ? count : 1, sizeof(mp_tile*), MP_ALLOC_UNDO);
+    if (!snapshot->tiles) {
+        mp_alloc_free(snapshot);
+        return NULL;
+    }
+    
+    if (!mp_tile_snapshot_same_geometry(base, buffer)) base = NULL;
+    
+    /* Unpack area for compressed base tiles / 압축된 기준 타일용 해제 영역 */
+    u8* scratch = NULL;
+    if (base && mp_tile_snapshot_has_packed(base)) {
+        scratch = (u8*)mp_alloc((size_t)MP_TILE_SIZE * MP_TILE_SIZE * buffer->bpp, MP_ALLOC_UNDO);
+        if (!scratch) base = NULL;
+    }
+    
+    for (u32 ty = 0; ty < snapshot->tiles_y; ty++) {
+        u32 y0 = ty * MP_TILE_SIZE;
+        u32 h = (buffer->height - y0 < MP_TILE_SIZE) ? buffer->height - y0 : MP_TILE_SIZE;
+        for (u32 tx = 0; tx < snapshot->tiles_x; tx++) {
+            u32 x0 = tx * MP_TILE_SIZE;
+            u32 w = (buffer->width - x0 < MP_TILE_SIZE) ? buffer->width - x0 : MP_TILE_SIZE;
+            size_t i = (size_t)ty * snapshot->tiles_x + tx;
+            
+            /* Share unchanged tiles instead of duplicating them / 변경되지 않은 타일은 복제 대신 공유 */
+            if (base && mp_tile_matches(base->tiles[i], buffer, x0, y0, scratch)) {
+                snapshot->tiles[i] = mp_tile_retain(base->tiles[i]);
+            } else {
+                snapshot->tiles[i] = mp_tile_copy_from(buffer, x0, y0, w, h);
+                if (!snapshot->tiles[i]) {
+                    mp_alloc_free(scratch);
+                    mp_tile_snapshot_release(snapshot);
+                    return NULL;
+                }
+            }
+        }
+    }
+    
+    mp_alloc_free(scratch);
+    return snapshot;
+}
+
+mp_tile_snapshot* mp_tile_snapshot_retain(mp_tile_snapshot* snapshot) {
+    if (snapshot) atomic_fetch_add_explicit(&snapshot->refs, 1, memory_order_relaxed);
+    return snapshot;
+}
+
+void mp_tile_snapshot_release(mp_tile_snapshot* snapshot) {
+    if (!snapshot) return;
+    if (atomic_fetch_sub_explicit(&snapshot->refs, 1, memory_order_acq_rel) != 1) return;
+    
+    size_t count = (size_t)snapshot->tiles_x * snapshot->tiles_y;
+    for (size_t i = 0; i < count; i++) {
+        mp_tile_release(snapshot->tiles[i]);
+    }
+    mp_alloc_free(snapshot->tiles);
+    mp_alloc_free(snapshot);
+}
+
+mp_result mp_tile_snapshot_restore(const mp_tile_snapshot* snapshot, mp_image_buffer** buffer,
+                                   const mp_tile_snapshot* current) {
+    if (!snapshot || !buffer) return MP_ERROR_INVALID_PARAM;
+    
+    mp_image_buffer* target = *buffer;
+    if (!target || target->width != snapshot->width || target->height != snapshot->height ||
+        target->format != snapshot->format) {
+        /* Geometry changed (rotate, crop, resize): every tile must be written / 형상 변경 시 전체 타일 기록 */
+        mp_image_buffer* fresh = mp_image_buffer_create(snapshot->width, snapshot->height, snapshot->format);
+        if (!fresh) return MP_ERROR_MEMORY;
+        if (target) mp_image_buffer_destroy(target);
+        target = fresh;
+        *buffer = fresh;
+        current = NULL;
+    }
+    
+    if (current && (current->tiles_x != snapshot->tiles_x || current->tiles_y != snapshot->tiles_y)) {
+        current = NULL;
+    }
+    
+    u8* scratch = NULL;
+    if (mp_tile_snapshot_has_packed(snapshot)) {
+        scratch = (u8*)mp_alloc((size_t)MP_TILE_SIZE * MP_TILE_SIZE * snapshot->bpp, MP_ALLOC_UNDO);
+        if (!scratch) return MP_ERROR_MEMORY;
+    }
+    
+    for (u32 ty = 0; ty < snapshot->tiles_y; ty++) {
+        for (u32 tx = 0; tx < snapshot->tiles_x; tx++) {
+            size_t i = (size_t)ty * snapshot->tiles_x + tx;
+            const mp_tile* tile = snapshot->tiles[i];
+            
+            /* Shared tile (or its packed copy) means identical pixels: nothing to write
+             * / 공유 타일 또는 그 압축 사본이면 동일 픽셀 */
+            if (current && mp_tile_same(current->tiles[i], tile)) continue;
+            
+            size_t row_bytes = (size_t)tile->w * target->bpp;
+            const u8* t = mp_tile_pixels(tile, snapshot->bpp, scratch);
+            if (!t) {
+                mp_alloc_free(scratch);
+                return MP_ERROR_CORRUPTED;
+            }
+            u8* b = target->data + (size_t)ty * MP_TILE_SIZE * target->stride + (size_t)tx * MP_TILE_SIZE * target->bpp;
+            for (u32 y = 0; y < tile->h; y++) {
+                memcpy(b, t, row_bytes);
+                t += row_bytes;
+                b += target->stride;
+            }
+        }
+    }
+    
+    mp_alloc_free(scratch);
+    return MP_SUCCESS;
+}
+
+size_t mp_tile_snapshot_unique_bytes(const mp_tile_snapshot* snapshot, const mp_tile_snapshot* other) {
+    if (!snapshot) return 0;
+    
+    mp_bool comparable = other && other->tiles_x == snapshot->tiles_x && other->tiles_y == snapshot->tiles_y;
+    size_t count = (size_t)snapshot->tiles_x * snapshot->tiles_y;
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        const mp_tile* tile = snapshot->tiles[i];
+        if (comparable && mp_tile_same(other->tiles[i], tile)) continue;
+        bytes += sizeof(mp_tile) + (tile->packed_size ? tile->packed_size : mp_tile_raw_bytes(tile, snapshot->bpp));
+    }
+    return bytes;
+}
+
+/* Whole image of the larger geometry / 더 큰 형상의 전체 이미지 */
+static void mp_tile_bounds_whole(u32 width_a, u32 height_a, u32 width_b, u32 height_b, mp_pixel_rect* bounds) {
+    bounds->x = bounds->y = 0;
+    bounds->width = width_a > width_b ? width_a : width_b;
+    bounds->height = height_a > height_b ? height_a : height_b;
+}
+
+/* Pixel bounds of the tile range [min, max], clipped to the image; MP_FALSE when empty
+ * / 타일 범위의 픽셀 경계 (이미지로 자름, 비어 있으면 MP_FALSE) */
+static mp_bool mp_tile_bounds_from(const mp_tile_snapshot* snapshot, u32 min_x, u32 min_y, u32 max_x, u32 max_y,
+                                   mp_pixel_rect* bounds) {
+    if (min_x > max_x || min_y > max_y) return MP_FALSE;
+    
+    bounds->x = min_x * MP_TILE_SIZE;
+    bounds->y = min_y * MP_TILE_SIZE;
+    u32 right = (max_x + 1) * MP_TILE_SIZE;
+    u32 bottom = (max_y + 1) * MP_TILE_SIZE;
+    bounds->width = (right < snapshot->width ? right : snapshot->width) - bounds->x;
+    bounds->height = (bottom < snapshot->height ? bottom : snapshot->height) - bounds->y;
+    return MP_TRUE;
+}
+
+mp_bool mp_tile_snapshot_diff_bounds(const mp_tile_snapshot* a, const mp_tile_snapshot* b, mp_pixel_rect* bounds) {
+    if (!a || !b || !bounds) return MP_FALSE;
+    
+    if (a->width != b->width || a->height != b->height || a->bpp != b->bpp) {
+        mp_tile_bounds_whole(a->width, a->height, b->width, b->height, bounds);
+        return MP_TRUE;
+    }
+    
+    u32 min_x = a->tiles_x, min_y = a->tiles_y, max_x = 0, max_y = 0;
+    for (u32 ty = 0; ty < a->tiles_y; ty++) {
+        for (u32 tx = 0; tx < a->tiles_x; tx++) {
+            size_t i = (size_t)ty * a->tiles_x + tx;
+            if (mp_tile_same(a->tiles[i], b->tiles[i])) continue;
+            if (tx < min_x) min_x = tx;
+            if (ty < min_y) min_y = ty;
+            if (tx > max_x) max_x = tx;
+            if (ty > max_y) max_y = ty;
+        }
+    }
+    return mp_tile_bounds_from(a, min_x, min_y, max_x, max_y, bounds);
+}
+
+mp_bool mp_tile_snapshot_diff_buffer_bounds(const mp_tile_snapshot* snapshot, const mp_image_buffer* buffer,
+                                            mp_pixel_rect* bounds) {
+    if (!snapshot || !buffer || !buffer->data || !bounds) return MP_FALSE;
+    
+    if (!mp_tile_snapshot_same_geometry(snapshot, buffer)) {
+        mp_tile_bounds_whole(snapshot->width, snapshot->height, buffer->width, buffer->height, bounds);
+        return MP_TRUE;
+    }
+    
+    u8* scratch = NULL;
+    if (mp_tile_snapshot_has_packed(snapshot)) {
+        scratch = (u8*)mp_alloc((size_t)MP_TILE_SIZE * MP_TILE_SIZE * snapshot->bpp, MP_ALLOC_UNDO);
+        if (!scratch) {
+            mp_tile_bounds_whole(snapshot->width, snapshot->height, buffer->width, buffer->height, bounds);
+            return MP_TRUE;
+        }
+    }
+    
+    /* A changed tile usually differs in its first row, so the scan stays cheap for operations
+     * that rewrite everything / 변경된 타일은 대개 첫 행에서 달라 전체 변경 연산도 검사 비용이 작음 */
+    u32 min_x = snapshot->tiles_x, min_y = snapshot->tiles_y, max_x = 0, max_y = 0;
+    for (u32 ty = 0; ty < snapshot->tiles_y; ty++) {
+        for (u32 tx = 0; tx < snapshot->tiles_x; tx++) {
+            size_t i = (size_t)ty * snapshot->tiles_x + tx;
+            if (mp_tile_matches(snapshot->tiles[i], buffer, tx * MP_TILE_SIZE, ty * MP_TILE_SIZE, scratch)) continue;
+            if (tx < min_x) min_x = tx;
+            if (ty < min_y) min_y = ty;
+            if (tx > max_x) max_x = tx;
+            if (ty > max_y) max_y = ty;
+        }
+    }
+    mp_alloc_free(scratch);
+    return mp_tile_bounds_from(snapshot, min_x, min_y, max_x, max_y, bounds);
+}
+
+size_t mp_tile_snapshot_compress(mp_tile_snapshot* snapshot) {
+    if (!snapshot) return 0;
+    
+    size_t count = (size_t)snapshot->tiles_x * snapshot->tiles_y;
+    size_t raw_max = (size_t)MP_TILE_SIZE * MP_TILE_SIZE * snapshot->bpp;
+    u8* packed = (u8*)mp_alloc(mp_lz_bound(raw_max), MP_ALLOC_UNDO);
+    if (!packed) return 0;
+    
+    size_t saved = 0;
+    for (size_t i = 0; i < count; i++) {
+        mp_tile* tile = snapshot->tiles[i];
+        if (tile->packed_size) continue;
+        
+        /* Another snapshot already packed this shared tile: take its copy
+         * / 다른 스냅샷이 이미 압축한 공유 타일이면 그 사본 사용 */
+        mp_tile* twin = atomic_load_explicit(&tile->packed, memory_order_acquire);
+        if (twin) {
+            snapshot->tiles[i] = mp_tile_retain(twin);
+            mp_tile_release(tile);
+            continue;
+        }
+        
+        /* Other snapshots may read a shared tile's pixels concurrently, so only an unshared
+         * tile is rewritten in place / 공유 타일은 동시에 읽힐 수 있으므로 공유되지 않은 타일만 제자리 압축 */
+        mp_bool shared = atomic_load_explicit(&tile->refs, memory_order_acquire) > 1;
+        if (!shared && tile->incompressible) continue;
+        
+        size_t raw = mp_tile_raw_bytes(tile, snapshot->bpp);
+        /* Only keep the packed form when it saves at least 1/8 / 1/8 이상 절약될 때만 압축 유지 */
+        size_t size = mp_lz_compress(tile->data, raw, packed, raw - raw / 8);
+        if (!size) {
+            if (!shared) tile->incompressible = MP_TRUE;
+            continue;
+        }
+        
+        u8* data = (u8*)mp_alloc(size, MP_ALLOC_UNDO);
+        if (!data) break;
+        memcpy(data, packed, size);
+        
+        if (!shared) {
+            mp_alloc_free(tile->data);
+            tile->data = data;
+            tile->packed_size = (u32)size;
+            saved += raw - size;
+            continue;
+        }
+        
+        /* Copy on write: publish a packed twin (one reference for the raw tile, one for this
+         * snapshot); if another thread published first, use theirs
+         * / Copy-on-Write: 압축 사본을 게시 (원본 타일용 참조 1, 이 스냅샷용 참조 1) */
+        mp_tile* copy = (mp_tile*)mp_alloc_zero(1, sizeof(mp_tile), MP_ALLOC_UNDO);
+        if (!copy) {
+            mp_alloc_free(data);
+            break;
+        }
+        atomic_init(&copy->refs, 2);
+        atomic_init(&copy->packed, NULL);
+        copy->w = tile->w;
+        copy->h = tile->h;
+        copy->data = data;
+        copy->packed_size = (u32)size;
+        mp_tile* expected = NULL;
+        if (!atomic_compare_exchange_strong_explicit(&tile->packed, &expected, copy,
+                                                     memory_order_acq_rel, memory_order_acquire)) {
+            mp_alloc_free(copy->data);
+            mp_alloc_free(copy);
+            copy = mp_tile_retain(expected);
+        }
+        snapshot->tiles[i] = copy;
+        mp_tile_release(tile);
+    }
+    
+    mp_alloc_free(packed);
+    return saved;
+}
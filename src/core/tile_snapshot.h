@@ -0,0 +1,75 @@
+#ifndef MANYPICTURES_TILE_SNAPSHOT_H
+#define MANYPICTURES_TILE_SNAPSHOT_H
+
+#include "types.h"
+#include <stdatomic.h>
+
+/* Copy-on-write, reference-counted tile snapshots of image buffers
+ * / 이미지 버퍼의 참조 카운트 기반 Copy-on-Write 타일 스냅샷
+ *
+ * A snapshot splits a buffer into MP_TILE_SIZE x MP_TILE_SIZE tiles. Tiles are immutable
+ * once captured and shared between snapshots through atomic reference counts, so a
+ * snapshot taken after an operation only owns the tiles that operation changed.
+ * 캡처된 타일은 불변이며 원자적 참조 카운트로 공유되므로, 연산 후 스냅샷은 변경된 타일만 소유합니다.
+ */
+
+#define MP_TILE_SIZE 64
+
+typedef struct mp_tile mp_tile;
+
+/* Rectangle in image pixels / 이미지 픽셀 단위 사각형 */
+typedef struct {
+    u32 x;
+    u32 y;
+    u32 width;
+    u32 height;
+} mp_pixel_rect;
+
+typedef struct mp_tile_snapshot {
+    u32 width;
+    u32 height;
+    u32 bpp;
+    mp_color_format format;
+    u32 tiles_x;
+    u32 tiles_y;
+    mp_tile** tiles;      /* tiles_x * tiles_y shared tiles / 공유 타일 배열 */
+    atomic_uint refs;     /* Snapshot reference count / 스냅샷 참조 카운트 */
+} mp_tile_snapshot;
+
+/* Capture a buffer, sharing every tile that is byte-identical in `base` (may be NULL)
+ * / 버퍼 캡처: `base`와 동일한 타일은 공유 (base는 NULL 가능) */
+mp_tile_snapshot* mp_tile_snapshot_capture(const mp_image_buffer* buffer, const mp_tile_snapshot* base);
+
+/* Reference counting / 참조 카운팅 */
+mp_tile_snapshot* mp_tile_snapshot_retain(mp_tile_snapshot* snapshot);
+void mp_tile_snapshot_release(mp_tile_snapshot* snapshot);
+
+/* Write a snapshot back into *buffer. When `current` describes the buffer's present
+ * contents, tiles shared with it are skipped. Reallocates on size change.
+ * / 스냅샷을 버퍼에 복원 (`current`와 공유하는 타일은 건너뜀, 크기 변경 시 재할당) */
+mp_result mp_tile_snapshot_restore(const mp_tile_snapshot* snapshot, mp_image_buffer** buffer,
+                                   const mp_tile_snapshot* current);
+
+/* Bytes held by tiles not shared with `other` (may be NULL) / `other`와 공유하지 않는 타일 바이트 */
+size_t mp_tile_snapshot_unique_bytes(const mp_tile_snapshot* snapshot, const mp_tile_snapshot* other);
+
+/* Bounding box of the tiles not shared between two snapshots; the whole image when their
+ * geometry differs. MP_FALSE when nothing differs.
+ * / 두 스냅샷이 공유하지 않는 타일의 경계 상자 (크기가 다르면 전체, 차이가 없으면 MP_FALSE) */
+mp_bool mp_tile_snapshot_diff_bounds(const mp_tile_snapshot* a, const mp_tile_snapshot* b, mp_pixel_rect* bounds);
+
+/* Bounding box of the tiles whose pixels differ from `buffer`, without copying anything; the
+ * whole image when the geometry differs. MP_FALSE when nothing differs.
+ * / `buffer`와 픽셀이 다른 타일의 경계 상자 (복사 없음, 형상이 다르면 전체, 차이가 없으면 MP_FALSE) */
+mp_bool mp_tile_snapshot_diff_buffer_bounds(const mp_tile_snapshot* snapshot, const mp_image_buffer* buffer,
+                                            mp_pixel_rect* bounds);
+
+/* LZ-pack every raw tile that shrinks by at least 1/8; returns bytes saved in place. Packed
+ * tiles are unpacked transparently by capture and restore. Tiles stay immutable: an unshared
+ * tile is packed in place, while a shared one is replaced in this snapshot by a packed copy
+ * that is attached to the raw tile and reused by every other sharer that compresses.
+ * / 1/8 이상 줄어드는 타일을 LZ 압축. 공유되지 않은 타일은 제자리 압축, 공유 타일은 원본에 붙은
+ * 압축 사본으로 교체되어 다른 공유자도 재사용합니다 (타일은 불변 유지). */
+size_t mp_tile_snapshot_compress(mp_tile_snapshot* snapshot);
+
+#endif /* MANYPICTURES_TILE_SNAPSHOT_H */
@@ -0,0 +1,192 @@
+#define _POSIX_C_SOURCE 200809L
+#include "trace.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MP_TRACE_RING_MASK (MP_TRACE_RING_EVENTS - 1)
+
+_Static_assert((MP_TRACE_RING_EVENTS & MP_TRACE_RING_MASK) == 0, "trace ring size must be a power of two");
+
+typedef struct {
+    const char* name;
+    u64 start;
+    u64 end;
+} mp_trace_event;
+
+typedef struct mp_trace_ring {
+    /* Events recorded since the last start; the owner publishes each event with a release
+     * store / 마지막 시작 이후 기록 수 (소유자가 release 저장으로 공개) */
+    atomic_ullong written;
+    u32 lane;                          /* Chrome tid / Chrome 스레드 번호 */
+    mp_bool main_thread;
+    struct mp_trace_ring* next;        /* Every ring / 전체 링 목록 */
+    struct mp_trace_ring* next_free;   /* Rings of exited threads / 종료된 스레드의 링 */
+    mp_trace_event events[MP_TRACE_RING_EVENTS];
+} mp_trace_ring;
+
+atomic_int g_mp_trace_active;
+
+static _Thread_local mp_trace_ring* t_mp_trace_ring;
+
+static pthread_once_t g_mp_trace_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_mp_trace_key;
+static pthread_mutex_t g_mp_trace_lock = PTHREAD_MUTEX_INITIALIZER;   /* Ring lists / 링 목록 */
+static mp_trace_ring* g_mp_trace_rings;
+static mp_trace_ring* g_mp_trace_free;
+static u32 g_mp_trace_lanes;
+static atomic_ullong g_mp_trace_lost;   /* Events without a ring / 링이 없어 잃은 이벤트 */
+
+/* Tick and clock reading taken at start, for converting ticks to microseconds
+ * / 틱을 마이크로초로 바꾸기 위한 시작 시점의 틱과 시계 값 */
+static u64 g_mp_trace_tick0;
+static u64 g_mp_trace_ns0;
+
+static u64 mp_trace_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+/* pthread key destructor: the ring outlives its thread and goes to the next new one
+ * / 스레드 종료 시 링을 보존하고 다음 새 스레드가 재사용 */
+static void mp_trace_thread_exit(void* arg) {
+    mp_trace_ring* ring = (mp_trace_ring*)arg;
+    pthread_mutex_lock(&g_mp_trace_lock);
+    ring->next_free = g_mp_trace_free;
+    g_mp_trace_free = ring;
+    pthread_mutex_unlock(&g_mp_trace_lock);
+    t_mp_trace_ring = NULL;
+}
+
+static void mp_trace_init(void) {
+    pthread_key_create(&g_mp_trace_key, mp_trace_thread_exit);
+}
+
+/* Rings are plain calloc memory so they never show up in allocator statistics
+ * / 할당기 통계에 잡히지 않도록 링은 calloc으로 할당 */
+static mp_trace_ring* mp_trace_thread_ring(void) {
+    if (t_mp_trace_ring) return t_mp_trace_ring;
+    pthread_once(&g_mp_trace_once, mp_trace_init);
+    
+    pthread_mutex_lock(&g_mp_trace_lock);
+    mp_trace_ring* ring = g_mp_trace_free;
+    if (ring) {
+        g_mp_trace_free = ring->next_free;
+    } else {
+        ring = (mp_trace_ring*)calloc(1, sizeof(mp_trace_ring));
+        if (ring) {
+            ring->lane = ++g_mp_trace_lanes;
+            ring->next = g_mp_trace_rings;
+            g_mp_trace_rings = ring;
+        }
+    }
+    pthread_mutex_unlock(&g_mp_trace_lock);
+    
+    if (ring) {
+        ring->next_free = NULL;
+        pthread_setspecific(g_mp_trace_key, ring);
+        t_mp_trace_ring = ring;
+    }
+    return ring;
+}
+
+void mp_trace_record(const char* name, u64 start, u64 end) {
+    mp_trace_ring* ring = mp_trace_thread_ring();
+    if (!ring) {
+        atomic_fetch_add_explicit(&g_mp_trace_lost, 1, memory_order_relaxed);
+        return;
+    }
+    u64 index = atomic_load_explicit(&ring->written, memory_order_relaxed);
+    mp_trace_event* event = &ring->events[index & MP_TRACE_RING_MASK];
+    event->name = name;
+    event->start = start;
+    event->end = end;
+    atomic_store_explicit(&ring->written, index + 1, memory_order_release);
+}
+
+mp_result mp_trace_start(void) {
+    mp_trace_ring* self = mp_trace_thread_ring();
+    if (!self) return MP_ERROR_MEMORY;
+    
+    pthread_mutex_lock(&g_mp_trace_lock);
+    for (mp_trace_ring* ring = g_mp_trace_rings; ring; ring = ring->next) {
+        atomic_store_explicit(&ring->written, 0, memory_order_relaxed);
+        ring->main_thread = ring == self;
+    }
+    pthread_mutex_unlock(&g_mp_trace_lock);
+    atomic_store_explicit(&g_mp_trace_lost, 0, memory_order_relaxed);
+    
+    g_mp_trace_ns0 = mp_trace_clock_ns();
+    g_mp_trace_tick0 = mp_trace_now();
+    atomic_store_explicit(&g_mp_trace_active, 1, memory_order_relaxed);
+    return MP_SUCCESS;
+}
+
+void mp_trace_stop(void) {
+    atomic_store_explicit(&g_mp_trace_active, 0, memory_order_relaxed);
+}
+
+static void mp_trace_write_name(FILE* file, const char* name) {
+    for (; *name; name++) {
+        if (*name == '"' || *name == '\\') fputc('\\', file);
+        if ((unsigned char)*name >= 0x20) fputc(*name, file);
+    }
+}
+
+mp_result mp_trace_write(const char* path) {
+    if (!path) return MP_ERROR_INVALID_PARAM;
+    
+    /* Ticks per microsecond over the whole recording; a short one is stretched so the TSC
+     * rate is measured over at least a millisecond
+     * / 전체 기록 구간으로 마이크로초당 틱 계산 (최소 1ms 구간으로 측정) */
+    u64 ns = mp_trace_clock_ns();
+    if (ns - g_mp_trace_ns0 < 1000000) {
+        struct timespec pause = { 0, (long)(1000000 - (ns - g_mp_trace_ns0)) };
+        nanosleep(&pause, NULL);
+        ns = mp_trace_clock_ns();
+    }
+    u64 ticks = mp_trace_now() - g_mp_trace_tick0;
+    double ticks_per_us = (double)ticks * 1000.0 / (double)(ns - g_mp_trace_ns0);
+    if (ticks_per_us <= 0.0) ticks_per_us = 1000.0;
+    
+    FILE* file = fopen(path, "w");
+    if (!file) return MP_ERROR_IO;
+    
+    u64 dropped = atomic_load_explicit(&g_mp_trace_lost, memory_order_relaxed);
+    mp_bool first = MP_TRUE;
+    fputs("{\"traceEvents\":[\n", file);
+    
+    pthread_mutex_lock(&g_mp_trace_lock);
+    for (mp_trace_ring* ring = g_mp_trace_rings; ring; ring = ring->next) {
+        u64 written = atomic_load_explicit(&ring->written, memory_order_acquire);
+        if (!written && !ring->main_thread) continue;
+        u64 begin = written > MP_TRACE_RING_EVENTS ? written - MP_TRACE_RING_EVENTS : 0;
+        dropped += begin;
+        
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+                first ? "" : ",\n", ring->lane);
+        if (ring->main_thread) fputs("main", file);
+        else fprintf(file, "worker %u", ring->lane);
+        fputs("\"}}", file);
+        first = MP_FALSE;
+        
+        for (u64 i = begin; i < written; i++) {
+            const mp_trace_event* event = &ring->events[i & MP_TRACE_RING_MASK];
+            if (event->start < g_mp_trace_tick0 || event->end < event->start) continue;
+            double ts = (double)(event->start - g_mp_trace_tick0) / ticks_per_us;
+            double dur = (double)(event->end - event->start) / ticks_per_us;
+            fputs(",\n{\"name\":\"", file);
+            mp_trace_write_name(file, event->name);
+            fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", ring->lane, ts, dur);
+        }
+    }
+    pthread_mutex_unlock(&g_mp_trace_lock);
+    
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":%llu}}\n",
+            (unsigned long long)dropped);
+    mp_bool ok = !ferror(file);
+    if (fclose(file) != 0) ok = MP_FALSE;
+    return ok ? MP_SUCCESS : MP_ERROR_IO;
+}
@@ -0,0 +1,82 @@
+#ifndef MANYPICTURES_TRACE_H
+#define MANYPICTURES_TRACE_H
+
+#include "types.h"
+#include <stdatomic.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/* Hot-path tracing / 핫 패스 추적
+ *
+ * Scoped timers around decoder stages, operations and rendering record complete events
+ * into a ring buffer owned by the recording thread, so recording shares no cache line and
+ * takes no lock. mp_trace_write exports everything as Chrome trace-event JSON, which
+ * chrome://tracing and Perfetto open directly. Recording is off until mp_trace_start; a
+ * scope then costs one relaxed load and a branch. Building with -DMP_NO_TRACE removes the
+ * scopes entirely. Each ring keeps its latest MP_TRACE_RING_EVENTS events; rings of exited
+ * threads are reused by new ones, so short-lived workers share a few lanes.
+ * 디코더 단계, 연산, 렌더링 주변의 범위 타이머가 스레드별 링 버퍼에 이벤트를 기록하고
+ * Chrome trace-event JSON으로 내보냅니다. 비활성 시 분기 하나, -DMP_NO_TRACE 빌드 시 비용 없음.
+ */
+
+#define MP_TRACE_RING_EVENTS 8192   /* Events kept per thread / 스레드별 보관 이벤트 수 */
+
+extern atomic_int g_mp_trace_active;
+
+/* Timestamp in ticks: TSC on x86, monotonic nanoseconds elsewhere / 틱 단위 시각 */
+static inline u64 mp_trace_now(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return (u64)__rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+#endif
+}
+
+/* Start tick when recording, 0 otherwise / 기록 중이면 시작 틱, 아니면 0 */
+static inline u64 mp_trace_begin(void) {
+    return atomic_load_explicit(&g_mp_trace_active, memory_order_relaxed) ? mp_trace_now() : 0;
+}
+
+/* `name` must outlive the trace, normally a string literal / `name`은 보통 문자열 리터럴 */
+void mp_trace_record(const char* name, u64 start, u64 end);
+
+/* Clear earlier events and start recording / 이전 이벤트를 지우고 기록 시작 */
+mp_result mp_trace_start(void);
+void mp_trace_stop(void);
+
+/* Write the recorded events as Chrome trace-event JSON; call once recording threads are
+ * idle / 기록 스레드가 쉬는 동안 Chrome trace-event JSON으로 저장 */
+mp_result mp_trace_write(const char* path);
+
+typedef struct {
+    const char* name;
+    u64 start;
+} mp_trace_scope;
+
+static inline void mp_trace_scope_end(mp_trace_scope* scope) {
+    if (scope->start) mp_trace_record(scope->name, scope->start, mp_trace_now());
+}
+
+#define MP_TRACE_CONCAT_(a, b) a##b
+#define MP_TRACE_CONCAT(a, b) MP_TRACE_CONCAT_(a, b)
+
+#ifndef MP_NO_TRACE
+/* Time the rest of the enclosing block / 둘러싼 블록의 나머지 구간 측정 */
+#define MP_TRACE_SCOPE(name) \
+    mp_trace_scope MP_TRACE_CONCAT(mp_trace_scope_, __LINE__) \
+        __attribute__((cleanup(mp_trace_scope_end))) = { (name), mp_trace_begin() }
+/* Time a stage between two points of one block / 한 블록 안 두 지점 사이 구간 측정 */
+#define MP_TRACE_BEGIN(var) u64 var = mp_trace_begin()
+#define MP_TRACE_END(var, name) \
+    do { if (var) mp_trace_record((name), (var), mp_trace_now()); } while (0)
+#else
+#define MP_TRACE_SCOPE(name) ((void)0)
+#define MP_TRACE_BEGIN(var) ((void)0)
+#define MP_TRACE_END(var, name) ((void)0)
+#endif
+
+#endif /* MANYPICTURES_TRACE_H */
@@ -248,6 +248,98 @@ mp_exif_data* mp_exif_read_buffer(const u8* data, size_t size) {
     return exif;
 }
 
+/* Embedded thumbnail (IFD1 JPEGInterchangeFormat) / 내장 썸네일 (IFD1 JPEGInterchangeFormat)
+ * Every offset comes from the file, so each one is checked against the segment size.
+ * 모든 오프셋은 파일에서 읽은 값이므로 세그먼트 크기와 대조해 검사합니다. */
+static mp_bool mp_exif_find_thumbnail(const u8* data, size_t size, size_t* out_offset, size_t* out_length) {
+    if (size < 14 || memcmp(data, "Exif\0\0", 6) != 0) return MP_FALSE;
+    
+    const u8* tiff_base = data + 6;
+    size_t tiff_size = size - 6;
+    u16 byte_order = (tiff_base[0] << 8) | tiff_base[1];
+    if (byte_order != MP_TIFF_II && byte_order != MP_TIFF_MM) return MP_FALSE;
+    mp_bool be = (byte_order == MP_TIFF_MM);
+    if (mp_read_u16_exif(tiff_base + 2, be) != 42) return MP_FALSE;
+    
+    /* IFD0, then the "next IFD" link to IFD1 / IFD0 다음 링크가 IFD1 */
+    u32 ifd0 = mp_read_u32_exif(tiff_base + 4, be);
+    if ((size_t)ifd0 + 2 > tiff_size) return MP_FALSE;
+    u16 ifd0_entries = mp_read_u16_exif(tiff_base + ifd0, be);
+    size_t link = (size_t)ifd0 + 2 + (size_t)ifd0_entries * 12;
+    if (link + 4 > tiff_size) return MP_FALSE;
+    u32 ifd1 = mp_read_u32_exif(tiff_base + link, be);
+    if (ifd1 == 0 || (size_t)ifd1 + 2 > tiff_size) return MP_FALSE;
+    
+    u16 entries = mp_read_u16_exif(tiff_base + ifd1, be);
+    if ((size_t)ifd1 + 2 + (size_t)entries * 12 > tiff_size) return MP_FALSE;
+    u32 offset = 0, length = 0;
+    for (u16 i = 0; i < entries; i++) {
+        const u8* entry = tiff_base + ifd1 + 2 + (size_t)i * 12;
+        u16 tag = mp_read_u16_exif(entry, be);
+        if (tag == EXIF_TAG_THUMBNAIL_OFFSET) offset = mp_read_u32_exif(entry + 8, be);
+        else if (tag == EXIF_TAG_THUMBNAIL_LENGTH) length = mp_read_u32_exif(entry + 8, be);
+    }
+    if (length < 4 || (size_t)offset + length > tiff_size) return MP_FALSE;
+    if (tiff_base[offset] != 0xFF || tiff_base[offset + 1] != 0xD8) return MP_FALSE;
+    
+    *out_offset = 6 + (size_t)offset;
+    *out_length = length;
+    return MP_TRUE;
+}
+
+mp_result mp_exif_read_thumbnail(const char* filepath, u8** out_data, size_t* out_size) {
+    if (!filepath || !out_data || !out_size) return MP_ERROR_INVALID_PARAM;
+    
+    FILE* file = fopen(filepath, "rb");
+    if (!file) return MP_ERROR_FILE_NOT_FOUND;
+    
+    u8 soi[2];
+    if (fread(soi, 1, 2, file) != 2 || soi[0] != 0xFF || soi[1] != 0xD8) {
+        fclose(file);
+        return MP_ERROR_UNSUPPORTED;
+    }
+    
+    /* The EXIF APP1 precedes the scan; XMP may also use APP1 / EXIF APP1은 스캔 앞에 위치 (XMP도 APP1 사용) */
+    mp_result result = MP_ERROR_UNSUPPORTED;
+    u8 marker[4];
+    while (fread(marker, 1, 4, file) == 4 && marker[0] == 0xFF && marker[1] != 0xDA) {
+        u16 size = (marker[2] << 8) | marker[3];
+        if (size < 2) break;
+        if (marker[1] != 0xE1) {
+            if (fseek(file, size - 2, SEEK_CUR) != 0) break;
+            continue;
+        }
+        
+        u8* segment = (u8*)mp_malloc(size - 2);
+        if (!segment) {
+            result = MP_ERROR_MEMORY;
+            break;
+        }
+        if (fread(segment, 1, size - 2, file) != (size_t)(size - 2)) {
+            mp_free(segment);
+            break;
+        }
+        
+        size_t offset, length;
+        if (mp_exif_find_thumbnail(segment, size - 2, &offset, &length)) {
+            *out_data = (u8*)mp_malloc(length);
+            if (*out_data) {
+                memcpy(*out_data, segment + offset, length);
+                *out_size = length;
+                result = MP_SUCCESS;
+            } else {
+                result = MP_ERROR_MEMORY;
+            }
+            mp_free(segment);
+            break;
+        }
+        mp_free(segment);
+    }
+    
+    fclose(file);
+    return result;
+}
+
 mp_result mp_exif_write_buffer(const mp_exif_data* exif, u8** out_data, size_t* out_size) {
     if (!exif || !out_data) return MP_ERROR_INVALID_PARAM;
     
@@ -14,6 +14,8 @@
 #define EXIF_TAG_SOFTWARE 0x0131
 #define EXIF_TAG_DATETIME 0x0132
 #define EXIF_TAG_EXIF_OFFSET 0x8769
+#define EXIF_TAG_THUMBNAIL_OFFSET 0x0201 /* IFD1 JPEGInterchangeFormat */
+#define EXIF_TAG_THUMBNAIL_LENGTH 0x0202 /* IFD1 JPEGInterchangeFormatLength */
 
 /* Custom Many Pictures tags (using maker note area) */
 #define EXIF_TAG_MP_HISTORY 0x9000
@@ -29,6 +31,10 @@ mp_result mp_exif_write_jpeg(const char* filepath, const mp_exif_data* exif);
 /* Read EXIF from buffer */
 mp_exif_data* mp_exif_read_buffer(const u8* data, size_t size);
 
+/* Copy the JPEG thumbnail embedded in a JPEG's EXIF block; free with mp_free.
+ * MP_ERROR_UNSUPPORTED when the file has none. / JPEG EXIF에 내장된 썸네일 복사 (없으면 MP_ERROR_UNSUPPORTED) */
+mp_result mp_exif_read_thumbnail(const char* filepath, u8** out_data, size_t* out_size);
+
 /* Write EXIF to buffer */
 mp_result mp_exif_write_buffer(const mp_exif_data* exif, u8** out_data, size_t* out_size);
 
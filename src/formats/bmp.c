@@ -1,6 +1,9 @@
 #include "../core/types.h"
 #include "../core/memory.h"
 #include "../core/image.h"
+#include "../core/image_layout.h"
+#include "../core/row_convert.h"
+#include "../core/trace.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -36,6 +39,7 @@ typedef struct {
 #define BMP_BI_BITFIELDS 3
 
 mp_image* mp_bmp_load(const char* filepath) {
+    MP_TRACE_SCOPE("bmp.load");
     FILE* file = fopen(filepath, "rb");
     if (!file) {
         return NULL;
@@ -68,13 +72,31 @@ mp_image* mp_bmp_load(const char* filepath) {
     u32 height = info_header.height < 0 ? -info_header.height : info_header.height;
     mp_bool top_down = info_header.height < 0;
     
+    /* Read palette if present */
+    u8 palette[256][4];
+    mp_bool gray_palette = MP_TRUE;
+    if (info_header.bits_per_pixel == 8) {
+        u32 palette_size = info_header.colors_used ? info_header.colors_used : 256;
+        if (palette_size > 256) palette_size = 256;
+        memset(palette, 0, sizeof(palette));
+        fseek(file, sizeof(bmp_file_header) + info_header.header_size, SEEK_SET);
+        if (fread(palette, 1, (size_t)palette_size * 4, file)) {} /* Silence / 침묵 */
+        
+        /* Entries are B G R X / 항목은 B G R X 순서 */
+        for (u32 i = 0; i < 256 && gray_palette; i++) {
+            gray_palette = palette[i][0] == palette[i][1] && palette[i][1] == palette[i][2];
+        }
+    }
+    
     mp_color_format format = MP_COLOR_FORMAT_RGBA;
     if (info_header.bits_per_pixel == 24) {
         format = MP_COLOR_FORMAT_RGB;
     } else if (info_header.bits_per_pixel == 32) {
         format = MP_COLOR_FORMAT_RGBA;
     } else if (info_header.bits_per_pixel == 8) {
-        format = MP_COLOR_FORMAT_GRAYSCALE;
+        /* Only an all-gray palette stays one channel; colour palettes expand to RGB
+         * / 전부 회색인 팔레트만 단일 채널로 유지하고 컬러 팔레트는 RGB로 확장 */
+        format = gray_palette ? MP_COLOR_FORMAT_GRAYSCALE : MP_COLOR_FORMAT_RGB;
     } else {
         fclose(file);
         return NULL;
@@ -86,14 +108,19 @@ mp_image* mp_bmp_load(const char* filepath) {
         return NULL;
     }
     
-    /* Read palette if present */
-    u8 palette[256][4];
+    u32 palette_table[256];
     if (info_header.bits_per_pixel == 8) {
-        u32 palette_size = info_header.colors_used ? info_header.colors_used : 256;
-        fseek(file, sizeof(bmp_file_header) + info_header.header_size, SEEK_SET);
-        if (fread(palette, 1, (size_t)palette_size * 4, file)) {} /* Silence / 침묵 */
+        for (u32 i = 0; i < 256; i++) {
+            palette_table[i] = gray_palette ? mp_row_palette_entry(palette[i][2], 0, 0, 0)
+                                            : mp_row_palette_entry(palette[i][2], palette[i][1], palette[i][0], 0);
+        }
     }
     
+    /* File rows are BGR / BGRA; pick the row converter once / 파일 행은 BGR(A), 변환기는 한 번만 선택 */
+    mp_row_converter convert = NULL;
+    if (info_header.bits_per_pixel == 24) convert = mp_row_converter_for(MP_COLOR_FORMAT_BGR, format);
+    else if (info_header.bits_per_pixel == 32) convert = mp_row_converter_for(MP_COLOR_FORMAT_BGRA, format);
+    
     /* Seek to pixel data */
     fseek(file, file_header.data_offset, SEEK_SET);
     
@@ -119,30 +146,11 @@ mp_image* mp_bmp_load(const char* filepath) {
             return NULL;
         }
         
-        for (u32 x = 0; x < width; x++) {
-            mp_pixel pixel;
-            
-            if (info_header.bits_per_pixel == 8) {
-                u8 index = row_buffer[x];
-                pixel.b = palette[index][0];
-                pixel.g = palette[index][1];
-                pixel.r = palette[index][2];
-                pixel.a = 255;
-            } else if (info_header.bits_per_pixel == 24) {
-                u32 offset = x * 3;
-                pixel.b = row_buffer[offset];
-                pixel.g = row_buffer[offset + 1];
-                pixel.r = row_buffer[offset + 2];
-                pixel.a = 255;
-            } else if (info_header.bits_per_pixel == 32) {
-                u32 offset = x * 4;
-                pixel.b = row_buffer[offset];
-                pixel.g = row_buffer[offset + 1];
-                pixel.r = row_buffer[offset + 2];
-                pixel.a = row_buffer[offset + 3];
-            }
-            
-            mp_image_set_pixel(image->buffer, x, actual_y, pixel);
+        u8* dst_row = image->buffer->data + (size_t)actual_y * image->buffer->stride;
+        if (convert) {
+            convert(row_buffer, dst_row, width);
+        } else {
+            mp_row_expand_palette(row_buffer, palette_table, dst_row, width, image->buffer->bpp);
         }
     }
     
@@ -157,6 +165,13 @@ mp_result mp_bmp_save(mp_image* image, const char* filepath) {
         return MP_ERROR_INVALID_PARAM;
     }
     
+    MP_TRACE_SCOPE("bmp.save");
+    /* Rows are written as BGR whatever the buffer holds / 버퍼 포맷과 무관하게 BGR로 기록 */
+    mp_row_converter convert = mp_row_converter_for(image->buffer->format, MP_COLOR_FORMAT_BGR);
+    if (!convert || image->buffer->bpp != mp_image_layout_bpp(image->buffer->format)) {
+        return MP_ERROR_UNSUPPORTED;
+    }
+    
     FILE* file = fopen(filepath, "wb");
     if (!file) {
         return MP_ERROR_IO;
@@ -212,14 +227,7 @@ mp_result mp_bmp_save(mp_image* image, const char* filepath) {
     
     for (u32 y = 0; y < height; y++) {
         u32 actual_y = height - 1 - y;
-        
-        for (u32 x = 0; x < width; x++) {
-            mp_pixel pixel = mp_image_get_pixel(image->buffer, x, actual_y);
-            u32 offset = x * 3;
-            row_buffer[offset] = pixel.b;
-            row_buffer[offset + 1] = pixel.g;
-            row_buffer[offset + 2] = pixel.r;
-        }
+        convert(image->buffer->data + (size_t)actual_y * image->buffer->stride, row_buffer, width);
         
         if (fwrite(row_buffer, 1, row_size, file) != row_size) {
             mp_free(row_buffer);
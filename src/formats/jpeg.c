@@ -1,50 +1,59 @@
 #include "../core/types.h"
 #include "../core/memory.h"
+#include "../core/alloc.h"
 #include "../core/image.h"
+#include "../core/trace.h"
 #include "../codecs/jpeg.h"
 #include <stdio.h>
 
 /* JPEG format handler - uses custom JPEG codec */
 
 mp_image* mp_jpeg_load(const char* filepath) {
+    MP_TRACE_SCOPE("jpeg.load");
     FILE* file = fopen(filepath, "rb");
     if (!file) {
         return NULL;
     }
     
+    MP_TRACE_BEGIN(read_start);
     /* Get file size */
     fseek(file, 0, SEEK_END);
     size_t size = ftell(file);
     fseek(file, 0, SEEK_SET);
     
     /* Read entire file */
-    u8* data = (u8*)mp_malloc(size);
+    u8* data = (u8*)mp_alloc(size, MP_ALLOC_CODEC);
     if (!data) {
         fclose(file);
         return NULL;
     }
     
     if (fread(data, 1, size, file) != size) {
-        mp_free(data);
+        mp_alloc_free(data);
         fclose(file);
         return NULL;
     }
     
     fclose(file);
+    MP_TRACE_END(read_start, "jpeg.read");
     
     /* Create decoder */
     jpeg_decoder* decoder = mp_jpeg_decoder_create(data, size);
     if (!decoder) {
-        mp_free(data);
+        mp_alloc_free(data);
         return NULL;
     }
     
-    /* Decode image */
+    /* Decode image. The codec still stops at the first scan (no entropy decoding, IDCT or
+     * colour conversion yet), so "jpeg.decode" covers marker parsing only and there is no
+     * convert stage to time / 코덱이 아직 첫 스캔에서 멈추므로 "jpeg.decode"는 마커 파싱만 측정 */
     mp_image_buffer* buffer = NULL;
+    MP_TRACE_BEGIN(decode_start);
     mp_result result = mp_jpeg_decode(decoder, &buffer);
+    MP_TRACE_END(decode_start, "jpeg.decode");
     
     mp_jpeg_decoder_destroy(decoder);
-    mp_free(data);
+    mp_alloc_free(data);
     
     if (result != MP_SUCCESS || !buffer) {
         return NULL;
@@ -75,6 +84,7 @@ mp_result mp_jpeg_save(mp_image* image, const char* filepath) {
         return MP_ERROR_INVALID_PARAM;
     }
     
+    MP_TRACE_SCOPE("jpeg.save");
     /* Create encoder with quality 90 */
     jpeg_encoder* encoder = mp_jpeg_encoder_create(90);
     if (!encoder) {
@@ -84,7 +94,9 @@ mp_result mp_jpeg_save(mp_image* image, const char* filepath) {
     /* Encode image */
     u8* data = NULL;
     size_t size = 0;
+    MP_TRACE_BEGIN(encode_start);
     mp_result result = mp_jpeg_encode(encoder, image->buffer, &data, &size);
+    MP_TRACE_END(encode_start, "jpeg.encode");
     
     mp_jpeg_encoder_destroy(encoder);
     
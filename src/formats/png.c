@@ -1,6 +1,9 @@
 #include "../core/types.h"
 #include "../core/memory.h"
+#include "../core/arena.h"
 #include "../core/image.h"
+#include "../core/row_convert.h"
+#include "../core/trace.h"
 #include "../codecs/deflate.h"
 #include <stdio.h>
 #include <string.h>
@@ -34,6 +37,9 @@
 #define PNG_FILTER_AVERAGE 3
 #define PNG_FILTER_PAETH 4
 
+/* Raw scanline bytes unfiltered before converting / 변환 전에 필터 해제하는 원본 스캔라인 바이트 수 */
+#define PNG_BAND_BYTES (256 * 1024)
+
 typedef struct {
     u32 width;
     u32 height;
@@ -114,12 +120,10 @@ static void mp_png_unfilter_scanline(u8* scanline, const u8* prev_scanline,
     }
 }
 
-mp_image* mp_png_load(const char* filepath) {
-    FILE* file = fopen(filepath, "rb");
-    if (!file) {
-        return NULL;
-    }
-    
+/* Decode an open file, which is closed here; every temporary comes from `arena`
+ * / 열린 파일 디코딩 (파일은 여기서 닫힘, 모든 임시 데이터는 `arena`에서 할당) */
+static mp_image* mp_png_read(FILE* file, mp_arena* arena) {
+    MP_TRACE_BEGIN(read_start);
     /* Check PNG signature */
     u8 signature[8];
     if (fread(signature, 1, 8, file) != 8) {
@@ -133,6 +137,15 @@ mp_image* mp_png_load(const char* filepath) {
         return NULL;
     }
     
+    /* IDAT data lies inside the file, so its size bounds the accumulator and one
+     * allocation usually holds every chunk / IDAT는 파일 안에 있으므로 파일 크기로 누적 버퍼를 한 번에 할당 */
+    size_t file_size = 0;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long end = ftell(file);
+        if (end > 0) file_size = (size_t)end;
+    }
+    fseek(file, 8, SEEK_SET);
+    
     png_ihdr ihdr = {0};
     u8* idat_data = NULL;
     size_t idat_size = 0;
@@ -169,16 +182,15 @@ mp_image* mp_png_load(const char* filepath) {
             mp_fast_printf("[PNG] IHDR: w=%u h=%u d=%u c=%u comp=%u filt=%u interl=%u\n", 
                            ihdr.width, ihdr.height, ihdr.bit_depth, ihdr.color_type, 
                            ihdr.compression, ihdr.filter, ihdr.interlace);
-                           
+            
             fseek(file, 4, SEEK_CUR); /* Skip CRC */
         } else if (chunk_type == PNG_CHUNK_PLTE) {
             u32 entries = chunk_length / 3;
             if (entries > 256) entries = 256;
             palette_size = entries;
             
-            u8* plte_data = (u8*)mp_malloc(chunk_length);
-            if (fread(plte_data, 1, chunk_length, file) != chunk_length) {
-                mp_free(plte_data);
+            u8* plte_data = (u8*)mp_arena_alloc(arena, chunk_length);
+            if (!plte_data || fread(plte_data, 1, chunk_length, file) != chunk_length) {
                 fclose(file);
                 return NULL;
             }
@@ -188,14 +200,14 @@ mp_image* mp_png_load(const char* filepath) {
                 palette[i].g = plte_data[i*3+1];
                 palette[i].b = plte_data[i*3+2];
             }
-            mp_free(plte_data);
             fseek(file, 4, SEEK_CUR); /* Skip CRC */
         } else if (chunk_type == PNG_CHUNK_IDAT) {
             if (idat_size + chunk_length > idat_capacity) {
+                size_t old_capacity = idat_capacity;
                 idat_capacity = (idat_size + chunk_length) * 2;
-                u8* new_data = (u8*)mp_realloc(idat_data, idat_capacity);
+                if (old_capacity == 0 && file_size >= idat_size + chunk_length) idat_capacity = file_size;
+                u8* new_data = (u8*)mp_arena_grow(arena, idat_data, old_capacity, idat_capacity);
                 if (!new_data) {
-                    mp_free(idat_data);
                     fclose(file);
                     return NULL;
                 }
@@ -203,7 +215,6 @@ mp_image* mp_png_load(const char* filepath) {
             }
             
             if (fread(idat_data + idat_size, 1, chunk_length, file) != chunk_length) {
-                mp_free(idat_data);
                 fclose(file);
                 return NULL;
             }
@@ -220,6 +231,7 @@ mp_image* mp_png_load(const char* filepath) {
     }
     
     fclose(file);
+    MP_TRACE_END(read_start, "png.read");
     
     if (!idat_data) {
         return NULL;
@@ -249,7 +261,6 @@ mp_image* mp_png_load(const char* filepath) {
         case PNG_COLOR_PALETTE:
             if (ihdr.bit_depth != 8) {
                 mp_fast_fprintf(2, "[PNG] Only 8-bit palette supported currently.\n");
-                mp_free(idat_data);
                 return NULL;
             }
             format = MP_COLOR_FORMAT_RGB; /* We expand palette to RGB */
@@ -257,7 +268,6 @@ mp_image* mp_png_load(const char* filepath) {
             break;
         default:
             mp_fast_fprintf(2, "[PNG] Unsupported color type: %d\n", ihdr.color_type);
-            mp_free(idat_data);
             return NULL;
     }
     
@@ -284,57 +294,75 @@ mp_image* mp_png_load(const char* filepath) {
         }
     }
     
-    u8* raw_data = (u8*)mp_malloc(raw_size);
+    u8* raw_data = (u8*)mp_arena_alloc(arena, raw_size);
     if (!raw_data) {
-        mp_free(idat_data);
         return NULL;
     }
     
+    MP_TRACE_BEGIN(inflate_start);
     mp_deflate_stream stream;
     mp_deflate_init(&stream, idat_data + 2, idat_size - 2, raw_data, raw_size);
     mp_result result = mp_deflate_decompress(&stream);
-    mp_free(idat_data);
+    MP_TRACE_END(inflate_start, "png.inflate");
     
     if (result != MP_SUCCESS) {
-        mp_free(raw_data);
         return NULL;
     }
     
     /* Create image */
     mp_image* image = mp_image_create(ihdr.width, ihdr.height, format);
     if (!image) {
-        mp_free(raw_data);
         return NULL;
     }
     
+    /* Palette indices expand through one table lookup per pixel; indices past the palette
+     * are black / 팔레트 인덱스는 테이블 조회 한 번으로 확장 (범위 밖 인덱스는 검정) */
+    u32 palette_table[256];
+    if (ihdr.color_type == PNG_COLOR_PALETTE) {
+        for (u32 i = 0; i < 256; i++) {
+            palette_table[i] = i < palette_size ? mp_row_palette_entry(palette[i].r, palette[i].g, palette[i].b, 255)
+                                                : mp_row_palette_entry(0, 0, 0, 255);
+        }
+    }
+    
     if (ihdr.interlace == 0) {
-        /* Standard non-interlaced processing / 표준 비인터레이스 처리 */
+        /* Standard non-interlaced processing, unfiltering then converting one band of
+         * about PNG_BAND_BYTES of scanlines at a time so both stages get their own span
+         * while the band is still in cache / 표준 비인터레이스 처리: 캐시에 남아 있는 밴드 단위로
+         * 필터 해제 후 변환하여 두 단계를 따로 측정 */
+        u32 band_rows = (u32)(PNG_BAND_BYTES / scanline_size);
+        if (band_rows == 0) band_rows = 1;
         u8* prev_scanline = NULL;
-        for (u32 y = 0; y < ihdr.height; y++) {
-            u8* scanline = raw_data + y * scanline_size;
-            u8 filter_type = scanline[0];
-            u8* pixel_data = scanline + 1;
+        for (u32 band_y = 0; band_y < ihdr.height; band_y += band_rows) {
+            u32 band_end = ihdr.height - band_y < band_rows ? ihdr.height : band_y + band_rows;
             
-            mp_png_unfilter_scanline(pixel_data, prev_scanline, 
-                                     ihdr.width * bytes_per_pixel, bytes_per_pixel, filter_type);
+            MP_TRACE_BEGIN(unfilter_start);
+            for (u32 y = band_y; y < band_end; y++) {
+                u8* scanline = raw_data + y * scanline_size;
+                u8 filter_type = scanline[0];
+                u8* pixel_data = scanline + 1;
+                
+                mp_png_unfilter_scanline(pixel_data, prev_scanline, 
+                                         ihdr.width * bytes_per_pixel, bytes_per_pixel, filter_type);
+                prev_scanline = pixel_data;
+            }
+            MP_TRACE_END(unfilter_start, "png.unfilter");
             
-            if (ihdr.color_type == PNG_COLOR_PALETTE) {
-                for (u32 x = 0; x < ihdr.width; x++) {
-                    u8 index = pixel_data[x];
-                    mp_pixel p = {0, 0, 0, 255};
-                    if (index < palette_size) {
-                        p.r = palette[index].r; p.g = palette[index].g; p.b = palette[index].b;
-                    }
-                    mp_image_set_pixel(image->buffer, x, y, p);
+            MP_TRACE_BEGIN(convert_start);
+            for (u32 y = band_y; y < band_end; y++) {
+                u8* pixel_data = raw_data + y * scanline_size + 1;
+                if (ihdr.color_type == PNG_COLOR_PALETTE) {
+                    mp_row_expand_palette(pixel_data, palette_table, image->buffer->data + y * image->buffer->stride,
+                                          ihdr.width, 3);
+                } else {
+                    memcpy(image->buffer->data + y * image->buffer->stride, pixel_data, 
+                           ihdr.width * bytes_per_pixel);
                 }
-            } else {
-                memcpy(image->buffer->data + y * image->buffer->stride, pixel_data, 
-                       ihdr.width * bytes_per_pixel);
             }
-            prev_scanline = pixel_data;
+            MP_TRACE_END(convert_start, "png.convert");
         }
     } else {
-        /* Adam7 Interlaced Processing / Adam7 인터레이스 처리 */
+        /* Adam7 Interlaced Processing, one pass unfiltered then scattered / Adam7 인터레이스 처리 (패스 단위로 필터 해제 후 배치) */
         static const u8 x_orig[] = {0, 4, 0, 2, 0, 1, 0};
         static const u8 y_orig[] = {0, 0, 4, 0, 2, 0, 1};
         static const u8 x_step[] = {8, 8, 4, 4, 2, 2, 1};
@@ -349,6 +377,7 @@ mp_image* mp_png_load(const char* filepath) {
             u32 pass_scanline_size = pw * bytes_per_pixel + 1;
             u8* prev_pass_scanline = NULL;
             
+            MP_TRACE_BEGIN(unfilter_start);
             for (u32 py = 0; py < ph; py++) {
                 u8* scanline = current_raw_ptr + py * pass_scanline_size;
                 u8 filter_type = scanline[0];
@@ -356,32 +385,50 @@ mp_image* mp_png_load(const char* filepath) {
                 
                 mp_png_unfilter_scanline(pixel_data, prev_pass_scanline, 
                                          pw * bytes_per_pixel, bytes_per_pixel, filter_type);
+                prev_pass_scanline = pixel_data;
+            }
+            MP_TRACE_END(unfilter_start, "png.unfilter");
+            
+            MP_TRACE_BEGIN(convert_start);
+            for (u32 py = 0; py < ph; py++) {
+                u8* pixel_data = current_raw_ptr + py * pass_scanline_size + 1;
+                u32 final_y = y_orig[p] + py * y_step[p];
                 
                 /* Map sub-pixels to final image / 서브 픽셀을 최종 이미지에 맵핑 */
                 for (u32 px = 0; px < pw; px++) {
                     u32 final_x = x_orig[p] + px * x_step[p];
-                    u32 final_y = y_orig[p] + py * y_step[p];
                     
                     if (ihdr.color_type == PNG_COLOR_PALETTE) {
-                         u8 index = pixel_data[px];
-                         mp_pixel pix = {0, 0, 0, 255};
-                         if (index < palette_size) {
-                             pix.r = palette[index].r; pix.g = palette[index].g; pix.b = palette[index].b;
-                         }
-                         mp_image_set_pixel(image->buffer, final_x, final_y, pix);
+                        u8* dest = image->buffer->data + final_y * image->buffer->stride + final_x * 3;
+                        memcpy(dest, &palette_table[pixel_data[px]], 3);
                     } else {
                         u8* src = pixel_data + px * bytes_per_pixel;
                         u8* dest = image->buffer->data + final_y * image->buffer->stride + final_x * bytes_per_pixel;
                         memcpy(dest, src, bytes_per_pixel);
                     }
                 }
-                prev_pass_scanline = pixel_data;
             }
+            MP_TRACE_END(convert_start, "png.convert");
             current_raw_ptr += ph * pass_scanline_size;
         }
     }
     
-    mp_free(raw_data);
+    return image;
+}
+
+mp_image* mp_png_load(const char* filepath) {
+    MP_TRACE_SCOPE("png.load");
+    FILE* file = fopen(filepath, "rb");
+    if (!file) {
+        return NULL;
+    }
+    
+    /* Palette scratch, IDAT accumulator and inflated scanlines all go back in one release
+     * / 팔레트, IDAT 누적 버퍼, 압축 해제된 스캔라인을 한 번에 반환 */
+    mp_arena arena;
+    mp_arena_init(&arena, MP_ARENA_BLOCK_SIZE, MP_ALLOC_CODEC);
+    mp_image* image = mp_png_read(file, &arena);
+    mp_arena_release(&arena);
     return image;
 }
 
@@ -390,6 +437,7 @@ mp_result mp_png_save(mp_image* image, const char* filepath) {
         return MP_ERROR_INVALID_PARAM;
     }
     
+    MP_TRACE_SCOPE("png.save");
     FILE* file = fopen(filepath, "wb");
     if (!file) {
         return MP_ERROR_IO;
@@ -441,13 +489,16 @@ mp_result mp_png_save(mp_image* image, const char* filepath) {
     /* Prepare image data with filter bytes */
     size_t scanline_size = image->buffer->width * bytes_per_pixel + 1;
     size_t raw_size = scanline_size * image->buffer->height;
-    u8* raw_data = (u8*)mp_malloc(raw_size);
+    mp_arena arena;
+    mp_arena_init(&arena, MP_ARENA_BLOCK_SIZE, MP_ALLOC_CODEC);
+    u8* raw_data = (u8*)mp_arena_alloc(&arena, raw_size);
     
     if (!raw_data) {
         fclose(file);
         return MP_ERROR_MEMORY;
     }
     
+    MP_TRACE_BEGIN(filter_start);
     for (u32 y = 0; y < image->buffer->height; y++) {
         raw_data[y * scanline_size] = PNG_FILTER_NONE;
         memcpy(raw_data + y * scanline_size + 1,
@@ -459,8 +510,12 @@ mp_result mp_png_save(mp_image* image, const char* filepath) {
     u8* compressed_data;
     size_t compressed_size;
     
+    MP_TRACE_END(filter_start, "png.filter");
+    
+    MP_TRACE_BEGIN(deflate_start);
     mp_result result = mp_deflate_compress(raw_data, raw_size, &compressed_data, &compressed_size);
-    mp_free(raw_data);
+    MP_TRACE_END(deflate_start, "png.deflate");
+    mp_arena_release(&arena);
     
     if (result != MP_SUCCESS) {
         fclose(file);
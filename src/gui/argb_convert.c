@@ -0,0 +1,280 @@
+#include "argb_convert.h"
+#include "../core/parallel.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MP_ARGB_X86 1
+#include <immintrin.h>
+#endif
+
+/* Minimum pixels per parallel chunk / 병렬 청크당 최소 픽셀 수 */
+#define MP_ARGB_PARALLEL_PIXELS 65536
+
+/* ---------------------------------------------------------------------------------------
+ * Scalar reference / 스칼라 기준 구현
+ * ------------------------------------------------------------------------------------- */
+
+/* Exact round(c * a / 255) / 정확한 반올림 */
+static inline u32 mp_argb_mul255(u32 c, u32 a) {
+    u32 t = c * a + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+static inline u32 mp_argb_pack(u32 a, u32 r, u32 g, u32 b) {
+    if (a != 255) {
+        r = mp_argb_mul255(r, a);
+        g = mp_argb_mul255(g, a);
+        b = mp_argb_mul255(b, a);
+    }
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+void mp_argb_convert_span_scalar(const u8* src, mp_color_format format, u32* dst, u32 count) {
+    switch (format) {
+        case MP_COLOR_FORMAT_RGB:
+            for (u32 x = 0; x < count; x++, src += 3) dst[x] = (0xFFU << 24) | ((u32)src[0] << 16) | ((u32)src[1] << 8) | src[2];
+            break;
+        case MP_COLOR_FORMAT_BGR:
+            for (u32 x = 0; x < count; x++, src += 3) dst[x] = (0xFFU << 24) | ((u32)src[2] << 16) | ((u32)src[1] << 8) | src[0];
+            break;
+        case MP_COLOR_FORMAT_RGBA:
+            for (u32 x = 0; x < count; x++, src += 4) dst[x] = mp_argb_pack(src[3], src[0], src[1], src[2]);
+            break;
+        case MP_COLOR_FORMAT_BGRA:
+            for (u32 x = 0; x < count; x++, src += 4) dst[x] = mp_argb_pack(src[3], src[2], src[1], src[0]);
+            break;
+        case MP_COLOR_FORMAT_GRAYSCALE:
+            for (u32 x = 0; x < count; x++) dst[x] = (0xFFU << 24) | ((u32)src[x] * 0x010101U);
+            break;
+        case MP_COLOR_FORMAT_GRAYSCALE_ALPHA:
+            for (u32 x = 0; x < count; x++, src += 2) dst[x] = mp_argb_pack(src[1], src[0], src[0], src[0]);
+            break;
+        default:
+            for (u32 x = 0; x < count; x++) dst[x] = 0xFF000000U;
+            break;
+    }
+}
+
+/* ---------------------------------------------------------------------------------------
+ * SSE2: 1-, 2- and 4-byte formats / SSE2: 1, 2, 4바이트 포맷
+ * ------------------------------------------------------------------------------------- */
+
+#if defined(__SSE2__)
+/* Premultiply four ARGB32 pixels; fully opaque groups pass through
+ * / ARGB32 4픽셀 프리멀티플라이 (모두 불투명이면 그대로) */
+static inline __m128i mp_argb_premultiply_sse2(__m128i px) {
+    const __m128i alpha_bits = _mm_set1_epi32((int)0xFF000000);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(px, alpha_bits), alpha_bits)) == 0xFFFF) return px;
+    
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(128);
+    const __m128i alpha_lane = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    
+    __m128i lo = _mm_unpacklo_epi8(px, zero);
+    __m128i hi = _mm_unpackhi_epi8(px, zero);
+    __m128i alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xFF), 0xFF);
+    __m128i ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xFF), 0xFF);
+    
+    __m128i tlo = _mm_add_epi16(_mm_mullo_epi16(lo, alo), round);
+    __m128i thi = _mm_add_epi16(_mm_mullo_epi16(hi, ahi), round);
+    tlo = _mm_srli_epi16(_mm_add_epi16(tlo, _mm_srli_epi16(tlo, 8)), 8);
+    thi = _mm_srli_epi16(_mm_add_epi16(thi, _mm_srli_epi16(thi, 8)), 8);
+    
+    /* Keep the original alpha / 원래 알파 유지 */
+    tlo = _mm_or_si128(_mm_andnot_si128(alpha_lane, tlo), _mm_and_si128(alpha_lane, lo));
+    thi = _mm_or_si128(_mm_andnot_si128(alpha_lane, thi), _mm_and_si128(alpha_lane, hi));
+    return _mm_packus_epi16(tlo, thi);
+}
+
+static u32 mp_argb_convert_sse2(const u8* src, mp_color_format format, u32* dst, u32 count) {
+    u32 x = 0;
+    
+    switch (format) {
+        case MP_COLOR_FORMAT_RGBA:
+        case MP_COLOR_FORMAT_BGRA: {
+            const __m128i keep = _mm_set1_epi32((int)0xFF00FF00);
+            const __m128i low = _mm_set1_epi32(0xFF);
+            for (; x + 4 <= count; x += 4) {
+                __m128i px = _mm_loadu_si128((const __m128i*)(src + x * 4));
+                if (format == MP_COLOR_FORMAT_RGBA) {
+                    /* 0xAABBGGRR -> 0xAARRGGBB / R과 B 교환 */
+                    px = _mm_or_si128(_mm_and_si128(px, keep),
+                                      _mm_or_si128(_mm_and_si128(_mm_srli_epi32(px, 16), low),
+                                                   _mm_slli_epi32(_mm_and_si128(px, low), 16)));
+                }
+                _mm_storeu_si128((__m128i*)(dst + x), mp_argb_premultiply_sse2(px));
+            }
+            break;
+        }
+        case MP_COLOR_FORMAT_GRAYSCALE:
+            for (; x + 16 <= count; x += 16) {
+                __m128i g = _mm_loadu_si128((const __m128i*)(src + x));
+                __m128i gg_lo = _mm_unpacklo_epi8(g, g);
+                __m128i gg_hi = _mm_unpackhi_epi8(g, g);
+                __m128i ga_lo = _mm_unpacklo_epi8(g, _mm_set1_epi8(-1));
+                __m128i ga_hi = _mm_unpackhi_epi8(g, _mm_set1_epi8(-1));
+                _mm_storeu_si128((__m128i*)(dst + x), _mm_unpacklo_epi16(gg_lo, ga_lo));
+                _mm_storeu_si128((__m128i*)(dst + x + 4), _mm_unpackhi_epi16(gg_lo, ga_lo));
+                _mm_storeu_si128((__m128i*)(dst + x + 8), _mm_unpacklo_epi16(gg_hi, ga_hi));
+                _mm_storeu_si128((__m128i*)(dst + x + 12), _mm_unpackhi_epi16(gg_hi, ga_hi));
+            }
+            break;
+        case MP_COLOR_FORMAT_GRAYSCALE_ALPHA: {
+            const __m128i low = _mm_set1_epi16(0xFF);
+            for (; x + 8 <= count; x += 8) {
+                /* 16-bit lanes hold g | a << 8 / 16비트 레인: g | a << 8 */
+                __m128i ga = _mm_loadu_si128((const __m128i*)(src + x * 2));
+                __m128i g = _mm_and_si128(ga, low);
+                __m128i gg = _mm_or_si128(g, _mm_slli_epi16(g, 8));
+                _mm_storeu_si128((__m128i*)(dst + x), mp_argb_premultiply_sse2(_mm_unpacklo_epi16(gg, ga)));
+                _mm_storeu_si128((__m128i*)(dst + x + 4), mp_argb_premultiply_sse2(_mm_unpackhi_epi16(gg, ga)));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return x;
+}
+#endif
+
+/* ---------------------------------------------------------------------------------------
+ * pshufb: 3-byte formats / pshufb: 3바이트 포맷
+ * ------------------------------------------------------------------------------------- */
+
+#if defined(MP_ARGB_X86)
+/* Byte shuffles taking four packed 3-byte pixels to B G R _ order; -128 yields zero
+ * / 3바이트 픽셀 4개를 B G R _ 순서로 재배치 (-128은 0) */
+#define MP_ARGB_SHUFFLE_RGB 2, 1, 0, -128, 5, 4, 3, -128, 8, 7, 6, -128, 11, 10, 9, -128
+#define MP_ARGB_SHUFFLE_BGR 0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128
+
+__attribute__((target("ssse3")))
+static u32 mp_argb_convert_ssse3(const u8* src, mp_bool bgr, u32* dst, u32 count) {
+    const __m128i shuffle = bgr ? _mm_setr_epi8(MP_ARGB_SHUFFLE_BGR) : _mm_setr_epi8(MP_ARGB_SHUFFLE_RGB);
+    const __m128i opaque = _mm_set1_epi32((int)0xFF000000);
+    u32 x = 0;
+    
+    /* Each 16-byte load uses 12 bytes; stop while the last load stays in the row
+     * / 16바이트 로드 중 12바이트 사용, 마지막 로드가 행 안에 있을 때까지 */
+    for (; x + 10 <= count; x += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(src + x * 3));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src + x * 3 + 12));
+        _mm_storeu_si128((__m128i*)(dst + x), _mm_or_si128(_mm_shuffle_epi8(a, shuffle), opaque));
+        _mm_storeu_si128((__m128i*)(dst + x + 4), _mm_or_si128(_mm_shuffle_epi8(b, shuffle), opaque));
+    }
+    return x;
+}
+
+__attribute__((target("avx2")))
+static u32 mp_argb_convert_avx2(const u8* src, mp_bool bgr, u32* dst, u32 count) {
+    const __m128i lane = bgr ? _mm_setr_epi8(MP_ARGB_SHUFFLE_BGR) : _mm_setr_epi8(MP_ARGB_SHUFFLE_RGB);
+    const __m256i shuffle = _mm256_broadcastsi128_si256(lane);
+    const __m256i opaque = _mm256_set1_epi32((int)0xFF000000);
+    u32 x = 0;
+    
+    /* vpshufb works per 128-bit lane, so each lane gets its own four pixels
+     * / vpshufb는 128비트 레인 단위이므로 레인마다 4픽셀씩 적재 */
+    for (; x + 18 <= count; x += 16) {
+        const u8* p = src + x * 3;
+        __m256i a = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)p)),
+                                            _mm_loadu_si128((const __m128i*)(p + 12)), 1);
+        __m256i b = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(p + 24))),
+                                            _mm_loadu_si128((const __m128i*)(p + 36)), 1);
+        _mm256_storeu_si256((__m256i*)(dst + x), _mm256_or_si256(_mm256_shuffle_epi8(a, shuffle), opaque));
+        _mm256_storeu_si256((__m256i*)(dst + x + 8), _mm256_or_si256(_mm256_shuffle_epi8(b, shuffle), opaque));
+    }
+    return x;
+}
+
+/* 0 = SSE2/scalar, 1 = SSSE3, 2 = AVX2; resolved once / 한 번만 판별 */
+static int mp_argb_simd_level(void) {
+    static atomic_int g_level = -1;
+    int level = atomic_load_explicit(&g_level, memory_order_relaxed);
+    if (level >= 0) return level;
+    
+    __builtin_cpu_init();
+    level = __builtin_cpu_supports("avx2") ? 2 : __builtin_cpu_supports("ssse3") ? 1 : 0;
+    const char* cap = getenv("MP_SIMD");
+    if (cap && *cap >= '0' && *cap <= '2' && *cap - '0' < level) level = *cap - '0';
+    
+    atomic_store_explicit(&g_level, level, memory_order_relaxed);
+    return level;
+}
+#endif
+
+/* ---------------------------------------------------------------------------------------
+ * Public API / 공개 API
+ * ------------------------------------------------------------------------------------- */
+
+mp_color_format mp_argb_source_format(const mp_image_buffer* buffer) {
+    u32 expected = 0;
+    switch (buffer->format) {
+        case MP_COLOR_FORMAT_RGB:
+        case MP_COLOR_FORMAT_BGR: expected = 3; break;
+        case MP_COLOR_FORMAT_RGBA:
+        case MP_COLOR_FORMAT_BGRA: expected = 4; break;
+        case MP_COLOR_FORMAT_GRAYSCALE: expected = 1; break;
+        case MP_COLOR_FORMAT_GRAYSCALE_ALPHA: expected = 2; break;
+        default: break;
+    }
+    if (expected == buffer->bpp) return buffer->format;
+    
+    switch (buffer->bpp) {
+        case 1: return MP_COLOR_FORMAT_GRAYSCALE;
+        case 2: return MP_COLOR_FORMAT_GRAYSCALE_ALPHA;
+        case 4: return MP_COLOR_FORMAT_RGBA;
+        default: return MP_COLOR_FORMAT_RGB;
+    }
+}
+
+void mp_argb_convert_span(const u8* src, mp_color_format format, u32* dst, u32 count) {
+    u32 done = 0;
+    u32 bpp = 3;
+    
+    if (format == MP_COLOR_FORMAT_RGB || format == MP_COLOR_FORMAT_BGR) {
+#if defined(MP_ARGB_X86)
+        mp_bool bgr = format == MP_COLOR_FORMAT_BGR;
+        int level = mp_argb_simd_level();
+        if (level >= 2) done = mp_argb_convert_avx2(src, bgr, dst, count);
+        if (level >= 1) done += mp_argb_convert_ssse3(src + done * 3, bgr, dst + done, count - done);
+#endif
+    } else {
+        bpp = format == MP_COLOR_FORMAT_GRAYSCALE ? 1 : format == MP_COLOR_FORMAT_GRAYSCALE_ALPHA ? 2 : 4;
+#if defined(__SSE2__)
+        done = mp_argb_convert_sse2(src, format, dst, count);
+#endif
+    }
+    
+    if (done < count) mp_argb_convert_span_scalar(src + (size_t)done * bpp, format, dst + done, count - done);
+}
+
+typedef struct {
+    const mp_image_buffer* buffer;
+    mp_color_format format;
+    u32 x, y, width;
+    u8* dst;
+    u32 dst_stride;
+} mp_argb_rect_job;
+
+static void mp_argb_convert_rows(void* ctx, u32 begin, u32 end) {
+    mp_argb_rect_job* job = (mp_argb_rect_job*)ctx;
+    const mp_image_buffer* buffer = job->buffer;
+    for (u32 row = begin; row < end; row++) {
+        const u8* src = buffer->data + (size_t)(job->y + row) * buffer->stride + (size_t)job->x * buffer->bpp;
+        mp_argb_convert_span(src, job->format, (u32*)(job->dst + (size_t)row * job->dst_stride), job->width);
+    }
+}
+
+void mp_argb_convert_rect(const mp_image_buffer* buffer, u32 x, u32 y, u32 width, u32 height,
+                          u8* dst, u32 dst_stride) {
+    if (!buffer || !buffer->data || !dst || width == 0 || height == 0) return;
+    
+    mp_argb_rect_job job = { buffer, mp_argb_source_format(buffer), x, y, width, dst, dst_stride };
+    u32 grain = MP_ARGB_PARALLEL_PIXELS / width;
+    mp_parallel_for(height, grain ? grain : 1, mp_argb_convert_rows, &job);
+}
@@ -0,0 +1,31 @@
+#ifndef MANYPICTURES_ARGB_CONVERT_H
+#define MANYPICTURES_ARGB_CONVERT_H
+
+#include "../core/types.h"
+
+/* Buffer pixels to Cairo ARGB32 / 버퍼 픽셀을 Cairo ARGB32로 변환
+ *
+ * Cairo's ARGB32 is a native-endian 0xAARRGGBB word with premultiplied alpha. RGB, BGR and
+ * grayscale become opaque; RGBA, BGRA and grayscale+alpha are premultiplied with exact
+ * rounding. 3-byte formats use a pshufb kernel (SSSE3, or AVX2 for 8 pixels per step)
+ * selected at run time; 1-, 2- and 4-byte formats use SSE2. MP_SIMD=0|1|2 caps the level.
+ * RGB/BGR/그레이는 불투명, 알파 포맷은 정확한 반올림으로 프리멀티플라이합니다. 실행 시 SIMD 수준을 선택합니다.
+ */
+
+/* Pixel format actually stored in `buffer`; falls back on bpp when format disagrees
+ * / 실제 저장된 픽셀 포맷 (format과 bpp가 다르면 bpp 기준) */
+mp_color_format mp_argb_source_format(const mp_image_buffer* buffer);
+
+/* Convert `count` pixels / `count`개 픽셀 변환 */
+void mp_argb_convert_span(const u8* src, mp_color_format format, u32* dst, u32 count);
+
+/* Scalar reference the SIMD paths must match bit for bit (`make test` checks it)
+ * / SIMD 경로가 비트 단위로 일치해야 하는 스칼라 기준 구현 (`make test`에서 검사) */
+void mp_argb_convert_span_scalar(const u8* src, mp_color_format format, u32* dst, u32 count);
+
+/* Convert a rectangle of `buffer` into `dst`, rows split across threads
+ * / 버퍼의 사각형 영역을 변환 (행 단위로 스레드 분할) */
+void mp_argb_convert_rect(const mp_image_buffer* buffer, u32 x, u32 y, u32 width, u32 height,
+                          u8* dst, u32 dst_stride);
+
+#endif /* MANYPICTURES_ARGB_CONVERT_H */
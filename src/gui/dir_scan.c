@@ -0,0 +1,98 @@
+#define _POSIX_C_SOURCE 200809L
+#include "dir_scan.h"
+#include "../core/memory.h"
+#include <dirent.h>
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+/* Same filter as the file picker / 파일 선택기와 같은 필터 */
+static mp_bool mp_dir_scan_is_image(const char* name) {
+    static const char* const extensions[] = { "jpg", "jpeg", "png", "bmp", "gif", "tif", "tiff", "webp" };
+    const char* dot = strrchr(name, '.');
+    if (!dot || dot == name) return MP_FALSE;
+    for (size_t i = 0; i < sizeof(extensions) / sizeof(extensions[0]); i++) {
+        if (strcasecmp(dot + 1, extensions[i]) == 0) return MP_TRUE;
+    }
+    return MP_FALSE;
+}
+
+/* Natural order: digit runs compare by value, letters ignore case / 자연 정렬: 숫자는 값으로, 문자는 대소문자 무시 */
+static int mp_dir_scan_compare_names(const char* a, const char* b) {
+    const char* x = a;
+    const char* y = b;
+    while (*x && *y) {
+        if (isdigit((unsigned char)*x) && isdigit((unsigned char)*y)) {
+            while (*x == '0') x++;
+            while (*y == '0') y++;
+            size_t nx = 0, ny = 0;
+            while (isdigit((unsigned char)x[nx])) nx++;
+            while (isdigit((unsigned char)y[ny])) ny++;
+            if (nx != ny) return nx < ny ? -1 : 1;
+            int cmp = memcmp(x, y, nx);
+            if (cmp != 0) return cmp;
+            x += nx;
+            y += ny;
+        } else {
+            int cx = tolower((unsigned char)*x);
+            int cy = tolower((unsigned char)*y);
+            if (cx != cy) return cx - cy;
+            x++;
+            y++;
+        }
+    }
+    if (*x || *y) return *x ? 1 : -1;
+    return strcmp(a, b);
+}
+
+static int mp_dir_scan_compare_paths(const void* a, const void* b) {
+    return mp_dir_scan_compare_names(*(const char* const*)a, *(const char* const*)b);
+}
+
+char** mp_dir_scan_images(const char* prefix, u32* out_count) {
+    DIR* dir = opendir(prefix[0] ? prefix : ".");
+    if (!dir) return NULL;
+    
+    size_t prefix_len = strlen(prefix);
+    u32 capacity = 64, count = 0;
+    char** files = (char**)mp_malloc(sizeof(char*) * capacity);
+    struct dirent* ent;
+    while (files && (ent = readdir(dir)) != NULL) {
+        if (ent->d_name[0] == '.' || !mp_dir_scan_is_image(ent->d_name)) continue;
+        if (count == capacity) {
+            char** grown = (char**)mp_realloc(files, sizeof(char*) * capacity * 2);
+            if (!grown) break;
+            files = grown;
+            capacity *= 2;
+        }
+        size_t len = strlen(ent->d_name);
+        char* path = (char*)mp_malloc(prefix_len + len + 1);
+        if (!path) break;
+        memcpy(path, prefix, prefix_len);
+        memcpy(path + prefix_len, ent->d_name, len + 1);
+        files[count++] = path;
+    }
+    closedir(dir);
+    if (!files) return NULL;
+    
+    qsort(files, count, sizeof(char*), mp_dir_scan_compare_paths);
+    *out_count = count;
+    return files;
+}
+
+void mp_dir_scan_free(char** files, u32 count) {
+    if (!files) return;
+    for (u32 i = 0; i < count; i++) mp_free(files[i]);
+    mp_free(files);
+}
+
+char* mp_dir_scan_prefix(const char* filepath) {
+    const char* slash = strrchr(filepath, '/');
+    size_t len = slash ? (size_t)(slash - filepath) + 1 : 0;
+    char* prefix = (char*)mp_malloc(len + 1);
+    if (!prefix) return NULL;
+    memcpy(prefix, filepath, len);
+    prefix[len] = '\0';
+    return prefix;
+}
@@ -0,0 +1,23 @@
+#ifndef MANYPICTURES_DIR_SCAN_H
+#define MANYPICTURES_DIR_SCAN_H
+
+#include "../core/types.h"
+
+/* Image files of one directory in natural order ("img2" before "img10") / 디렉터리의 이미지 파일 (자연 정렬)
+ *
+ * `prefix` is a path prefix ending in '/', or "" for the working directory; every returned
+ * path is `prefix` + file name. Hidden files are skipped and the extensions are those of
+ * the file picker.
+ * `prefix`는 '/'로 끝나는 경로 접두사(작업 디렉터리는 ""), 반환 경로는 접두사 + 파일 이름입니다.
+ */
+
+/* NULL if the directory cannot be read / 디렉터리를 읽을 수 없으면 NULL */
+char** mp_dir_scan_images(const char* prefix, u32* out_count);
+
+void mp_dir_scan_free(char** files, u32 count);
+
+/* Directory prefix of `filepath` as used above, "" when it has none; free with mp_free
+ * / `filepath`의 디렉터리 접두사 (mp_free로 해제) */
+char* mp_dir_scan_prefix(const char* filepath);
+
+#endif /* MANYPICTURES_DIR_SCAN_H */
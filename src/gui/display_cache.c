@@ -0,0 +1,741 @@
+#define _POSIX_C_SOURCE 200809L
+#include "display_cache.h"
+#include "argb_convert.h"
+#include "../core/memory.h"
+#include "../core/parallel.h"
+#include <cairo/cairo.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define MP_DISPLAY_HASH_BUCKETS 4096
+#define MP_DISPLAY_HALF_TILE (MP_DISPLAY_TILE_SIZE / 2)
+
+typedef struct mp_display_tile {
+    u32 level;
+    u32 tx;
+    u32 ty;
+    u32 width;                        /* In level pixels / 레벨 픽셀 단위 */
+    u32 height;
+    cairo_surface_t* surface;
+    struct mp_display_tile* hash_next;
+    struct mp_display_tile* lru_prev; /* Towards most recently used / 최근 사용 방향 */
+    struct mp_display_tile* lru_next;
+} mp_display_tile;
+
+/* A tile being built this frame / 이번 프레임에서 생성 중인 타일 */
+typedef struct {
+    mp_display_tile* tile;
+    cairo_surface_t* children[4];     /* Retained level L-1 tiles, row-major / 유지된 하위 레벨 타일 */
+    mp_bool from_children;
+} mp_display_build;
+
+typedef struct {
+    const mp_image_buffer* buffer;
+    mp_color_format format;
+    mp_display_build* builds;
+    mp_bool parallel_rows;            /* A single tile: split its rows instead / 타일 하나면 행을 분할 */
+    const atomic_bool* cancel;        /* Background batches only / 백그라운드 묶음 전용 */
+} mp_display_build_batch;
+
+typedef enum {
+    MP_DISPLAY_BUILDER_IDLE,
+    MP_DISPLAY_BUILDER_QUEUED,
+    MP_DISPLAY_BUILDER_RUNNING,
+    MP_DISPLAY_BUILDER_DONE           /* Waiting for mp_display_cache_dispatch / dispatch 대기 */
+} mp_display_builder_state;
+
+struct mp_display_cache {
+    mp_display_tile* buckets[MP_DISPLAY_HASH_BUCKETS];
+    mp_display_tile* lru_head;        /* Most recently used / 가장 최근 사용 */
+    mp_display_tile* lru_tail;
+    size_t bytes;
+    size_t budget;
+    u32 width;                        /* Image size the tiles belong to / 타일이 속한 이미지 크기 */
+    u32 height;
+    
+    /* Builder thread for level tiles averaged from the buffer / 버퍼에서 평균하는 레벨 타일 생성 스레드 */
+    pthread_t thread;
+    mp_bool thread_started;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t idle;
+    int notify[2];                    /* [0] read by the event loop / 이벤트 루프가 읽는 알림 파이프 */
+    atomic_bool cancel;
+    
+    /* Guarded by lock / lock으로 보호 */
+    mp_bool quit;
+    mp_display_builder_state state;
+    mp_display_build_batch batch;     /* One batch in flight at most / 진행 중인 묶음은 최대 하나 */
+    u32 batch_count;
+};
+
+static inline u32 mp_display_level_extent(u32 size, u32 level) {
+    return (u32)(((u64)size + (1u << level) - 1) >> level);
+}
+
+static inline u32 mp_display_hash(u32 level, u32 tx, u32 ty) {
+    return ((level * 73856093u) ^ (tx * 19349663u) ^ (ty * 83492791u)) & (MP_DISPLAY_HASH_BUCKETS - 1);
+}
+
+/* ---------------------------------------------------------------------------------------
+ * LRU bookkeeping / LRU 관리
+ * ------------------------------------------------------------------------------------- */
+
+static void mp_display_lru_unlink(mp_display_cache* cache, mp_display_tile* tile) {
+    if (tile->lru_prev) tile->lru_prev->lru_next = tile->lru_next;
+    else cache->lru_head = tile->lru_next;
+    if (tile->lru_next) tile->lru_next->lru_prev = tile->lru_prev;
+    else cache->lru_tail = tile->lru_prev;
+    tile->lru_prev = tile->lru_next = NULL;
+}
+
+static void mp_display_lru_push_front(mp_display_cache* cache, mp_display_tile* tile) {
+    tile->lru_prev = NULL;
+    tile->lru_next = cache->lru_head;
+    if (cache->lru_head) cache->lru_head->lru_prev = tile;
+    cache->lru_head = tile;
+    if (!cache->lru_tail) cache->lru_tail = tile;
+}
+
+static size_t mp_display_tile_bytes(const mp_display_tile* tile) {
+    return sizeof(mp_display_tile) + (size_t)tile->width * tile->height * 4;
+}
+
+static void mp_display_tile_free(mp_display_tile* tile) {
+    if (tile->surface) cairo_surface_destroy(tile->surface);
+    mp_free(tile);
+}
+
+static void mp_display_cache_remove(mp_display_cache* cache, mp_display_tile* tile) {
+    mp_display_tile** link = &cache->buckets[mp_display_hash(tile->level, tile->tx, tile->ty)];
+    while (*link && *link != tile) link = &(*link)->hash_next;
+    if (*link) *link = tile->hash_next;
+    
+    mp_display_lru_unlink(cache, tile);
+    cache->bytes -= mp_display_tile_bytes(tile);
+    mp_display_tile_free(tile);
+}
+
+static mp_display_tile* mp_display_cache_find(mp_display_cache* cache, u32 level, u32 tx, u32 ty) {
+    mp_display_tile* tile = cache->buckets[mp_display_hash(level, tx, ty)];
+    while (tile && !(tile->level == level && tile->tx == tx && tile->ty == ty)) tile = tile->hash_next;
+    if (tile && tile != cache->lru_head) {
+        mp_display_lru_unlink(cache, tile);
+        mp_display_lru_push_front(cache, tile);
+    }
+    return tile;
+}
+
+static void mp_display_cache_insert(mp_display_cache* cache, mp_display_tile* tile) {
+    size_t bytes = mp_display_tile_bytes(tile);
+    
+    /* Evict least recently used tiles; surfaces still being painted hold their own reference
+     * / LRU 타일 제거 (그리는 중인 서피스는 자체 참조를 유지) */
+    while (cache->lru_tail && cache->bytes + bytes > cache->budget) {
+        mp_display_cache_remove(cache, cache->lru_tail);
+    }
+    
+    u32 h = mp_display_hash(tile->level, tile->tx, tile->ty);
+    tile->hash_next = cache->buckets[h];
+    cache->buckets[h] = tile;
+    mp_display_lru_push_front(cache, tile);
+    cache->bytes += bytes;
+}
+
+/* ---------------------------------------------------------------------------------------
+ * Tile builders / 타일 생성
+ * ------------------------------------------------------------------------------------- */
+
+/* Average a 2x2 block of ARGB32 pixels per channel / ARGB32 2x2 블록의 채널별 평균 */
+static inline u32 mp_display_box(u32 a, u32 b, u32 c, u32 d) {
+    u32 out = 0;
+    for (u32 shift = 0; shift < 32; shift += 8) {
+        u32 sum = ((a >> shift) & 0xFF) + ((b >> shift) & 0xFF) + ((c >> shift) & 0xFF) + ((d >> shift) & 0xFF);
+        out |= ((sum + 2) >> 2) << shift;
+    }
+    return out;
+}
+
+/* Halve two source rows of `src_w` pixels into `out_w` pixels, replicating an odd last column
+ * / 두 원본 행을 절반으로 축소 (홀수 마지막 열은 복제) */
+static void mp_display_halve_span(const u32* r0, const u32* r1, u32 src_w, u32* out, u32 out_w) {
+    u32 pairs = src_w / 2;
+    if (pairs > out_w) pairs = out_w;
+    u32 x = 0;
+
+#if defined(__SSE2__)
+    /* Two output pixels per step: widen to 16 bits, add rows, then add neighbours
+     * / 단계당 출력 2픽셀: 16비트로 확장, 행 합산 후 이웃 합산 */
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(2);
+    for (; x + 2 <= pairs; x += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(r0 + x * 2));
+        __m128i b = _mm_loadu_si128((const __m128i*)(r1 + x * 2));
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+        hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+        __m128i sum = _mm_unpacklo_epi64(lo, hi);
+        sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+        _mm_storel_epi64((__m128i*)(out + x), _mm_packus_epi16(sum, zero));
+    }
+#endif
+    for (; x < pairs; x++) {
+        out[x] = mp_display_box(r0[x * 2], r0[x * 2 + 1], r1[x * 2], r1[x * 2 + 1]);
+    }
+    for (; x < out_w; x++) {
+        out[x] = mp_display_box(r0[x * 2], r0[x * 2], r1[x * 2], r1[x * 2]);
+    }
+}
+
+/* Level 0: straight conversion of the covered buffer region / 레벨 0: 해당 버퍼 영역 직접 변환 */
+static void mp_display_build_base(const mp_display_build_batch* batch, mp_display_tile* tile, u8* dst, u32 dst_stride) {
+    const mp_image_buffer* buffer = batch->buffer;
+    u32 x0 = tile->tx * MP_DISPLAY_TILE_SIZE;
+    u32 y0 = tile->ty * MP_DISPLAY_TILE_SIZE;
+    
+    if (batch->parallel_rows) {
+        mp_argb_convert_rect(buffer, x0, y0, tile->width, tile->height, dst, dst_stride);
+        return;
+    }
+    for (u32 y = 0; y < tile->height; y++) {
+        const u8* src = buffer->data + (size_t)(y0 + y) * buffer->stride + (size_t)x0 * buffer->bpp;
+        mp_argb_convert_span(src, batch->format, (u32*)(dst + (size_t)y * dst_stride), tile->width);
+    }
+}
+
+/* Level L from its (up to) four cached level L-1 children / 캐시된 하위 레벨 타일 4개로부터 생성 */
+static void mp_display_build_from_children(mp_display_build* build, u8* dst, u32 dst_stride) {
+    mp_display_tile* tile = build->tile;
+    
+    for (u32 y = 0; y < tile->height; y++) {
+        u32 j = y >= MP_DISPLAY_HALF_TILE;
+        u32 child_row = (y - j * MP_DISPLAY_HALF_TILE) * 2;
+        u32* out = (u32*)(dst + (size_t)y * dst_stride);
+        
+        for (u32 i = 0; i < 2; i++) {
+            u32 out_x = i * MP_DISPLAY_HALF_TILE;
+            if (out_x >= tile->width) break;
+            u32 out_w = tile->width - out_x < MP_DISPLAY_HALF_TILE ? tile->width - out_x : MP_DISPLAY_HALF_TILE;
+            
+            cairo_surface_t* child = build->children[j * 2 + i];
+            u32 cw = (u32)cairo_image_surface_get_width(child);
+            u32 ch = (u32)cairo_image_surface_get_height(child);
+            u32 cs = (u32)cairo_image_surface_get_stride(child);
+            const u8* cdata = cairo_image_surface_get_data(child);
+            u32 row1 = child_row + 1 < ch ? child_row + 1 : child_row; /* Odd last row / 홀수 마지막 행 */
+            
+            mp_display_halve_span((const u32*)(cdata + (size_t)child_row * cs), (const u32*)(cdata + (size_t)row1 * cs),
+                                  cw, out + out_x, out_w);
+        }
+    }
+}
+
+/* Level L straight from the buffer: exact area average of each 2^L block, taken over
+ * premultiplied pixels / 버퍼에서 직접 생성: 프리멀티플라이된 2^L 블록의 정확한 면적 평균 */
+static void mp_display_build_from_buffer(const mp_display_build_batch* batch, mp_display_tile* tile, u8* dst, u32 dst_stride) {
+    const mp_image_buffer* buffer = batch->buffer;
+    u32 level = tile->level;
+    u32 n = 1u << level;
+    u64 span = (u64)MP_DISPLAY_TILE_SIZE << level;
+    u64 sx0 = (u64)tile->tx * span;
+    u64 sy0 = (u64)tile->ty * span;
+    u32 src_w = (u32)(buffer->width - sx0 < span ? buffer->width - sx0 : span);
+    u64 acc[MP_DISPLAY_TILE_SIZE * 4];
+    u32 line[MP_DISPLAY_TILE_SIZE];
+    
+    for (u32 y = 0; y < tile->height; y++) {
+        u64 by0 = sy0 + (u64)y * n;
+        u32 rows = (u32)(buffer->height - by0 < n ? buffer->height - by0 : n);
+        memset(acc, 0, sizeof(u64) * 4 * tile->width);
+        
+        /* Convert each source row in tile-wide chunks, then fold columns into their block
+         * / 원본 행을 타일 폭 단위로 변환한 뒤 열을 블록별로 누적 */
+        for (u32 r = 0; r < rows; r++) {
+            const u8* src_row = buffer->data + (size_t)(by0 + r) * buffer->stride + (size_t)sx0 * buffer->bpp;
+            for (u32 c0 = 0; c0 < src_w; c0 += MP_DISPLAY_TILE_SIZE) {
+                u32 len = src_w - c0 < MP_DISPLAY_TILE_SIZE ? src_w - c0 : MP_DISPLAY_TILE_SIZE;
+                mp_argb_convert_span(src_row + (size_t)c0 * buffer->bpp, batch->format, line, len);
+                for (u32 k = 0; k < len; k++) {
+                    u64* a = &acc[((c0 + k) >> level) * 4];
+                    u32 v = line[k];
+                    a[0] += v >> 24;
+                    a[1] += (v >> 16) & 0xFF;
+                    a[2] += (v >> 8) & 0xFF;
+                    a[3] += v & 0xFF;
+                }
+            }
+        }
+        
+        u32* out = (u32*)(dst + (size_t)y * dst_stride);
+        for (u32 x = 0; x < tile->width; x++) {
+            u64 bx0 = (u64)x * n;
+            u64 cols = src_w - bx0 < n ? src_w - bx0 : n;
+            u64 count = cols * rows;
+            u64 half = count / 2;
+            const u64* a = &acc[x * 4];
+            out[x] = (u32)(((a[0] + half) / count) << 24 | ((a[1] + half) / count) << 16 |
+                           ((a[2] + half) / count) << 8 | ((a[3] + half) / count));
+        }
+    }
+}
+
+static void mp_display_build_tiles(void* ctx, u32 begin, u32 end) {
+    mp_display_build_batch* batch = (mp_display_build_batch*)ctx;
+    for (u32 i = begin; i < end; i++) {
+        if (batch->cancel && atomic_load_explicit(batch->cancel, memory_order_relaxed)) return;
+        mp_display_build* build = &batch->builds[i];
+        mp_display_tile* tile = build->tile;
+        u8* dst = cairo_image_surface_get_data(tile->surface);
+        u32 dst_stride = (u32)cairo_image_surface_get_stride(tile->surface);
+        
+        if (tile->level == 0) mp_display_build_base(batch, tile, dst, dst_stride);
+        else if (build->from_children) mp_display_build_from_children(build, dst, dst_stride);
+        else mp_display_build_from_buffer(batch, tile, dst, dst_stride);
+    }
+}
+
+/* Prepare a tile for building: allocate its surface and retain any cached children
+ * / 생성 준비: 서피스 할당 및 캐시된 하위 타일 유지 */
+static mp_bool mp_display_prepare_build(mp_display_cache* cache, const mp_image_buffer* buffer,
+                                        u32 level, u32 tx, u32 ty, mp_display_build* build) {
+    memset(build, 0, sizeof(*build));
+    
+    u32 lw = mp_display_level_extent(buffer->width, level);
+    u32 lh = mp_display_level_extent(buffer->height, level);
+    mp_display_tile* tile = (mp_display_tile*)mp_calloc(1, sizeof(mp_display_tile));
+    if (!tile) return MP_FALSE;
+    tile->level = level;
+    tile->tx = tx;
+    tile->ty = ty;
+    tile->width = lw - tx * MP_DISPLAY_TILE_SIZE < MP_DISPLAY_TILE_SIZE ? lw - tx * MP_DISPLAY_TILE_SIZE : MP_DISPLAY_TILE_SIZE;
+    tile->height = lh - ty * MP_DISPLAY_TILE_SIZE < MP_DISPLAY_TILE_SIZE ? lh - ty * MP_DISPLAY_TILE_SIZE : MP_DISPLAY_TILE_SIZE;
+    tile->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, (int)tile->width, (int)tile->height);
+    if (cairo_surface_status(tile->surface) != CAIRO_STATUS_SUCCESS) {
+        mp_display_tile_free(tile);
+        return MP_FALSE;
+    }
+    cairo_surface_flush(tile->surface);
+    build->tile = tile;
+    
+    if (level > 0) {
+        /* Children that exist at level L-1 must all be cached / 하위 레벨에 존재하는 자식이 모두 캐시되어 있어야 함 */
+        u32 cw = mp_display_level_extent(buffer->width, level - 1);
+        u32 chh = mp_display_level_extent(buffer->height, level - 1);
+        build->from_children = MP_TRUE;
+        for (u32 j = 0; j < 2; j++) {
+            for (u32 i = 0; i < 2; i++) {
+                u32 cx = tx * 2 + i, cy = ty * 2 + j;
+                if ((u64)cx * MP_DISPLAY_TILE_SIZE >= cw || (u64)cy * MP_DISPLAY_TILE_SIZE >= chh) continue;
+                mp_display_tile* child = mp_display_cache_find(cache, level - 1, cx, cy);
+                if (!child) {
+                    build->from_children = MP_FALSE;
+                    continue;
+                }
+                build->children[j * 2 + i] = cairo_surface_reference(child->surface);
+            }
+        }
+    }
+    return MP_TRUE;
+}
+
+static void mp_display_release_children(mp_display_build* build) {
+    for (u32 i = 0; i < 4; i++) {
+        if (build->children[i]) cairo_surface_destroy(build->children[i]);
+        build->children[i] = NULL;
+    }
+}
+
+static void mp_display_finish_build(mp_display_build* build) {
+    mp_display_release_children(build);
+    cairo_surface_mark_dirty(build->tile->surface);
+}
+
+/* ---------------------------------------------------------------------------------------
+ * Background builder / 백그라운드 생성
+ *
+ * A level tile whose children are not cached is averaged from the whole 2^L-square block
+ * of the buffer below it, so the first zoomed-out paint of a large image would read every
+ * pixel on the event thread. Those tiles go to the builder thread instead; the paint shows
+ * a coarser cached tile or a placeholder, and the pipe wakes the loop when they are ready.
+ * 자식이 캐시되지 않은 레벨 타일은 버퍼 전체를 읽어야 하므로 생성 스레드로 보내고, 그동안 더 거친 타일이나 자리 표시를 그립니다.
+ * ------------------------------------------------------------------------------------- */
+
+static void* mp_display_builder_main(void* arg) {
+    mp_display_cache* cache = (mp_display_cache*)arg;
+    
+    pthread_mutex_lock(&cache->lock);
+    for (;;) {
+        while (!cache->quit && cache->state != MP_DISPLAY_BUILDER_QUEUED) {
+            pthread_cond_wait(&cache->wake, &cache->lock);
+        }
+        if (cache->quit) break;
+        
+        cache->state = MP_DISPLAY_BUILDER_RUNNING;
+        mp_display_build_batch batch = cache->batch;
+        u32 count = cache->batch_count;
+        pthread_mutex_unlock(&cache->lock);
+        
+        mp_parallel_for(count, 1, mp_display_build_tiles, &batch);
+        
+        pthread_mutex_lock(&cache->lock);
+        cache->state = MP_DISPLAY_BUILDER_DONE;
+        pthread_cond_broadcast(&cache->idle);
+        
+        /* Pipe is non-blocking; a full pipe already means "wake up" / 파이프가 가득 차도 이미 깨우기 신호 */
+        u8 signal = 1;
+        ssize_t written = write(cache->notify[1], &signal, 1);
+        (void)written;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return NULL;
+}
+
+static void mp_display_builder_start(mp_display_cache* cache) {
+    cache->notify[0] = cache->notify[1] = -1;
+    atomic_init(&cache->cancel, MP_FALSE);
+    pthread_mutex_init(&cache->lock, NULL);
+    pthread_cond_init(&cache->wake, NULL);
+    pthread_cond_init(&cache->idle, NULL);
+    if (pipe(cache->notify) != 0) {
+        cache->notify[0] = cache->notify[1] = -1;
+        return;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(cache->notify[i], F_SETFL, fcntl(cache->notify[i], F_GETFL, 0) | O_NONBLOCK);
+        fcntl(cache->notify[i], F_SETFD, FD_CLOEXEC);
+    }
+    cache->thread_started = pthread_create(&cache->thread, NULL, mp_display_builder_main, cache) == 0;
+}
+
+/* Free a batch's tiles without caching them; the builder must not be running
+ * / 묶음의 타일을 캐시하지 않고 해제 (생성 스레드가 실행 중이 아니어야 함) */
+static void mp_display_discard_batch(mp_display_cache* cache) {
+    for (u32 b = 0; b < cache->batch_count; b++) {
+        mp_display_release_children(&cache->batch.builds[b]);
+        mp_display_tile_free(cache->batch.builds[b].tile);
+    }
+    mp_free(cache->batch.builds);
+    cache->batch.builds = NULL;
+    cache->batch.buffer = NULL;
+    cache->batch_count = 0;
+    cache->state = MP_DISPLAY_BUILDER_IDLE;
+}
+
+/* Hand `count` prepared builds to the builder, which owns them from now on
+ * / 준비된 생성 작업을 생성 스레드에 넘김 (이후 생성 스레드 소유) */
+static void mp_display_builder_submit(mp_display_cache* cache, const mp_image_buffer* buffer,
+                                      mp_display_build* builds, u32 count) {
+    pthread_mutex_lock(&cache->lock);
+    cache->batch = (mp_display_build_batch){ buffer, mp_argb_source_format(buffer), builds, MP_FALSE, &cache->cancel };
+    cache->batch_count = count;
+    cache->state = MP_DISPLAY_BUILDER_QUEUED;
+    pthread_cond_signal(&cache->wake);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+static mp_bool mp_display_builder_idle(mp_display_cache* cache) {
+    if (!cache->thread_started) return MP_FALSE;
+    pthread_mutex_lock(&cache->lock);
+    mp_bool idle = cache->state == MP_DISPLAY_BUILDER_IDLE;
+    pthread_mutex_unlock(&cache->lock);
+    return idle;
+}
+
+/* Coarsest-first search for a cached tile above `level` covering tile (tx, ty)
+ * / (tx, ty) 타일을 덮는 상위 레벨의 캐시된 타일 검색 */
+static mp_display_tile* mp_display_cache_find_coarser(mp_display_cache* cache, u32 level, u32 tx, u32 ty) {
+    for (u32 up = level + 1; up < MP_DISPLAY_MAX_LEVELS; up++) {
+        u32 shift = up - level;
+        mp_display_tile* tile = mp_display_cache_find(cache, up, tx >> shift, ty >> shift);
+        if (tile) return tile;
+        if (mp_display_level_extent(cache->width, up) <= MP_DISPLAY_TILE_SIZE &&
+            mp_display_level_extent(cache->height, up) <= MP_DISPLAY_TILE_SIZE) break;
+    }
+    return NULL;
+}
+
+/* Stand-in for a tile not built yet, over the device rectangle (x, y, w, h): the matching
+ * part of a coarser cached tile, upscaled, or a flat placeholder when there is none
+ * / 아직 없는 타일 대신 상위 캐시 타일의 해당 부분을 확대해 그리거나, 없으면 자리 표시 */
+static void mp_display_draw_stand_in(cairo_t* cr, const mp_display_tile* coarser, f64 scale, f64 origin_x, f64 origin_y,
+                                     f64 x, f64 y, f64 w, f64 h) {
+    cairo_save(cr);
+    cairo_rectangle(cr, x, y, w, h);
+    cairo_clip(cr);
+    if (coarser) {
+        f64 coarse_scale = scale * (f64)(1u << coarser->level);
+        f64 coarse_span = MP_DISPLAY_TILE_SIZE * coarse_scale;
+        cairo_translate(cr, origin_x + coarser->tx * coarse_span, origin_y + coarser->ty * coarse_span);
+        cairo_scale(cr, coarse_scale, coarse_scale);
+        cairo_set_source_surface(cr, coarser->surface, 0, 0);
+        cairo_pattern_set_extend(cairo_get_source(cr), CAIRO_EXTEND_PAD);
+    } else {
+        cairo_set_source_rgba(cr, 0.5, 0.5, 0.5, 0.35);
+    }
+    cairo_paint(cr);
+    cairo_restore(cr);
+}
+
+/* ---------------------------------------------------------------------------------------
+ * Public API / 공개 API
+ * ------------------------------------------------------------------------------------- */
+
+mp_display_cache* mp_display_cache_create(u32 budget_mb) {
+    mp_display_cache* cache = (mp_display_cache*)mp_calloc(1, sizeof(mp_display_cache));
+    if (!cache) return NULL;
+    cache->budget = (size_t)budget_mb << 20;
+    
+    /* Without the thread every tile is simply built while painting / 스레드가 없으면 그리는 중에 생성 */
+    mp_display_builder_start(cache);
+    return cache;
+}
+
+void mp_display_cache_cancel(mp_display_cache* cache) {
+    if (!cache || !cache->thread_started) return;
+    
+    pthread_mutex_lock(&cache->lock);
+    if (cache->state != MP_DISPLAY_BUILDER_IDLE) {
+        /* A queued batch never starts; a running one stops at its next tile
+         * / 대기 중인 묶음은 시작하지 않고, 실행 중인 묶음은 다음 타일에서 멈춤 */
+        atomic_store(&cache->cancel, MP_TRUE);
+        while (cache->state == MP_DISPLAY_BUILDER_RUNNING) pthread_cond_wait(&cache->idle, &cache->lock);
+        mp_display_discard_batch(cache);
+        atomic_store(&cache->cancel, MP_FALSE);
+    }
+    pthread_mutex_unlock(&cache->lock);
+}
+
+int mp_display_cache_fd(const mp_display_cache* cache) {
+    return cache ? cache->notify[0] : -1;
+}
+
+mp_bool mp_display_cache_dispatch(mp_display_cache* cache) {
+    if (!cache || cache->notify[0] == -1) return MP_FALSE;
+    
+    u8 drain[64];
+    while (read(cache->notify[0], drain, sizeof(drain)) > 0) {}
+    
+    pthread_mutex_lock(&cache->lock);
+    mp_bool ready = cache->state == MP_DISPLAY_BUILDER_DONE;
+    if (ready) {
+        for (u32 b = 0; b < cache->batch_count; b++) {
+            mp_display_finish_build(&cache->batch.builds[b]);
+            mp_display_cache_insert(cache, cache->batch.builds[b].tile);
+        }
+        mp_free(cache->batch.builds);
+        cache->batch.builds = NULL;
+        cache->batch.buffer = NULL;
+        cache->batch_count = 0;
+        cache->state = MP_DISPLAY_BUILDER_IDLE;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return ready;
+}
+
+void mp_display_cache_invalidate(mp_display_cache* cache) {
+    if (!cache) return;
+    mp_display_cache_cancel(cache);
+    while (cache->lru_tail) mp_display_cache_remove(cache, cache->lru_tail);
+}
+
+void mp_display_cache_invalidate_rect(mp_display_cache* cache, u32 x, u32 y, u32 width, u32 height) {
+    if (!cache || width == 0 || height == 0) return;
+    
+    /* Tiles in flight may cover the rectangle; the next paint asks again / 진행 중인 타일은 다음 그리기에서 다시 요청 */
+    mp_display_cache_cancel(cache);
+    
+    mp_display_tile* tile = cache->lru_head;
+    while (tile) {
+        mp_display_tile* next = tile->lru_next;
+        u64 span = (u64)MP_DISPLAY_TILE_SIZE << tile->level;
+        u64 tile_x = tile->tx * span;
+        u64 tile_y = tile->ty * span;
+        if (tile_x < (u64)x + width && (u64)x < tile_x + span &&
+            tile_y < (u64)y + height && (u64)y < tile_y + span) {
+            mp_display_cache_remove(cache, tile);
+        }
+        tile = next;
+    }
+}
+
+void mp_display_cache_destroy(mp_display_cache* cache) {
+    if (!cache) return;
+    mp_display_cache_invalidate(cache);
+    
+    if (cache->thread_started) {
+        pthread_mutex_lock(&cache->lock);
+        cache->quit = MP_TRUE;
+        pthread_cond_signal(&cache->wake);
+        pthread_mutex_unlock(&cache->lock);
+        pthread_join(cache->thread, NULL);
+    }
+    pthread_cond_destroy(&cache->idle);
+    pthread_cond_destroy(&cache->wake);
+    pthread_mutex_destroy(&cache->lock);
+    if (cache->notify[0] != -1) close(cache->notify[0]);
+    if (cache->notify[1] != -1) close(cache->notify[1]);
+    mp_free(cache);
+}
+
+size_t mp_display_cache_bytes(const mp_display_cache* cache) {
+    return cache ? cache->bytes : 0;
+}
+
+u32 mp_display_cache_level_for_scale(f64 scale, u32 width, u32 height) {
+    u32 level = 0;
+    u32 size = width > height ? width : height;
+    /* Go coarser while the next level still covers the scale and the image spans more than
+     * one tile / 다음 레벨이 배율을 충족하고 이미지가 타일 하나보다 클 때까지 거칠게 */
+    while (level + 1 < MP_DISPLAY_MAX_LEVELS && scale * (f64)(2u << level) <= 1.0 &&
+           mp_display_level_extent(size, level) > MP_DISPLAY_TILE_SIZE) {
+        level++;
+    }
+    return level;
+}
+
+mp_bool mp_display_cache_draw(mp_display_cache* cache, void* context, const mp_image_buffer* buffer, u32 width, u32 height,
+                              f64 scale, f64 origin_x, f64 origin_y,
+                              i32 clip_x, i32 clip_y, i32 clip_w, i32 clip_h) {
+    cairo_t* cr = (cairo_t*)context;
+    if (!cache || !cr || width == 0 || height == 0 || scale <= 0.0 || clip_w <= 0 || clip_h <= 0) return MP_TRUE;
+    if (buffer && (!buffer->data || buffer->width != width || buffer->height != height)) return MP_FALSE;
+    
+    /* Tiles of a rotated or cropped image no longer line up / 회전·자른 이미지의 타일은 더 이상 맞지 않음 */
+    if (width != cache->width || height != cache->height) {
+        mp_display_cache_invalidate(cache);
+        cache->width = width;
+        cache->height = height;
+    }
+    
+    u32 level = mp_display_cache_level_for_scale(scale, width, height);
+    f64 level_scale = scale * (f64)(1u << level);   /* Device pixels per level pixel / 레벨 픽셀당 장치 픽셀 */
+    f64 tile_span = MP_DISPLAY_TILE_SIZE * level_scale;
+    u32 tiles_x = (mp_display_level_extent(width, level) + MP_DISPLAY_TILE_SIZE - 1) / MP_DISPLAY_TILE_SIZE;
+    u32 tiles_y = (mp_display_level_extent(height, level) + MP_DISPLAY_TILE_SIZE - 1) / MP_DISPLAY_TILE_SIZE;
+    
+    /* Visible tile range / 보이는 타일 범위 */
+    f64 fx0 = floor((clip_x - origin_x) / tile_span);
+    f64 fy0 = floor((clip_y - origin_y) / tile_span);
+    f64 fx1 = floor((clip_x + clip_w - origin_x) / tile_span);
+    f64 fy1 = floor((clip_y + clip_h - origin_y) / tile_span);
+    if (fx1 < 0 || fy1 < 0 || fx0 >= tiles_x || fy0 >= tiles_y) return MP_TRUE;
+    u32 tx0 = fx0 < 0 ? 0 : (u32)fx0;
+    u32 ty0 = fy0 < 0 ? 0 : (u32)fy0;
+    u32 tx1 = fx1 >= tiles_x ? tiles_x - 1 : (u32)fx1;
+    u32 ty1 = fy1 >= tiles_y ? tiles_y - 1 : (u32)fy1;
+    
+    u32 count = (tx1 - tx0 + 1) * (ty1 - ty0 + 1);
+    cairo_surface_t** surfaces = (cairo_surface_t**)mp_calloc(count, sizeof(cairo_surface_t*));
+    mp_display_tile** coarser = (mp_display_tile**)mp_calloc(count, sizeof(mp_display_tile*));
+    mp_display_build* builds = (mp_display_build*)mp_calloc(count, sizeof(mp_display_build));
+    mp_display_build* deferred = (mp_display_build*)mp_calloc(count, sizeof(mp_display_build));
+    u32* build_slot = (u32*)mp_calloc(count, sizeof(u32));
+    if (!surfaces || !coarser || !builds || !deferred || !build_slot) {
+        mp_free(surfaces);
+        mp_free(coarser);
+        mp_free(builds);
+        mp_free(deferred);
+        mp_free(build_slot);
+        return MP_FALSE;
+    }
+    
+    /* Pass 1: cache hits are retained, misses are prepared. Misses that would be averaged
+     * from the buffer go to the builder when it is free / 1단계: 캐시 적중은 유지, 누락은 생성 준비
+     * (버퍼에서 평균해야 하는 누락은 생성 스레드가 비어 있으면 넘김) */
+    mp_bool complete = MP_TRUE;
+    mp_bool builder_idle = buffer && level > 0 && mp_display_builder_idle(cache);
+    
+    /* A view larger than half the budget would evict its own tiles as they arrive and ask
+     * again forever; such views keep building in place / 예산 절반보다 큰 뷰는 도착한 타일을 스스로
+     * 밀어내므로 그리는 중에 생성 */
+    mp_bool defer = cache->thread_started && (size_t)count * MP_DISPLAY_TILE_SIZE * MP_DISPLAY_TILE_SIZE * 4 <= cache->budget / 2;
+    u32 build_count = 0;
+    u32 deferred_count = 0;
+    for (u32 ty = ty0, i = 0; ty <= ty1; ty++) {
+        for (u32 tx = tx0; tx <= tx1; tx++, i++) {
+            mp_display_tile* tile = mp_display_cache_find(cache, level, tx, ty);
+            if (tile) {
+                surfaces[i] = cairo_surface_reference(tile->surface);
+                continue;
+            }
+            
+            mp_display_build* build = &builds[build_count];
+            if (buffer && mp_display_prepare_build(cache, buffer, level, tx, ty, build)) {
+                if (level == 0 || build->from_children || !defer) {
+                    build_slot[build_count++] = i;
+                    continue;
+                }
+                mp_display_release_children(build);
+                if (builder_idle) deferred[deferred_count++] = *build;
+                else mp_display_tile_free(build->tile);
+            }
+            complete = MP_FALSE;
+        }
+    }
+    
+    /* Pass 2: build all misses in parallel, one tile per task / 2단계: 누락 타일을 병렬로 생성 */
+    if (build_count > 0) {
+        mp_display_build_batch batch = { buffer, mp_argb_source_format(buffer), builds, build_count == 1, NULL };
+        mp_parallel_for(build_count, 1, mp_display_build_tiles, &batch);
+        for (u32 b = 0; b < build_count; b++) {
+            mp_display_finish_build(&builds[b]);
+            surfaces[build_slot[b]] = cairo_surface_reference(builds[b].tile->surface);
+            mp_display_cache_insert(cache, builds[b].tile);
+        }
+    }
+    if (deferred_count > 0) {
+        mp_display_builder_submit(cache, buffer, deferred, deferred_count);
+        deferred = NULL;
+    }
+    
+    /* Tiles still missing show the closest coarser cached tile / 여전히 없는 타일은 가장 가까운 상위 타일로 표시 */
+    for (u32 ty = ty0, i = 0; ty <= ty1; ty++) {
+        for (u32 tx = tx0; tx <= tx1; tx++, i++) {
+            if (!surfaces[i]) coarser[i] = mp_display_cache_find_coarser(cache, level, tx, ty);
+        }
+    }
+    
+    /* Pass 3: paint. Every tile shares the same level scale and unantialiased edges, so
+     * neighbours meet without seams / 3단계: 동일 배율과 비앤티앨리어싱 경계로 이음새 없이 그리기 */
+    cairo_save(cr);
+    cairo_set_antialias(cr, CAIRO_ANTIALIAS_NONE);
+    u32 lw = mp_display_level_extent(width, level);
+    u32 lh = mp_display_level_extent(height, level);
+    for (u32 ty = ty0, i = 0; ty <= ty1; ty++) {
+        for (u32 tx = tx0; tx <= tx1; tx++, i++) {
+            if (!surfaces[i]) {
+                u32 tw = lw - tx * MP_DISPLAY_TILE_SIZE < MP_DISPLAY_TILE_SIZE ? lw - tx * MP_DISPLAY_TILE_SIZE : MP_DISPLAY_TILE_SIZE;
+                u32 th = lh - ty * MP_DISPLAY_TILE_SIZE < MP_DISPLAY_TILE_SIZE ? lh - ty * MP_DISPLAY_TILE_SIZE : MP_DISPLAY_TILE_SIZE;
+                mp_display_draw_stand_in(cr, coarser[i], scale, origin_x, origin_y, origin_x + tx * tile_span,
+                                         origin_y + ty * tile_span, tw * level_scale, th * level_scale);
+                continue;
+            }
+            cairo_save(cr);
+            cairo_translate(cr, origin_x + tx * tile_span, origin_y + ty * tile_span);
+            cairo_scale(cr, level_scale, level_scale);
+            cairo_set_source_surface(cr, surfaces[i], 0, 0);
+            cairo_pattern_set_extend(cairo_get_source(cr), CAIRO_EXTEND_PAD);
+            cairo_rectangle(cr, 0, 0, cairo_image_surface_get_width(surfaces[i]), cairo_image_surface_get_height(surfaces[i]));
+            cairo_fill(cr);
+            cairo_restore(cr);
+            cairo_surface_destroy(surfaces[i]);
+        }
+    }
+    cairo_restore(cr);
+    
+    mp_free(surfaces);
+    mp_free(coarser);
+    mp_free(builds);
+    mp_free(deferred);
+    mp_free(build_slot);
+    return complete;
+}
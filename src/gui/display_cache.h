@@ -0,0 +1,62 @@
+#ifndef MANYPICTURES_DISPLAY_CACHE_H
+#define MANYPICTURES_DISPLAY_CACHE_H
+
+#include "../core/types.h"
+
+/* Tiled, viewport-only display cache / 타일 기반 뷰포트 전용 디스플레이 캐시
+ *
+ * The image is shown through MP_DISPLAY_TILE_SIZE-square ARGB32 tiles kept in an LRU keyed by
+ * (mip level, tx, ty). Level L tiles are 2^L-times downsampled: built from their four
+ * cached children when available, otherwise box-filtered straight from the image buffer
+ * on a builder thread, since that reads every pixel below the tile. Only tiles intersecting
+ * the viewport are ever converted, and the cache never holds more than its byte budget,
+ * so very large images pan and zoom in bounded memory.
+ * 뷰포트와 겹치는 타일만 변환하며 (밉 레벨, tx, ty) 키의 LRU로 메모리 예산 내에서 유지합니다.
+ * 버퍼에서 직접 평균하는 레벨 타일은 생성 스레드에서 만듭니다.
+ */
+
+#define MP_DISPLAY_TILE_SIZE 256
+#define MP_DISPLAY_MAX_LEVELS 16
+
+typedef struct mp_display_cache mp_display_cache;
+
+mp_display_cache* mp_display_cache_create(u32 budget_mb);
+void mp_display_cache_destroy(mp_display_cache* cache);
+
+/* Stop the builder and drop the tiles it was making. The builder keeps reading the buffer
+ * last passed to mp_display_cache_draw until this returns, so call it before that buffer
+ * is written or freed / 생성 중단 및 진행 중인 타일 폐기 (버퍼를 쓰거나 해제하기 전에 호출) */
+void mp_display_cache_cancel(mp_display_cache* cache);
+
+/* Readable when the builder finished tiles; mp_display_cache_dispatch caches them and
+ * reports whether any did (the view needs a repaint) / 생성 완료 시 읽기 가능 (dispatch가 캐시에 넣고 완료 여부 반환) */
+int mp_display_cache_fd(const mp_display_cache* cache);
+mp_bool mp_display_cache_dispatch(mp_display_cache* cache);
+
+/* Drop every tile after the image changed / 이미지 변경 후 모든 타일 제거 */
+void mp_display_cache_invalidate(mp_display_cache* cache);
+
+/* Drop only the tiles, at every level, covering the changed image rectangle
+ * / 변경된 이미지 사각형을 덮는 타일만 모든 레벨에서 제거 */
+void mp_display_cache_invalidate_rect(mp_display_cache* cache, u32 x, u32 y, u32 width, u32 height);
+
+/* Coarsest mip level still at least as detailed as `scale` / `scale` 이상의 해상도를 갖는 가장 거친 밉 레벨 */
+u32 mp_display_cache_level_for_scale(f64 scale, u32 width, u32 height);
+
+/* Paint a `width` x `height` image scaled by `scale` with its origin at (origin_x, origin_y),
+ * touching only tiles inside the device rectangle (clip_x, clip_y, clip_w, clip_h). Missing
+ * tiles are converted from `buffer`, or queued to the builder when they would be averaged
+ * from it; with `buffer` NULL (in use elsewhere) only cached tiles are drawn and the buffer
+ * is never read. A tile not available is drawn from a coarser cached one, or as a flat
+ * placeholder. A size different from the cached tiles drops them all first. Returns
+ * MP_TRUE if every visible tile was drawn. `cr` is a cairo_t*.
+ * / 클립 영역 안의 타일만 그림 (`buffer`가 NULL이면 버퍼를 읽지 않고 캐시된 타일만 사용,
+ * 없는 타일은 상위 캐시 타일이나 자리 표시로 대신함) */
+mp_bool mp_display_cache_draw(mp_display_cache* cache, void* cr, const mp_image_buffer* buffer, u32 width, u32 height,
+                              f64 scale, f64 origin_x, f64 origin_y,
+                              i32 clip_x, i32 clip_y, i32 clip_w, i32 clip_h);
+
+/* Bytes currently held / 현재 점유 바이트 */
+size_t mp_display_cache_bytes(const mp_display_cache* cache);
+
+#endif /* MANYPICTURES_DISPLAY_CACHE_H */
@@ -4,8 +4,10 @@
 #include "../core/memory.h"
 #include "../core/image.h"
 #include "../core/fast_io.h"
+#include "../core/trace.h"
 #include "../operations/color_ops.h"
 #include "../operations/edit_ops.h"
+#include "dir_scan.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -15,6 +17,7 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <math.h>
+#include <poll.h>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -29,11 +32,45 @@
 
 /* Forward declarations for Double Buffering / 더블 버퍼링을 위한 전방 선언 */
 static void mp_gui_request_repaint(mp_application* app);
-static void mp_gui_render_to_backbuffer(mp_application* app, int w, int h);
+static void mp_gui_request_repaint_area(mp_application* app, mp_gui_rect area);
+static void mp_gui_request_repaint_progress(mp_application* app);
+static void mp_gui_request_repaint_view(mp_application* app);
+static void mp_gui_render_to_backbuffer(mp_application* app, int w, int h, mp_gui_rect clip);
 static void mp_gui_draw_monster_bg(cairo_t* cr, int w, int h);
 static void mp_gui_update_image_surface(mp_application* app);
+static void mp_gui_update_image_region(mp_application* app, const mp_pixel_rect* region);
+static void mp_app_open_grid_selection(mp_application* app);
 void mp_image_record_history(mp_image* img, mp_operation_type op_type, const char* description);
 
+/* Rectangle Helpers / 사각형 헬퍼 */
+static mp_bool mp_gui_rect_empty(mp_gui_rect r) {
+    return r.width <= 0 || r.height <= 0;
+}
+
+static mp_gui_rect mp_gui_rect_union(mp_gui_rect a, mp_gui_rect b) {
+    if (mp_gui_rect_empty(a)) return b;
+    if (mp_gui_rect_empty(b)) return a;
+    i32 x0 = a.x < b.x ? a.x : b.x;
+    i32 y0 = a.y < b.y ? a.y : b.y;
+    i32 x1 = a.x + a.width > b.x + b.width ? a.x + a.width : b.x + b.width;
+    i32 y1 = a.y + a.height > b.y + b.height ? a.y + a.height : b.y + b.height;
+    return (mp_gui_rect){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+static mp_gui_rect mp_gui_rect_intersect(mp_gui_rect a, mp_gui_rect b) {
+    i32 x0 = a.x > b.x ? a.x : b.x;
+    i32 y0 = a.y > b.y ? a.y : b.y;
+    i32 x1 = a.x + a.width < b.x + b.width ? a.x + a.width : b.x + b.width;
+    i32 y1 = a.y + a.height < b.y + b.height ? a.y + a.height : b.y + b.height;
+    if (x1 <= x0 || y1 <= y0) return (mp_gui_rect){ 0, 0, 0, 0 };
+    return (mp_gui_rect){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+/* Image view area right of the sidebar / 사이드바 오른쪽의 이미지 뷰 영역 */
+static mp_gui_rect mp_gui_view_rect(int w, int h) {
+    return (mp_gui_rect){ 220, 60, w - 240, h - 80 };
+}
+
 /* Rounded Rectangle Helper / 라운드 사각형 헬퍼 */
 static void draw_rounded_rectangle(cairo_t* cr, double x, double y, double w, double h, double r) {
     cairo_new_sub_path(cr);
@@ -57,13 +94,13 @@ static void mp_gui_open_file_dialog_system(mp_application* app) {
         mp_fast_printf("[GUI] Dialog already open. / 대화 상자가 이미 열려 있습니다.\n");
         return;
     }
-
+    
     int pipefd[2];
     if (pipe(pipefd) == -1) {
         perror("pipe");
         return;
     }
-
+    
     pid_t pid = fork();
     if (pid == -1) {
         perror("fork");
@@ -71,7 +108,7 @@ static void mp_gui_open_file_dialog_system(mp_application* app) {
         close(pipefd[1]);
         return;
     }
-
+    
     if (pid == 0) {
         /* Child Process */
         close(pipefd[0]); /* Close read end */
@@ -82,7 +119,7 @@ static void mp_gui_open_file_dialog_system(mp_application* app) {
         int nullfd = open("/dev/null", O_WRONLY);
         dup2(nullfd, STDERR_FILENO);
         close(nullfd);
-
+        
         /* Try Zenity */
         execlp("zenity", "zenity", "--file-selection", "--title=Select Image / 이미지 선택", 
                "--file-filter=Images | *.jpg *.jpeg *.png *.bmp *.gif *.tiff *.webp", NULL);
@@ -90,7 +127,7 @@ static void mp_gui_open_file_dialog_system(mp_application* app) {
         /* If Zenity fails, try KDialog */
         execlp("kdialog", "kdialog", "--getopenfilename", ".", 
                "Image Files (*.jpg *.jpeg *.png *.bmp *.gif *.tiff *.webp)", NULL);
-
+        
         _exit(127); /* Command not found */
     } else {
         /* Parent Process */
@@ -108,10 +145,10 @@ static void mp_gui_open_file_dialog_system(mp_application* app) {
 
 static void mp_gui_check_dialog_result(mp_application* app) {
     if (app->dialog_fd == -1) return;
-
+    
     char buffer[1024];
     ssize_t bytes = read(app->dialog_fd, buffer, sizeof(buffer) - 1);
-
+    
     if (bytes > 0) {
         buffer[bytes] = '\0';
         /* Remove newline */
@@ -119,12 +156,11 @@ static void mp_gui_check_dialog_result(mp_application* app) {
         if (newline) *newline = '\0';
         
         if (strlen(buffer) > 0) {
-            mp_app_load_image(app, buffer);
-            /* Force redraw using the new flicker-free method / 새로운 깜빡임 방지 방식을 사용하여 강제 다시 그리기 */
-            mp_gui_request_repaint(app);
+            /* Repaints the spinner, and the view once decoded / 스피너와 디코딩 후 뷰를 다시 그림 */
+            mp_app_load_image_async(app, buffer);
         }
     }
-
+    
     if (bytes != -1 || (bytes == -1 && errno != EAGAIN && errno != EWOULDBLOCK)) {
         /* EOF or Error (pipe closed by child exit) */
         
@@ -184,6 +220,35 @@ void mp_gui_shutdown(void) {
     mp_fast_printf("GUI shutdown completed / GUI 종료 완료\n");
 }
 
+/* Back buffer: an MIT-SHM image when the server allows it, so presenting is a shared memory
+ * copy, otherwise a plain image surface pushed through Xlib. MP_NO_SHM forces the latter.
+ * / 백 버퍼: 가능하면 MIT-SHM 이미지, 아니면 Xlib로 전송하는 일반 이미지 서피스 */
+static void mp_window_create_back_buffer(mp_window* window, u32 width, u32 height) {
+    window->shm_image = NULL;
+    if (!getenv("MP_NO_SHM")) {
+        window->shm_image = mp_shm_image_create(g_display, window->x_window, width, height);
+    }
+    
+    if (window->shm_image) {
+        window->back_surface = cairo_image_surface_create_for_data(mp_shm_image_data(window->shm_image),
+                                                                   CAIRO_FORMAT_ARGB32, (int)width, (int)height,
+                                                                   (int)mp_shm_image_stride(window->shm_image));
+    } else {
+        window->back_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, (int)width, (int)height);
+    }
+    window->back_context = cairo_create((cairo_surface_t*)window->back_surface);
+}
+
+static void mp_window_destroy_back_buffer(mp_window* window) {
+    /* The surface points into the segment, so it goes first / 서피스가 세그먼트를 가리키므로 먼저 해제 */
+    if (window->back_context) cairo_destroy((cairo_t*)window->back_context);
+    if (window->back_surface) cairo_surface_destroy((cairo_surface_t*)window->back_surface);
+    mp_shm_image_destroy(window->shm_image);
+    window->back_context = NULL;
+    window->back_surface = NULL;
+    window->shm_image = NULL;
+}
+
 mp_window* mp_window_create(const char* title, u32 width, u32 height) {
     if (!g_display) return NULL;
     
@@ -212,8 +277,8 @@ mp_window* mp_window_create(const char* title, u32 width, u32 height) {
     window->cairo_context = cairo_create((cairo_surface_t*)window->cairo_surface);
     
     /* Create Back Buffer / 백 버퍼 생성 */
-    window->back_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
-    window->back_context = cairo_create((cairo_surface_t*)window->back_surface);
+    mp_window_create_back_buffer(window, width, height);
+    mp_fast_printf("[GUI] Presentation / 화면 출력: %s\n", window->shm_image ? "MIT-SHM" : "Xlib");
     
     /* Disable Background Clearing to prevent flickering / 깜빡임 방지를 위해 배경 지우기 비활성화 */
     XSetWindowAttributes swa;
@@ -226,8 +291,7 @@ mp_window* mp_window_create(const char* title, u32 width, u32 height) {
 void mp_window_destroy(mp_window* window) {
     if (!window) return;
     
-    if (window->back_context) cairo_destroy((cairo_t*)window->back_context);
-    if (window->back_surface) cairo_surface_destroy((cairo_surface_t*)window->back_surface);
+    mp_window_destroy_back_buffer(window);
     if (window->cairo_context) cairo_destroy((cairo_t*)window->cairo_context);
     if (window->cairo_surface) cairo_surface_destroy((cairo_surface_t*)window->cairo_surface);
     if (window->x_window) XDestroyWindow(g_display, window->x_window);
@@ -423,57 +487,23 @@ static void mp_gui_draw_sidebar(cairo_t* cr, int h, mp_language_mode mode) {
     }
 }
 
-static void mp_gui_update_image_surface(mp_application* app) {
-    if (!app || !app->current_image || !app->current_image->buffer) return;
-    
-    if (app->image_surface) {
-        cairo_surface_destroy((cairo_surface_t*)app->image_surface);
-        app->image_surface = NULL;
-    }
-    
-    int w = app->current_image->buffer->width;
-    int h = app->current_image->buffer->height;
-    
-    /* Cairo expects CAIRO_FORMAT_ARGB32 (B G R A in little endian) */
-    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, w, h);
-    int stride = cairo_image_surface_get_stride(surface);
-    unsigned char* data = cairo_image_surface_get_data(surface);
-    unsigned char* src = app->current_image->buffer->data;
-    
-    /* CRITICAL FIX: Handle stride for large images to prevent overlapping/stripes */
-    /* 대형 이미지의 스트라이드를 처리하여 중첩/줄무늬 현상 방지 */
-    /* Extreme optimization: Unrolling + 32-bit writes / 극한 최적화: 언롤링 + 32비트 쓰기 */
-    for (int y = 0; y < h; y++) {
-        u8* restrict row = data + y * stride;
-        u8* restrict src_row = src + y * app->current_image->buffer->stride;
-        int x = 0;
-        
-        #pragma GCC unroll 4
-        for (; x <= w - 4; x += 4) {
-            /* Use 32-bit writes to minimize bus traffic / 버스 트래픽 최소화를 위해 32비트 쓰기 사용 */
-            /* ARGB Little Endian: 0xAARRGGBB -> Memory [0]=B, [1]=G, [2]=R, [3]=A */
-            *((u32*)(row + 0)) = (0xFFU << 24) | (src_row[0] << 16) | (src_row[1] << 8) | src_row[2];
-            *((u32*)(row + 4)) = (0xFFU << 24) | (src_row[3] << 16) | (src_row[4] << 8) | src_row[5];
-            *((u32*)(row + 8)) = (0xFFU << 24) | (src_row[6] << 16) | (src_row[7] << 8) | src_row[8];
-            *((u32*)(row + 12)) = (0xFFU << 24) | (src_row[9] << 16) | (src_row[10] << 8) | src_row[11];
-            row += 16; src_row += 12;
-        }
-        for (; x < w; x++) {
-            *((u32*)row) = (0xFFU << 24) | (src_row[0] << 16) | (src_row[1] << 8) | src_row[2];
-            row += 4; src_row += 3;
-        }
-    }
-    
-    cairo_surface_mark_dirty(surface);
-    app->image_surface = surface;
+/* Record the size of the image being shown. Called on the event thread while no job runs,
+ * so drawing during a job never has to look at a buffer the worker may be replacing
+ * / 표시 중인 이미지 크기 기록. 작업이 없을 때 이벤트 스레드에서 호출되므로 작업 중 그리기는
+ * 작업 스레드가 교체 중인 버퍼를 보지 않음 */
+static void mp_gui_snapshot_geometry(mp_application* app) {
+    const mp_image_buffer* buffer = app->current_image ? app->current_image->buffer : NULL;
+    app->shown_width = buffer ? buffer->width : 0;
+    app->shown_height = buffer ? buffer->height : 0;
 }
 
-static void mp_gui_draw_image(cairo_t* cr, mp_application* app, int w, int h) {
-    if (!app || !app->current_image || !app->image_surface) return;
+/* Scale and window origin of the current image / 현재 이미지의 배율과 창 내 원점 */
+static mp_bool mp_gui_image_placement(mp_application* app, int w, int h, double* out_scale, double* out_x, double* out_y) {
+    if (!app || !app->current_image) return MP_FALSE;
     
-    cairo_surface_t* img_surface = (cairo_surface_t*)app->image_surface;
-    int img_w = cairo_image_surface_get_width(img_surface);
-    int img_h = cairo_image_surface_get_height(img_surface);
+    int img_w = (int)app->shown_width;
+    int img_h = (int)app->shown_height;
+    if (img_w <= 0 || img_h <= 0) return MP_FALSE;
     
     /* Automatic "Fit to Window" Scaling / 자동 "창 맞춤" 크기 조정 */
     double scale = 1.0;
@@ -489,15 +519,71 @@ static void mp_gui_draw_image(cairo_t* cr, mp_application* app, int w, int h) {
     }
     
     /* Center in view area / 뷰 영역 중앙에 배치 */
-    double tx = 220 + (view_w - img_w * scale) / 2.0;
-    double ty = 60 + (view_h - img_h * scale) / 2.0;
+    *out_scale = scale;
+    *out_x = 220 + (view_w - img_w * scale) / 2.0;
+    *out_y = 60 + (view_h - img_h * scale) / 2.0;
+    return MP_TRUE;
+}
+
+/* Whole image replaced: drop every cached tile and repaint the view
+ * / 이미지 전체 교체: 캐시된 타일을 모두 버리고 뷰를 다시 그림 */
+static void mp_gui_update_image_surface(mp_application* app) {
+    if (!app) return;
     
-    cairo_save(cr);
-    cairo_translate(cr, tx, ty);
-    cairo_scale(cr, scale, scale);
-    cairo_set_source_surface(cr, img_surface, 0, 0);
-    cairo_paint(cr);
-    cairo_restore(cr);
+    mp_gui_snapshot_geometry(app);
+    mp_display_cache_invalidate(app->display_cache);
+    if (app->main_window) {
+        mp_gui_request_repaint_area(app, mp_gui_view_rect((int)app->main_window->base.width,
+                                                          (int)app->main_window->base.height));
+    }
+}
+
+/* Part of the image changed: drop only the tiles over `region` and repaint the window area
+ * it maps to / 이미지 일부 변경: 해당 영역의 타일만 버리고 대응하는 창 영역만 다시 그림 */
+static void mp_gui_update_image_region(mp_application* app, const mp_pixel_rect* region) {
+    if (!app || !app->current_image || !app->current_image->buffer || region->width == 0 || region->height == 0) return;
+    
+    const mp_image_buffer* buffer = app->current_image->buffer;
+    if (buffer->width != app->shown_width || buffer->height != app->shown_height ||
+        (region->x == 0 && region->y == 0 && region->width >= buffer->width && region->height >= buffer->height)) {
+        /* Also covers a size change, where the old extent must be cleared / 크기 변경 시 이전 영역도 지워야 함 */
+        mp_gui_update_image_surface(app);
+        return;
+    }
+    
+    mp_display_cache_invalidate_rect(app->display_cache, region->x, region->y, region->width, region->height);
+    if (!app->main_window) return;
+    
+    int w = (int)app->main_window->base.width;
+    int h = (int)app->main_window->base.height;
+    double scale, tx, ty;
+    if (!mp_gui_image_placement(app, w, h, &scale, &tx, &ty)) return;
+    
+    /* Round outwards so filtered edge pixels are included / 필터링된 가장자리 픽셀 포함을 위해 바깥으로 반올림 */
+    i32 x0 = (i32)floor(tx + region->x * scale) - 1;
+    i32 y0 = (i32)floor(ty + region->y * scale) - 1;
+    i32 x1 = (i32)ceil(tx + (region->x + region->width) * scale) + 1;
+    i32 y1 = (i32)ceil(ty + (region->y + region->height) * scale) + 1;
+    mp_gui_rect area = { x0, y0, x1 - x0, y1 - y0 };
+    mp_gui_request_repaint_area(app, mp_gui_rect_intersect(area, mp_gui_view_rect(w, h)));
+}
+
+static void mp_gui_draw_image(cairo_t* cr, mp_application* app, int w, int h, mp_gui_rect clip) {
+    MP_TRACE_SCOPE("gui.draw_image");
+    double scale, tx, ty;
+    if (!mp_gui_image_placement(app, w, h, &scale, &tx, &ty)) return;
+    
+    mp_gui_rect area = mp_gui_rect_intersect(clip, mp_gui_view_rect(w, h));
+    if (mp_gui_rect_empty(area)) return;
+    
+    /* Only tiles intersecting the damaged part of the view are converted and painted. While
+     * a job runs the worker may rewrite or replace the buffer, so it is not touched at all:
+     * cached tiles are shown at the geometry recorded before the job started.
+     * / 뷰의 손상 영역과 겹치는 타일만 변환해 그림. 작업 중에는 버퍼를 전혀 건드리지 않고
+     * 작업 시작 전 기록한 크기로 캐시된 타일만 표시 */
+    const mp_image_buffer* source = mp_worker_busy(app->worker) ? NULL : app->current_image->buffer;
+    mp_display_cache_draw(app->display_cache, cr, source, app->shown_width, app->shown_height, scale, tx, ty,
+                          area.x, area.y, area.width, area.height);
 }
 
 
@@ -532,8 +618,80 @@ static void mp_gui_draw_monster_bg(cairo_t* cr, int w, int h) {
     cairo_show_text(cr, title);
 }
 
-static void mp_gui_render_to_backbuffer(mp_application* app, int w, int h) {
+/* Window area covered by the progress panel, stroke included / 진행 패널이 덮는 창 영역 (테두리 포함) */
+static mp_gui_rect mp_gui_progress_rect(int w, int h) {
+    int cx = 220 + (w - 240) / 2;
+    int cy = 60 + (h - 80) / 2;
+    return (mp_gui_rect){ cx - 172, cy - 62, 344, 124 };
+}
+
+/* Indeterminate spinner shown while the worker runs; decoders report no fractional progress
+ * / 작업 중 표시되는 무한 스피너 (디코더는 진행률을 보고하지 않음) */
+static void mp_gui_draw_progress(cairo_t* cr, mp_application* app, int w, int h) {
+    if (!mp_worker_busy(app->worker)) return;
+    
+    f64 elapsed = mp_worker_elapsed(app->worker);
+    double cx = 220 + (w - 240) / 2.0;
+    double cy = 60 + (h - 80) / 2.0;
+    
+    /* Glass panel / 유리 패널 */
+    draw_rounded_rectangle(cr, cx - 170, cy - 60, 340, 120, 16);
+    cairo_set_source_rgba(cr, 0.05, 0.05, 0.1, 0.75);
+    cairo_fill_preserve(cr);
+    cairo_set_source_rgba(cr, 1, 1, 1, 0.25);
+    cairo_set_line_width(cr, 1.2);
+    cairo_stroke(cr);
+    
+    /* Rotating arc / 회전하는 호 */
+    double angle = elapsed * 2.0 * M_PI * 0.8;
+    cairo_set_line_width(cr, 4.0);
+    cairo_set_source_rgba(cr, 1, 1, 1, 0.15);
+    cairo_arc(cr, cx - 120, cy, 18, 0, 2 * M_PI);
+    cairo_stroke(cr);
+    cairo_set_source_rgb(cr, 0.4, 0.8, 1.0);
+    cairo_arc(cr, cx - 120, cy, 18, angle, angle + M_PI * 0.6);
+    cairo_stroke(cr);
+    
+    /* Label and elapsed time / 라벨 및 경과 시간 */
+    char elapsed_text[32];
+    snprintf(elapsed_text, sizeof(elapsed_text), "%.1f s", elapsed);
+    cairo_select_font_face(cr, g_system_font, CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
+    cairo_set_font_size(cr, 13);
+    cairo_set_source_rgb(cr, 1, 1, 1);
+    cairo_move_to(cr, cx - 85, cy - 4);
+    cairo_show_text(cr, mp_worker_label(app->worker));
+    cairo_set_font_size(cr, 11);
+    cairo_set_source_rgb(cr, 0.6, 0.6, 0.6);
+    cairo_move_to(cr, cx - 85, cy + 16);
+    cairo_show_text(cr, elapsed_text);
+}
+
+/* Background and sidebar only change with the window size or language, so they are drawn
+ * once into their own surface / 배경과 사이드바는 창 크기나 언어가 바뀔 때만 다시 그림 */
+static cairo_surface_t* mp_gui_chrome_surface(mp_application* app, int w, int h) {
+    cairo_surface_t* chrome = (cairo_surface_t*)app->chrome_surface;
+    if (chrome && cairo_image_surface_get_width(chrome) == w && cairo_image_surface_get_height(chrome) == h &&
+        app->chrome_language == app->language_mode) {
+        return chrome;
+    }
+    
+    MP_TRACE_SCOPE("gui.chrome");
+    if (chrome) cairo_surface_destroy(chrome);
+    chrome = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, w, h);
+    cairo_t* cr = cairo_create(chrome);
+    mp_gui_draw_monster_bg(cr, w, h);
+    mp_gui_draw_sidebar(cr, h, app->language_mode);
+    cairo_destroy(cr);
+    cairo_surface_flush(chrome);
+    
+    app->chrome_surface = chrome;
+    app->chrome_language = app->language_mode;
+    return chrome;
+}
+
+static void mp_gui_render_to_backbuffer(mp_application* app, int w, int h, mp_gui_rect clip) {
     if (!app || !app->main_window || !app->main_window->back_context) return;
+    MP_TRACE_SCOPE("gui.render");
     cairo_t* cr = (cairo_t*)app->main_window->back_context;
     
     /* Reset state / 상태 초기화 */
@@ -541,26 +699,91 @@ static void mp_gui_render_to_backbuffer(mp_application* app, int w, int h) {
     cairo_new_path(cr);
     cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
     
+    /* Everything below stays inside the damaged area / 아래 그리기는 모두 손상 영역 안으로 제한 */
+    cairo_save(cr);
+    cairo_rectangle(cr, clip.x, clip.y, clip.width, clip.height);
+    cairo_clip(cr);
+    
     /* Draw to off-screen buffer / 오프스크린 버퍼에 그리기 */
-    mp_gui_draw_monster_bg(cr, w, h);
-    mp_gui_draw_sidebar(cr, h, app->language_mode);
-    if (app->current_image) {
-        mp_gui_draw_image(cr, app, w, h);
+    cairo_set_source_surface(cr, mp_gui_chrome_surface(app, w, h), 0, 0);
+    cairo_paint(cr);
+    if (app->grid_visible) {
+        mp_gui_rect view = mp_gui_view_rect(w, h);
+        mp_thumb_grid_draw(app->grid, cr, view.x, view.y, view.width, view.height, g_system_font);
+    } else if (app->current_image) {
+        mp_gui_draw_image(cr, app, w, h, clip);
     }
+    mp_gui_draw_progress(cr, app, w, h);
+    cairo_restore(cr);
+}
+
+/* Repaint scheduler: requests only accumulate the damaged area, and the main loop renders it
+ * once per batch of events / 다시 그리기 스케줄러: 요청은 손상 영역만 누적하고 메인 루프가 묶음당 한 번 렌더링 */
+static void mp_gui_request_repaint_area(mp_application* app, mp_gui_rect area) {
+    if (!app || !app->main_window || mp_gui_rect_empty(area)) return;
+    app->damage = mp_gui_rect_union(app->damage, area);
+    app->repaint_pending = MP_TRUE;
 }
 
 static void mp_gui_request_repaint(mp_application* app) {
     if (!app || !app->main_window) return;
-    XWindowAttributes wa;
-    XGetWindowAttributes(g_display, app->main_window->x_window, &wa);
-    mp_gui_render_to_backbuffer(app, wa.width, wa.height);
+    mp_gui_request_repaint_area(app, (mp_gui_rect){ 0, 0, (i32)app->main_window->base.width,
+                                                    (i32)app->main_window->base.height });
+}
+
+static void mp_gui_request_repaint_view(mp_application* app) {
+    if (!app || !app->main_window) return;
+    mp_gui_request_repaint_area(app, mp_gui_view_rect((int)app->main_window->base.width,
+                                                      (int)app->main_window->base.height));
+}
+
+static void mp_gui_request_repaint_progress(mp_application* app) {
+    if (!app || !app->main_window) return;
+    mp_gui_request_repaint_area(app, mp_gui_progress_rect((int)app->main_window->base.width,
+                                                          (int)app->main_window->base.height));
+}
+
+static void mp_gui_flush_repaint(mp_application* app) {
+    if (!app || !app->main_window || !app->repaint_pending) return;
+    MP_TRACE_SCOPE("gui.repaint");
+    
+    /* The server may still be reading the shared back buffer; the completion event wakes the
+     * loop again / 서버가 공유 백 버퍼를 읽는 중이면 완료 이벤트 후 다시 시도 */
+    if (mp_shm_image_busy(app->main_window->shm_image)) return;
+    app->repaint_pending = MP_FALSE;
+    
+    int w = (int)app->main_window->base.width;
+    int h = (int)app->main_window->base.height;
+    mp_gui_rect area = mp_gui_rect_intersect(app->damage, (mp_gui_rect){ 0, 0, w, h });
+    app->damage = (mp_gui_rect){ 0, 0, 0, 0 };
+    if (mp_gui_rect_empty(area)) return;
+    
+    mp_gui_render_to_backbuffer(app, w, h, area);
     
     /* Flush Cairo to backbuffer surface / Cairo를 백버퍼 서피스로 플러시 */
     cairo_surface_flush((cairo_surface_t*)app->main_window->back_surface);
     
-    /* Trigger Expose without clearing (background is None) / 지우지 않고 Expose 트리거 */
-    XClearArea(g_display, app->main_window->x_window, 0, 0, 0, 0, True);
-    XFlush(g_display);
+    /* Shared memory presents directly; Xlib goes through an Expose for the damaged area only
+     * (background is None) / 공유 메모리는 바로 표시, Xlib는 손상 영역에만 Expose 트리거 */
+    if (app->main_window->shm_image) {
+        mp_shm_image_put(app->main_window->shm_image, area.x, area.y, area.width, area.height);
+    } else {
+        XClearArea(g_display, app->main_window->x_window, area.x, area.y, (unsigned)area.width, (unsigned)area.height, True);
+    }
+}
+
+static void mp_gui_present(mp_application* app, mp_gui_rect area) {
+    if (!app->main_window) return;
+    MP_TRACE_SCOPE("gui.present");
+    
+    if (app->main_window->shm_image) {
+        mp_shm_image_put(app->main_window->shm_image, area.x, area.y, area.width, area.height);
+    } else if (app->main_window->cairo_context && app->main_window->back_surface) {
+        cairo_t* cr = (cairo_t*)app->main_window->cairo_context;
+        cairo_set_source_surface(cr, (cairo_surface_t*)app->main_window->back_surface, 0, 0);
+        cairo_rectangle(cr, area.x, area.y, area.width, area.height);
+        cairo_fill(cr);
+    }
 }
 
 void mp_gui_run(mp_application* app) {
@@ -572,17 +795,24 @@ void mp_gui_run(mp_application* app) {
     
     /* Allow mouse and resize events / 마우스 및 크기 조정 이벤트 허용 */
     XSelectInput(g_display, app->main_window->x_window, ExposureMask | KeyPressMask | ButtonPressMask | StructureNotifyMask | SubstructureNotifyMask);
-
+    
     /* Initial render */
     XWindowAttributes wa;
     XGetWindowAttributes(g_display, app->main_window->x_window, &wa);
-    mp_gui_render_to_backbuffer(app, wa.width, wa.height);
-
+    app->main_window->base.width = (u32)wa.width;
+    app->main_window->base.height = (u32)wa.height;
+    mp_gui_render_to_backbuffer(app, wa.width, wa.height, (mp_gui_rect){ 0, 0, wa.width, wa.height });
+    
     /* Init blocking state */
     app->dialog_fd = -1;
     app->dialog_pid = -1;
-
+    
+    u32 progress_frame = 0;
+    
     while (!quit) {
+        mp_gui_rect exposed = { 0, 0, 0, 0 };
+        
+        /* Drain everything already queued so one batch yields one frame / 대기 중인 이벤트를 모두 처리하여 묶음당 한 프레임 */
         while (XPending(g_display) > 0) {
             XNextEvent(g_display, &ev);
         
@@ -590,27 +820,26 @@ void mp_gui_run(mp_application* app) {
             case ConfigureNotify: {
                 int nw = ev.xconfigure.width;
                 int nh = ev.xconfigure.height;
+                /* Moves arrive as ConfigureNotify too; only a size change needs new surfaces
+                 * / 이동도 ConfigureNotify로 오므로 크기 변경 시에만 서피스 재생성 */
+                if ((u32)nw == app->main_window->base.width && (u32)nh == app->main_window->base.height) break;
+                app->main_window->base.width = (u32)nw;
+                app->main_window->base.height = (u32)nh;
+                
                 /* Resize main Cairo surface and backbuffer / 메인 Cairo 서피스 및 백버퍼 크기 조정 */
                 if (app->main_window->cairo_surface) {
                     cairo_xlib_surface_set_size((cairo_surface_t*)app->main_window->cairo_surface, nw, nh);
                 }
                 if (app->main_window->back_surface) {
-                    cairo_destroy((cairo_t*)app->main_window->back_context);
-                    cairo_surface_destroy((cairo_surface_t*)app->main_window->back_surface);
-                    app->main_window->back_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, nw, nh);
-                    app->main_window->back_context = cairo_create((cairo_surface_t*)app->main_window->back_surface);
-                    mp_gui_render_to_backbuffer(app, nw, nh);
+                    mp_window_destroy_back_buffer(app->main_window);
+                    mp_window_create_back_buffer(app->main_window, (u32)nw, (u32)nh);
+                    mp_gui_request_repaint(app);
                 }
                 break;
             }
             case Expose: {
-                if (ev.xexpose.count > 0) break;
-                
-                if (app->main_window && app->main_window->cairo_context && app->main_window->back_surface) {
-                    cairo_t* cr = (cairo_t*)app->main_window->cairo_context;
-                    cairo_set_source_surface(cr, (cairo_surface_t*)app->main_window->back_surface, 0, 0);
-                    cairo_paint(cr);
-                }
+                mp_gui_rect area = { ev.xexpose.x, ev.xexpose.y, ev.xexpose.width, ev.xexpose.height };
+                exposed = mp_gui_rect_union(exposed, area);
                 break;
             }
             case ButtonPress: {
@@ -631,24 +860,34 @@ void mp_gui_run(mp_application* app) {
                                 } else if (g_buttons[i].op_type == MP_OP_LANG_TOGGLE) {
                                     app->language_mode = (app->language_mode + 1) % 3;
                                     mp_fast_printf("[GUI] Language switched to mode %d / 언어 모드 %d로 전환됨\n", app->language_mode, app->language_mode);
-                                    mp_gui_request_repaint(app);
+                                    mp_gui_request_repaint_area(app, (mp_gui_rect){ 0, 0, 220, (i32)app->main_window->base.height });
                                 } else {
-                                    mp_app_apply_operation(app, g_buttons[i].op_type);
-                                    mp_gui_request_repaint(app);
+                                    /* The operation requests the area it changes / 연산이 변경 영역을 직접 요청 */
+                                    mp_app_apply_operation_async(app, g_buttons[i].op_type);
                                 }
                             }
                         }
+                    } else if (app->grid_visible) {
+                        /* Clicking a thumbnail opens it / 썸네일을 누르면 열기 */
+                        i32 index = mp_thumb_grid_hit(app->grid, x, y);
+                        if (index >= 0) {
+                            mp_thumb_grid_select(app->grid, index);
+                            mp_app_open_grid_selection(app);
+                        }
                     }
+                } else if (app->grid_visible && (ev.xbutton.button == 4 || ev.xbutton.button == 5)) {
+                    mp_thumb_grid_scroll(app->grid, ev.xbutton.button == 4 ? -MP_THUMB_GRID_CELL / 2 : MP_THUMB_GRID_CELL / 2);
+                    mp_gui_request_repaint_view(app);
                 } else if (ev.xbutton.button == 4) { /* Scroll Up -> Zoom In */
                     app->fit_to_window = MP_FALSE;
                     app->zoom_level *= 1.1f;
                     if (app->zoom_level > 10.0f) app->zoom_level = 10.0f;
-                    mp_gui_request_repaint(app);
+                    mp_gui_request_repaint_view(app);
                 } else if (ev.xbutton.button == 5) { /* Scroll Down -> Zoom Out */
                     app->fit_to_window = MP_FALSE;
                     app->zoom_level /= 1.1f;
                     if (app->zoom_level < 0.01f) app->zoom_level = 0.01f;
-                    mp_gui_request_repaint(app);
+                    mp_gui_request_repaint_view(app);
                 }
                 break;
             }
@@ -657,45 +896,129 @@ void mp_gui_run(mp_application* app) {
                 KeySym sym = XLookupKeysym(xkey, 0);
                 mp_bool ctrl = (xkey->state & ControlMask) != 0;
                 mp_bool shift = (xkey->state & ShiftMask) != 0;
-
+                
                 if (ctrl) {
                     if (sym == XK_z || sym == XK_Z) {
                         if (shift) mp_app_redo(app);
                         else mp_app_undo(app);
-                        mp_gui_request_repaint(app);
                     } else if (sym == XK_y || sym == XK_Y) {
                         mp_app_redo(app);
-                        mp_gui_request_repaint(app);
                     } else if (sym == XK_o || sym == XK_O) {
                         mp_gui_open_file_dialog_system(app);
                     } else if (sym == XK_equal || sym == XK_plus || sym == XK_KP_Add) {
                         app->fit_to_window = MP_FALSE;
                         app->zoom_level *= 1.1f;
                         if (app->zoom_level > 10.0f) app->zoom_level = 10.0f;
-                        mp_gui_request_repaint(app);
+                        mp_gui_request_repaint_view(app);
                     } else if (sym == XK_minus || sym == XK_underscore || sym == XK_KP_Subtract) {
                         app->fit_to_window = MP_FALSE;
                         app->zoom_level /= 1.1f;
                         if (app->zoom_level < 0.01f) app->zoom_level = 0.01f;
-                        mp_gui_request_repaint(app);
+                        mp_gui_request_repaint_view(app);
                     } else if (sym == XK_0 || sym == XK_KP_0) {
                         app->fit_to_window = MP_TRUE;
                         app->zoom_level = 1.0f;
-                        mp_gui_request_repaint(app);
+                        mp_gui_request_repaint_view(app);
                     }
+                } else if (app->grid_visible) {
+                    /* Grid keys: arrows select, Enter opens, Escape or G returns / 그리드 키 */
+                    i32 page = ((i32)app->main_window->base.height - 80) / MP_THUMB_GRID_CELL;
+                    if (page < 1) page = 1;
+                    if (sym == XK_Escape || sym == XK_g || sym == XK_G) mp_app_toggle_grid(app);
+                    else if (sym == XK_q || sym == XK_Q) quit = MP_TRUE;
+                    else if (sym == XK_Return || sym == XK_KP_Enter) mp_app_open_grid_selection(app);
+                    else if (sym == XK_Left) mp_thumb_grid_move(app->grid, -1, 0);
+                    else if (sym == XK_Right) mp_thumb_grid_move(app->grid, 1, 0);
+                    else if (sym == XK_Up) mp_thumb_grid_move(app->grid, 0, -1);
+                    else if (sym == XK_Down) mp_thumb_grid_move(app->grid, 0, 1);
+                    else if (sym == XK_Prior) mp_thumb_grid_move(app->grid, 0, -page);
+                    else if (sym == XK_Next) mp_thumb_grid_move(app->grid, 0, page);
+                    else if (sym == XK_Home) mp_thumb_grid_select(app->grid, 0);
+                    else if (sym == XK_End) mp_thumb_grid_select(app->grid, (i32)mp_thumb_grid_count(app->grid) - 1);
+                    mp_gui_request_repaint_view(app);
                 } else {
                     if (sym == XK_Escape || sym == XK_q || sym == XK_Q) quit = MP_TRUE;
+                    else if (sym == XK_g || sym == XK_G) mp_app_toggle_grid(app);
+                    else if (sym == XK_r || sym == XK_R) mp_app_rotate(app, shift ? 270 : 90);
+                    else if (sym == XK_Right || sym == XK_Next || sym == XK_space) mp_app_navigate(app, 1);
+                    else if (sym == XK_Left || sym == XK_Prior || sym == XK_BackSpace) mp_app_navigate(app, -1);
                 }
                 break;
             }
             case DestroyNotify:
                 quit = MP_TRUE;
                 break;
+            default:
+                /* MIT-SHM completion: the back buffer may be drawn into again / 공유 메모리 표시 완료 */
+                mp_shm_image_handle_event(app->main_window->shm_image, &ev);
+                break;
+        }
+        }
+        
+        if (!mp_gui_rect_empty(exposed)) mp_gui_present(app, exposed);
+        
+        /* Worker completions and spinner frames also schedule repaints; completion handlers
+         * damage what they changed, this only covers the spinner
+         * / 작업 완료와 스피너 프레임도 다시 그리기 예약 (완료 처리기가 변경 영역을 직접 요청) */
+        if (mp_thumb_grid_dispatch(app->grid) && app->grid_visible) {
+            mp_gui_request_repaint_view(app);
+        }
+        if (mp_display_cache_dispatch(app->display_cache)) {
+            mp_gui_request_repaint_view(app);
+        }
+        if (mp_worker_dispatch(app->worker)) {
+            mp_gui_request_repaint_progress(app);
+        } else if (mp_worker_busy(app->worker)) {
+            /* Animate the progress indicator at ~15 fps / 진행 표시기를 약 15fps로 갱신 */
+            u32 frame = (u32)(mp_worker_elapsed(app->worker) * 15.0);
+            if (frame != progress_frame) {
+                progress_frame = frame;
+                mp_gui_request_repaint_progress(app);
+            }
+        }
+        
+        /* At most one render per wakeup; the resulting Expose presents it / 깨어날 때마다 최대 한 번 렌더링 */
+        mp_gui_flush_repaint(app);
+        XFlush(g_display);
+        if (quit) break;
+        
+        /* Events Xlib already buffered would not wake poll() / Xlib에 이미 버퍼링된 이벤트는 poll()을 깨우지 않음 */
+        if (XQLength(g_display) > 0) continue;
+        
+        /* Sleep until X input, the file dialog, the worker or the tile builder needs attention.
+         * Only a running job sets a timeout, to drive the spinner.
+         * / X 입력, 대화 상자, 작업 스레드, 타일 생성 스레드가 깨울 때까지 대기 */
+        struct pollfd fds[5];
+        nfds_t nfds = 0;
+        fds[nfds].fd = ConnectionNumber(g_display);
+        fds[nfds++].events = POLLIN;
+        if (app->worker) {
+            fds[nfds].fd = mp_worker_fd(app->worker);
+            fds[nfds++].events = POLLIN;
+        }
+        if (app->grid) {
+            fds[nfds].fd = mp_thumb_grid_fd(app->grid);
+            fds[nfds++].events = POLLIN;
+        }
+        if (mp_display_cache_fd(app->display_cache) != -1) {
+            fds[nfds].fd = mp_display_cache_fd(app->display_cache);
+            fds[nfds++].events = POLLIN;
         }
+        nfds_t dialog_slot = nfds;
+        if (app->dialog_fd != -1) {
+            fds[nfds].fd = app->dialog_fd;
+            fds[nfds++].events = POLLIN;
         }
         
-        mp_gui_check_dialog_result(app);
-        usleep(10000); /* 10ms poll */
+        int timeout = -1;
+        if (mp_worker_busy(app->worker)) {
+            f64 next = (progress_frame + 1) / 15.0 - mp_worker_elapsed(app->worker);
+            timeout = next > 0 ? (int)(next * 1000.0) + 1 : 0;
+        }
+        
+        if (poll(fds, nfds, timeout) > 0 && dialog_slot < nfds && fds[dialog_slot].revents) {
+            mp_gui_check_dialog_result(app);
+        }
     }
 }
 
@@ -709,87 +1032,72 @@ mp_application* mp_app_create(void) {
     app->running = MP_TRUE;
     
     /* Undo/Redo Init */
-    app->undo_count = 0;
-    app->redo_count = 0;
-    app->max_undo = 20;
-    app->undo_stack = (mp_image_buffer**)mp_calloc(app->max_undo, sizeof(mp_image_buffer*));
-    app->redo_stack = (mp_image_buffer**)mp_calloc(app->max_undo, sizeof(mp_image_buffer*));
-    
-    app->fit_to_window = MP_TRUE;
-    app->image_surface = NULL;
-    
-    return app;
-}
-
-static void mp_app_clear_redo(mp_application* app) {
-    for (int i = 0; i < app->redo_count; i++) {
-        mp_image_buffer_destroy(app->redo_stack[i]);
+    app->undo_budget_mb = MP_GUI_UNDO_BUDGET_MB;
+    const char* budget = getenv("MP_UNDO_BUDGET_MB");
+    if (budget && atoi(budget) > 0) app->undo_budget_mb = (u32)atoi(budget);
+    app->undo = mp_undo_store_create(app->undo_budget_mb);
+    if (!app->undo) { mp_window_destroy(app->main_window); mp_free(app); return NULL; }
+    
+    /* Without a worker thread everything simply runs inline / 작업 스레드가 없으면 즉시 실행 */
+    app->worker = mp_worker_create();
+    if (!app->worker) {
+        mp_fast_fprintf(2, "[GUI] Worker thread unavailable, decoding inline / 작업 스레드 없음, 동기 디코딩\n");
     }
-    app->redo_count = 0;
-}
-
-static void mp_app_push_undo(mp_application* app) {
-    if (!app || !app->current_image) return;
     
-    /* If full, shift */
-    if (app->undo_count == app->max_undo) {
-        mp_image_buffer_destroy(app->undo_stack[0]);
-        for (int i = 0; i < app->max_undo - 1; i++) {
-            app->undo_stack[i] = app->undo_stack[i+1];
-        }
-        app->undo_count--;
+    /* Display Tile Cache Init / 표시 타일 캐시 초기화 */
+    u32 display_budget_mb = MP_GUI_DISPLAY_BUDGET_MB;
+    const char* display_budget = getenv("MP_DISPLAY_BUDGET_MB");
+    if (display_budget && atoi(display_budget) > 0) display_budget_mb = (u32)atoi(display_budget);
+    app->display_cache = mp_display_cache_create(display_budget_mb);
+    if (!app->display_cache) {
+        mp_worker_destroy(app->worker);
+        mp_undo_store_destroy(app->undo);
+        mp_window_destroy(app->main_window);
+        mp_free(app);
+        return NULL;
     }
     
-    app->undo_stack[app->undo_count++] = mp_image_buffer_clone(app->current_image->buffer);
-    mp_app_clear_redo(app);
-}
-
-void mp_app_undo(mp_application* app) {
-    if (!app || !app->current_image || app->undo_count == 0) return;
-    
-    /* Push current to redo */
-    if (app->redo_count < app->max_undo) {
-        app->redo_stack[app->redo_count++] = app->current_image->buffer;
-    } else {
-        mp_image_buffer_destroy(app->current_image->buffer);
+    /* Next/previous relies on the prefetch thread / 이전/다음 탐색은 미리 읽기 스레드 필요 */
+    u32 prefetch_budget_mb = MP_GUI_PREFETCH_BUDGET_MB;
+    u32 prefetch_ahead = MP_GUI_PREFETCH_AHEAD;
+    const char* prefetch_budget = getenv("MP_PREFETCH_BUDGET_MB");
+    const char* ahead = getenv("MP_PREFETCH_AHEAD");
+    if (prefetch_budget && atoi(prefetch_budget) > 0) prefetch_budget_mb = (u32)atoi(prefetch_budget);
+    if (ahead && atoi(ahead) >= 0) prefetch_ahead = (u32)atoi(ahead);
+    app->prefetch = mp_prefetch_create(prefetch_budget_mb, prefetch_ahead);
+    if (!app->prefetch) {
+        mp_fast_fprintf(2, "[GUI] Prefetch thread unavailable, next/previous disabled / 미리 읽기 스레드 없음\n");
     }
     
-    /* Restore from undo */
-    app->current_image->buffer = app->undo_stack[--app->undo_count];
-    mp_gui_update_image_surface(app);
-    mp_image_record_history(app->current_image, MP_OP_UNDO, "Chronos-EXIF Undo");
-    mp_fast_printf("[GUI] Undo performed / 실행 취소됨 (%d left)\n", app->undo_count);
-}
-
-void mp_app_redo(mp_application* app) {
-    if (!app || !app->current_image || app->redo_count == 0) return;
-    
-    /* Push current to undo */
-    if (app->undo_count < app->max_undo) {
-        app->undo_stack[app->undo_count++] = app->current_image->buffer;
-    } else {
-        mp_image_buffer_destroy(app->current_image->buffer);
-    }
+    app->fit_to_window = MP_TRUE;
     
-    /* Restore from redo */
-    app->current_image->buffer = app->redo_stack[--app->redo_count];
-    mp_gui_update_image_surface(app);
-    mp_image_record_history(app->current_image, MP_OP_REDO, "Chronos-EXIF Redo");
-    mp_fast_printf("[GUI] Redo performed / 다시 실행됨 (%d left)\n", app->redo_count);
+    return app;
 }
 
 void mp_app_destroy(mp_application* app) {
     if (!app) return;
+    
+    /* Finish any in-flight job before tearing down what it touches / 진행 중인 작업을 먼저 완료 */
+    if (app->pending_load) mp_free(app->pending_load);
+    app->pending_load = NULL;
+    mp_worker_destroy(app->worker);
+    app->worker = NULL;
+    mp_prefetch_destroy(app->prefetch);
+    app->prefetch = NULL;
+    mp_thumb_grid_destroy(app->grid);
+    app->grid = NULL;
+    mp_thumb_cache_close(app->thumb_cache);
+    app->thumb_cache = NULL;
+    
+    mp_display_cache_cancel(app->display_cache);
     if (app->current_image) mp_image_destroy(app->current_image);
     if (app->current_file) mp_free(app->current_file);
-    if (app->image_surface) cairo_surface_destroy((cairo_surface_t*)app->image_surface);
+    mp_display_cache_destroy(app->display_cache);
+    if (app->chrome_surface) cairo_surface_destroy((cairo_surface_t*)app->chrome_surface);
     if (app->main_window) mp_window_destroy(app->main_window);
     
-    for (int i = 0; i < app->undo_count; i++) mp_image_buffer_destroy(app->undo_stack[i]);
-    for (int i = 0; i < app->redo_count; i++) mp_image_buffer_destroy(app->redo_stack[i]);
-    mp_free(app->undo_stack);
-    mp_free(app->redo_stack);
-
+    mp_undo_store_destroy(app->undo);
+    
     mp_free(app);
 }
 
@@ -835,28 +1143,27 @@ void mp_app_transition_to_cli(mp_application* app) {
 }
 
 
-mp_result mp_app_load_image(mp_application* app, const char* filepath) {
-    if (!app || !filepath) {
-        return MP_ERROR_INVALID_PARAM;
-    }
+/* Make a freshly decoded image the current one / 새로 디코딩된 이미지를 현재 이미지로 채택 */
+static void mp_app_adopt_image(mp_application* app, mp_image* image, const char* filepath) {
+    /* The old buffer is freed or handed to the prefetcher / 이전 버퍼는 해제되거나 미리 읽기로 넘어감 */
+    mp_display_cache_cancel(app->display_cache);
     
     /* Clear stacks when loading new image / 새로운 이미지 로드 시 스택 초기화 */
-    for (int i = 0; i < app->undo_count; i++) mp_image_buffer_destroy(app->undo_stack[i]);
-    for (int i = 0; i < app->redo_count; i++) mp_image_buffer_destroy(app->redo_stack[i]);
-    app->undo_count = 0;
-    app->redo_count = 0;
-
-    mp_image* image = mp_image_load(filepath);
-    if (!image) {
-        mp_fast_fprintf(2, "Failed to load image / 이미지 로드 실패: %s\n", filepath);
-        return MP_ERROR_FILE_NOT_FOUND;
-    }
+    mp_undo_store_clear(app->undo);
     
-    if (app->current_image) {
+    /* An unedited image goes back to the prefetcher so returning to it is instant
+     * / 편집하지 않은 이미지는 미리 읽기 캐시로 돌려 다시 돌아올 때 즉시 표시 */
+    if (app->current_image && app->prefetch && app->current_file && !app->current_image->modified) {
+        mp_prefetch_give(app->prefetch, app->current_file, app->current_image);
+    } else if (app->current_image) {
         mp_image_destroy(app->current_image);
     }
     
     app->current_image = image;
+    if (app->grid_visible) {
+        app->grid_visible = MP_FALSE;
+        mp_thumb_grid_pause(app->grid, MP_TRUE);
+    }
     mp_gui_update_image_surface(app);
     
     if (app->current_file) {
@@ -867,9 +1174,180 @@ mp_result mp_app_load_image(mp_application* app, const char* filepath) {
     mp_image_record_history(image, MP_OP_LOAD, "Loaded Image Artifact");
     mp_fast_printf("Image loaded / 이미지 로드됨: %ux%u\n", image->buffer->width, image->buffer->height);
     
+    u32 index, count;
+    if (mp_prefetch_position(app->prefetch, &index, &count)) {
+        mp_fast_printf("[GUI] %u / %u in folder / 폴더 내 위치\n", index + 1, count);
+    }
+}
+
+mp_result mp_app_load_image(mp_application* app, const char* filepath) {
+    if (!app || !filepath) {
+        return MP_ERROR_INVALID_PARAM;
+    }
+    
+    /* Never wait on the event thread for a prefetch in flight: take what is ready and
+     * decode the rest here. Waiting is left to the worker's load job.
+     * / 이벤트 스레드에서는 진행 중인 미리 읽기를 기다리지 않음 (대기는 작업 스레드의 로드 작업이 담당) */
+    mp_prefetch_set_current(app->prefetch, filepath);
+    mp_image* image = mp_prefetch_take(app->prefetch, filepath, MP_FALSE);
+    if (!image) image = mp_image_load(filepath);
+    if (!image) {
+        mp_fast_fprintf(2, "Failed to load image / 이미지 로드 실패: %s\n", filepath);
+        return MP_ERROR_FILE_NOT_FOUND;
+    }
+    
+    mp_app_adopt_image(app, image, filepath);
     return MP_SUCCESS;
 }
 
+typedef struct {
+    mp_application* app;
+    char* filepath;
+    mp_image* image;
+} mp_load_job;
+
+static mp_result mp_load_job_run(void* ctx) {
+    mp_load_job* job = (mp_load_job*)ctx;
+    /* A prefetch of this very file may be under way; finishing it beats starting over
+     * / 같은 파일을 미리 읽는 중이면 처음부터 다시 디코딩하지 않고 기다림 */
+    job->image = mp_prefetch_take(job->app->prefetch, job->filepath, MP_TRUE);
+    if (!job->image) job->image = mp_image_load(job->filepath);
+    return job->image ? MP_SUCCESS : MP_ERROR_FILE_NOT_FOUND;
+}
+
+/* A file picked while a job ran loads once it finishes / 작업 중 선택된 파일을 작업이 끝나면 로드 */
+static void mp_app_start_pending_load(mp_application* app) {
+    if (!app->pending_load) return;
+    char* next = app->pending_load;
+    app->pending_load = NULL;
+    mp_app_load_image_async(app, next);
+    mp_free(next);
+}
+
+static void mp_load_job_done(void* ctx, mp_result result) {
+    mp_load_job* job = (mp_load_job*)ctx;
+    mp_application* app = job->app;
+    
+    if (result == MP_SUCCESS) {
+        mp_app_adopt_image(app, job->image, job->filepath);
+    } else {
+        mp_fast_fprintf(2, "Failed to load image / 이미지 로드 실패: %s\n", job->filepath);
+    }
+    mp_free(job->filepath);
+    mp_free(job);
+    mp_app_start_pending_load(app);
+}
+
+mp_result mp_app_load_image_async(mp_application* app, const char* filepath) {
+    if (!app || !filepath) {
+        return MP_ERROR_INVALID_PARAM;
+    }
+    if (!app->worker) {
+        return mp_app_load_image(app, filepath);
+    }
+    
+    /* Neighbours of the requested file start decoding now / 요청된 파일의 이웃을 지금부터 디코딩 */
+    mp_prefetch_set_current(app->prefetch, filepath);
+    
+    if (mp_worker_busy(app->worker)) {
+        /* Only the latest pick matters / 가장 최근 선택만 유지 */
+        if (app->pending_load) mp_free(app->pending_load);
+        app->pending_load = mp_strdup(filepath);
+        mp_fast_printf("[GUI] Busy, load queued / 작업 중, 로드 대기: %s\n", filepath);
+        return MP_SUCCESS;
+    }
+    
+    /* Already decoded by the prefetcher: swap it in right away / 미리 디코딩된 이미지는 즉시 교체 */
+    mp_image* cached = mp_prefetch_take(app->prefetch, filepath, MP_FALSE);
+    if (cached) {
+        mp_app_adopt_image(app, cached, filepath);
+        return MP_SUCCESS;
+    }
+    
+    mp_load_job* job = (mp_load_job*)mp_calloc(1, sizeof(mp_load_job));
+    if (!job) return MP_ERROR_MEMORY;
+    job->app = app;
+    job->filepath = mp_strdup(filepath);
+    if (!job->filepath) {
+        mp_free(job);
+        return MP_ERROR_MEMORY;
+    }
+    
+    if (!mp_worker_submit(app->worker, "Loading image / 이미지 불러오는 중", mp_load_job_run, mp_load_job_done, job)) {
+        mp_free(job->filepath);
+        mp_free(job);
+        return mp_app_load_image(app, filepath);
+    }
+    mp_gui_request_repaint_progress(app);
+    mp_fast_printf("Decoding in background / 백그라운드 디코딩 중: %s\n", filepath);
+    return MP_SUCCESS;
+}
+
+mp_result mp_app_navigate(mp_application* app, i32 delta) {
+    if (!app || !app->prefetch || !app->current_file) {
+        return MP_ERROR_INVALID_PARAM;
+    }
+    
+    /* Step from the file being loaded, if any, so repeated keys keep moving / 로드 중인 파일 기준으로 이동 */
+    char* target = mp_prefetch_neighbor(app->prefetch, delta);
+    if (!target) return MP_ERROR_FILE_NOT_FOUND;
+    mp_result result = mp_app_load_image_async(app, target);
+    mp_free(target);
+    return result;
+}
+
+void mp_app_toggle_grid(mp_application* app) {
+    if (!app) return;
+    
+    /* Hidden grids stop generating but keep their thumbnails / 숨긴 그리드는 생성을 멈추되 썸네일은 유지 */
+    if (app->grid_visible) {
+        app->grid_visible = MP_FALSE;
+        mp_thumb_grid_pause(app->grid, MP_TRUE);
+        mp_gui_request_repaint_view(app);
+        return;
+    }
+    
+    char* prefix = app->current_file ? mp_dir_scan_prefix(app->current_file) : mp_strdup("");
+    if (!prefix) return;
+    if (app->grid && strcmp(mp_thumb_grid_prefix(app->grid), prefix) != 0) {
+        mp_thumb_grid_destroy(app->grid);
+        app->grid = NULL;
+    }
+    if (!app->thumb_cache) {
+        app->thumb_cache = mp_thumb_cache_open(NULL);
+        if (!app->thumb_cache) {
+            mp_fast_fprintf(2, "[GUI] Thumbnail cache unavailable, thumbnails kept in memory / 썸네일 캐시 없음, 메모리에만 보관\n");
+        }
+    }
+    if (!app->grid) app->grid = mp_thumb_grid_create(prefix, app->thumb_cache);
+    mp_free(prefix);
+    if (!app->grid) {
+        mp_fast_fprintf(2, "[GUI] Cannot list this folder / 폴더를 읽을 수 없습니다\n");
+        return;
+    }
+    
+    /* Start on the file being viewed / 보고 있던 파일에서 시작 */
+    for (u32 i = 0; app->current_file && i < mp_thumb_grid_count(app->grid); i++) {
+        if (strcmp(mp_thumb_grid_path(app->grid, (i32)i), app->current_file) == 0) {
+            mp_thumb_grid_select(app->grid, (i32)i);
+            break;
+        }
+    }
+    app->grid_visible = MP_TRUE;
+    mp_thumb_grid_pause(app->grid, MP_FALSE);
+    mp_gui_request_repaint_view(app);
+    mp_fast_printf("[GUI] Thumbnail grid: %u images / 썸네일 그리드: 이미지 %u개\n",
+                   mp_thumb_grid_count(app->grid), mp_thumb_grid_count(app->grid));
+}
+
+/* Leave the grid for the selected image / 선택한 이미지를 열고 그리드 닫기 */
+static void mp_app_open_grid_selection(mp_application* app) {
+    const char* path = mp_thumb_grid_path(app->grid, mp_thumb_grid_selected(app->grid));
+    if (!path) return;
+    mp_app_toggle_grid(app);
+    mp_app_load_image_async(app, path);
+}
+
 mp_result mp_app_save_image(mp_application* app, const char* filepath) {
     if (!app || !filepath || !app->current_image) {
         return MP_ERROR_INVALID_PARAM;
@@ -893,16 +1371,62 @@ mp_result mp_app_save_image(mp_application* app, const char* filepath) {
     return MP_SUCCESS;
 }
 
-mp_result mp_app_apply_operation(mp_application* app, mp_operation_type op_type) {
-    if (!app || !app->current_image) {
-        return MP_ERROR_INVALID_PARAM;
+/* Operations that only touch view state, run inline on the event thread
+ * / 뷰 상태만 변경하는 연산 (이벤트 스레드에서 즉시 실행) */
+static mp_bool mp_app_is_view_operation(mp_operation_type op_type) {
+    return op_type == MP_OP_LANG_TOGGLE || op_type == MP_OP_OPEN_DIALOG ||
+           op_type == MP_OP_ZOOM_IN || op_type == MP_OP_ZOOM_OUT || op_type == MP_OP_ZOOM_RESET ||
+           op_type == MP_OP_UNDO || op_type == MP_OP_REDO;
+}
+
+static mp_result mp_app_apply_view_operation(mp_application* app, mp_operation_type op_type) {
+    switch (op_type) {
+        case MP_OP_UNDO:
+            mp_app_undo(app);
+            return MP_SUCCESS;
+        
+        case MP_OP_REDO:
+            mp_app_redo(app);
+            return MP_SUCCESS;
+        
+        case MP_OP_ZOOM_IN:
+            app->fit_to_window = MP_FALSE;
+            app->zoom_level *= 1.2f;
+            if (app->zoom_level > 10.0f) app->zoom_level = 10.0f;
+            mp_gui_request_repaint_view(app);
+            return MP_SUCCESS;
+        
+        case MP_OP_ZOOM_OUT:
+            app->fit_to_window = MP_FALSE;
+            app->zoom_level /= 1.2f;
+            if (app->zoom_level < 0.01f) app->zoom_level = 0.01f;
+            mp_gui_request_repaint_view(app);
+            return MP_SUCCESS;
+        
+        case MP_OP_ZOOM_RESET:
+            app->fit_to_window = MP_TRUE;
+            app->zoom_level = 1.0f;
+            mp_gui_request_repaint_view(app);
+            return MP_SUCCESS;
+        
+        default:
+            return MP_ERROR_UNSUPPORTED;
     }
-    
+}
+
+/* Image work of an operation. Touches only current_image and the undo store, so it may
+ * run on the worker thread. `param` is the operation's parameter (rotation degrees) and
+ * `dirty` receives the image region it changed.
+ * / 현재 이미지와 실행 취소 저장소만 변경하므로 작업 스레드에서 실행 가능 (`param`은 회전 각도 등) */
+static mp_result mp_app_execute_operation(mp_application* app, mp_operation_type op_type, i32 param,
+                                          mp_pixel_rect* dirty) {
     mp_result result = MP_SUCCESS;
+    dirty->x = dirty->y = dirty->width = dirty->height = 0;
     
-    if (op_type != MP_OP_LANG_TOGGLE && op_type != MP_OP_OPEN_DIALOG && op_type != MP_OP_SAVE &&
-        op_type != MP_OP_ZOOM_IN && op_type != MP_OP_ZOOM_OUT && op_type != MP_OP_ZOOM_RESET) {
-        mp_app_push_undo(app);
+    /* Record before the pixels change / 픽셀 변경 전에 기록 */
+    mp_bool recorded = MP_FALSE;
+    if (op_type != MP_OP_SAVE) {
+        recorded = mp_undo_store_record(app->undo, app->current_image, op_type, param) == MP_SUCCESS;
     }
     
     switch (op_type) {
@@ -918,72 +1442,230 @@ mp_result mp_app_apply_operation(mp_application* app, mp_operation_type op_type)
             } else {
                  mp_app_save_image(app, "monster_artifact.png");
             }
-            return MP_SUCCESS;
+            break;
         case MP_OP_GRAYSCALE:
             mp_fast_printf("Applying grayscale conversion... / 그레이스케일 변환 적용 중...\n");
             result = mp_op_to_grayscale(app->current_image);
             break;
-            
+        
         case MP_OP_COLORIZE:
             mp_fast_printf("Applying colorization... / 컬러화 적용 중...\n");
             result = mp_op_to_color(app->current_image);
             break;
-            
+        
         case MP_OP_INVERT:
             mp_fast_printf("Applying color inversion... / 색상 반전 적용 중...\n");
             result = mp_op_invert(app->current_image);
             break;
-            
+        
         case MP_OP_INVERT_GRAYSCALE:
             mp_fast_printf("Applying invert + grayscale... / 반전 및 그레이스케일 적용 중...\n");
             result = mp_op_invert_grayscale(app->current_image);
             break;
-            
+        
         case MP_OP_FLIP_H:
             mp_fast_printf("Flipping horizontally... / 좌우 반전 중...\n");
             result = mp_op_flip_horizontal(app->current_image);
             break;
-            
+        
         case MP_OP_FLIP_V:
             mp_fast_printf("Flipping vertically... / 상하 반전 중...\n");
             result = mp_op_flip_vertical(app->current_image);
             break;
-            
-        case MP_OP_UNDO:
-            mp_app_undo(app);
-            return MP_SUCCESS;
-            
-        case MP_OP_REDO:
-            mp_app_redo(app);
-            return MP_SUCCESS;
-            
-        case MP_OP_ZOOM_IN:
-            app->fit_to_window = MP_FALSE;
-            app->zoom_level *= 1.2f;
-            if (app->zoom_level > 10.0f) app->zoom_level = 10.0f;
-            return MP_SUCCESS;
-            
-        case MP_OP_ZOOM_OUT:
-            app->fit_to_window = MP_FALSE;
-            app->zoom_level /= 1.2f;
-            if (app->zoom_level < 0.01f) app->zoom_level = 0.01f;
-            return MP_SUCCESS;
-            
-        case MP_OP_ZOOM_RESET:
-            app->fit_to_window = MP_TRUE;
-            app->zoom_level = 1.0f;
-            return MP_SUCCESS;
-            
+        
+        case MP_OP_ROTATE:
+            mp_fast_printf("Rotating %d degrees... / %d도 회전 중...\n", param, param);
+            result = mp_op_rotate(app->current_image, param);
+            break;
+        
         default:
-            return MP_ERROR_UNSUPPORTED;
+            result = MP_ERROR_UNSUPPORTED;
+            break;
+    }
+    
+    /* Redo history survives a failed operation. A committed record knows what changed: the
+     * tiles a colour operation altered, or the whole image for flips, rotation and inversion
+     * / 실패한 연산은 다시 실행 기록을 지우지 않음. 커밋된 기록이 변경 영역을 알려줌 */
+    if (recorded) {
+        if (result == MP_SUCCESS) {
+            mp_undo_store_commit(app->undo, app->current_image);
+            *dirty = app->undo->dirty;
+        } else {
+            mp_undo_store_cancel(app->undo);
+        }
+    } else if (result == MP_SUCCESS && op_type != MP_OP_SAVE) {
+        /* Without a record there is nothing to compare against / 기록이 없으면 비교 대상이 없음 */
+        dirty->width = app->current_image->buffer->width;
+        dirty->height = app->current_image->buffer->height;
     }
+    return result;
+}
+
+/* Event-thread half: refresh the changed part of the display / 이벤트 스레드 측: 변경된 표시 영역 갱신 */
+static void mp_app_finish_operation(mp_application* app, mp_operation_type op_type, mp_result result,
+                                    const mp_pixel_rect* dirty) {
+    if (op_type == MP_OP_SAVE) return;
     
     if (result == MP_SUCCESS) {
-        mp_gui_update_image_surface(app);
+        mp_gui_update_image_region(app, dirty);
         mp_fast_printf("Operation completed successfully / 작업 완료\n");
     } else {
         mp_fast_fprintf(2, "Operation failed / 작업 실패\n");
     }
+}
+
+static mp_result mp_app_run_operation(mp_application* app, mp_operation_type op_type, i32 param) {
+    if (!app || !app->current_image) {
+        return MP_ERROR_INVALID_PARAM;
+    }
+    
+    if (mp_app_is_view_operation(op_type)) {
+        return mp_app_apply_view_operation(app, op_type);
+    }
     
+    mp_display_cache_cancel(app->display_cache);
+    mp_pixel_rect dirty;
+    mp_result result = mp_app_execute_operation(app, op_type, param, &dirty);
+    mp_app_finish_operation(app, op_type, result, &dirty);
     return result;
 }
+
+mp_result mp_app_apply_operation(mp_application* app, mp_operation_type op_type) {
+    return mp_app_run_operation(app, op_type, 0);
+}
+
+typedef struct {
+    mp_application* app;
+    mp_operation_type op_type;
+    i32 param;
+    mp_pixel_rect dirty;
+} mp_operation_job;
+
+static mp_result mp_operation_job_run(void* ctx) {
+    mp_operation_job* job = (mp_operation_job*)ctx;
+    return mp_app_execute_operation(job->app, job->op_type, job->param, &job->dirty);
+}
+
+static void mp_operation_job_done(void* ctx, mp_result result) {
+    mp_operation_job* job = (mp_operation_job*)ctx;
+    mp_application* app = job->app;
+    mp_app_finish_operation(app, job->op_type, result, &job->dirty);
+    mp_free(job);
+    mp_app_start_pending_load(app);
+}
+
+static mp_result mp_app_submit_operation(mp_application* app, mp_operation_type op_type, i32 param) {
+    if (!app || !app->current_image) {
+        return MP_ERROR_INVALID_PARAM;
+    }
+    if (!app->worker || mp_app_is_view_operation(op_type)) {
+        return mp_app_run_operation(app, op_type, param);
+    }
+    
+    /* The worker owns current_image until it finishes / 작업 완료 전까지 현재 이미지는 작업 스레드 소유 */
+    if (mp_worker_busy(app->worker)) {
+        mp_fast_printf("[GUI] Busy, please wait / 작업 중입니다. 잠시 기다려 주세요\n");
+        return MP_ERROR_INVALID_PARAM;
+    }
+    
+    mp_operation_job* job = (mp_operation_job*)mp_malloc(sizeof(mp_operation_job));
+    if (!job) return MP_ERROR_MEMORY;
+    job->app = app;
+    job->op_type = op_type;
+    job->param = param;
+    
+    /* Display tiles stop reading the buffer before the worker rewrites it / 작업 스레드가 쓰기 전에 타일 생성 중단 */
+    mp_display_cache_cancel(app->display_cache);
+    const char* label = op_type == MP_OP_SAVE ? "Saving image / 이미지 저장 중" : "Processing / 처리 중";
+    if (!mp_worker_submit(app->worker, label, mp_operation_job_run, mp_operation_job_done, job)) {
+        mp_free(job);
+        return mp_app_run_operation(app, op_type, param);
+    }
+    mp_gui_request_repaint_progress(app);
+    return MP_SUCCESS;
+}
+
+mp_result mp_app_apply_operation_async(mp_application* app, mp_operation_type op_type) {
+    return mp_app_submit_operation(app, op_type, 0);
+}
+
+typedef struct {
+    mp_application* app;
+    mp_bool redo;
+} mp_undo_job;
+
+static mp_result mp_app_step_history(mp_application* app, mp_bool redo) {
+    return redo ? mp_undo_store_redo(app->undo, app->current_image)
+                : mp_undo_store_undo(app->undo, app->current_image);
+}
+
+static void mp_app_finish_history(mp_application* app, mp_bool redo, mp_result result) {
+    if (result != MP_SUCCESS) {
+        mp_fast_fprintf(2, redo ? "[GUI] Redo failed / 다시 실행 실패\n" : "[GUI] Undo failed / 실행 취소 실패\n");
+        return;
+    }
+    
+    mp_gui_update_image_region(app, &app->undo->dirty);
+    if (redo) {
+        mp_image_record_history(app->current_image, MP_OP_REDO, "Chronos-EXIF Redo");
+        mp_fast_printf("[GUI] Redo performed / 다시 실행됨 (%u left, %zu KB)\n",
+                       app->undo->redo_count, app->undo->used_bytes >> 10);
+    } else {
+        mp_image_record_history(app->current_image, MP_OP_UNDO, "Chronos-EXIF Undo");
+        mp_fast_printf("[GUI] Undo performed / 실행 취소됨 (%u left, %zu KB)\n",
+                       app->undo->undo_count, app->undo->used_bytes >> 10);
+    }
+}
+
+static mp_result mp_undo_job_run(void* ctx) {
+    mp_undo_job* job = (mp_undo_job*)ctx;
+    return mp_app_step_history(job->app, job->redo);
+}
+
+static void mp_undo_job_done(void* ctx, mp_result result) {
+    mp_undo_job* job = (mp_undo_job*)ctx;
+    mp_application* app = job->app;
+    mp_app_finish_history(app, job->redo, result);
+    mp_free(job);
+    mp_app_start_pending_load(app);
+}
+
+/* Inverse ops (a rotate, a tile restore) run on the worker like any operation
+ * 역연산(회전, 타일 복원)도 일반 작업처럼 작업 스레드에서 실행 */
+static void mp_app_submit_history(mp_application* app, mp_bool redo) {
+    if (!app || !app->current_image) return;
+    
+    /* The worker may be recording into the store; counts are only stable when idle
+     * 작업 스레드가 기록 중일 수 있으므로 유휴 상태에서만 개수를 확인 */
+    if (mp_worker_busy(app->worker)) {
+        mp_fast_printf("[GUI] Busy, please wait / 작업 중입니다. 잠시 기다려 주세요\n");
+        return;
+    }
+    if ((redo ? app->undo->redo_count : app->undo->undo_count) == 0) return;
+    mp_display_cache_cancel(app->display_cache);
+    
+    mp_undo_job* job = app->worker ? (mp_undo_job*)mp_malloc(sizeof(mp_undo_job)) : NULL;
+    if (job) {
+        job->app = app;
+        job->redo = redo;
+        const char* label = redo ? "Redoing / 다시 실행 중" : "Undoing / 실행 취소 중";
+        if (mp_worker_submit(app->worker, label, mp_undo_job_run, mp_undo_job_done, job)) {
+            mp_gui_request_repaint_progress(app);
+            return;
+        }
+        mp_free(job);
+    }
+    mp_app_finish_history(app, redo, mp_app_step_history(app, redo));
+}
+
+void mp_app_undo(mp_application* app) {
+    mp_app_submit_history(app, MP_FALSE);
+}
+
+void mp_app_redo(mp_application* app) {
+    mp_app_submit_history(app, MP_TRUE);
+}
+
+mp_result mp_app_rotate(mp_application* app, i32 degrees) {
+    return mp_app_submit_operation(app, MP_OP_ROTATE, degrees);
+}
@@ -2,6 +2,12 @@
 #define MANYPICTURES_GUI_H
 
 #include "../core/types.h"
+#include "undo_store.h"
+#include "worker.h"
+#include "display_cache.h"
+#include "shm_image.h"
+#include "prefetch.h"
+#include "thumb_grid.h"
 
 /* GUI system for Many Pictures */
 
@@ -78,6 +84,12 @@ struct mp_widget {
     mp_widget* next_sibling;
 };
 
+/* Rectangle in window pixels / 창 픽셀 단위 사각형 */
+typedef struct {
+    i32 x, y;
+    i32 width, height;
+} mp_gui_rect;
+
 /* Window structure */
 struct mp_window {
     mp_widget base;
@@ -92,13 +104,28 @@ struct mp_window {
     void* cairo_context; /* Window context */
     void* back_surface;  /* Off-screen backbuffer */
     void* back_context;  /* Off-screen context */
+    mp_shm_image* shm_image; /* Shared memory behind back_surface, NULL on the Xlib path / back_surface의 공유 메모리 */
 };
 
+/* Default undo memory budget, overridable with MP_UNDO_BUDGET_MB / 기본 실행 취소 메모리 예산 */
+#define MP_GUI_UNDO_BUDGET_MB 256
+
+/* Default display tile cache budget, overridable with MP_DISPLAY_BUDGET_MB / 기본 표시 타일 캐시 예산 */
+#define MP_GUI_DISPLAY_BUDGET_MB 256
+
+/* Neighbour prefetch budget and reach, overridable with MP_PREFETCH_BUDGET_MB / MP_PREFETCH_AHEAD
+ * / 이웃 미리 읽기 예산과 범위 */
+#define MP_GUI_PREFETCH_BUDGET_MB 512
+#define MP_GUI_PREFETCH_AHEAD 2
+
 /* Application structure */
 typedef struct {
     mp_window* main_window;
     mp_image* current_image;
-    void* image_surface; /* Cached CAIRO surface for rendering / 렌더링용 캐시된 CAIRO 서피스 */
+    u32 shown_width, shown_height; /* Geometry on screen, event thread only / 화면 표시 크기 (이벤트 스레드 전용) */
+    mp_display_cache* display_cache; /* ARGB tiles of the visible region / 보이는 영역의 ARGB 타일 */
+    void* chrome_surface; /* Cached background and sidebar / 캐시된 배경 및 사이드바 */
+    mp_language_mode chrome_language; /* Language the sidebar was drawn in / 사이드바를 그린 언어 */
     mp_widget* image_view;
     mp_widget* toolbar;
     mp_widget* statusbar;
@@ -109,12 +136,25 @@ typedef struct {
     i32 scroll_x, scroll_y;
     mp_language_mode language_mode; /* Current language mode / 현재 언어 모드 */
     
-    /* Undo/Redo System / 실행 취소/다시 실행 시스템 */
-    mp_image_buffer** undo_stack;
-    mp_image_buffer** redo_stack;
-    int undo_count;
-    int redo_count;
-    int max_undo;
+    /* Undo/Redo System (delta tile store with a memory budget) / 실행 취소/다시 실행 시스템 (메모리 예산 기반 델타 타일 저장소) */
+    mp_undo_store* undo;
+    u32 undo_budget_mb;
+    
+    /* Background decode / operation thread / 백그라운드 디코딩 및 연산 스레드 */
+    mp_worker* worker;
+    char* pending_load;  /* File picked while the worker was busy / 작업 중 선택된 파일 */
+    
+    /* Next/previous over the current directory, decoded ahead / 현재 디렉터리 이전/다음 탐색 (미리 디코딩) */
+    mp_prefetch* prefetch;
+    
+    /* Thumbnail grid of the current directory, kept while hidden / 현재 디렉터리의 썸네일 그리드 (숨겨도 유지) */
+    mp_thumb_cache* thumb_cache;
+    mp_thumb_grid* grid;
+    mp_bool grid_visible;
+    
+    /* Set by mp_gui_request_repaint*, consumed once per loop iteration / 루프 반복당 한 번 처리되는 다시 그리기 요청 */
+    mp_bool repaint_pending;
+    mp_gui_rect damage;  /* Union of the requested areas / 요청된 영역의 합집합 */
     
     /* Non-blocking Dialog State / 비차단 대화 상자 상태 */
     int dialog_fd;
@@ -169,15 +209,36 @@ void mp_app_destroy(mp_application* app);
 /* Run application */
 mp_result mp_app_run(mp_application* app);
 
-/* Load image in application */
+/* Load image in application, decoding on the calling thread; an image the prefetcher has
+ * ready is used, one it is still decoding is not waited for
+ * / 호출 스레드에서 디코딩 (준비된 미리 읽기 이미지는 사용하되 진행 중인 것은 기다리지 않음) */
 mp_result mp_app_load_image(mp_application* app, const char* filepath);
 
+/* Decode on the worker thread; the image is swapped in when the event loop sees completion
+ * / 작업 스레드에서 디코딩 후 이벤트 루프가 완료를 감지하면 이미지 교체 */
+mp_result mp_app_load_image_async(mp_application* app, const char* filepath);
+
+/* Open the file `delta` places away in the current directory (wraps around)
+ * / 현재 디렉터리에서 `delta`만큼 떨어진 파일 열기 (순환) */
+mp_result mp_app_navigate(mp_application* app, i32 delta);
+
+/* Show or hide the thumbnail grid of the current file's directory / 현재 파일 디렉터리의 썸네일 그리드 표시 전환 */
+void mp_app_toggle_grid(mp_application* app);
+
 /* Save image in application */
 mp_result mp_app_save_image(mp_application* app, const char* filepath);
 
 /* Apply operation to current image */
 mp_result mp_app_apply_operation(mp_application* app, mp_operation_type op_type);
 
+/* Same, with image work run on the worker thread; rejected while another job runs
+ * / 이미지 작업을 작업 스레드에서 실행 (다른 작업 진행 중에는 거부) */
+mp_result mp_app_apply_operation_async(mp_application* app, mp_operation_type op_type);
+
+/* Rotate the current image clockwise on the worker thread; undo applies -degrees
+ * / 현재 이미지를 작업 스레드에서 시계 방향 회전 (실행 취소는 -degrees 적용) */
+mp_result mp_app_rotate(mp_application* app, i32 degrees);
+
 /* Undo/Redo */
 void mp_app_undo(mp_application* app);
 void mp_app_redo(mp_application* app);
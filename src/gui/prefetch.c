@@ -0,0 +1,319 @@
+#define _POSIX_C_SOURCE 200809L
+#include "prefetch.h"
+#include "dir_scan.h"
+#include "../core/memory.h"
+#include "../core/image.h"
+#include <pthread.h>
+#include <string.h>
+
+#define MP_PREFETCH_NONE 0xFFFFFFFFu
+
+typedef struct mp_prefetch_entry {
+    char* path;
+    mp_image* image;          /* NULL when the decode failed / 디코딩 실패 시 NULL */
+    size_t bytes;
+    struct mp_prefetch_entry* prev;  /* Towards the most recent / 최근 쪽 */
+    struct mp_prefetch_entry* next;  /* Towards the least recent / 오래된 쪽 */
+} mp_prefetch_entry;
+
+struct mp_prefetch {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;      /* Work for the thread / 스레드 작업 알림 */
+    pthread_cond_t decoded;   /* A decode finished / 디코딩 완료 알림 */
+    
+    /* Guarded by lock / lock으로 보호 */
+    mp_bool quit;
+    char* directory;          /* Prefix shared by `files`, "" for the working directory / 공통 경로 접두사 */
+    char** files;             /* Full paths in natural order / 자연 정렬된 전체 경로 */
+    u32 file_count;
+    u32 current;
+    u32 ahead;
+    mp_prefetch_entry* head;
+    mp_prefetch_entry* tail;
+    size_t bytes;
+    size_t budget;
+    char* decoding;           /* File the thread is decoding / 스레드가 디코딩 중인 파일 */
+};
+
+static void mp_prefetch_free_files(mp_prefetch* prefetch) {
+    mp_dir_scan_free(prefetch->files, prefetch->file_count);
+    mp_free(prefetch->directory);
+    prefetch->files = NULL;
+    prefetch->directory = NULL;
+    prefetch->file_count = 0;
+    prefetch->current = MP_PREFETCH_NONE;
+}
+
+static mp_bool mp_prefetch_scan(mp_prefetch* prefetch, const char* directory) {
+    u32 count = 0;
+    char** files = mp_dir_scan_images(directory, &count);
+    if (!files) return MP_FALSE;
+    
+    mp_prefetch_free_files(prefetch);
+    prefetch->directory = mp_strdup(directory);
+    prefetch->files = files;
+    prefetch->file_count = count;
+    return MP_TRUE;
+}
+
+/* k-th file to prefetch: +1, -1, +2, -2, ... / k번째 미리 읽을 파일 */
+static const char* mp_prefetch_wanted(const mp_prefetch* prefetch, u32 k) {
+    u32 count = prefetch->file_count;
+    if (prefetch->current == MP_PREFETCH_NONE || count < 2) return NULL;
+    u32 distance = (k / 2 + 1) % count;
+    u32 index = (k & 1) ? (prefetch->current + count - distance) % count
+                        : (prefetch->current + distance) % count;
+    return index == prefetch->current ? NULL : prefetch->files[index];
+}
+
+static mp_bool mp_prefetch_is_wanted(const mp_prefetch* prefetch, const char* path) {
+    for (u32 k = 0; k < prefetch->ahead * 2; k++) {
+        const char* wanted = mp_prefetch_wanted(prefetch, k);
+        if (wanted && strcmp(wanted, path) == 0) return MP_TRUE;
+    }
+    return MP_FALSE;
+}
+
+static mp_prefetch_entry* mp_prefetch_find(const mp_prefetch* prefetch, const char* path) {
+    for (mp_prefetch_entry* e = prefetch->head; e; e = e->next) {
+        if (strcmp(e->path, path) == 0) return e;
+    }
+    return NULL;
+}
+
+static void mp_prefetch_unlink(mp_prefetch* prefetch, mp_prefetch_entry* e) {
+    if (e->prev) e->prev->next = e->next;
+    else prefetch->head = e->next;
+    if (e->next) e->next->prev = e->prev;
+    else prefetch->tail = e->prev;
+    prefetch->bytes -= e->bytes;
+}
+
+static void mp_prefetch_free_entry(mp_prefetch_entry* e) {
+    if (e->image) mp_image_destroy(e->image);
+    mp_free(e->path);
+    mp_free(e);
+}
+
+/* Drop least recently used files that are no longer near the current one until the budget
+ * holds / 예산을 맞출 때까지 현재 파일 주변이 아닌 오래된 항목부터 제거 */
+static void mp_prefetch_evict(mp_prefetch* prefetch) {
+    mp_prefetch_entry* e = prefetch->tail;
+    while (e && prefetch->bytes > prefetch->budget) {
+        mp_prefetch_entry* prev = e->prev;
+        if (!mp_prefetch_is_wanted(prefetch, e->path)) {
+            mp_prefetch_unlink(prefetch, e);
+            mp_prefetch_free_entry(e);
+        }
+        e = prev;
+    }
+}
+
+/* Takes ownership of `path` and `image` / `path`와 `image`의 소유권을 가져감 */
+static void mp_prefetch_insert(mp_prefetch* prefetch, char* path, mp_image* image) {
+    mp_prefetch_entry* e = (mp_prefetch_entry*)mp_calloc(1, sizeof(mp_prefetch_entry));
+    if (!e) {
+        if (image) mp_image_destroy(image);
+        mp_free(path);
+        return;
+    }
+    e->path = path;
+    e->image = image;
+    e->bytes = image ? sizeof(mp_image) + image->buffer->data_size : 0;
+    
+    e->next = prefetch->head;
+    if (prefetch->head) prefetch->head->prev = e;
+    else prefetch->tail = e;
+    prefetch->head = e;
+    prefetch->bytes += e->bytes;
+    mp_prefetch_evict(prefetch);
+}
+
+/* Nearest wanted file not cached yet, or NULL when done or the budget is full
+ * / 아직 캐시되지 않은 가장 가까운 파일 (완료 또는 예산 초과 시 NULL) */
+static const char* mp_prefetch_next_missing(const mp_prefetch* prefetch) {
+    if (prefetch->bytes >= prefetch->budget) return NULL;
+    for (u32 k = 0; k < prefetch->ahead * 2; k++) {
+        const char* wanted = mp_prefetch_wanted(prefetch, k);
+        if (wanted && !mp_prefetch_find(prefetch, wanted)) return wanted;
+    }
+    return NULL;
+}
+
+static void* mp_prefetch_main(void* arg) {
+    mp_prefetch* prefetch = (mp_prefetch*)arg;
+    
+    pthread_mutex_lock(&prefetch->lock);
+    for (;;) {
+        const char* next = NULL;
+        while (!prefetch->quit && !(next = mp_prefetch_next_missing(prefetch))) {
+            pthread_cond_wait(&prefetch->wake, &prefetch->lock);
+        }
+        if (prefetch->quit) break;
+        
+        char* path = mp_strdup(next);
+        if (!path) break;
+        prefetch->decoding = path;
+        pthread_mutex_unlock(&prefetch->lock);
+        
+        mp_image* image = mp_image_load(path);
+        
+        pthread_mutex_lock(&prefetch->lock);
+        prefetch->decoding = NULL;
+        mp_prefetch_insert(prefetch, path, image);
+        pthread_cond_broadcast(&prefetch->decoded);
+    }
+    pthread_mutex_unlock(&prefetch->lock);
+    return NULL;
+}
+
+mp_prefetch* mp_prefetch_create(u32 budget_mb, u32 ahead) {
+    mp_prefetch* prefetch = (mp_prefetch*)mp_calloc(1, sizeof(mp_prefetch));
+    if (!prefetch) return NULL;
+    
+    prefetch->budget = (size_t)budget_mb << 20;
+    prefetch->ahead = ahead;
+    prefetch->current = MP_PREFETCH_NONE;
+    pthread_mutex_init(&prefetch->lock, NULL);
+    pthread_cond_init(&prefetch->wake, NULL);
+    pthread_cond_init(&prefetch->decoded, NULL);
+    
+    if (pthread_create(&prefetch->thread, NULL, mp_prefetch_main, prefetch) != 0) {
+        pthread_cond_destroy(&prefetch->decoded);
+        pthread_cond_destroy(&prefetch->wake);
+        pthread_mutex_destroy(&prefetch->lock);
+        mp_free(prefetch);
+        return NULL;
+    }
+    return prefetch;
+}
+
+void mp_prefetch_destroy(mp_prefetch* prefetch) {
+    if (!prefetch) return;
+    
+    pthread_mutex_lock(&prefetch->lock);
+    prefetch->quit = MP_TRUE;
+    pthread_cond_signal(&prefetch->wake);
+    pthread_mutex_unlock(&prefetch->lock);
+    pthread_join(prefetch->thread, NULL);
+    
+    while (prefetch->head) {
+        mp_prefetch_entry* e = prefetch->head;
+        mp_prefetch_unlink(prefetch, e);
+        mp_prefetch_free_entry(e);
+    }
+    mp_prefetch_free_files(prefetch);
+    pthread_cond_destroy(&prefetch->decoded);
+    pthread_cond_destroy(&prefetch->wake);
+    pthread_mutex_destroy(&prefetch->lock);
+    mp_free(prefetch);
+}
+
+void mp_prefetch_set_current(mp_prefetch* prefetch, const char* filepath) {
+    if (!prefetch || !filepath) return;
+    
+    char* directory = mp_dir_scan_prefix(filepath);
+    if (!directory) return;
+    
+    pthread_mutex_lock(&prefetch->lock);
+    
+    /* Rescan on a new directory, or when the file is new to it / 새 디렉터리이거나 목록에 없는 파일이면 재검색 */
+    for (int pass = 0; pass < 2; pass++) {
+        prefetch->current = MP_PREFETCH_NONE;
+        if (prefetch->directory && strcmp(prefetch->directory, directory) == 0) {
+            for (u32 i = 0; i < prefetch->file_count; i++) {
+                if (strcmp(prefetch->files[i], filepath) == 0) {
+                    prefetch->current = i;
+                    break;
+                }
+            }
+        }
+        if (prefetch->current != MP_PREFETCH_NONE || pass == 1) break;
+        if (!mp_prefetch_scan(prefetch, directory)) mp_prefetch_free_files(prefetch);
+    }
+    mp_free(directory);
+    
+    /* Failed decodes far from the new position are forgotten / 새 위치에서 먼 실패 항목은 제거 */
+    mp_prefetch_entry* e = prefetch->head;
+    while (e) {
+        mp_prefetch_entry* next = e->next;
+        if (!e->image && !mp_prefetch_is_wanted(prefetch, e->path)) {
+            mp_prefetch_unlink(prefetch, e);
+            mp_prefetch_free_entry(e);
+        }
+        e = next;
+    }
+    mp_prefetch_evict(prefetch);
+    
+    pthread_cond_signal(&prefetch->wake);
+    pthread_mutex_unlock(&prefetch->lock);
+}
+
+char* mp_prefetch_neighbor(mp_prefetch* prefetch, i32 delta) {
+    if (!prefetch) return NULL;
+    
+    char* path = NULL;
+    pthread_mutex_lock(&prefetch->lock);
+    u32 count = prefetch->file_count;
+    if (prefetch->current != MP_PREFETCH_NONE && count > 1) {
+        i64 index = ((i64)prefetch->current + delta) % (i64)count;
+        if (index < 0) index += count;
+        if ((u32)index != prefetch->current) path = mp_strdup(prefetch->files[index]);
+    }
+    pthread_mutex_unlock(&prefetch->lock);
+    return path;
+}
+
+mp_bool mp_prefetch_position(mp_prefetch* prefetch, u32* index, u32* count) {
+    if (!prefetch) return MP_FALSE;
+    
+    pthread_mutex_lock(&prefetch->lock);
+    mp_bool known = prefetch->current != MP_PREFETCH_NONE;
+    if (index) *index = prefetch->current;
+    if (count) *count = prefetch->file_count;
+    pthread_mutex_unlock(&prefetch->lock);
+    return known;
+}
+
+mp_image* mp_prefetch_take(mp_prefetch* prefetch, const char* filepath, mp_bool wait) {
+    if (!prefetch || !filepath) return NULL;
+    
+    mp_image* image = NULL;
+    pthread_mutex_lock(&prefetch->lock);
+    for (;;) {
+        mp_prefetch_entry* e = mp_prefetch_find(prefetch, filepath);
+        if (e) {
+            mp_prefetch_unlink(prefetch, e);
+            image = e->image;
+            e->image = NULL;
+            mp_prefetch_free_entry(e);
+            break;
+        }
+        if (!wait || !prefetch->decoding || strcmp(prefetch->decoding, filepath) != 0) break;
+        pthread_cond_wait(&prefetch->decoded, &prefetch->lock);
+    }
+    
+    /* The budget may have room for the next neighbour now / 다음 이웃을 위한 예산이 생겼을 수 있음 */
+    pthread_cond_signal(&prefetch->wake);
+    pthread_mutex_unlock(&prefetch->lock);
+    return image;
+}
+
+void mp_prefetch_give(mp_prefetch* prefetch, const char* filepath, mp_image* image) {
+    if (!image) return;
+    char* path = prefetch && filepath ? mp_strdup(filepath) : NULL;
+    if (!path) {
+        mp_image_destroy(image);
+        return;
+    }
+    
+    pthread_mutex_lock(&prefetch->lock);
+    if (mp_prefetch_find(prefetch, filepath)) {
+        mp_image_destroy(image);
+        mp_free(path);
+    } else {
+        mp_prefetch_insert(prefetch, path, image);
+    }
+    pthread_mutex_unlock(&prefetch->lock);
+}
@@ -0,0 +1,46 @@
+#ifndef MANYPICTURES_PREFETCH_H
+#define MANYPICTURES_PREFETCH_H
+
+#include "../core/types.h"
+
+/* Directory navigation with background neighbour decoding / 디렉터리 탐색 및 이웃 이미지 백그라운드 디코딩
+ *
+ * Keeps the image files of the current file's directory in natural order ("img2" before
+ * "img10"). A dedicated thread decodes the `ahead` files on each side of the current one,
+ * nearest first, into an LRU bounded by a memory budget, so next/previous usually only
+ * has to take a finished image. Entries near the current file are never evicted for
+ * farther ones, and decoding stops while the budget is full.
+ * 현재 파일 디렉터리의 이미지를 자연 정렬로 유지하고, 전용 스레드가 앞뒤 `ahead`개 파일을 가까운 순서로
+ * 메모리 예산 내 LRU에 미리 디코딩합니다.
+ */
+
+typedef struct mp_prefetch mp_prefetch;
+
+/* NULL if the thread cannot be started / 스레드를 시작할 수 없으면 NULL */
+mp_prefetch* mp_prefetch_create(u32 budget_mb, u32 ahead);
+
+/* Stops the thread after its current decode and frees every cached image
+ * / 진행 중인 디코딩 후 스레드를 멈추고 캐시된 이미지를 모두 해제 */
+void mp_prefetch_destroy(mp_prefetch* prefetch);
+
+/* Centre navigation and prefetching on `filepath`, rescanning its directory when needed
+ * / `filepath`를 기준으로 탐색 및 미리 읽기 (필요하면 디렉터리 재검색) */
+void mp_prefetch_set_current(mp_prefetch* prefetch, const char* filepath);
+
+/* Path `delta` files away from the current one, wrapping around; NULL when there is no
+ * other file. Free with mp_free. / 현재 파일에서 `delta`만큼 떨어진 경로 (순환, mp_free로 해제) */
+char* mp_prefetch_neighbor(mp_prefetch* prefetch, i32 delta);
+
+/* Position of the current file and number of files / 현재 파일 위치와 파일 수 */
+mp_bool mp_prefetch_position(mp_prefetch* prefetch, u32* index, u32* count);
+
+/* Remove the decoded image of `filepath` and hand it to the caller. With `wait`, a decode
+ * of that file already in progress is waited for. NULL on a miss or a failed decode.
+ * / `filepath`의 디코딩된 이미지를 꺼내 반환 (`wait`이면 진행 중인 디코딩을 기다림) */
+mp_image* mp_prefetch_take(mp_prefetch* prefetch, const char* filepath, mp_bool wait);
+
+/* Return an unmodified image so going back to it is instant; takes ownership
+ * / 수정되지 않은 이미지를 반환해 다시 돌아갈 때 즉시 표시 (소유권 이전) */
+void mp_prefetch_give(mp_prefetch* prefetch, const char* filepath, mp_image* image);
+
+#endif /* MANYPICTURES_PREFETCH_H */
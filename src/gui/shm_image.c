@@ -0,0 +1,141 @@
+#define _DEFAULT_SOURCE
+#include "shm_image.h"
+#include "../core/memory.h"
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <stdlib.h>
+
+struct mp_shm_image {
+    Display* display;
+    Window window;
+    GC gc;
+    XImage* ximage;
+    XShmSegmentInfo segment;
+    int completion_type;      /* ShmCompletion event code / 완료 이벤트 코드 */
+    u32 pending;              /* Puts not yet completed / 완료되지 않은 표시 요청 수 */
+};
+
+/* XShmAttach fails asynchronously (e.g. over the network); trap it around one XSync
+ * / XShmAttach 실패는 비동기로 오므로 XSync 동안 오류를 포착 */
+static mp_bool g_shm_attach_failed = MP_FALSE;
+
+static int mp_shm_error_handler(Display* display, XErrorEvent* event) {
+    (void)display;
+    (void)event;
+    g_shm_attach_failed = MP_TRUE;
+    return 0;
+}
+
+/* Cairo ARGB32 is native-endian 0xAARRGGBB; the visual must read those bytes as RGB
+ * / Cairo ARGB32 배치를 그대로 RGB로 읽는 비주얼인지 확인 */
+static mp_bool mp_shm_visual_matches(const XImage* ximage, const Visual* visual) {
+    const u16 probe = 1;
+    int host_order = *(const u8*)&probe ? LSBFirst : MSBFirst;
+    return ximage->bits_per_pixel == 32 && ximage->byte_order == host_order &&
+           visual->red_mask == 0xFF0000 && visual->green_mask == 0x00FF00 && visual->blue_mask == 0x0000FF &&
+           (u32)ximage->bytes_per_line == (u32)ximage->width * 4;
+}
+
+mp_shm_image* mp_shm_image_create(void* x_display, unsigned long window, u32 width, u32 height) {
+    Display* display = (Display*)x_display;
+    if (!display || width == 0 || height == 0 || !XShmQueryExtension(display)) return NULL;
+    
+    int screen = DefaultScreen(display);
+    Visual* visual = DefaultVisual(display, screen);
+    if (visual->class != TrueColor) return NULL;
+    
+    mp_shm_image* image = (mp_shm_image*)mp_calloc(1, sizeof(mp_shm_image));
+    if (!image) return NULL;
+    image->display = display;
+    image->window = (Window)window;
+    image->segment.shmid = -1;
+    image->segment.shmaddr = (char*)-1;
+    
+    image->ximage = XShmCreateImage(display, visual, (unsigned)DefaultDepth(display, screen), ZPixmap,
+                                    NULL, &image->segment, width, height);
+    if (!image->ximage || !mp_shm_visual_matches(image->ximage, visual)) goto fail;
+    
+    image->segment.shmid = shmget(IPC_PRIVATE, (size_t)image->ximage->bytes_per_line * height, IPC_CREAT | 0600);
+    if (image->segment.shmid < 0) goto fail;
+    image->segment.shmaddr = image->ximage->data = (char*)shmat(image->segment.shmid, NULL, 0);
+    if (image->segment.shmaddr == (char*)-1) goto fail;
+    image->segment.readOnly = False;
+    
+    g_shm_attach_failed = MP_FALSE;
+    XErrorHandler previous = XSetErrorHandler(mp_shm_error_handler);
+    Status attached = XShmAttach(display, &image->segment);
+    XSync(display, False);
+    XSetErrorHandler(previous);
+    
+    /* Once both sides are attached the segment can be marked for removal, so it cannot
+     * outlive a crash / 양쪽 연결 후 삭제 표시하여 비정상 종료 시에도 남지 않게 함 */
+    shmctl(image->segment.shmid, IPC_RMID, NULL);
+    if (!attached || g_shm_attach_failed) {
+        image->segment.shmid = -1;
+        goto fail;
+    }
+    
+    image->gc = XCreateGC(display, image->window, 0, NULL);
+    image->completion_type = XShmGetEventBase(display) + ShmCompletion;
+    return image;
+    
+fail:
+    if (image->segment.shmaddr != (char*)-1) shmdt(image->segment.shmaddr);
+    if (image->segment.shmid >= 0) shmctl(image->segment.shmid, IPC_RMID, NULL);
+    if (image->ximage) {
+        image->ximage->data = NULL;
+        XDestroyImage(image->ximage);
+    }
+    mp_free(image);
+    return NULL;
+}
+
+void mp_shm_image_destroy(mp_shm_image* image) {
+    if (!image) return;
+    
+    /* Make sure the server is done with the segment before unmapping it / 매핑 해제 전 서버 사용 완료 보장 */
+    XShmDetach(image->display, &image->segment);
+    XSync(image->display, False);
+    shmdt(image->segment.shmaddr);
+    
+    image->ximage->data = NULL;
+    XDestroyImage(image->ximage);
+    XFreeGC(image->display, image->gc);
+    mp_free(image);
+}
+
+u8* mp_shm_image_data(const mp_shm_image* image) {
+    return image ? (u8*)image->ximage->data : NULL;
+}
+
+u32 mp_shm_image_stride(const mp_shm_image* image) {
+    return image ? (u32)image->ximage->bytes_per_line : 0;
+}
+
+mp_bool mp_shm_image_put(mp_shm_image* image, i32 x, i32 y, i32 width, i32 height) {
+    if (!image || width <= 0 || height <= 0) return MP_FALSE;
+    
+    if (!XShmPutImage(image->display, image->window, image->gc, image->ximage,
+                      x, y, x, y, (unsigned)width, (unsigned)height, True)) {
+        return MP_FALSE;
+    }
+    image->pending++;
+    return MP_TRUE;
+}
+
+mp_bool mp_shm_image_busy(const mp_shm_image* image) {
+    return image && image->pending > 0;
+}
+
+mp_bool mp_shm_image_handle_event(mp_shm_image* image, const void* event) {
+    const XEvent* ev = (const XEvent*)event;
+    if (!image || ev->type != image->completion_type) return MP_FALSE;
+    
+    const XShmCompletionEvent* done = (const XShmCompletionEvent*)ev;
+    if (done->shmseg != image->segment.shmseg) return MP_FALSE;
+    if (image->pending > 0) image->pending--;
+    return MP_TRUE;
+}
@@ -0,0 +1,40 @@
+#ifndef MANYPICTURES_SHM_IMAGE_H
+#define MANYPICTURES_SHM_IMAGE_H
+
+#include "../core/types.h"
+
+/* MIT-SHM back buffer / MIT-SHM 백 버퍼
+ *
+ * An XImage whose pixels live in a System V shared memory segment attached by the X server.
+ * The GUI renders straight into it through a Cairo ARGB32 surface, and presenting is an
+ * XShmPutImage: the server copies from shared memory instead of receiving the frame over
+ * the socket. Creation fails (NULL) on remote displays, without the extension or with a
+ * visual whose layout differs from Cairo's, and the caller falls back to Xlib.
+ * 서버와 공유하는 메모리에 직접 렌더링하고 XShmPutImage로 표시합니다. 사용할 수 없으면 NULL을 반환합니다.
+ *
+ * The server reads the segment asynchronously; after mp_shm_image_put the buffer must not
+ * be written until mp_shm_image_busy turns false (on the completion event).
+ * 표시 요청 후 완료 이벤트가 올 때까지 버퍼에 쓰면 안 됩니다.
+ */
+
+typedef struct mp_shm_image mp_shm_image;
+
+/* `display` is a Display*, `window` a Window / `display`는 Display*, `window`는 Window */
+mp_shm_image* mp_shm_image_create(void* display, unsigned long window, u32 width, u32 height);
+void mp_shm_image_destroy(mp_shm_image* image);
+
+/* Pixel memory in Cairo ARGB32 layout / Cairo ARGB32 배치의 픽셀 메모리 */
+u8* mp_shm_image_data(const mp_shm_image* image);
+u32 mp_shm_image_stride(const mp_shm_image* image);
+
+/* Copy a rectangle to the window at the same position / 사각형을 창의 같은 위치로 복사 */
+mp_bool mp_shm_image_put(mp_shm_image* image, i32 x, i32 y, i32 width, i32 height);
+
+/* A put is still being read by the server / 서버가 아직 읽는 중 */
+mp_bool mp_shm_image_busy(const mp_shm_image* image);
+
+/* Consume a completion event (an XEvent*); MP_TRUE if it belonged to this image
+ * / 완료 이벤트 처리 (이 이미지의 이벤트이면 MP_TRUE) */
+mp_bool mp_shm_image_handle_event(mp_shm_image* image, const void* event);
+
+#endif /* MANYPICTURES_SHM_IMAGE_H */
@@ -0,0 +1,395 @@
+#define _POSIX_C_SOURCE 200809L
+#include "thumb_cache.h"
+#include "argb_convert.h"
+#include "../core/memory.h"
+#include <pthread.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define MP_THUMB_PACK_MAGIC "MPTHUMB1"
+#define MP_THUMB_PACK_BOM 0x01020304u         /* Pixels are host-endian / 픽셀은 호스트 엔디언 */
+#define MP_THUMB_RECORD_MAGIC 0x5254504Du     /* "MPTR" */
+
+typedef struct {
+    char magic[8];
+    u32 bom;
+    u32 reserved;
+} mp_thumb_pack_header;
+
+/* Followed by `payload` bytes of pixels, padded to 8 / `payload` 바이트의 픽셀이 뒤따름 (8바이트 정렬) */
+typedef struct {
+    u32 magic;
+    u32 payload;
+    u64 key;
+    u16 width;
+    u16 height;
+    u8 channels;              /* 3: RGB, 4: premultiplied ARGB32 / 3: RGB, 4: 프리멀티플라이 ARGB32 */
+    u8 reserved[3];
+} mp_thumb_record;
+
+typedef struct {
+    u64 key;                  /* 0 marks a free slot / 0은 빈 슬롯 */
+    u64 offset;
+} mp_thumb_slot;
+
+struct mp_thumb_cache {
+    pthread_mutex_t lock;
+    int fd;                   /* Held with a shared flock for the session / 세션 동안 공유 flock 유지 */
+    char* path;
+    mp_bool read_only;        /* Torn tail another process may still be writing / 다른 프로세스가 쓰는 중일 수 있는 잘린 꼬리 */
+    const u8* map;            /* Records present at open / 열 때 존재하던 레코드 */
+    size_t map_length;        /* Bytes mapped / 매핑된 바이트 */
+    size_t map_size;          /* Valid prefix of the mapping / 매핑 중 유효한 부분 */
+    size_t file_size;
+    size_t limit;
+    mp_thumb_slot* slots;     /* Open addressing, power-of-two capacity / 개방 주소법 해시 */
+    u32 capacity;
+    u32 count;
+};
+
+static size_t mp_thumb_record_size(u32 payload) {
+    return sizeof(mp_thumb_record) + (((size_t)payload + 7) & ~(size_t)7);
+}
+
+static mp_thumb_slot* mp_thumb_cache_slot(const mp_thumb_cache* cache, u64 key) {
+    u32 mask = cache->capacity - 1;
+    u32 i = (u32)(key ^ (key >> 32)) & mask;
+    while (cache->slots[i].key != 0 && cache->slots[i].key != key) i = (i + 1) & mask;
+    return &cache->slots[i];
+}
+
+static mp_bool mp_thumb_cache_index(mp_thumb_cache* cache, u64 key, u64 offset) {
+    if ((cache->count + 1) * 2 > cache->capacity) {
+        u32 capacity = cache->capacity ? cache->capacity * 2 : 1024;
+        mp_thumb_slot* slots = (mp_thumb_slot*)mp_calloc(capacity, sizeof(mp_thumb_slot));
+        if (!slots) return MP_FALSE;
+        mp_thumb_slot* old = cache->slots;
+        u32 old_capacity = cache->capacity;
+        cache->slots = slots;
+        cache->capacity = capacity;
+        for (u32 i = 0; i < old_capacity; i++) {
+            if (old[i].key) *mp_thumb_cache_slot(cache, old[i].key) = old[i];
+        }
+        mp_free(old);
+    }
+    
+    /* A later record for the same key wins / 같은 키는 나중 레코드가 우선 */
+    mp_thumb_slot* slot = mp_thumb_cache_slot(cache, key);
+    if (slot->key == 0) cache->count++;
+    slot->key = key;
+    slot->offset = offset;
+    return MP_TRUE;
+}
+
+static mp_bool mp_thumb_record_valid(const mp_thumb_record* record) {
+    return record->magic == MP_THUMB_RECORD_MAGIC && record->key != 0 &&
+           record->width > 0 && record->width <= MP_THUMB_SIZE &&
+           record->height > 0 && record->height <= MP_THUMB_SIZE &&
+           (record->channels == 3 || record->channels == 4) &&
+           record->payload == (u32)record->width * record->height * record->channels;
+}
+
+/* Index every complete record; returns where the valid part of the pack ends
+ * / 완전한 레코드를 모두 색인하고 유효한 부분의 끝 위치를 반환 */
+static size_t mp_thumb_cache_scan(mp_thumb_cache* cache) {
+    size_t pos = sizeof(mp_thumb_pack_header);
+    while (pos + sizeof(mp_thumb_record) <= cache->map_size) {
+        mp_thumb_record record;
+        memcpy(&record, cache->map + pos, sizeof(record));
+        if (!mp_thumb_record_valid(&record)) break;
+        size_t size = mp_thumb_record_size(record.payload);
+        if (size > cache->map_size - pos) break;
+        if (!mp_thumb_cache_index(cache, record.key, pos)) break;
+        pos += size;
+    }
+    return pos;
+}
+
+/* `$XDG_CACHE_HOME/manypictures`, falling back to `~/.cache/manypictures` / 기본 캐시 디렉터리 */
+static char* mp_thumb_cache_default_path(void) {
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    char base[4096];
+    if (xdg && xdg[0] == '/') snprintf(base, sizeof(base), "%s", xdg);
+    else if (home && home[0]) snprintf(base, sizeof(base), "%s/.cache", home);
+    else return NULL;
+    
+    char dir[4096];
+    int n = snprintf(dir, sizeof(dir), "%s/manypictures", base);
+    if (n < 0 || (size_t)n >= sizeof(dir) - 32) return NULL;
+    if (mkdir(base, 0700) != 0 && errno != EEXIST) return NULL;
+    if (mkdir(dir, 0700) != 0 && errno != EEXIST) return NULL;
+    
+    char* path = (char*)mp_malloc((size_t)n + 18);
+    if (path) snprintf(path, (size_t)n + 18, "%s/thumbnails.pack", dir);
+    return path;
+}
+
+/* Forget every record and unmap the pack / 모든 레코드를 잊고 팩 매핑 해제 */
+static void mp_thumb_cache_forget(mp_thumb_cache* cache) {
+    if (cache->map) munmap((void*)cache->map, cache->map_length);
+    cache->map = NULL;
+    cache->map_length = cache->map_size = 0;
+    mp_free(cache->slots);
+    cache->slots = NULL;
+    cache->capacity = cache->count = 0;
+}
+
+static mp_bool mp_thumb_cache_write_header(int fd) {
+    mp_thumb_pack_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MP_THUMB_PACK_MAGIC, 8);
+    header.bom = MP_THUMB_PACK_BOM;
+    return write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header);
+}
+
+/* Start a new pack under a temporary name and rename it over the old one. Other processes
+ * keep their mapping of the old file, so nothing they read is ever cut short.
+ * / 임시 이름으로 새 팩을 만든 뒤 기존 팩 위로 이름을 바꿈 (다른 프로세스의 매핑은 그대로 유지) */
+static mp_bool mp_thumb_cache_restart(mp_thumb_cache* cache) {
+    size_t length = strlen(cache->path) + 32;
+    char* temp = (char*)mp_malloc(length);
+    if (!temp) return MP_FALSE;
+    snprintf(temp, length, "%s.%ld.tmp", cache->path, (long)getpid());
+    
+    int fd = open(temp, O_RDWR | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0600);
+    mp_bool ok = fd != -1 && flock(fd, LOCK_SH) == 0 && mp_thumb_cache_write_header(fd) &&
+                 rename(temp, cache->path) == 0;
+    if (!ok) {
+        if (fd != -1) close(fd);
+        unlink(temp);
+        mp_free(temp);
+        return MP_FALSE;
+    }
+    mp_free(temp);
+    
+    mp_thumb_cache_forget(cache);
+    close(cache->fd);
+    cache->fd = fd;
+    cache->file_size = sizeof(mp_thumb_pack_header);
+    cache->read_only = MP_FALSE;
+    return MP_TRUE;
+}
+
+mp_thumb_cache* mp_thumb_cache_open(const char* path) {
+    char* owned = path ? mp_strdup(path) : mp_thumb_cache_default_path();
+    if (!owned) return NULL;
+    
+    int fd = open(owned, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if (fd == -1) {
+        mp_free(owned);
+        return NULL;
+    }
+    
+    mp_thumb_cache* cache = (mp_thumb_cache*)mp_calloc(1, sizeof(mp_thumb_cache));
+    if (!cache) {
+        mp_free(owned);
+        close(fd);
+        return NULL;
+    }
+    cache->fd = fd;
+    cache->path = owned;
+    cache->limit = (size_t)MP_THUMB_CACHE_LIMIT_MB << 20;
+    const char* limit = getenv("MP_THUMB_CACHE_MB");
+    if (limit && atoi(limit) > 0) cache->limit = (size_t)atoi(limit) << 20;
+    pthread_mutex_init(&cache->lock, NULL);
+    
+    /* Only the sole user of the pack may cut or rewrite it in place; everyone else waits
+     * for that to finish and then shares it / 팩의 유일한 사용자만 제자리에서 자르거나 다시 쓸 수
+     * 있고, 나머지는 끝날 때까지 기다린 뒤 공유 */
+    mp_bool exclusive = flock(fd, LOCK_EX | LOCK_NB) == 0;
+    struct stat st;
+    if ((!exclusive && flock(fd, LOCK_SH) != 0) || fstat(fd, &st) != 0) {
+        mp_thumb_cache_close(cache);
+        return NULL;
+    }
+    cache->file_size = (size_t)st.st_size;
+    
+    /* Map and index an existing pack of the right kind / 올바른 형식의 기존 팩을 매핑하고 색인 */
+    mp_thumb_pack_header header;
+    mp_bool usable = cache->file_size >= sizeof(header) && cache->file_size <= cache->limit &&
+                     pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+                     memcmp(header.magic, MP_THUMB_PACK_MAGIC, 8) == 0 && header.bom == MP_THUMB_PACK_BOM;
+    if (usable) {
+        void* map = mmap(NULL, cache->file_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (map != MAP_FAILED) {
+            cache->map = (const u8*)map;
+            cache->map_length = cache->file_size;
+            cache->map_size = cache->file_size;
+            
+            /* New records go where the valid part ends, so the cut tail is never read from the map.
+             * A shared pack's tail may be a record still being written: leave it and only read.
+             * / 새 레코드는 유효 부분 끝에 추가됨. 공유 중인 팩의 꼬리는 쓰는 중일 수 있어 읽기만 함 */
+            size_t end = mp_thumb_cache_scan(cache);
+            if (end < cache->file_size) {
+                if (exclusive) usable = ftruncate(fd, (off_t)end) == 0;
+                else cache->read_only = MP_TRUE;
+                cache->file_size = end;
+                cache->map_size = end;
+            }
+        } else {
+            usable = MP_FALSE;
+        }
+    }
+    
+    /* Missing, foreign or oversized: start a new pack / 없거나 다른 형식이거나 너무 크면 새 팩 시작 */
+    if (!usable) {
+        mp_thumb_cache_forget(cache);
+        if (exclusive) {
+            usable = ftruncate(fd, 0) == 0 && mp_thumb_cache_write_header(fd);
+            cache->file_size = sizeof(header);
+        } else {
+            usable = mp_thumb_cache_restart(cache);
+        }
+        if (!usable) {
+            mp_thumb_cache_close(cache);
+            return NULL;
+        }
+    }
+    
+    if (exclusive) flock(cache->fd, LOCK_SH);
+    return cache;
+}
+
+void mp_thumb_cache_close(mp_thumb_cache* cache) {
+    if (!cache) return;
+    mp_thumb_cache_forget(cache);
+    close(cache->fd);
+    mp_free(cache->path);
+    pthread_mutex_destroy(&cache->lock);
+    mp_free(cache);
+}
+
+mp_bool mp_thumb_cache_key(const char* filepath, u64* out_key) {
+    struct stat st;
+    if (!filepath || stat(filepath, &st) != 0) return MP_FALSE;
+    
+    /* FNV-1a over the path, then size and mtime / 경로, 크기, 수정 시각에 대한 FNV-1a */
+    u64 hash = 0xcbf29ce484222325ull;
+    for (const u8* p = (const u8*)filepath; *p; p++) hash = (hash ^ *p) * 0x100000001b3ull;
+    u64 fields[3] = { (u64)st.st_size, (u64)st.st_mtim.tv_sec, (u64)st.st_mtim.tv_nsec };
+    const u8* bytes = (const u8*)fields;
+    for (size_t i = 0; i < sizeof(fields); i++) hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    
+    *out_key = hash ? hash : 1;
+    return MP_TRUE;
+}
+
+mp_bool mp_thumb_cache_contains(mp_thumb_cache* cache, u64 key) {
+    if (!cache || key == 0) return MP_FALSE;
+    pthread_mutex_lock(&cache->lock);
+    mp_bool found = cache->capacity && mp_thumb_cache_slot(cache, key)->key == key;
+    pthread_mutex_unlock(&cache->lock);
+    return found;
+}
+
+mp_bool mp_thumb_cache_lookup(mp_thumb_cache* cache, u64 key, u32* dst, u32* out_width, u32* out_height) {
+    if (!cache || key == 0 || !dst) return MP_FALSE;
+    
+    /* Held throughout: a pack restarted by a store unmaps what this would read
+     * / 읽는 동안 잠금 유지 (저장 중 새 팩을 시작하면 매핑이 해제됨) */
+    pthread_mutex_lock(&cache->lock);
+    mp_bool found = cache->capacity && mp_thumb_cache_slot(cache, key)->key == key;
+    u64 offset = found ? mp_thumb_cache_slot(cache, key)->offset : 0;
+    
+    mp_thumb_record record;
+    const u8* pixels = NULL;
+    u8* scratch = NULL;
+    if (!found) {
+        /* Miss / 없음 */
+    } else if (offset + sizeof(record) <= cache->map_size) {
+        memcpy(&record, cache->map + offset, sizeof(record));
+        if (mp_thumb_record_valid(&record) && offset + sizeof(record) + record.payload <= cache->map_size) {
+            pixels = cache->map + offset + sizeof(record);
+        }
+    } else if (pread(cache->fd, &record, sizeof(record), (off_t)offset) == (ssize_t)sizeof(record) &&
+               mp_thumb_record_valid(&record)) {
+        scratch = (u8*)mp_malloc(record.payload);
+        if (scratch && pread(cache->fd, scratch, record.payload, (off_t)(offset + sizeof(record))) == (ssize_t)record.payload) {
+            pixels = scratch;
+        }
+    }
+    
+    if (pixels) {
+        u32 count = (u32)record.width * record.height;
+        if (record.channels == 3) mp_argb_convert_span(pixels, MP_COLOR_FORMAT_RGB, dst, count);
+        else memcpy(dst, pixels, (size_t)count * 4);
+    }
+    pthread_mutex_unlock(&cache->lock);
+    mp_free(scratch);
+    if (!pixels) return MP_FALSE;
+    
+    *out_width = record.width;
+    *out_height = record.height;
+    return MP_TRUE;
+}
+
+mp_result mp_thumb_cache_store(mp_thumb_cache* cache, u64 key, const u32* argb, u32 width, u32 height) {
+    if (!cache || key == 0 || !argb || width == 0 || height == 0 ||
+        width > MP_THUMB_SIZE || height > MP_THUMB_SIZE) {
+        return MP_ERROR_INVALID_PARAM;
+    }
+    
+    u32 count = width * height;
+    mp_bool opaque = MP_TRUE;
+    for (u32 i = 0; i < count && opaque; i++) opaque = (argb[i] >> 24) == 0xFF;
+    
+    mp_thumb_record record;
+    memset(&record, 0, sizeof(record));
+    record.magic = MP_THUMB_RECORD_MAGIC;
+    record.key = key;
+    record.width = (u16)width;
+    record.height = (u16)height;
+    record.channels = opaque ? 3 : 4;
+    record.payload = count * record.channels;
+    
+    /* One write per record so concurrent appenders never interleave / 레코드당 한 번의 쓰기로 추가 */
+    size_t size = mp_thumb_record_size(record.payload);
+    u8* buffer = (u8*)mp_calloc(1, size);
+    if (!buffer) return MP_ERROR_MEMORY;
+    memcpy(buffer, &record, sizeof(record));
+    u8* out = buffer + sizeof(record);
+    if (opaque) {
+        for (u32 i = 0; i < count; i++, out += 3) {
+            out[0] = (u8)(argb[i] >> 16);
+            out[1] = (u8)(argb[i] >> 8);
+            out[2] = (u8)argb[i];
+        }
+    } else {
+        memcpy(out, argb, (size_t)count * 4);
+    }
+    
+    /* Appends need no exclusive lock: O_APPEND puts each single write whole at the end, even
+     * with other processes appending too. A full pack is replaced rather than refusing
+     * every later store / O_APPEND 단일 쓰기는 다른 프로세스와도 섞이지 않음. 가득 찬 팩은 새로 시작 */
+    mp_result result = MP_ERROR_IO;
+    pthread_mutex_lock(&cache->lock);
+    if (cache->read_only) {
+        result = MP_ERROR_UNSUPPORTED;
+    } else if ((cache->file_size + size <= cache->limit || mp_thumb_cache_restart(cache)) &&
+               write(cache->fd, buffer, size) == (ssize_t)size) {
+        off_t end = lseek(cache->fd, 0, SEEK_CUR);
+        if (end >= (off_t)size) {
+            cache->file_size = (size_t)end;
+            if (mp_thumb_cache_index(cache, key, (u64)end - size)) result = MP_SUCCESS;
+        }
+    }
+    pthread_mutex_unlock(&cache->lock);
+    mp_free(buffer);
+    return result;
+}
+
+u32 mp_thumb_cache_count(mp_thumb_cache* cache) {
+    if (!cache) return 0;
+    pthread_mutex_lock(&cache->lock);
+    u32 count = cache->count;
+    pthread_mutex_unlock(&cache->lock);
+    return count;
+}
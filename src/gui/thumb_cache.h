@@ -0,0 +1,52 @@
+#ifndef MANYPICTURES_THUMB_CACHE_H
+#define MANYPICTURES_THUMB_CACHE_H
+
+#include "../core/types.h"
+
+/* Persistent thumbnail cache / 영구 썸네일 캐시
+ *
+ * One append-only pack file (default `$XDG_CACHE_HOME/manypictures/thumbnails.pack`)
+ * holds thumbnails keyed by a hash of path, mtime and size, so an edited file simply
+ * gets a new key. Opening maps the pack and indexes its records; a torn tail left by a
+ * crash is cut off. Lookups copy straight out of the mapping, and records appended in
+ * this session are read back with pread. Once the pack reaches its limit
+ * (`MP_THUMB_CACHE_MB`, default 1024) a new one is started in its place.
+ * Every process holds a shared flock on the pack. Only a process that gets it exclusively
+ * at open cuts a torn tail or rewrites the pack in place; otherwise a torn tail (possibly
+ * another process's append in progress) leaves the cache read-only, and a new pack
+ * replaces the old one by rename so other processes' mappings stay intact.
+ * 경로, 수정 시각, 크기의 해시로 키를 정한 썸네일을 추가 전용 팩 파일 하나에 저장하며,
+ * 열 때 매핑하여 색인하고 조회는 매핑에서 바로 복사합니다.
+ */
+
+/* Longest thumbnail edge in pixels / 썸네일 최대 변 길이 (픽셀) */
+#define MP_THUMB_SIZE 128
+
+#define MP_THUMB_CACHE_LIMIT_MB 1024
+
+typedef struct mp_thumb_cache mp_thumb_cache;
+
+/* `path` NULL uses the default location, creating its directories; NULL if the pack
+ * cannot be opened / `path`가 NULL이면 기본 위치 사용 (열 수 없으면 NULL) */
+mp_thumb_cache* mp_thumb_cache_open(const char* path);
+void mp_thumb_cache_close(mp_thumb_cache* cache);
+
+/* Key of `filepath` as it is on disk now; MP_FALSE if it cannot be stat'ed
+ * / 현재 디스크 상태 기준 `filepath`의 키 (stat 실패 시 MP_FALSE) */
+mp_bool mp_thumb_cache_key(const char* filepath, u64* out_key);
+
+mp_bool mp_thumb_cache_contains(mp_thumb_cache* cache, u64 key);
+
+/* Premultiplied ARGB32 pixels into `dst` (MP_THUMB_SIZE² capacity); MP_FALSE on a miss
+ * / 프리멀티플라이된 ARGB32로 `dst`에 복사 (없으면 MP_FALSE) */
+mp_bool mp_thumb_cache_lookup(mp_thumb_cache* cache, u64 key, u32* dst, u32* out_width, u32* out_height);
+
+/* Append a thumbnail; opaque ones are stored as RGB. Safe from several threads and
+ * processes. MP_ERROR_UNSUPPORTED while the cache is read-only.
+ * / 썸네일 추가 (불투명하면 RGB로 저장, 여러 스레드·프로세스에서 호출 가능) */
+mp_result mp_thumb_cache_store(mp_thumb_cache* cache, u64 key, const u32* argb, u32 width, u32 height);
+
+/* Number of indexed thumbnails / 색인된 썸네일 수 */
+u32 mp_thumb_cache_count(mp_thumb_cache* cache);
+
+#endif /* MANYPICTURES_THUMB_CACHE_H */
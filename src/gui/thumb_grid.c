@@ -0,0 +1,531 @@
+#define _POSIX_C_SOURCE 200809L
+#include "thumb_grid.h"
+#include "dir_scan.h"
+#include "argb_convert.h"
+#include "../core/memory.h"
+#include "../core/image.h"
+#include "../core/parallel.h"
+#include "../codecs/jpeg.h"
+#include "../exif/exif.h"
+#include <cairo/cairo.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+typedef enum {
+    MP_THUMB_PENDING,
+    MP_THUMB_WORKING,
+    MP_THUMB_CACHED,          /* In the pack / 팩에 저장됨 */
+    MP_THUMB_MEMORY,          /* The pack refused it; pixels kept here / 팩 저장 실패, 메모리에 보관 */
+    MP_THUMB_FAILED
+} mp_thumb_state;
+
+typedef struct {
+    mp_thumb_state state;     /* Guarded by the grid lock / 그리드 lock으로 보호 */
+    u64 key;
+    u32* pixels;              /* MP_THUMB_MEMORY only, immutable once set / 설정 후 불변 */
+    u32 width;
+    u32 height;
+    i32 slot;                 /* Surface slot, event thread only / 서피스 슬롯 (이벤트 스레드 전용) */
+} mp_thumb_item;
+
+typedef struct {
+    i32 item;                 /* -1 when free / 비어 있으면 -1 */
+    u64 frame;                /* Last frame that drew it / 마지막으로 그린 프레임 */
+    cairo_surface_t* surface;
+} mp_thumb_surface;
+
+struct mp_thumb_grid {
+    char* prefix;
+    char** files;
+    u32 count;
+    mp_thumb_item* items;
+    mp_thumb_cache* cache;
+    
+    pthread_t threads[MP_THUMB_GRID_MAX_THREADS];
+    u32 thread_count;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    int notify[2];            /* [0] read by the event loop / 이벤트 루프가 읽는 알림 파이프 */
+    
+    /* Guarded by lock / lock으로 보호 */
+    mp_bool quit;
+    mp_bool paused;
+    u32 cursor;               /* Where workers look for the next file / 다음 파일 탐색 시작 위치 */
+    u32 remaining;            /* Items still MP_THUMB_PENDING / 대기 중인 항목 수 */
+    
+    /* Event thread only / 이벤트 스레드 전용 */
+    mp_thumb_surface surfaces[MP_THUMB_GRID_SURFACES];
+    u32* scratch;
+    u64 frame;
+    i32 selected;
+    i32 scroll;
+    i32 view_x, view_y, view_w, view_h;
+    i32 columns;
+    i32 left;
+    u32 focus;
+};
+
+/* Fit into MP_THUMB_SIZE² keeping the aspect ratio, averaging every covered source pixel in
+ * premultiplied ARGB / 비율을 유지해 MP_THUMB_SIZE² 안에 맞추며 덮는 원본 픽셀을 모두 평균 */
+static mp_bool mp_thumb_downscale(const mp_image_buffer* src, u32* dst, u32* out_width, u32* out_height) {
+    if (!src || !src->data || src->width == 0 || src->height == 0) return MP_FALSE;
+    
+    u32 sw = src->width, sh = src->height;
+    u32 dw = sw, dh = sh;
+    if (sw > MP_THUMB_SIZE || sh > MP_THUMB_SIZE) {
+        if (sw >= sh) {
+            dw = MP_THUMB_SIZE;
+            dh = (u32)(((u64)sh * MP_THUMB_SIZE + sw / 2) / sw);
+        } else {
+            dh = MP_THUMB_SIZE;
+            dw = (u32)(((u64)sw * MP_THUMB_SIZE + sh / 2) / sh);
+        }
+        if (dw == 0) dw = 1;
+        if (dh == 0) dh = 1;
+    }
+    
+    u32* line = (u32*)mp_malloc((size_t)sw * sizeof(u32));
+    u64* acc = (u64*)mp_calloc((size_t)dw * 4, sizeof(u64));
+    u32* columns = (u32*)mp_calloc(dw, sizeof(u32));
+    if (!line || !acc || !columns) {
+        mp_free(line);
+        mp_free(acc);
+        mp_free(columns);
+        return MP_FALSE;
+    }
+    for (u32 x = 0; x < sw; x++) columns[(u64)x * dw / sw]++;
+    
+    mp_color_format format = mp_argb_source_format(src);
+    u32 rows = 0;
+    for (u32 y = 0; y < sh; y++) {
+        u32 oy = (u32)((u64)y * dh / sh);
+        mp_argb_convert_span(src->data + (size_t)y * src->stride, format, line, sw);
+        for (u32 x = 0; x < sw; x++) {
+            u64* a = &acc[((u64)x * dw / sw) * 4];
+            u32 v = line[x];
+            a[0] += v >> 24;
+            a[1] += (v >> 16) & 0xFF;
+            a[2] += (v >> 8) & 0xFF;
+            a[3] += v & 0xFF;
+        }
+        rows++;
+        
+        /* Last source row of this output row / 이 출력 행의 마지막 원본 행 */
+        if (y + 1 == sh || (u32)((u64)(y + 1) * dh / sh) != oy) {
+            u32* out = dst + (size_t)oy * dw;
+            for (u32 x = 0; x < dw; x++) {
+                u64 count = (u64)columns[x] * rows;
+                u64 half = count / 2;
+                const u64* a = &acc[x * 4];
+                out[x] = (u32)(((a[0] + half) / count) << 24 | ((a[1] + half) / count) << 16 |
+                               ((a[2] + half) / count) << 8 | ((a[3] + half) / count));
+            }
+            memset(acc, 0, (size_t)dw * 4 * sizeof(u64));
+            rows = 0;
+        }
+    }
+    
+    mp_free(line);
+    mp_free(acc);
+    mp_free(columns);
+    *out_width = dw;
+    *out_height = dh;
+    return MP_TRUE;
+}
+
+/* The EXIF thumbnail of a camera JPEG decodes in a fraction of the time of the photo
+ * / 카메라 JPEG의 EXIF 썸네일은 원본보다 훨씬 빨리 디코딩됨 */
+static mp_bool mp_thumb_from_exif(const char* path, u32* dst, u32* width, u32* height) {
+    u8* data = NULL;
+    size_t size = 0;
+    if (mp_exif_read_thumbnail(path, &data, &size) != MP_SUCCESS) return MP_FALSE;
+    
+    mp_bool made = MP_FALSE;
+    jpeg_decoder* decoder = mp_jpeg_decoder_create(data, size);
+    if (decoder) {
+        mp_image_buffer* buffer = NULL;
+        if (mp_jpeg_decode(decoder, &buffer) == MP_SUCCESS && buffer) {
+            made = mp_thumb_downscale(buffer, dst, width, height);
+        }
+        if (buffer) mp_image_buffer_destroy(buffer);
+        mp_jpeg_decoder_destroy(decoder);
+    }
+    mp_free(data);
+    return made;
+}
+
+static mp_bool mp_thumb_from_image(const char* path, u32* dst, u32* width, u32* height) {
+    mp_image* image = mp_image_load(path);
+    if (!image) return MP_FALSE;
+    mp_bool made = mp_thumb_downscale(image->buffer, dst, width, height);
+    mp_image_destroy(image);
+    return made;
+}
+
+/* Runs on a pool thread without the lock / 잠금 없이 풀 스레드에서 실행 */
+static mp_thumb_state mp_thumb_grid_generate(mp_thumb_grid* grid, const char* path, mp_thumb_item* out) {
+    if (!mp_thumb_cache_key(path, &out->key)) return MP_THUMB_FAILED;
+    if (mp_thumb_cache_contains(grid->cache, out->key)) return MP_THUMB_CACHED;
+    
+    u32* pixels = (u32*)mp_malloc((size_t)MP_THUMB_SIZE * MP_THUMB_SIZE * sizeof(u32));
+    if (!pixels) return MP_THUMB_FAILED;
+    if (!mp_thumb_from_exif(path, pixels, &out->width, &out->height) &&
+        !mp_thumb_from_image(path, pixels, &out->width, &out->height)) {
+        mp_free(pixels);
+        return MP_THUMB_FAILED;
+    }
+    
+    if (mp_thumb_cache_store(grid->cache, out->key, pixels, out->width, out->height) == MP_SUCCESS) {
+        mp_free(pixels);
+        return MP_THUMB_CACHED;
+    }
+    out->pixels = pixels;
+    return MP_THUMB_MEMORY;
+}
+
+static void* mp_thumb_grid_main(void* arg) {
+    mp_thumb_grid* grid = (mp_thumb_grid*)arg;
+    
+    pthread_mutex_lock(&grid->lock);
+    for (;;) {
+        while (!grid->quit && (grid->paused || grid->remaining == 0)) {
+            pthread_cond_wait(&grid->wake, &grid->lock);
+        }
+        if (grid->quit) break;
+        
+        /* First pending item from the cursor on / 커서부터 첫 대기 항목 */
+        u32 index = grid->cursor % grid->count;
+        while (grid->items[index].state != MP_THUMB_PENDING) index = (index + 1) % grid->count;
+        grid->items[index].state = MP_THUMB_WORKING;
+        grid->remaining--;
+        grid->cursor = index + 1;
+        pthread_mutex_unlock(&grid->lock);
+        
+        mp_thumb_item made = { MP_THUMB_PENDING, 0, NULL, 0, 0, -1 };
+        mp_thumb_state state = mp_thumb_grid_generate(grid, grid->files[index], &made);
+        
+        pthread_mutex_lock(&grid->lock);
+        mp_thumb_item* item = &grid->items[index];
+        item->key = made.key;
+        item->pixels = made.pixels;
+        item->width = made.width;
+        item->height = made.height;
+        item->state = state;
+        
+        /* Pipe is non-blocking; a full pipe already means "wake up" / 파이프가 가득 차도 이미 깨우기 신호 */
+        u8 signal = 1;
+        ssize_t written = write(grid->notify[1], &signal, 1);
+        (void)written;
+    }
+    pthread_mutex_unlock(&grid->lock);
+    return NULL;
+}
+
+mp_thumb_grid* mp_thumb_grid_create(const char* prefix, mp_thumb_cache* cache) {
+    if (!prefix) return NULL;
+    mp_thumb_grid* grid = (mp_thumb_grid*)mp_calloc(1, sizeof(mp_thumb_grid));
+    if (!grid) return NULL;
+    
+    grid->cache = cache;
+    grid->prefix = mp_strdup(prefix);
+    grid->files = mp_dir_scan_images(prefix, &grid->count);
+    grid->scratch = (u32*)mp_malloc((size_t)MP_THUMB_SIZE * MP_THUMB_SIZE * sizeof(u32));
+    grid->items = (mp_thumb_item*)mp_calloc(grid->count ? grid->count : 1, sizeof(mp_thumb_item));
+    if (!grid->prefix || !grid->files || !grid->scratch || !grid->items || pipe(grid->notify) == -1) {
+        mp_dir_scan_free(grid->files, grid->count);
+        mp_free(grid->items);
+        mp_free(grid->scratch);
+        mp_free(grid->prefix);
+        mp_free(grid);
+        return NULL;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(grid->notify[i], F_SETFL, fcntl(grid->notify[i], F_GETFL, 0) | O_NONBLOCK);
+        fcntl(grid->notify[i], F_SETFD, FD_CLOEXEC);
+    }
+    for (u32 i = 0; i < grid->count; i++) grid->items[i].slot = -1;
+    for (u32 i = 0; i < MP_THUMB_GRID_SURFACES; i++) grid->surfaces[i].item = -1;
+    grid->remaining = grid->count;
+    grid->columns = 1;
+    pthread_mutex_init(&grid->lock, NULL);
+    pthread_cond_init(&grid->wake, NULL);
+    
+    /* Leave one core to the event thread / 이벤트 스레드를 위해 코어 하나를 남김 */
+    u32 threads = mp_parallel_thread_count();
+    threads = threads > 1 ? threads - 1 : 1;
+    if (threads > MP_THUMB_GRID_MAX_THREADS) threads = MP_THUMB_GRID_MAX_THREADS;
+    while (grid->thread_count < threads &&
+           pthread_create(&grid->threads[grid->thread_count], NULL, mp_thumb_grid_main, grid) == 0) {
+        grid->thread_count++;
+    }
+    if (grid->thread_count == 0) {
+        mp_thumb_grid_destroy(grid);
+        return NULL;
+    }
+    return grid;
+}
+
+void mp_thumb_grid_destroy(mp_thumb_grid* grid) {
+    if (!grid) return;
+    
+    pthread_mutex_lock(&grid->lock);
+    grid->quit = MP_TRUE;
+    pthread_cond_broadcast(&grid->wake);
+    pthread_mutex_unlock(&grid->lock);
+    for (u32 i = 0; i < grid->thread_count; i++) pthread_join(grid->threads[i], NULL);
+    
+    for (u32 i = 0; i < MP_THUMB_GRID_SURFACES; i++) {
+        if (grid->surfaces[i].surface) cairo_surface_destroy(grid->surfaces[i].surface);
+    }
+    for (u32 i = 0; i < grid->count; i++) mp_free(grid->items[i].pixels);
+    pthread_cond_destroy(&grid->wake);
+    pthread_mutex_destroy(&grid->lock);
+    close(grid->notify[0]);
+    close(grid->notify[1]);
+    mp_dir_scan_free(grid->files, grid->count);
+    mp_free(grid->items);
+    mp_free(grid->scratch);
+    mp_free(grid->prefix);
+    mp_free(grid);
+}
+
+const char* mp_thumb_grid_prefix(const mp_thumb_grid* grid) {
+    return grid ? grid->prefix : NULL;
+}
+
+u32 mp_thumb_grid_count(const mp_thumb_grid* grid) {
+    return grid ? grid->count : 0;
+}
+
+const char* mp_thumb_grid_path(const mp_thumb_grid* grid, i32 index) {
+    if (!grid || index < 0 || (u32)index >= grid->count) return NULL;
+    return grid->files[index];
+}
+
+void mp_thumb_grid_pause(mp_thumb_grid* grid, mp_bool paused) {
+    if (!grid) return;
+    pthread_mutex_lock(&grid->lock);
+    grid->paused = paused;
+    if (!paused) pthread_cond_broadcast(&grid->wake);
+    pthread_mutex_unlock(&grid->lock);
+}
+
+int mp_thumb_grid_fd(const mp_thumb_grid* grid) {
+    return grid ? grid->notify[0] : -1;
+}
+
+mp_bool mp_thumb_grid_dispatch(mp_thumb_grid* grid) {
+    if (!grid) return MP_FALSE;
+    mp_bool ready = MP_FALSE;
+    u8 drain[64];
+    while (read(grid->notify[0], drain, sizeof(drain)) > 0) ready = MP_TRUE;
+    return ready;
+}
+
+i32 mp_thumb_grid_selected(const mp_thumb_grid* grid) {
+    return grid ? grid->selected : -1;
+}
+
+/* Keep scroll inside the content / 스크롤을 내용 범위 안으로 제한 */
+static void mp_thumb_grid_clamp_scroll(mp_thumb_grid* grid) {
+    i32 rows = (i32)((grid->count + (u32)grid->columns - 1) / (u32)grid->columns);
+    i32 max_scroll = rows * MP_THUMB_GRID_CELL - grid->view_h;
+    if (grid->scroll > max_scroll) grid->scroll = max_scroll;
+    if (grid->scroll < 0) grid->scroll = 0;
+}
+
+/* Scroll just enough to show the selected cell / 선택된 칸이 보일 만큼만 스크롤 */
+static void mp_thumb_grid_reveal(mp_thumb_grid* grid) {
+    i32 top = (grid->selected / grid->columns) * MP_THUMB_GRID_CELL;
+    if (top < grid->scroll) grid->scroll = top;
+    if (top + MP_THUMB_GRID_CELL > grid->scroll + grid->view_h) grid->scroll = top + MP_THUMB_GRID_CELL - grid->view_h;
+    mp_thumb_grid_clamp_scroll(grid);
+}
+
+void mp_thumb_grid_select(mp_thumb_grid* grid, i32 index) {
+    if (!grid || grid->count == 0) return;
+    if (index < 0) index = 0;
+    if ((u32)index >= grid->count) index = (i32)grid->count - 1;
+    grid->selected = index;
+    mp_thumb_grid_reveal(grid);
+}
+
+void mp_thumb_grid_move(mp_thumb_grid* grid, i32 dx, i32 dy) {
+    if (!grid) return;
+    mp_thumb_grid_select(grid, grid->selected + dx + dy * grid->columns);
+}
+
+void mp_thumb_grid_scroll(mp_thumb_grid* grid, i32 dy) {
+    if (!grid) return;
+    grid->scroll += dy;
+    mp_thumb_grid_clamp_scroll(grid);
+}
+
+i32 mp_thumb_grid_hit(const mp_thumb_grid* grid, i32 x, i32 y) {
+    if (!grid || x < grid->view_x || y < grid->view_y ||
+        x >= grid->view_x + grid->view_w || y >= grid->view_y + grid->view_h || x < grid->left) {
+        return -1;
+    }
+    i32 column = (x - grid->left) / MP_THUMB_GRID_CELL;
+    i32 row = (y - grid->view_y + grid->scroll) / MP_THUMB_GRID_CELL;
+    if (column >= grid->columns) return -1;
+    i64 index = (i64)row * grid->columns + column;
+    return index < (i64)grid->count ? (i32)index : -1;
+}
+
+/* Surface of a ready thumbnail, reusing the slot least recently drawn; NULL while pending
+ * / 준비된 썸네일의 서피스 (가장 오래 전에 그린 슬롯 재사용, 대기 중이면 NULL) */
+static cairo_surface_t* mp_thumb_grid_surface(mp_thumb_grid* grid, u32 index, mp_thumb_state* out_state) {
+    mp_thumb_item* item = &grid->items[index];
+    pthread_mutex_lock(&grid->lock);
+    mp_thumb_state state = item->state;
+    pthread_mutex_unlock(&grid->lock);
+    *out_state = state;
+    
+    if (item->slot >= 0) {
+        grid->surfaces[item->slot].frame = grid->frame;
+        return grid->surfaces[item->slot].surface;
+    }
+    if (state != MP_THUMB_CACHED && state != MP_THUMB_MEMORY) return NULL;
+    
+    u32 width = item->width, height = item->height;
+    const u32* pixels = item->pixels;
+    if (state == MP_THUMB_CACHED) {
+        if (!mp_thumb_cache_lookup(grid->cache, item->key, grid->scratch, &width, &height)) return NULL;
+        pixels = grid->scratch;
+    }
+    
+    i32 slot = -1;
+    for (i32 i = 0; i < MP_THUMB_GRID_SURFACES; i++) {
+        mp_thumb_surface* s = &grid->surfaces[i];
+        if (s->item < 0) {
+            slot = i;
+            break;
+        }
+        if (s->frame != grid->frame && (slot < 0 || s->frame < grid->surfaces[slot].frame)) slot = i;
+    }
+    if (slot < 0) return NULL;
+    
+    mp_thumb_surface* s = &grid->surfaces[slot];
+    if (s->item >= 0) grid->items[s->item].slot = -1;
+    if (s->surface) cairo_surface_destroy(s->surface);
+    s->item = -1;
+    s->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, (int)width, (int)height);
+    if (cairo_surface_status(s->surface) != CAIRO_STATUS_SUCCESS) {
+        cairo_surface_destroy(s->surface);
+        s->surface = NULL;
+        return NULL;
+    }
+    
+    cairo_surface_flush(s->surface);
+    u8* data = cairo_image_surface_get_data(s->surface);
+    int stride = cairo_image_surface_get_stride(s->surface);
+    for (u32 y = 0; y < height; y++) memcpy(data + (size_t)y * stride, pixels + (size_t)y * width, (size_t)width * 4);
+    cairo_surface_mark_dirty(s->surface);
+    
+    s->item = (i32)index;
+    s->frame = grid->frame;
+    item->slot = slot;
+    return s->surface;
+}
+
+/* File name below the thumbnail, shortened to the cell / 썸네일 아래 파일 이름 (셀 폭에 맞춤) */
+static void mp_thumb_grid_caption(cairo_t* cr, const char* path, double x, double y, double width) {
+    const char* slash = strrchr(path, '/');
+    const char* name = slash ? slash + 1 : path;
+    char text[256];
+    snprintf(text, sizeof(text), "%s", name);
+    
+    cairo_text_extents_t extents;
+    cairo_text_extents(cr, text, &extents);
+    size_t len = strlen(text);
+    while (extents.x_advance > width && len > 1) {
+        /* Step back over whole UTF-8 sequences / UTF-8 문자 단위로 줄임 */
+        do len--; while (len > 0 && ((u8)text[len] & 0xC0) == 0x80);
+        if (len + 4 > sizeof(text)) break;
+        memcpy(text + len, "...", 4);
+        cairo_text_extents(cr, text, &extents);
+    }
+    cairo_move_to(cr, x + (width - extents.x_advance) / 2.0, y);
+    cairo_show_text(cr, text);
+}
+
+void mp_thumb_grid_draw(mp_thumb_grid* grid, void* context, i32 x, i32 y, i32 width, i32 height, const char* font) {
+    if (!grid || !context || width <= 0 || height <= 0) return;
+    cairo_t* cr = (cairo_t*)context;
+    
+    /* A selection made before the first layout, or a resize, used the old geometry: bring
+     * it back into view / 첫 배치 전 선택이나 크기 변경 후에는 선택 항목을 다시 보이게 함 */
+    i32 columns = width / MP_THUMB_GRID_CELL > 0 ? width / MP_THUMB_GRID_CELL : 1;
+    mp_bool relayout = columns != grid->columns || height != grid->view_h;
+    grid->view_x = x;
+    grid->view_y = y;
+    grid->view_w = width;
+    grid->view_h = height;
+    grid->columns = columns;
+    grid->left = x + (width - grid->columns * MP_THUMB_GRID_CELL) / 2;
+    if (relayout && grid->count > 0) mp_thumb_grid_reveal(grid);
+    else mp_thumb_grid_clamp_scroll(grid);
+    grid->frame++;
+    
+    cairo_save(cr);
+    cairo_rectangle(cr, x, y, width, height);
+    cairo_clip(cr);
+    cairo_select_font_face(cr, font, CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 11);
+    
+    if (grid->count == 0) {
+        cairo_set_source_rgb(cr, 0.7, 0.7, 0.7);
+        cairo_move_to(cr, x + 20, y + 30);
+        cairo_show_text(cr, "No images in this folder / 이 폴더에 이미지가 없습니다");
+        cairo_restore(cr);
+        return;
+    }
+    
+    u32 first = (u32)(grid->scroll / MP_THUMB_GRID_CELL) * (u32)grid->columns;
+    u32 last = (u32)((grid->scroll + height - 1) / MP_THUMB_GRID_CELL + 1) * (u32)grid->columns;
+    if (last > grid->count) last = grid->count;
+    
+    /* Workers continue from the first visible cell / 작업 스레드는 첫 번째 보이는 셀부터 진행 */
+    if (first != grid->focus) {
+        grid->focus = first;
+        pthread_mutex_lock(&grid->lock);
+        grid->cursor = first;
+        pthread_mutex_unlock(&grid->lock);
+    }
+    
+    for (u32 i = first; i < last; i++) {
+        double cx = grid->left + (double)((i32)i % grid->columns) * MP_THUMB_GRID_CELL;
+        double cy = y + (double)((i32)i / grid->columns) * MP_THUMB_GRID_CELL - grid->scroll;
+        double box_x = cx + (MP_THUMB_GRID_CELL - MP_THUMB_SIZE) / 2.0;
+        double box_y = cy + 6;
+        
+        if ((i32)i == grid->selected) {
+            cairo_set_source_rgba(cr, 0.4, 0.8, 1.0, 0.25);
+            cairo_rectangle(cr, cx + 2, cy + 2, MP_THUMB_GRID_CELL - 4, MP_THUMB_GRID_CELL - 4);
+            cairo_fill(cr);
+        }
+        
+        mp_thumb_state state;
+        cairo_surface_t* surface = mp_thumb_grid_surface(grid, i, &state);
+        if (surface) {
+            double tw = cairo_image_surface_get_width(surface);
+            double th = cairo_image_surface_get_height(surface);
+            cairo_set_source_surface(cr, surface, box_x + (MP_THUMB_SIZE - tw) / 2.0, box_y + (MP_THUMB_SIZE - th) / 2.0);
+            cairo_paint(cr);
+        } else {
+            /* Placeholder, reddish when the file could not be read / 자리 표시 (읽기 실패 시 붉은색) */
+            if (state == MP_THUMB_FAILED) cairo_set_source_rgba(cr, 0.6, 0.2, 0.2, 0.3);
+            else cairo_set_source_rgba(cr, 1, 1, 1, 0.06);
+            cairo_rectangle(cr, box_x, box_y, MP_THUMB_SIZE, MP_THUMB_SIZE);
+            cairo_fill(cr);
+        }
+        
+        cairo_set_source_rgb(cr, 0.85, 0.85, 0.85);
+        mp_thumb_grid_caption(cr, grid->files[i], cx + 4, cy + MP_THUMB_GRID_CELL - 12, MP_THUMB_GRID_CELL - 8);
+    }
+    cairo_restore(cr);
+}
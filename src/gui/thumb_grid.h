@@ -0,0 +1,60 @@
+#ifndef MANYPICTURES_THUMB_GRID_H
+#define MANYPICTURES_THUMB_GRID_H
+
+#include "../core/types.h"
+#include "thumb_cache.h"
+
+/* Thumbnail grid of one directory / 디렉터리 썸네일 그리드
+ *
+ * A pool of threads makes one thumbnail per image file: a pack hit costs only an index
+ * probe, otherwise the EXIF thumbnail is tried before a full decode, and the result is
+ * appended to the pack. Workers start from the first visible cell, so whatever is on
+ * screen is ready first. The event thread turns ready thumbnails into Cairo surfaces,
+ * keeping at most MP_THUMB_GRID_SURFACES of them.
+ * 스레드 풀이 이미지마다 썸네일을 만들며 (팩 적중, EXIF 썸네일, 전체 디코딩 순), 화면에 보이는 셀부터 처리합니다.
+ */
+
+#define MP_THUMB_GRID_CELL 160        /* Cell pitch: thumbnail, margin and caption / 셀 간격 */
+#define MP_THUMB_GRID_SURFACES 512    /* Thumbnails kept as Cairo surfaces / Cairo 서피스로 유지할 썸네일 수 */
+#define MP_THUMB_GRID_MAX_THREADS 8
+
+typedef struct mp_thumb_grid mp_thumb_grid;
+
+/* Images under `prefix` (see mp_dir_scan_images); `cache` may be NULL and must outlive
+ * the grid / `prefix` 아래 이미지의 그리드 (`cache`는 NULL 가능, 그리드보다 오래 유지) */
+mp_thumb_grid* mp_thumb_grid_create(const char* prefix, mp_thumb_cache* cache);
+
+/* Waits for thumbnails in progress / 진행 중인 썸네일 생성을 기다림 */
+void mp_thumb_grid_destroy(mp_thumb_grid* grid);
+
+const char* mp_thumb_grid_prefix(const mp_thumb_grid* grid);
+u32 mp_thumb_grid_count(const mp_thumb_grid* grid);
+
+/* NULL outside [0, count) / 범위 밖이면 NULL */
+const char* mp_thumb_grid_path(const mp_thumb_grid* grid, i32 index);
+
+/* Paused workers finish their current file and wait / 일시 정지 시 현재 파일만 마치고 대기 */
+void mp_thumb_grid_pause(mp_thumb_grid* grid, mp_bool paused);
+
+/* Readable when thumbnails became ready; mp_thumb_grid_dispatch drains it and reports
+ * whether any did / 썸네일 준비 시 읽기 가능 (dispatch가 비우고 준비 여부 반환) */
+int mp_thumb_grid_fd(const mp_thumb_grid* grid);
+mp_bool mp_thumb_grid_dispatch(mp_thumb_grid* grid);
+
+/* Selection, scrolled into view; moves are in cells and clamp at the ends
+ * / 선택 항목 (보이도록 스크롤, 이동은 셀 단위) */
+i32 mp_thumb_grid_selected(const mp_thumb_grid* grid);
+void mp_thumb_grid_select(mp_thumb_grid* grid, i32 index);
+void mp_thumb_grid_move(mp_thumb_grid* grid, i32 dx, i32 dy);
+
+/* Scroll by `dy` pixels / `dy` 픽셀만큼 스크롤 */
+void mp_thumb_grid_scroll(mp_thumb_grid* grid, i32 dy);
+
+/* Cell under a window point as of the last draw, -1 if none / 마지막 그리기 기준 해당 위치의 셀 */
+i32 mp_thumb_grid_hit(const mp_thumb_grid* grid, i32 x, i32 y);
+
+/* Paint the grid into the window rectangle (x, y, width, height); `cr` is a cairo_t*
+ * / 창 사각형에 그리드를 그림 */
+void mp_thumb_grid_draw(mp_thumb_grid* grid, void* cr, i32 x, i32 y, i32 width, i32 height, const char* font);
+
+#endif /* MANYPICTURES_THUMB_GRID_H */
@@ -0,0 +1,235 @@
+#include "undo_store.h"
+#include "../core/memory.h"
+#include "../core/image.h"
+#include "../operations/color_ops.h"
+#include "../operations/edit_ops.h"
+#include <string.h>
+
+static mp_bool mp_undo_is_invertible(mp_operation_type op_type) {
+    return op_type == MP_OP_INVERT || op_type == MP_OP_FLIP_H ||
+           op_type == MP_OP_FLIP_V || op_type == MP_OP_ROTATE;
+}
+
+/* Apply an invertible operation forwards or backwards / 가역 연산을 정방향 또는 역방향으로 적용 */
+static mp_result mp_undo_apply(mp_image* image, mp_operation_type op_type, i32 param, mp_bool inverse) {
+    switch (op_type) {
+        case MP_OP_INVERT: return mp_op_invert(image);
+        case MP_OP_FLIP_H: return mp_op_flip_horizontal(image);
+        case MP_OP_FLIP_V: return mp_op_flip_vertical(image);
+        case MP_OP_ROTATE: return mp_op_rotate(image, inverse ? -param : param);
+        default: return MP_ERROR_UNSUPPORTED;
+    }
+}
+
+static void mp_undo_entry_free(mp_undo_entry* entry) {
+    mp_tile_snapshot_release(entry->snapshot);
+    entry->snapshot = NULL;
+}
+
+/* Nearest snapshot below `count` on a stack / 스택에서 `count` 아래의 가장 가까운 스냅샷 */
+static mp_tile_snapshot* mp_undo_top_snapshot(mp_undo_entry* stack, u32 count) {
+    while (count > 0) {
+        if (stack[--count].snapshot) return stack[count].snapshot;
+    }
+    return NULL;
+}
+
+/* Walk both stacks oldest-to-newest, counting each snapshot against its neighbour.
+ * Tiles shared by non-adjacent entries are counted twice, so this errs high.
+ * / 인접 스냅샷 기준으로 점유 바이트 재계산 (비인접 공유는 중복 집계되어 보수적) */
+static void mp_undo_store_account(mp_undo_store* store) {
+    const mp_tile_snapshot* prev = NULL;
+    size_t bytes = 0;
+    for (u32 i = 0; i < store->undo_count; i++) {
+        if (!store->undo[i].snapshot) continue;
+        bytes += mp_tile_snapshot_unique_bytes(store->undo[i].snapshot, prev);
+        prev = store->undo[i].snapshot;
+    }
+    for (u32 i = store->redo_count; i > 0; i--) {
+        if (!store->redo[i - 1].snapshot) continue;
+        bytes += mp_tile_snapshot_unique_bytes(store->redo[i - 1].snapshot, prev);
+        prev = store->redo[i - 1].snapshot;
+    }
+    store->used_bytes = bytes;
+}
+
+static void mp_undo_store_compress_stack(mp_undo_entry* stack, u32 count) {
+    for (u32 i = 0; i + MP_UNDO_HOT_ENTRIES < count; i++) {
+        if (stack[i].snapshot && !stack[i].cold) {
+            mp_tile_snapshot_compress(stack[i].snapshot);
+            stack[i].cold = MP_TRUE;
+        }
+    }
+}
+
+/* Compress cold entries, then evict the oldest until within budget. The newest undo
+ * entry is always kept so a single step back works even for oversized images.
+ * / 차가운 항목 압축 후 예산 내로 들어올 때까지 가장 오래된 항목 제거 */
+static void mp_undo_store_trim(mp_undo_store* store) {
+    mp_undo_store_compress_stack(store->undo, store->undo_count);
+    mp_undo_store_compress_stack(store->redo, store->redo_count);
+    mp_undo_store_account(store);
+    
+    while (store->used_bytes > store->budget_bytes && store->undo_count + store->redo_count > 1) {
+        if (store->undo_count > 1 || store->redo_count == 0) {
+            mp_undo_entry_free(&store->undo[0]);
+            memmove(store->undo, store->undo + 1, (store->undo_count - 1) * sizeof(mp_undo_entry));
+            store->undo_count--;
+        } else {
+            /* Farthest redo state sits at the bottom of the redo stack / 가장 먼 다시 실행 상태 */
+            mp_undo_entry_free(&store->redo[0]);
+            memmove(store->redo, store->redo + 1, (store->redo_count - 1) * sizeof(mp_undo_entry));
+            store->redo_count--;
+        }
+        mp_undo_store_account(store);
+    }
+}
+
+static mp_bool mp_undo_store_reserve(mp_undo_store* store, u32 needed) {
+    if (needed <= store->capacity) return MP_TRUE;
+    
+    u32 capacity = store->capacity ? store->capacity * 2 : 16;
+    while (capacity < needed) capacity *= 2;
+    
+    mp_undo_entry* undo = (mp_undo_entry*)mp_realloc(store->undo, capacity * sizeof(mp_undo_entry));
+    if (!undo) return MP_FALSE;
+    store->undo = undo;
+    mp_undo_entry* redo = (mp_undo_entry*)mp_realloc(store->redo, capacity * sizeof(mp_undo_entry));
+    if (!redo) return MP_FALSE;
+    store->redo = redo;
+    
+    store->capacity = capacity;
+    return MP_TRUE;
+}
+
+mp_undo_store* mp_undo_store_create(u32 budget_mb) {
+    mp_undo_store* store = (mp_undo_store*)mp_calloc(1, sizeof(mp_undo_store));
+    if (!store) return NULL;
+    store->budget_bytes = (size_t)budget_mb << 20;
+    return store;
+}
+
+void mp_undo_store_clear(mp_undo_store* store) {
+    if (!store) return;
+    for (u32 i = 0; i < store->undo_count; i++) mp_undo_entry_free(&store->undo[i]);
+    for (u32 i = 0; i < store->redo_count; i++) mp_undo_entry_free(&store->redo[i]);
+    store->undo_count = 0;
+    store->redo_count = 0;
+    store->used_bytes = 0;
+}
+
+void mp_undo_store_destroy(mp_undo_store* store) {
+    if (!store) return;
+    mp_undo_store_clear(store);
+    mp_free(store->undo);
+    mp_free(store->redo);
+    mp_free(store);
+}
+
+mp_result mp_undo_store_record(mp_undo_store* store, const mp_image* image,
+                               mp_operation_type op_type, i32 param) {
+    if (!store || !image || !image->buffer) return MP_ERROR_INVALID_PARAM;
+    if (!mp_undo_store_reserve(store, store->undo_count + 1)) return MP_ERROR_MEMORY;
+    
+    mp_undo_entry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.op_type = op_type;
+    entry.param = param;
+    
+    if (mp_undo_is_invertible(op_type)) {
+        entry.kind = MP_UNDO_ENTRY_INVERSE;
+    } else {
+        /* Share every tile the previous snapshot already holds / 이전 스냅샷이 가진 타일은 공유 */
+        entry.kind = MP_UNDO_ENTRY_SNAPSHOT;
+        entry.snapshot = mp_tile_snapshot_capture(image->buffer,
+                                                  mp_undo_top_snapshot(store->undo, store->undo_count));
+        if (!entry.snapshot) return MP_ERROR_MEMORY;
+    }
+    
+    /* Redo and trimming wait for commit, so a failed operation can be cancelled without
+     * losing either / 다시 실행 제거와 정리는 commit까지 미뤄 실패 시 그대로 취소 가능 */
+    store->undo[store->undo_count++] = entry;
+    return MP_SUCCESS;
+}
+
+void mp_undo_store_commit(mp_undo_store* store, const mp_image* image) {
+    if (!store) return;
+    
+    /* Compared before trimming, while the recorded tiles are still unpacked
+     * / 정리 전 (기록한 타일이 아직 압축되지 않았을 때) 비교 */
+    const mp_undo_entry* entry = store->undo_count ? &store->undo[store->undo_count - 1] : NULL;
+    store->dirty.x = store->dirty.y = store->dirty.width = store->dirty.height = 0;
+    if (image && image->buffer && entry) {
+        if (entry->kind == MP_UNDO_ENTRY_INVERSE) {
+            store->dirty.width = image->buffer->width;
+            store->dirty.height = image->buffer->height;
+        } else if (!mp_tile_snapshot_diff_buffer_bounds(entry->snapshot, image->buffer, &store->dirty)) {
+            store->dirty.width = store->dirty.height = 0;
+        }
+    }
+    
+    for (u32 i = 0; i < store->redo_count; i++) mp_undo_entry_free(&store->redo[i]);
+    store->redo_count = 0;
+    mp_undo_store_trim(store);
+}
+
+void mp_undo_store_cancel(mp_undo_store* store) {
+    if (!store || store->undo_count == 0) return;
+    mp_undo_entry_free(&store->undo[--store->undo_count]);
+    mp_undo_store_account(store);
+}
+
+/* Move the top entry of `from` across to `to`, changing the image accordingly
+ * / `from`의 최상위 항목을 `to`로 옮기며 이미지를 갱신 */
+static mp_result mp_undo_store_step(mp_undo_store* store, mp_image* image,
+                                    mp_undo_entry* from, u32* from_count,
+                                    mp_undo_entry* to, u32* to_count, mp_bool backwards) {
+    if (!store || !image || !image->buffer || *from_count == 0) return MP_ERROR_INVALID_PARAM;
+    
+    mp_undo_entry entry = from[*from_count - 1];
+    
+    if (entry.kind == MP_UNDO_ENTRY_INVERSE) {
+        mp_result result = mp_undo_apply(image, entry.op_type, entry.param, backwards);
+        if (result != MP_SUCCESS) return result;
+        store->dirty.x = store->dirty.y = 0;
+        store->dirty.width = image->buffer->width;
+        store->dirty.height = image->buffer->height;
+    } else {
+        /* Captured against the target, so only differing tiles are copied and restored
+         * / 대상 기준으로 캡처하므로 다른 타일만 복사 및 복원 */
+        mp_tile_snapshot* current = mp_tile_snapshot_capture(image->buffer, entry.snapshot);
+        if (!current) return MP_ERROR_MEMORY;
+        
+        if (!mp_tile_snapshot_diff_bounds(entry.snapshot, current, &store->dirty)) {
+            store->dirty.width = store->dirty.height = 0;
+        }
+        
+        mp_result result = mp_tile_snapshot_restore(entry.snapshot, &image->buffer, current);
+        if (result != MP_SUCCESS) {
+            mp_tile_snapshot_release(current);
+            return result;
+        }
+        mp_tile_snapshot_release(entry.snapshot);
+        entry.snapshot = current;
+        entry.cold = MP_FALSE;
+    }
+    
+    (*from_count)--;
+    to[(*to_count)++] = entry;
+    image->modified = MP_TRUE;
+    
+    mp_undo_store_trim(store);
+    return MP_SUCCESS;
+}
+
+mp_result mp_undo_store_undo(mp_undo_store* store, mp_image* image) {
+    if (!store) return MP_ERROR_INVALID_PARAM;
+    return mp_undo_store_step(store, image, store->undo, &store->undo_count,
+                              store->redo, &store->redo_count, MP_TRUE);
+}
+
+mp_result mp_undo_store_redo(mp_undo_store* store, mp_image* image) {
+    if (!store) return MP_ERROR_INVALID_PARAM;
+    return mp_undo_store_step(store, image, store->redo, &store->redo_count,
+                              store->undo, &store->undo_count, MP_FALSE);
+}
@@ -0,0 +1,73 @@
+#ifndef MANYPICTURES_UNDO_STORE_H
+#define MANYPICTURES_UNDO_STORE_H
+
+#include "../core/types.h"
+#include "../core/tile_snapshot.h"
+
+/* Delta undo/redo store with a memory budget / 메모리 예산 기반 델타 실행 취소/다시 실행 저장소
+ *
+ * Invertible operations (invert, flips, rotate) are recorded as their parameters only.
+ * Everything else records a tile snapshot that shares unchanged tiles with its
+ * neighbours, so an entry costs roughly the tiles its operation touched. Entries below
+ * the most recent MP_UNDO_HOT_ENTRIES are LZ-packed, and the oldest are evicted once
+ * the store exceeds its budget.
+ * 가역 연산은 매개변수만 기록하고, 그 외 연산은 변경된 타일만 소유하는 스냅샷을 기록합니다.
+ * 오래된 항목은 LZ 압축되며 예산 초과 시 가장 오래된 항목부터 제거됩니다.
+ */
+
+#define MP_UNDO_HOT_ENTRIES 2
+
+typedef enum {
+    MP_UNDO_ENTRY_INVERSE,   /* Undo by applying the inverse operation / 역연산으로 취소 */
+    MP_UNDO_ENTRY_SNAPSHOT   /* Undo by restoring tiles / 타일 복원으로 취소 */
+} mp_undo_entry_kind;
+
+typedef struct {
+    mp_undo_entry_kind kind;
+    mp_operation_type op_type;   /* Operation this entry steps over / 이 항목이 건너뛰는 연산 */
+    i32 param;                   /* Operation parameter (rotation degrees) / 연산 매개변수 */
+    mp_tile_snapshot* snapshot;  /* State on the other side (SNAPSHOT only) / 반대편 상태 */
+    mp_bool cold;                /* Already compressed / 압축 완료 */
+} mp_undo_entry;
+
+typedef struct {
+    mp_undo_entry* undo;
+    mp_undo_entry* redo;
+    u32 undo_count;
+    u32 redo_count;
+    u32 capacity;
+    size_t budget_bytes;
+    size_t used_bytes;           /* Approximate bytes held by snapshots / 스냅샷 점유 바이트 (근사치) */
+    mp_pixel_rect dirty;         /* Region the last commit, undo or redo changed / 마지막 적용/실행 취소/다시 실행이 바꾼 영역 */
+} mp_undo_store;
+
+mp_undo_store* mp_undo_store_create(u32 budget_mb);
+void mp_undo_store_destroy(mp_undo_store* store);
+
+/* Drop every entry (e.g. when a new image is loaded) / 모든 항목 제거 */
+void mp_undo_store_clear(mp_undo_store* store);
+
+/* Record the state before `op_type` is applied to `image`. `param` is the operation's own
+ * parameter (rotation degrees); the inverse applies -param. Follow with commit once the
+ * operation succeeded, or cancel when it failed.
+ * / `op_type` 적용 전 상태 기록 (`param`은 회전 각도 등, 역연산은 -param). 성공 시 commit, 실패 시 cancel */
+mp_result mp_undo_store_record(mp_undo_store* store, const mp_image* image,
+                               mp_operation_type op_type, i32 param);
+
+/* The recorded operation was applied to `image`: set `dirty` to the region it changed, drop
+ * the redo stack and trim to the budget. Invertible operations move or rewrite every pixel
+ * and report the whole image; snapshot entries report the tiles that differ from the record.
+ * / 기록한 연산이 `image`에 적용됨: 변경 영역을 `dirty`에 기록하고 다시 실행 스택 제거 후 정리
+ * (가역 연산은 전체 이미지, 스냅샷 항목은 기록과 다른 타일) */
+void mp_undo_store_commit(mp_undo_store* store, const mp_image* image);
+
+/* Forget the last record after the operation failed; the redo stack is left as it was
+ * / 연산 실패 시 마지막 기록 취소 (다시 실행 스택은 그대로 유지) */
+void mp_undo_store_cancel(mp_undo_store* store);
+
+/* Step backwards / forwards and set `dirty`; MP_ERROR_INVALID_PARAM when there is nothing to do
+ * / 뒤로 또는 앞으로 이동 후 `dirty` 설정 (더 이상 없으면 MP_ERROR_INVALID_PARAM) */
+mp_result mp_undo_store_undo(mp_undo_store* store, mp_image* image);
+mp_result mp_undo_store_redo(mp_undo_store* store, mp_image* image);
+
+#endif /* MANYPICTURES_UNDO_STORE_H */
@@ -0,0 +1,168 @@
+#define _POSIX_C_SOURCE 200809L
+#include "worker.h"
+#include "../core/memory.h"
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+
+struct mp_worker {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    int notify[2];            /* [0] read by the event loop, [1] written by the worker / 알림 파이프 */
+    
+    /* Guarded by lock / lock으로 보호 */
+    mp_bool quit;
+    mp_bool pending;          /* Submitted, not yet picked up / 제출되었으나 아직 시작 전 */
+    mp_bool finished;         /* Ran, completion not yet dispatched / 실행 완료, 콜백 대기 */
+    mp_result result;
+    
+    /* Owned by the submitting thread / 제출 스레드 소유 */
+    mp_bool busy;
+    const char* label;
+    mp_worker_fn run;
+    mp_worker_done_fn done;
+    void* ctx;
+    struct timespec started;
+};
+
+static void* mp_worker_main(void* arg) {
+    mp_worker* worker = (mp_worker*)arg;
+    
+    pthread_mutex_lock(&worker->lock);
+    for (;;) {
+        while (!worker->pending && !worker->quit) {
+            pthread_cond_wait(&worker->wake, &worker->lock);
+        }
+        if (!worker->pending) break;
+        
+        worker->pending = MP_FALSE;
+        mp_worker_fn run = worker->run;
+        void* ctx = worker->ctx;
+        pthread_mutex_unlock(&worker->lock);
+        
+        mp_result result = run(ctx);
+        
+        pthread_mutex_lock(&worker->lock);
+        worker->result = result;
+        worker->finished = MP_TRUE;
+        
+        /* Pipe is non-blocking; a full pipe already means "wake up" / 파이프가 가득 차도 이미 깨우기 신호 */
+        u8 signal = 1;
+        ssize_t written = write(worker->notify[1], &signal, 1);
+        (void)written;
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return NULL;
+}
+
+mp_worker* mp_worker_create(void) {
+    mp_worker* worker = (mp_worker*)mp_calloc(1, sizeof(mp_worker));
+    if (!worker) return NULL;
+    
+    if (pipe(worker->notify) == -1) {
+        mp_free(worker);
+        return NULL;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(worker->notify[i], F_SETFL, fcntl(worker->notify[i], F_GETFL, 0) | O_NONBLOCK);
+        fcntl(worker->notify[i], F_SETFD, FD_CLOEXEC); /* Keep out of the dialog child / 대화 상자 자식에 상속 방지 */
+    }
+    
+    pthread_mutex_init(&worker->lock, NULL);
+    pthread_cond_init(&worker->wake, NULL);
+    
+    if (pthread_create(&worker->thread, NULL, mp_worker_main, worker) != 0) {
+        pthread_cond_destroy(&worker->wake);
+        pthread_mutex_destroy(&worker->lock);
+        close(worker->notify[0]);
+        close(worker->notify[1]);
+        mp_free(worker);
+        return NULL;
+    }
+    return worker;
+}
+
+void mp_worker_destroy(mp_worker* worker) {
+    if (!worker) return;
+    
+    pthread_mutex_lock(&worker->lock);
+    worker->quit = MP_TRUE;
+    pthread_cond_signal(&worker->wake);
+    pthread_mutex_unlock(&worker->lock);
+    pthread_join(worker->thread, NULL);
+    
+    /* A submitted job always runs before the thread exits; let it release its context
+     * / 제출된 작업은 종료 전에 항상 실행되므로 컨텍스트 해제를 위해 콜백 실행 */
+    mp_worker_dispatch(worker);
+    
+    pthread_cond_destroy(&worker->wake);
+    pthread_mutex_destroy(&worker->lock);
+    close(worker->notify[0]);
+    close(worker->notify[1]);
+    mp_free(worker);
+}
+
+mp_bool mp_worker_submit(mp_worker* worker, const char* label,
+                         mp_worker_fn run, mp_worker_done_fn done, void* ctx) {
+    if (!worker || !run || worker->busy) return MP_FALSE;
+    
+    worker->busy = MP_TRUE;
+    worker->label = label;
+    worker->done = done;
+    worker->ctx = ctx;
+    clock_gettime(CLOCK_MONOTONIC, &worker->started);
+    
+    pthread_mutex_lock(&worker->lock);
+    worker->run = run;
+    worker->pending = MP_TRUE;
+    pthread_cond_signal(&worker->wake);
+    pthread_mutex_unlock(&worker->lock);
+    return MP_TRUE;
+}
+
+int mp_worker_fd(const mp_worker* worker) {
+    return worker ? worker->notify[0] : -1;
+}
+
+mp_bool mp_worker_busy(const mp_worker* worker) {
+    return worker && worker->busy;
+}
+
+const char* mp_worker_label(const mp_worker* worker) {
+    return (worker && worker->busy && worker->label) ? worker->label : "";
+}
+
+f64 mp_worker_elapsed(const mp_worker* worker) {
+    if (!worker || !worker->busy) return 0.0;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (f64)(now.tv_sec - worker->started.tv_sec) + (f64)(now.tv_nsec - worker->started.tv_nsec) * 1e-9;
+}
+
+mp_bool mp_worker_dispatch(mp_worker* worker) {
+    if (!worker) return MP_FALSE;
+    
+    u8 drain[64];
+    while (read(worker->notify[0], drain, sizeof(drain)) > 0) {}
+    
+    pthread_mutex_lock(&worker->lock);
+    mp_bool finished = worker->finished;
+    mp_result result = worker->result;
+    worker->finished = MP_FALSE;
+    pthread_mutex_unlock(&worker->lock);
+    if (!finished) return MP_FALSE;
+    
+    /* Clear first so the callback may submit a follow-up job / 콜백이 후속 작업을 제출할 수 있도록 먼저 초기화 */
+    mp_worker_done_fn done = worker->done;
+    void* ctx = worker->ctx;
+    worker->busy = MP_FALSE;
+    worker->label = NULL;
+    worker->done = NULL;
+    worker->ctx = NULL;
+    
+    if (done) done(ctx, result);
+    return MP_TRUE;
+}
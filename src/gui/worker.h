@@ -0,0 +1,44 @@
+#ifndef MANYPICTURES_WORKER_H
+#define MANYPICTURES_WORKER_H
+
+#include "../core/types.h"
+
+/* Background job thread for the GUI / GUI용 백그라운드 작업 스레드
+ *
+ * Runs one job at a time off the X event thread. When a job finishes, the worker writes
+ * to a pipe whose read end (mp_worker_fd) the event loop waits on together with the X
+ * connection; mp_worker_dispatch then runs the job's completion callback on the caller.
+ * 작업 완료 시 파이프에 신호를 쓰고, 이벤트 루프가 X 연결과 함께 대기하다가 mp_worker_dispatch로 완료 콜백을 실행합니다.
+ */
+
+typedef struct mp_worker mp_worker;
+
+/* Runs on the worker thread / 작업 스레드에서 실행 */
+typedef mp_result (*mp_worker_fn)(void* ctx);
+/* Runs on the thread calling mp_worker_dispatch / mp_worker_dispatch 호출 스레드에서 실행 */
+typedef void (*mp_worker_done_fn)(void* ctx, mp_result result);
+
+mp_worker* mp_worker_create(void);
+
+/* Waits for a running job; its completion callback is still run / 실행 중인 작업 대기 후 완료 콜백 실행 */
+void mp_worker_destroy(mp_worker* worker);
+
+/* Queue a job; MP_FALSE while another job is in flight / 다른 작업이 진행 중이면 MP_FALSE */
+mp_bool mp_worker_submit(mp_worker* worker, const char* label,
+                         mp_worker_fn run, mp_worker_done_fn done, void* ctx);
+
+/* Readable when a job has completed / 작업 완료 시 읽기 가능 */
+int mp_worker_fd(const mp_worker* worker);
+
+/* A job was submitted and its completion has not been dispatched yet / 완료가 아직 처리되지 않은 작업 존재 */
+mp_bool mp_worker_busy(const mp_worker* worker);
+
+/* Label and elapsed seconds of the job in flight, for progress display / 진행 표시용 라벨 및 경과 시간 */
+const char* mp_worker_label(const mp_worker* worker);
+f64 mp_worker_elapsed(const mp_worker* worker);
+
+/* Run the completion callback of a finished job; returns MP_TRUE if one ran
+ * / 완료된 작업의 콜백 실행 (실행했다면 MP_TRUE) */
+mp_bool mp_worker_dispatch(mp_worker* worker);
+
+#endif /* MANYPICTURES_WORKER_H */
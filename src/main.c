@@ -1,13 +1,23 @@
+#define _POSIX_C_SOURCE 200809L
 #include "core/types.h"
 #include "core/memory.h"
 #include "core/image.h"
 #include "core/fast_io.h"
+#include "core/decode_cache.h"
+#include "core/trace.h"
+#include "core/alloc.h"
 #include "operations/color_ops.h"
 #include "operations/edit_ops.h"
+#ifndef MP_HEADLESS
 #include "gui/gui.h"
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
 
 /* Many Pictures - Advanced Image Viewer and Editor / 고성능 이미지 뷰어 및 편집기
  * 
@@ -43,13 +53,20 @@ static void print_usage(const char* program_name) {
     mp_fast_printf("  -o, --output <file>     Output file path / 출력 파일 경로\n");
     mp_fast_printf("  --info <file>           Show image information / 이미지 정보 표시\n");
     mp_fast_printf("  --history <file>        Show image history from EXIF / EXIF에서 이미지 히스토리 표시\n");
+    mp_fast_printf("  --cache                 Reuse decoded pixels across runs / 실행 간 디코딩 결과 재사용\n");
+    mp_fast_printf("  --metrics json          Print one JSON record per image; progress goes to stderr / 이미지별 JSON 지표 출력\n");
+    mp_fast_printf("                          Memory: peak_rss_bytes; peak_tracked_scratch_bytes omits image buffers\n");
+    mp_fast_printf("                          / 메모리 지표는 peak_rss_bytes (추적 최대치는 이미지 버퍼 제외)\n");
+    mp_fast_printf("  --trace <file>          Write a Chrome trace of decode, ops and rendering / 디코딩, 연산, 렌더링 추적 기록\n");
     mp_fast_printf("\n");
     mp_fast_printf("Supported formats / 지원 포맷:\n");
     mp_fast_printf("  Images: BMP, PNG, JPEG, GIF, TIFF, WebP, ICO, TGA, PSD\n");
     mp_fast_printf("  Videos: AVI, MP4, MKV, WebM, MOV, FLV\n");
     mp_fast_printf("\n");
     mp_fast_printf("Examples / 예시:\n");
+#ifndef MP_HEADLESS
     mp_fast_printf("  %s image.jpg                    # Open in GUI / GUI에서 열기\n", program_name);
+#endif
     mp_fast_printf("  %s -g input.jpg -o output.jpg   # Convert to grayscale / 흑백 변환\n", program_name);
     mp_fast_printf("  %s -c gray.jpg -o color.jpg     # Colorize grayscale / 컬러화\n", program_name);
     mp_fast_printf("  %s -i input.png -o output.png   # Invert colors / 색상 반전\n", program_name);
@@ -62,8 +79,8 @@ static void print_version(void) {
     mp_fast_printf("Copyright (c) Rheehose (Rhee Creative) 2008-2026\n");
 }
 
-static void print_image_info(const char* filepath) {
-    mp_image* image = mp_image_load(filepath);
+static void print_image_info(mp_decode_cache* cache, const char* filepath) {
+    mp_image* image = mp_decode_cache_load(cache, filepath);
     if (!image) {
         mp_fast_fprintf(2, "Error: Failed to load image '%s'\n", filepath);
         return;
@@ -110,7 +127,187 @@ static void print_image_info(const char* filepath) {
         }
     }
     
-    mp_image_destroy(image);
+    mp_decode_cache_release(cache, image);
+}
+
+/* Trace output path from --trace, written at exit / 종료 시 기록할 추적 파일 경로 */
+static const char* g_trace_file = NULL;
+
+static void write_trace(void) {
+    mp_trace_stop();
+    if (mp_trace_write(g_trace_file) != MP_SUCCESS) {
+        mp_fast_fprintf(2, "Error: Failed to write trace '%s'\n", g_trace_file);
+    } else {
+        mp_fast_printf("Trace written: %s\n", g_trace_file);
+    }
+}
+
+/* Options that apply to every mode and are taken before the others
+ * / 모든 모드에 적용되어 다른 인자보다 먼저 처리되는 옵션 */
+static mp_bool is_global_option(const char* arg) {
+    return strcmp(arg, "--trace") == 0 || strcmp(arg, "--metrics") == 0;
+}
+
+static const char* find_option_value(int argc, char** argv, const char* name) {
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], name) == 0) return argv[i + 1];
+    }
+    return NULL;
+}
+
+static void start_trace(int argc, char** argv) {
+    g_trace_file = find_option_value(argc, argv, "--trace");
+    if (!g_trace_file) return;
+    if (mp_trace_start() != MP_SUCCESS) {
+        mp_fast_fprintf(2, "Error: Failed to start tracing\n");
+        g_trace_file = NULL;
+        return;
+    }
+    atexit(write_trace);
+}
+
+#ifndef MP_HEADLESS
+/* First argument that is not a global option or its value / 전역 옵션과 그 값이 아닌 첫 인자 */
+static const char* first_file_argument(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (is_global_option(argv[i])) {
+            i++;
+            continue;
+        }
+        return argv[i];
+    }
+    return NULL;
+}
+#endif
+
+/* Per-run metrics / 실행별 지표
+ *
+ * With --metrics json, stdout carries nothing but one JSON record per processed image, for
+ * schedulers that track performance across releases; everything else printed to stdout,
+ * including codec progress, is moved to stderr. CPU time covers every thread of the process.
+ * peak_rss_bytes is the memory figure to track: image buffers come from mp_image_buffer_create
+ * and never pass through mp_alloc, so the allocator peak only covers scratch buffers.
+ * --metrics json이면 stdout에는 이미지별 JSON 기록만 남고 나머지 출력은 stderr로 이동합니다.
+ */
+static FILE* g_metrics_out = NULL;
+
+typedef struct {
+    struct timespec wall;
+    struct timespec cpu;
+} cli_clock;
+
+typedef struct {
+    double wall_ms;
+    double cpu_ms;
+} cli_stage_time;
+
+typedef struct {
+    const char* input_file;
+    const char* output_file;
+    const char* operation;
+    const char* status;
+    u32 width, height;                 /* Decoded size / 디코딩 크기 */
+    u32 output_width, output_height;
+    u64 bytes_read, bytes_written;
+    cli_stage_time decode, op, encode;
+} cli_metrics;
+
+static mp_result start_metrics(int argc, char** argv) {
+    const char* format = find_option_value(argc, argv, "--metrics");
+    if (!format) return MP_SUCCESS;
+    if (strcmp(format, "json") != 0) {
+        mp_fast_fprintf(2, "Error: Unsupported metrics format '%s' (expected json)\n", format);
+        return MP_ERROR_INVALID_PARAM;
+    }
+    
+    int fd = dup(STDOUT_FILENO);
+    if (fd < 0 || !(g_metrics_out = fdopen(fd, "w"))) {
+        if (fd >= 0) close(fd);
+        mp_fast_fprintf(2, "Error: Failed to open metrics output\n");
+        return MP_ERROR_IO;
+    }
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+    return MP_SUCCESS;
+}
+
+static void cli_clock_read(cli_clock* clock) {
+    clock_gettime(CLOCK_MONOTONIC, &clock->wall);
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &clock->cpu);
+}
+
+static double cli_elapsed_ms(const struct timespec* from, const struct timespec* to) {
+    return (double)(to->tv_sec - from->tv_sec) * 1e3 + (double)(to->tv_nsec - from->tv_nsec) / 1e6;
+}
+
+static void cli_stage_end(cli_stage_time* stage, const cli_clock* start) {
+    cli_clock now;
+    cli_clock_read(&now);
+    stage->wall_ms = cli_elapsed_ms(&start->wall, &now.wall);
+    stage->cpu_ms = cli_elapsed_ms(&start->cpu, &now.cpu);
+}
+
+static u64 cli_file_size(const char* path) {
+    struct stat st;
+    return path && stat(path, &st) == 0 ? (u64)st.st_size : 0;
+}
+
+static void write_json_string(FILE* out, const char* value) {
+    if (!value) {
+        fputs("null", out);
+        return;
+    }
+    fputc('"', out);
+    for (const unsigned char* c = (const unsigned char*)value; *c; c++) {
+        if (*c == '"' || *c == '\\') fprintf(out, "\\%c", *c);
+        else if (*c < 0x20) fprintf(out, "\\u%04x", *c);
+        else fputc(*c, out);
+    }
+    fputc('"', out);
+}
+
+static void write_json_stage(FILE* out, const char* name, const cli_stage_time* stage, u64 pixels) {
+    double mpix_per_s = stage->wall_ms > 0.0 ? (double)pixels / (stage->wall_ms * 1e3) : 0.0;
+    fprintf(out, ",\"%s\":{\"wall_ms\":%.3f,\"cpu_ms\":%.3f,\"mpix_per_s\":%.2f}",
+            name, stage->wall_ms, stage->cpu_ms, mpix_per_s);
+}
+
+static void write_metrics(const cli_metrics* metrics) {
+    if (!g_metrics_out) return;
+    FILE* out = g_metrics_out;
+    u64 pixels = (u64)metrics->width * metrics->height;
+    u64 output_pixels = (u64)metrics->output_width * metrics->output_height;
+    cli_stage_time total = {
+        metrics->decode.wall_ms + metrics->op.wall_ms + metrics->encode.wall_ms,
+        metrics->decode.cpu_ms + metrics->op.cpu_ms + metrics->encode.cpu_ms
+    };
+    
+    /* Allocator peak covers only scratch buffers taken through mp_alloc, not image buffers;
+     * max RSS covers the process / 할당기 최대치는 mp_alloc 스크래치 버퍼만, 최대 RSS는 프로세스 전체 */
+    mp_alloc_stats stats;
+    mp_alloc_get_stats(&stats);
+    struct rusage usage;
+    u64 peak_rss = getrusage(RUSAGE_SELF, &usage) == 0 ? (u64)usage.ru_maxrss * 1024 : 0;
+    
+    fputs("{\"input\":", out);
+    write_json_string(out, metrics->input_file);
+    fputs(",\"output\":", out);
+    write_json_string(out, metrics->output_file);
+    fputs(",\"operation\":", out);
+    write_json_string(out, metrics->operation);
+    fputs(",\"status\":", out);
+    write_json_string(out, metrics->status);
+    fprintf(out, ",\"width\":%u,\"height\":%u,\"output_width\":%u,\"output_height\":%u,\"pixels\":%llu",
+            metrics->width, metrics->height, metrics->output_width, metrics->output_height,
+            (unsigned long long)pixels);
+    fprintf(out, ",\"bytes_read\":%llu,\"bytes_written\":%llu",
+            (unsigned long long)metrics->bytes_read, (unsigned long long)metrics->bytes_written);
+    write_json_stage(out, "decode", &metrics->decode, pixels);
+    write_json_stage(out, "op", &metrics->op, pixels);
+    write_json_stage(out, "encode", &metrics->encode, output_pixels);
+    write_json_stage(out, "total", &total, pixels);
+    fprintf(out, ",\"peak_tracked_scratch_bytes\":%zu,\"peak_rss_bytes\":%llu}\n",
+            stats.total.peak_bytes, (unsigned long long)peak_rss);
+    fflush(out);
 }
 
 static mp_result process_command_line(int argc, char** argv) {
@@ -120,7 +317,9 @@ static mp_result process_command_line(int argc, char** argv) {
     
     const char* input_file = NULL;
     const char* output_file = NULL;
+    const char* info_file = NULL;
     const char* operation = NULL;
+    mp_bool use_cache = MP_FALSE;
     i32 rotate_degrees = 0;
     u32 resize_width = 0, resize_height = 0;
     
@@ -132,10 +331,11 @@ static mp_result process_command_line(int argc, char** argv) {
             print_version();
             exit(0);
         } else if (strcmp(argv[i], "--info") == 0) {
-            if (i + 1 < argc) {
-                print_image_info(argv[++i]);
-                exit(0);
-            }
+            if (i + 1 < argc) info_file = argv[++i];
+        } else if (is_global_option(argv[i])) {
+            i++;
+        } else if (strcmp(argv[i], "--cache") == 0) {
+            use_cache = MP_TRUE;
         } else if (strcmp(argv[i], "-g") == 0 || strcmp(argv[i], "--grayscale") == 0) {
             operation = "grayscale";
             if (i + 1 < argc) input_file = argv[++i];
@@ -167,27 +367,51 @@ static mp_result process_command_line(int argc, char** argv) {
         }
     }
     
-    if (!input_file) {
-        return MP_ERROR_INVALID_PARAM;
+    /* Without a cache directory the loads below fall back to mp_image_load
+     * / 캐시 디렉터리가 없으면 아래 로드는 mp_image_load로 대체 */
+    mp_decode_cache* cache = use_cache ? mp_decode_cache_open(NULL) : NULL;
+    if (info_file) {
+        print_image_info(cache, info_file);
+        mp_decode_cache_close(cache);
+        exit(0);
     }
     
-    if (!operation) {
+    if (!input_file || !operation) {
         /* No operation specified, just return to open GUI */
+        mp_decode_cache_close(cache);
         return MP_ERROR_INVALID_PARAM;
     }
     
+    if (!output_file) {
+        output_file = "output.png";
+    }
+    cli_metrics metrics = { 0 };
+    metrics.input_file = input_file;
+    metrics.output_file = output_file;
+    metrics.operation = operation;
+    metrics.bytes_read = cli_file_size(input_file);
+    cli_clock stage_start;
+    
     /* Load image */
     mp_fast_printf("Loading image: %s\n", input_file);
-    mp_image* image = mp_image_load(input_file);
+    cli_clock_read(&stage_start);
+    mp_image* image = mp_decode_cache_load(cache, input_file);
+    cli_stage_end(&metrics.decode, &stage_start);
     if (!image) {
         mp_fast_fprintf(2, "Error: Failed to load image '%s'\n", input_file);
+        metrics.status = "load_failed";
+        write_metrics(&metrics);
+        mp_decode_cache_close(cache);
         return MP_ERROR_FILE_NOT_FOUND;
     }
+    metrics.width = image->buffer->width;
+    metrics.height = image->buffer->height;
     
     /* Apply operation */
     mp_fast_printf("Applying operation: %s\n", operation);
     mp_result result = MP_SUCCESS;
     
+    cli_clock_read(&stage_start);
     if (strcmp(operation, "grayscale") == 0) {
         result = mp_op_to_grayscale(image);
     } else if (strcmp(operation, "colorize") == 0) {
@@ -201,47 +425,70 @@ static mp_result process_command_line(int argc, char** argv) {
     } else if (strcmp(operation, "resize") == 0) {
         result = mp_op_resize(image, resize_width, resize_height);
     }
+    cli_stage_end(&metrics.op, &stage_start);
+    metrics.output_width = image->buffer->width;
+    metrics.output_height = image->buffer->height;
     
     if (result != MP_SUCCESS) {
         mp_fast_fprintf(2, "Error: Operation failed\n");
-        mp_image_destroy(image);
+        metrics.status = "operation_failed";
+        write_metrics(&metrics);
+        mp_decode_cache_release(cache, image);
+        mp_decode_cache_close(cache);
         return result;
     }
     
     /* Save image */
-    if (!output_file) {
-        output_file = "output.png";
-    }
-    
     mp_fast_printf("Saving image: %s\n", output_file);
     mp_image_format format = mp_image_detect_format(output_file);
     if (format == MP_FORMAT_UNKNOWN) {
         format = MP_FORMAT_PNG;
     }
     
+    cli_clock_read(&stage_start);
     result = mp_image_save(image, output_file, format);
+    cli_stage_end(&metrics.encode, &stage_start);
     if (result != MP_SUCCESS) {
         mp_fast_fprintf(2, "Error: Failed to save image\n");
-        mp_image_destroy(image);
+        metrics.status = "save_failed";
+        write_metrics(&metrics);
+        mp_decode_cache_release(cache, image);
+        mp_decode_cache_close(cache);
         return result;
     }
     
+    metrics.bytes_written = cli_file_size(output_file);
+    metrics.status = "ok";
+    write_metrics(&metrics);
     mp_fast_printf("Done!\n");
-    mp_image_destroy(image);
+    mp_decode_cache_release(cache, image);
+    mp_decode_cache_close(cache);
     
     return MP_SUCCESS;
 }
 
 int main(int argc, char** argv) {
+    if (start_metrics(argc, argv) != MP_SUCCESS) return 1;
+    
     mp_fast_printf("%s v%s / %s v%s\n", MP_NAME, MP_VERSION, MP_NAME, MP_VERSION);
     mp_fast_printf("Initializing... / 초기화 중...\n\n");
     
     /* Initialize memory system / 메모리 시스템 초기화 */
     mp_memory_init();
+    start_trace(argc, argv);
     
     /* Try command-line processing first */
     mp_result result = process_command_line(argc, argv);
     
+#ifdef MP_HEADLESS
+    /* No GUI to fall back to: unknown arguments or none at all are usage errors
+     * / GUI가 없으므로 알 수 없는 인자나 인자 없음은 사용법 오류 */
+    if (result == MP_ERROR_INVALID_PARAM) {
+        print_usage(argv[0]);
+        mp_memory_shutdown();
+        return 1;
+    }
+#else
     if ((result == MP_ERROR_INVALID_PARAM && argc >= 2) || (argc == 1)) {
         /* Open GUI mode / GUI 모드 진입 */
         mp_fast_printf("Starting GUI mode... / GUI 모드 시작 중...\n");
@@ -260,9 +507,11 @@ int main(int argc, char** argv) {
             return 1;
         }
         
-        /* Load initial file if provided / 인자가 있으면 초기 파일 로드 */
-        if (argc >= 2) {
-            mp_app_load_image(app, argv[1]);
+        /* Load initial file if provided; it decodes on the worker while the window comes up
+         * / 인자가 있으면 초기 파일 로드 (창이 뜨는 동안 작업 스레드에서 디코딩) */
+        const char* initial_file = first_file_argument(argc, argv);
+        if (initial_file) {
+            mp_app_load_image_async(app, initial_file);
         }
         
         /* Run application / 애플리케이션 실행 */
@@ -275,9 +524,15 @@ int main(int argc, char** argv) {
         /* This case is now handled by GUI default or specific error / 이제 GUI 기본값 또는 특정 오류로 처리됨 */
         print_usage(argv[0]);
     }
+#endif
     
     /* Shutdown memory system */
     mp_memory_shutdown();
     
+#ifdef MP_HEADLESS
+    /* Batch callers need failures in the exit status / 배치 호출자를 위해 실패를 종료 코드로 전달 */
+    return result == MP_SUCCESS ? 0 : 1;
+#else
     return 0;
+#endif
 }
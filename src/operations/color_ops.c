@@ -2,44 +2,135 @@
 #include "../core/memory.h"
 #include "../core/image.h"
 #include "../core/fast_io.h"
+#include "../core/image_layout.h"
+#include "../core/parallel.h"
+#include "../core/trace.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+/* Bytes of each row a byte-wise kernel covers: the whole padded stride when the buffer
+ * has the padded layout (no remainder), otherwise exactly the pixels
+ * / 바이트 단위 커널이 처리할 행 바이트 수 (패딩 레이아웃이면 stride 전체, 아니면 픽셀만) */
+static size_t mp_color_row_bytes(const mp_image_buffer* buffer) {
+    return mp_image_layout_padded(buffer) ? buffer->stride : (size_t)buffer->width * buffer->bpp;
+}
+
+/* One 16-byte period of the channel pattern: 0xFF on color bytes, 0x00 on alpha. Rows
+ * start on a pixel, and 16 is a multiple of every period that has an alpha byte.
+ * / 16바이트 채널 패턴 (색상 0xFF, 알파 0x00) */
+static void mp_color_channel_mask(u32 bpp, u8 mask[16]) {
+    for (u32 i = 0; i < 16; i++) {
+        mask[i] = ((bpp == 2 || bpp == 4) && i % bpp == bpp - 1) ? 0x00 : 0xFF;
+    }
+}
+
+/* Luma weights in memory order / 메모리 순서의 휘도 가중치 */
+static void mp_color_luma_weights(mp_color_format format, u32* w0, u32* w1, u32* w2) {
+    mp_bool bgr = format == MP_COLOR_FORMAT_BGR || format == MP_COLOR_FORMAT_BGRA;
+    *w0 = bgr ? 29 : 77;
+    *w1 = 150;
+    *w2 = bgr ? 77 : 29;
+}
+
+/* p ^= mask / 마스크와 XOR */
+static void mp_color_xor_row(u8* restrict p, size_t bytes, const u8 mask[16]) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i m = _mm_loadu_si128((const __m128i*)mask);
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        _mm_storeu_si128((__m128i*)(p + i), _mm_xor_si128(v, m));
+    }
+#endif
+    for (; i < bytes; i++) p[i] ^= mask[i & 15];
+}
+
+/* Saturating p + add - sub / 포화 덧셈과 뺄셈 */
+static void mp_color_adds_row(u8* restrict p, size_t bytes, const u8 add[16], const u8 sub[16]) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i a = _mm_loadu_si128((const __m128i*)add);
+    __m128i s = _mm_loadu_si128((const __m128i*)sub);
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        _mm_storeu_si128((__m128i*)(p + i), _mm_subs_epu8(_mm_adds_epu8(v, a), s));
+    }
+#endif
+    for (; i < bytes; i++) {
+        u32 v = p[i] + add[i & 15];
+        v = v > 255 ? 255 : v;
+        p[i] = (u8)(v > sub[i & 15] ? v - sub[i & 15] : 0);
+    }
+}
+
+/* Truncate(factor * (c - 128) + 128) clamped to a byte, exactly as the scalar LUT
+ * computes it / 스칼라 LUT와 동일한 계산 */
+static void mp_color_contrast_row(u8* restrict p, size_t bytes, const u8 mask[16], f32 factor, const u8 lut[256]) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i m = _mm_loadu_si128((const __m128i*)mask);
+    __m128i zero = _mm_setzero_si128();
+    __m128i bias = _mm_set1_epi32(128);
+    __m128 f = _mm_set1_ps(factor);
+    __m128 offset = _mm_set1_ps(128.0f);
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i q[4] = {
+            _mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero),
+            _mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero)
+        };
+        for (int k = 0; k < 4; k++) {
+            __m128 c = _mm_cvtepi32_ps(_mm_sub_epi32(q[k], bias));
+            q[k] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(c, f), offset));
+        }
+        __m128i out = _mm_packus_epi16(_mm_packs_epi32(q[0], q[1]), _mm_packs_epi32(q[2], q[3]));
+        out = _mm_or_si128(_mm_and_si128(out, m), _mm_andnot_si128(m, v));
+        _mm_storeu_si128((__m128i*)(p + i), out);
+    }
+#else
+    (void)factor;
+#endif
+    for (; i < bytes; i++) {
+        if (mask[i & 15]) p[i] = lut[p[i]];
+    }
+}
+
 
 mp_result mp_op_to_grayscale(mp_image* image) {
+    MP_TRACE_SCOPE("op.to_grayscale");
     if (!image || !image->buffer) {
         return MP_ERROR_INVALID_PARAM;
     }
     
     mp_image_buffer* buffer = image->buffer;
-    u8* restrict data = buffer->data;
+    MP_IMAGE_CHECK_LAYOUT(buffer);
     u32 width = buffer->width;
-    u32 height = buffer->height;
     u32 bpp = buffer->bpp;
-    u32 stride = buffer->stride;
     
-    /* Extreme optimization: Fixed-point + 8x Unrolling / 극한 최적화: 고정 소수점 + 8배 언롤링 */
-    for (u32 y = 0; y < height; y++) {
-        u8* restrict p = data + y * stride;
-        u32 x = 0;
-        for (; x <= width - 8; x += 8) {
-            #define GS_STEP { \
-                u32 g = (p[0] * 77 + p[1] * 150 + p[2] * 29) >> 8; \
-                p[0] = p[1] = p[2] = (u8)g; p += bpp; \
+    /* Gray formats already are / 회색 포맷은 이미 흑백 */
+    if (bpp >= 3) {
+        u32 w0, w1, w2;
+        mp_color_luma_weights(buffer->format, &w0, &w1, &w2);
+        
+        /* Fixed-point luma, row by row so padded strides are respected / 고정 소수점 휘도, 행 단위 처리 */
+        for (u32 y = 0; y < buffer->height; y++) {
+            u8* restrict p = buffer->data + (size_t)y * buffer->stride;
+            for (u32 x = 0; x < width; x++, p += bpp) {
+                u32 g = (p[0] * w0 + p[1] * w1 + p[2] * w2) >> 8;
+                p[0] = p[1] = p[2] = (u8)g;
             }
-            GS_STEP GS_STEP GS_STEP GS_STEP
-            GS_STEP GS_STEP GS_STEP GS_STEP
-            #undef GS_STEP
-        }
-        for (; x < width; x++) {
-            u32 g = (p[0] * 77 + p[1] * 150 + p[2] * 29) >> 8;
-            p[0] = p[1] = p[2] = (u8)g; p += bpp;
         }
     }
     
@@ -49,25 +140,21 @@ mp_result mp_op_to_grayscale(mp_image* image) {
 }
 
 mp_result mp_op_invert(mp_image* image) {
+    MP_TRACE_SCOPE("op.invert");
     if (!image || !image->buffer) {
         return MP_ERROR_INVALID_PARAM;
     }
     
     mp_image_buffer* buffer = image->buffer;
-    u8* restrict p = buffer->data;
-    size_t count = (size_t)buffer->width * buffer->height;
-    u32 bpp = buffer->bpp;
+    MP_IMAGE_CHECK_LAYOUT(buffer);
+    u8 mask[16];
+    mp_color_channel_mask(buffer->bpp, mask);
+    size_t bytes = mp_color_row_bytes(buffer);
     
-    /* Extreme optimization: Pointer arithmetic + 8x Unrolling / 극한 최적화: 포인터 연산 + 8배 언롤링 */
-    size_t i = 0;
-    for (; i <= count - 8; i += 8) {
-        #define INV_STEP { p[0] = ~p[0]; p[1] = ~p[1]; p[2] = ~p[2]; p += bpp; }
-        INV_STEP INV_STEP INV_STEP INV_STEP
-        INV_STEP INV_STEP INV_STEP INV_STEP
-        #undef INV_STEP
-    }
-    for (; i < count; i++) {
-        p[0] = ~p[0]; p[1] = ~p[1]; p[2] = ~p[2]; p += bpp;
+    /* Alpha is masked out, which keeps invert an exact self-inverse for undo
+     * / 알파는 마스크로 제외 (실행 취소를 위해 정확한 자기 역연산 유지) */
+    for (u32 y = 0; y < buffer->height; y++) {
+        mp_color_xor_row(buffer->data + (size_t)y * buffer->stride, bytes, mask);
     }
     
     image->modified = MP_TRUE;
@@ -75,8 +162,6 @@ mp_result mp_op_invert(mp_image* image) {
     return MP_SUCCESS;
 }
 
-
-
 void mp_rgb_to_hsv(u8 r, u8 g, u8 b, f32* h, f32* s, f32* v) {
     f32 rf = r / 255.0f;
     f32 gf = g / 255.0f;
@@ -146,34 +231,27 @@ void mp_hsv_to_rgb(f32 h, f32 s, f32 v, u8* r, u8* g, u8* b) {
 }
 
 mp_result mp_op_brightness(mp_image* image, i32 value) {
+    MP_TRACE_SCOPE("op.brightness");
     if (!image || !image->buffer) {
         return MP_ERROR_INVALID_PARAM;
     }
     
-    /* Precompute LUT / LUT 사전 계산 */
-    u8 lut[256];
-    for (int i = 0; i < 256; i++) {
-        i32 v = i + value;
-        lut[i] = (u8)(v < 0 ? 0 : (v > 255 ? 255 : v));
-    }
-    
     mp_image_buffer* buffer = image->buffer;
-    u8* restrict p = buffer->data;
-    size_t count = (size_t)buffer->width * buffer->height;
-    u32 bpp = buffer->bpp;
-    
-    /* Extreme optimization: LUT + 16x Unrolling / 극한 최적화: LUT + 16배 언롤링 */
-    size_t i = 0;
-    for (; i <= count - 16; i += 16) {
-        #define BR_LUT_STEP { p[0] = lut[p[0]]; p[1] = lut[p[1]]; p[2] = lut[p[2]]; p += bpp; }
-        BR_LUT_STEP BR_LUT_STEP BR_LUT_STEP BR_LUT_STEP
-        BR_LUT_STEP BR_LUT_STEP BR_LUT_STEP BR_LUT_STEP
-        BR_LUT_STEP BR_LUT_STEP BR_LUT_STEP BR_LUT_STEP
-        BR_LUT_STEP BR_LUT_STEP BR_LUT_STEP BR_LUT_STEP
-        #undef BR_LUT_STEP
+    MP_IMAGE_CHECK_LAYOUT(buffer);
+    
+    /* clamp(c + value) as one saturating add or subtract on color bytes
+     * / 색상 바이트에 포화 덧셈 또는 뺄셈 한 번으로 clamp(c + value) 계산 */
+    u8 mask[16], add[16], sub[16];
+    mp_color_channel_mask(buffer->bpp, mask);
+    u8 amount = (u8)(value > 255 || value < -255 ? 255 : (value < 0 ? -value : value));
+    for (int i = 0; i < 16; i++) {
+        add[i] = value > 0 ? (mask[i] & amount) : 0;
+        sub[i] = value < 0 ? (mask[i] & amount) : 0;
     }
-    for (; i < count; i++) {
-        p[0] = lut[p[0]]; p[1] = lut[p[1]]; p[2] = lut[p[2]]; p += bpp;
+    
+    size_t bytes = mp_color_row_bytes(buffer);
+    for (u32 y = 0; y < buffer->height; y++) {
+        mp_color_adds_row(buffer->data + (size_t)y * buffer->stride, bytes, add, sub);
     }
     
     image->modified = MP_TRUE;
@@ -182,6 +260,7 @@ mp_result mp_op_brightness(mp_image* image, i32 value) {
 }
 
 mp_result mp_op_contrast(mp_image* image, f32 value) {
+    MP_TRACE_SCOPE("op.contrast");
     if (!image || !image->buffer) {
         return MP_ERROR_INVALID_PARAM;
     }
@@ -196,22 +275,23 @@ mp_result mp_op_contrast(mp_image* image, f32 value) {
     }
     
     mp_image_buffer* buffer = image->buffer;
-    u8* restrict p = buffer->data;
-    size_t count = (size_t)buffer->width * buffer->height;
-    u32 bpp = buffer->bpp;
-    
-    /* Extreme optimization: LUT + 16x Unrolling / 극한 최적화: LUT + 16배 언롤링 */
-    size_t i = 0;
-    for (; i <= count - 16; i += 16) {
-        #define CT_LUT_STEP { p[0] = lut[p[0]]; p[1] = lut[p[1]]; p[2] = lut[p[2]]; p += bpp; }
-        CT_LUT_STEP CT_LUT_STEP CT_LUT_STEP CT_LUT_STEP
-        CT_LUT_STEP CT_LUT_STEP CT_LUT_STEP CT_LUT_STEP
-        CT_LUT_STEP CT_LUT_STEP CT_LUT_STEP CT_LUT_STEP
-        CT_LUT_STEP CT_LUT_STEP CT_LUT_STEP CT_LUT_STEP
-        #undef CT_LUT_STEP
-    }
-    for (; i < count; i++) {
-        p[0] = lut[p[0]]; p[1] = lut[p[1]]; p[2] = lut[p[2]]; p += bpp;
+    MP_IMAGE_CHECK_LAYOUT(buffer);
+    u8 mask[16];
+    mp_color_channel_mask(buffer->bpp, mask);
+    
+    /* The vector path evaluates the LUT formula directly; a factor that overflows an i32
+     * would not match the LUT, so that case stays on the LUT / 계수가 너무 크면 LUT만 사용 */
+    size_t bytes = mp_color_row_bytes(buffer);
+    mp_bool direct = fabsf(factor) < 1.0e7f;
+    for (u32 y = 0; y < buffer->height; y++) {
+        u8* row = buffer->data + (size_t)y * buffer->stride;
+        if (direct) {
+            mp_color_contrast_row(row, bytes, mask, factor, lut);
+        } else {
+            for (size_t i = 0; i < bytes; i++) {
+                if (mask[i & 15]) row[i] = lut[row[i]];
+            }
+        }
     }
     
     image->modified = MP_TRUE;
@@ -219,28 +299,62 @@ mp_result mp_op_contrast(mp_image* image, f32 value) {
     return MP_SUCCESS;
 }
 
-mp_result mp_op_saturation(mp_image* image, f32 value) {
-    if (!image || !image->buffer) {
-        return MP_ERROR_INVALID_PARAM;
-    }
-    
-    mp_image_buffer* buffer = image->buffer;
+/* Saturation and hue work in HSV on the color channels only; gray formats have zero
+ * saturation, so both are identities there / HSV 기반 조정 (회색 포맷에서는 항등 변환) */
+#define MP_COLOR_HSV_PARALLEL_PIXELS 16384
+
+typedef struct {
+    mp_image_buffer* buffer;
+    u32 r_offset;          /* Byte offsets of red and blue in a pixel / 픽셀 내 빨강, 파랑 오프셋 */
+    u32 b_offset;
+    f32 saturation;        /* Saturation factor / 채도 배율 */
+    f32 hue;               /* Hue shift in degrees / 색상 이동 (도) */
+} mp_color_hsv_job;
+
+static void mp_color_hsv_rows(void* ctx, u32 begin, u32 end) {
+    const mp_color_hsv_job* job = (const mp_color_hsv_job*)ctx;
+    const mp_image_buffer* buffer = job->buffer;
+    u32 bpp = buffer->bpp;
     
-    for (u32 y = 0; y < buffer->height; y++) {
-        for (u32 x = 0; x < buffer->width; x++) {
-            mp_pixel pixel = mp_image_get_pixel(buffer, x, y);
-            
+    for (u32 y = begin; y < end; y++) {
+        u8* p = buffer->data + (size_t)y * buffer->stride;
+        for (u32 x = 0; x < buffer->width; x++, p += bpp) {
             f32 h, s, v;
-            mp_rgb_to_hsv(pixel.r, pixel.g, pixel.b, &h, &s, &v);
+            mp_rgb_to_hsv(p[job->r_offset], p[1], p[job->b_offset], &h, &s, &v);
             
-            s *= value;
+            s *= job->saturation;
             if (s > 1.0f) s = 1.0f;
             if (s < 0.0f) s = 0.0f;
             
-            mp_hsv_to_rgb(h, s, v, &pixel.r, &pixel.g, &pixel.b);
-            mp_image_set_pixel(buffer, x, y, pixel);
+            h += job->hue;
+            while (h < 0.0f) h += 360.0f;
+            while (h >= 360.0f) h -= 360.0f;
+            
+            mp_hsv_to_rgb(h, s, v, &p[job->r_offset], &p[1], &p[job->b_offset]);
         }
     }
+}
+
+static void mp_color_adjust_hsv(mp_image_buffer* buffer, f32 saturation, f32 hue) {
+    if (buffer->bpp < 3) return;
+    
+    mp_bool bgr = buffer->format == MP_COLOR_FORMAT_BGR || buffer->format == MP_COLOR_FORMAT_BGRA;
+    mp_color_hsv_job job;
+    job.buffer = buffer;
+    job.r_offset = bgr ? 2 : 0;
+    job.b_offset = bgr ? 0 : 2;
+    job.saturation = saturation;
+    job.hue = hue;
+    mp_parallel_for(buffer->height, MP_COLOR_HSV_PARALLEL_PIXELS / buffer->width + 1, mp_color_hsv_rows, &job);
+}
+
+mp_result mp_op_saturation(mp_image* image, f32 value) {
+    MP_TRACE_SCOPE("op.saturation");
+    if (!image || !image->buffer) {
+        return MP_ERROR_INVALID_PARAM;
+    }
+    
+    mp_color_adjust_hsv(image->buffer, value, 0.0f);
     
     image->modified = MP_TRUE;
     mp_image_record_history(image, MP_OP_SATURATION, "Adjusted Saturation");
@@ -248,27 +362,12 @@ mp_result mp_op_saturation(mp_image* image, f32 value) {
 }
 
 mp_result mp_op_hue(mp_image* image, i32 degrees) {
+    MP_TRACE_SCOPE("op.hue");
     if (!image || !image->buffer) {
         return MP_ERROR_INVALID_PARAM;
     }
     
-    mp_image_buffer* buffer = image->buffer;
-    
-    for (u32 y = 0; y < buffer->height; y++) {
-        for (u32 x = 0; x < buffer->width; x++) {
-            mp_pixel pixel = mp_image_get_pixel(buffer, x, y);
-            
-            f32 h, s, v;
-            mp_rgb_to_hsv(pixel.r, pixel.g, pixel.b, &h, &s, &v);
-            
-            h += degrees;
-            while (h < 0.0f) h += 360.0f;
-            while (h >= 360.0f) h -= 360.0f;
-            
-            mp_hsv_to_rgb(h, s, v, &pixel.r, &pixel.g, &pixel.b);
-            mp_image_set_pixel(buffer, x, y, pixel);
-        }
-    }
+    mp_color_adjust_hsv(image->buffer, 1.0f, (f32)degrees);
     
     image->modified = MP_TRUE;
     mp_image_record_history(image, MP_OP_HUE, "Adjusted Hue");
@@ -288,7 +387,7 @@ void mp_colorization_predict(u8 gray, u8 context[8], u8* r, u8* g, u8* b) {
     f32 var = 0;
     for (int i = 0; i < 8; i++) var += fabsf(context[i] - avg_ctx);
     var /= 255.0f;
-
+    
     /* Base Spectral Mapping / 기본 스펙트럼 매핑 */
     f32 h = 200.0f + 60.0f * sinf(g_norm * M_PI * 1.5f + var * 2.0f); /* Hue shift based on luminence and detail */
     f32 s = 0.3f + 0.4f * (1.0f - g_norm) + var * 0.5f; /* Higher saturation in shadows and detailed areas */
@@ -305,6 +404,7 @@ void mp_colorization_predict(u8 gray, u8 context[8], u8* r, u8* g, u8* b) {
 }
 
 mp_result mp_op_to_color(mp_image* image) {
+    MP_TRACE_SCOPE("op.to_color");
     if (!image || !image->buffer) return MP_ERROR_INVALID_PARAM;
     
     mp_image_buffer* buffer = image->buffer;
@@ -350,33 +450,37 @@ mp_result mp_op_to_color(mp_image* image) {
 
 
 mp_result mp_op_invert_grayscale(mp_image* image) {
+    MP_TRACE_SCOPE("op.invert_grayscale");
     if (!image || !image->buffer) return MP_ERROR_INVALID_PARAM;
     
     mp_image_buffer* buffer = image->buffer;
-    u8* restrict p = buffer->data;
-    size_t count = (size_t)buffer->width * buffer->height;
+    MP_IMAGE_CHECK_LAYOUT(buffer);
+    u32 width = buffer->width;
     u32 bpp = buffer->bpp;
     
-    /* Extreme optimization: Fixed-point + Unrolling + Direct manipulation / 극한 최적화: 고정 소수점 + 언롤링 + 직접 조작 */
-    size_t i = 0;
-    for (; i <= count - 8; i += 8) {
-        #define IGS_STEP { \
-            u8 ir = 255 - p[0], ig = 255 - p[1], ib = 255 - p[2]; \
-            u32 gray = (ir * 77 + ig * 150 + ib * 29) >> 8; \
-            p[0] = p[1] = p[2] = (u8)gray; p += bpp; \
+    if (bpp < 3) {
+        /* Gray already: inverting is all that is left / 이미 흑백이면 반전만 수행 */
+        u8 mask[16];
+        mp_color_channel_mask(bpp, mask);
+        size_t bytes = mp_color_row_bytes(buffer);
+        for (u32 y = 0; y < buffer->height; y++) {
+            mp_color_xor_row(buffer->data + (size_t)y * buffer->stride, bytes, mask);
+        }
+    } else {
+        u32 w0, w1, w2;
+        mp_color_luma_weights(buffer->format, &w0, &w1, &w2);
+        
+        /* Fixed-point: luma of (255 - c) / 고정 소수점: (255 - c)의 휘도 */
+        for (u32 y = 0; y < buffer->height; y++) {
+            u8* restrict p = buffer->data + (size_t)y * buffer->stride;
+            for (u32 x = 0; x < width; x++, p += bpp) {
+                u32 gray = ((255 - p[0]) * w0 + (255 - p[1]) * w1 + (255 - p[2]) * w2) >> 8;
+                p[0] = p[1] = p[2] = (u8)gray;
+            }
         }
-        IGS_STEP IGS_STEP IGS_STEP IGS_STEP
-        IGS_STEP IGS_STEP IGS_STEP IGS_STEP
-        #undef IGS_STEP
-    }
-    for (; i < count; i++) {
-        u8 ir = 255 - p[0], ig = 255 - p[1], ib = 255 - p[2];
-        u32 gray = (ir * 77 + ig * 150 + ib * 29) >> 8;
-        p[0] = p[1] = p[2] = (u8)gray; p += bpp;
     }
     
     image->modified = MP_TRUE;
     mp_image_record_history(image, MP_OP_INVERT_GRAYSCALE, "Inverted and Grayscaled (Monster Optimized)");
     return MP_SUCCESS;
 }
-
@@ -1,10 +1,235 @@
 #include "edit_ops.h"
 #include "../core/memory.h"
 #include "../core/image.h"
+#include "../core/image_view.h"
+#include "../core/image_layout.h"
+#include "../core/pixel_layout.h"
+#include "../core/alloc.h"
+#include "../core/parallel.h"
+#include "../core/trace.h"
 #include <string.h>
 #include <math.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Cache-blocked rotation: 16x16 pixel tiles keep both the source rows and the
+ * destination columns of one tile resident in L1 / 캐시 블로킹 회전: 16x16 픽셀 타일 */
+#define MP_ROTATE_TILE 16
+
+/* Minimum pixels per worker before rotation goes multi-threaded / 멀티스레드 전환 최소 픽셀 수 */
+#define MP_ROTATE_PARALLEL_PIXELS (1u << 18)
+
+typedef struct {
+    const u8* src;
+    u8* dst;
+    u32 src_stride;
+    u32 dst_stride;
+    u32 width;      /* Source width / 원본 너비 */
+    u32 height;     /* Source height / 원본 높이 */
+    u32 bpp;
+    i32 degrees;
+} mp_rotate_job;
+
+static inline void mp_rotate_copy_px(u8* restrict d, const u8* restrict s, u32 bpp) {
+    switch (bpp) {
+        case 4: memcpy(d, s, 4); break;
+        case 3: d[0] = s[0]; d[1] = s[1]; d[2] = s[2]; break;
+        case 1: d[0] = s[0]; break;
+        default: memcpy(d, s, bpp); break;
+    }
+}
+
+/* Scalar transpose of an arbitrary source rectangle [x0,x1) x [y0,y1) / 임의 사각형 스칼라 전치 */
+static void mp_rotate_rect_scalar(const mp_rotate_job* job, u32 x0, u32 y0, u32 x1, u32 y1) {
+    u32 bpp = job->bpp;
+    for (u32 y = y0; y < y1; y++) {
+        const u8* restrict src_px = job->src + (size_t)y * job->src_stride + (size_t)x0 * bpp;
+        if (job->degrees == 90) {
+            u8* restrict dst_px = job->dst + (size_t)x0 * job->dst_stride + (size_t)(job->height - 1 - y) * bpp;
+            for (u32 x = x0; x < x1; x++) {
+                mp_rotate_copy_px(dst_px, src_px, bpp);
+                src_px += bpp;
+                dst_px += job->dst_stride;
+            }
+        } else {
+            u8* restrict dst_px = job->dst + (size_t)(job->width - 1 - x0) * job->dst_stride + (size_t)y * bpp;
+            for (u32 x = x0; x < x1; x++) {
+                mp_rotate_copy_px(dst_px, src_px, bpp);
+                src_px += bpp;
+                dst_px -= job->dst_stride;
+            }
+        }
+    }
+}
+
+#if defined(__SSE2__)
+/* 4x4 register transpose of 32-bit pixels (unpack sequence) / 32비트 픽셀 4x4 레지스터 전치 */
+static inline void mp_rotate_block4_32(const mp_rotate_job* job, u32 x, u32 y) {
+    const u8* s = job->src + (size_t)y * job->src_stride + (size_t)x * 4;
+    __m128i r0 = _mm_loadu_si128((const __m128i*)(s));
+    __m128i r1 = _mm_loadu_si128((const __m128i*)(s + job->src_stride));
+    __m128i r2 = _mm_loadu_si128((const __m128i*)(s + 2 * (size_t)job->src_stride));
+    __m128i r3 = _mm_loadu_si128((const __m128i*)(s + 3 * (size_t)job->src_stride));
+    
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+    __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+    
+    /* c[i] now holds source column x+i, rows y..y+3 / c[i]는 원본 x+i 열 */
+    __m128i c[4];
+    c[0] = _mm_unpacklo_epi64(t0, t1);
+    c[1] = _mm_unpackhi_epi64(t0, t1);
+    c[2] = _mm_unpacklo_epi64(t2, t3);
+    c[3] = _mm_unpackhi_epi64(t2, t3);
+    
+    if (job->degrees == 90) {
+        /* Destination columns run bottom-up: reverse lanes / 대상 열이 역순이므로 레인 반전 */
+        u8* d = job->dst + (size_t)x * job->dst_stride + (size_t)(job->height - 4 - y) * 4;
+        for (int i = 0; i < 4; i++) {
+            _mm_storeu_si128((__m128i*)(d + (size_t)i * job->dst_stride),
+                             _mm_shuffle_epi32(c[i], _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+    } else {
+        u8* d = job->dst + (size_t)(job->width - 1 - x) * job->dst_stride + (size_t)y * 4;
+        for (int i = 0; i < 4; i++) {
+            _mm_storeu_si128((__m128i*)(d - (size_t)i * job->dst_stride), c[i]);
+        }
+    }
+}
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define MP_ROTATE_BLOCK24 1
+/* 4x4 block of 24-bit pixels: each 12-byte source run is read as one 8-byte and one 4-byte
+ * load, and each destination run written the same way, instead of twelve byte copies
+ * / 24비트 픽셀 4x4 블록: 12바이트 구간을 8+4바이트 단위로 읽고 씀 */
+static inline void mp_rotate_load24x4(const u8* s, u32 px[4]) {
+    u64 lo;
+    u32 hi;
+    memcpy(&lo, s, 8);
+    memcpy(&hi, s + 8, 4);
+    px[0] = (u32)lo & 0xFFFFFFu;
+    px[1] = (u32)(lo >> 24) & 0xFFFFFFu;
+    px[2] = (u32)(lo >> 48) | ((hi & 0xFFu) << 16);
+    px[3] = hi >> 8;
+}
+
+static inline void mp_rotate_store24x4(u8* d, u32 p0, u32 p1, u32 p2, u32 p3) {
+    u64 lo = (u64)p0 | ((u64)p1 << 24) | ((u64)p2 << 48);
+    u32 hi = (p2 >> 16) | (p3 << 8);
+    memcpy(d, &lo, 8);
+    memcpy(d + 8, &hi, 4);
+}
+
+static inline void mp_rotate_block4_24(const mp_rotate_job* job, u32 x, u32 y) {
+    const u8* s = job->src + (size_t)y * job->src_stride + (size_t)x * 3;
+    u32 px[4][4];   /* px[r][c]: source row y+r, column x+c / 원본 y+r 행, x+c 열 */
+    for (u32 r = 0; r < 4; r++) mp_rotate_load24x4(s + (size_t)r * job->src_stride, px[r]);
+    
+    if (job->degrees == 90) {
+        /* Destination columns run bottom-up / 대상 열이 역순 */
+        u8* d = job->dst + (size_t)x * job->dst_stride + (size_t)(job->height - 4 - y) * 3;
+        for (u32 c = 0; c < 4; c++) {
+            mp_rotate_store24x4(d + (size_t)c * job->dst_stride, px[3][c], px[2][c], px[1][c], px[0][c]);
+        }
+    } else {
+        u8* d = job->dst + (size_t)(job->width - 1 - x) * job->dst_stride + (size_t)y * 3;
+        for (u32 c = 0; c < 4; c++) {
+            mp_rotate_store24x4(d - (size_t)c * job->dst_stride, px[0][c], px[1][c], px[2][c], px[3][c]);
+        }
+    }
+}
+#endif
+
+static void mp_rotate_tile(const mp_rotate_job* job, u32 x0, u32 y0, u32 x1, u32 y1) {
+#if defined(MP_ROTATE_BLOCK24)
+    if (job->bpp == 3) {
+        u32 xv = x0 + ((x1 - x0) & ~3u);
+        u32 yv = y0 + ((y1 - y0) & ~3u);
+        for (u32 y = y0; y < yv; y += 4) {
+            for (u32 x = x0; x < xv; x += 4) {
+                mp_rotate_block4_24(job, x, y);
+            }
+        }
+        if (xv < x1) mp_rotate_rect_scalar(job, xv, y0, x1, yv);
+        if (yv < y1) mp_rotate_rect_scalar(job, x0, yv, x1, y1);
+        return;
+    }
+#endif
+#if defined(__SSE2__)
+    if (job->bpp == 4) {
+        u32 xv = x0 + ((x1 - x0) & ~3u);
+        u32 yv = y0 + ((y1 - y0) & ~3u);
+        for (u32 y = y0; y < yv; y += 4) {
+            for (u32 x = x0; x < xv; x += 4) {
+                mp_rotate_block4_32(job, x, y);
+            }
+        }
+        /* Ragged right and bottom edges / 오른쪽 및 아래쪽 가장자리 잔여분 */
+        if (xv < x1) mp_rotate_rect_scalar(job, xv, y0, x1, yv);
+        if (yv < y1) mp_rotate_rect_scalar(job, x0, yv, x1, y1);
+        return;
+    }
+#endif
+    mp_rotate_rect_scalar(job, x0, y0, x1, y1);
+}
+
+/* Worker over a band of source tile rows / 원본 타일 행 밴드 처리 워커 */
+static void mp_rotate_transpose_rows(void* ctx, u32 begin, u32 end) {
+    const mp_rotate_job* job = (const mp_rotate_job*)ctx;
+    u32 y_end = end * MP_ROTATE_TILE;
+    if (y_end > job->height) y_end = job->height;
+    
+    for (u32 ty = begin * MP_ROTATE_TILE; ty < y_end; ty += MP_ROTATE_TILE) {
+        u32 ty1 = (ty + MP_ROTATE_TILE < y_end) ? ty + MP_ROTATE_TILE : y_end;
+        for (u32 tx = 0; tx < job->width; tx += MP_ROTATE_TILE) {
+            u32 tx1 = (tx + MP_ROTATE_TILE < job->width) ? tx + MP_ROTATE_TILE : job->width;
+            mp_rotate_tile(job, tx, ty, tx1, ty1);
+        }
+    }
+}
+
+/* 180 degrees is a pure row stream: reverse each row into the mirrored row / 180도: 행 단위 역순 스트림 */
+static void mp_rotate_180_rows(void* ctx, u32 begin, u32 end) {
+    const mp_rotate_job* job = (const mp_rotate_job*)ctx;
+    u32 w = job->width;
+    u32 bpp = job->bpp;
+    
+    for (u32 y = begin; y < end; y++) {
+        const u8* restrict src_row = job->src + (size_t)y * job->src_stride;
+        u8* restrict dst_row = job->dst + (size_t)(job->height - 1 - y) * job->dst_stride;
+        u32 x = 0;
+#if defined(__SSE2__)
+        if (bpp == 4) {
+            /* Reverse four 32-bit pixels per shuffle / 셔플 한 번에 32비트 픽셀 4개 반전 */
+            for (; x + 4 <= w; x += 4) {
+                __m128i v = _mm_loadu_si128((const __m128i*)(src_row + (size_t)x * 4));
+                _mm_storeu_si128((__m128i*)(dst_row + (size_t)(w - 4 - x) * 4),
+                                 _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)));
+            }
+        } else if (bpp == 1) {
+            /* Byte reverse: swap words, then dwords/qwords, then bytes within words / 바이트 역순 셔플 */
+            for (; x + 16 <= w; x += 16) {
+                __m128i v = _mm_loadu_si128((const __m128i*)(src_row + x));
+                v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+                v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+                v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+                v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+                _mm_storeu_si128((__m128i*)(dst_row + (w - 16 - x)), v);
+            }
+        }
+#endif
+        for (; x < w; x++) {
+            mp_rotate_copy_px(dst_row + (size_t)(w - 1 - x) * bpp, src_row + (size_t)x * bpp, bpp);
+        }
+    }
+}
+
 mp_result mp_op_rotate(mp_image* image, i32 degrees) {
+    MP_TRACE_SCOPE("op.rotate");
     if (!image || !image->buffer) {
         return MP_ERROR_INVALID_PARAM;
     }
@@ -17,6 +242,7 @@ mp_result mp_op_rotate(mp_image* image, i32 degrees) {
     }
     
     mp_image_buffer* old_buffer = image->buffer;
+    MP_IMAGE_CHECK_LAYOUT(old_buffer);
     mp_image_buffer* new_buffer;
     
     if (degrees == 90 || degrees == 270) {
@@ -32,42 +258,24 @@ mp_result mp_op_rotate(mp_image* image, i32 degrees) {
         return MP_ERROR_MEMORY;
     }
     
-    u32 bpp = old_buffer->bpp;
-    u32 old_w = old_buffer->width;
-    u32 old_h = old_buffer->height;
-    u8* restrict src = old_buffer->data;
-    u8* restrict dst = new_buffer->data;
-
-    /* Extreme optimization: Dedicated loops for specific rotations / 극한 최적화: 특정 회전을 위한 전용 루프 */
-    if (degrees == 90) {
-        for (u32 y = 0; y < old_h; y++) {
-            u8* src_row = src + y * old_buffer->stride;
-            for (u32 x = 0; x < old_w; x++) {
-                u32 new_x = old_h - 1 - y;
-                u32 new_y = x;
-                u8* dst_px = dst + new_y * new_buffer->stride + new_x * bpp;
-                memcpy(dst_px, src_row + x * bpp, bpp);
-            }
-        }
-    } else if (degrees == 180) {
-        for (u32 y = 0; y < old_h; y++) {
-            u8* src_row = src + y * old_buffer->stride;
-            u8* dst_row = dst + (old_h - 1 - y) * new_buffer->stride;
-            for (u32 x = 0; x < old_w; x++) {
-                u32 new_x = old_w - 1 - x;
-                memcpy(dst_row + new_x * bpp, src_row + x * bpp, bpp);
-            }
-        }
-    } else if (degrees == 270) {
-        for (u32 y = 0; y < old_h; y++) {
-            u8* src_row = src + y * old_buffer->stride;
-            for (u32 x = 0; x < old_w; x++) {
-                u32 new_x = y;
-                u32 new_y = old_w - 1 - x;
-                u8* dst_px = dst + new_y * new_buffer->stride + new_x * bpp;
-                memcpy(dst_px, src_row + x * bpp, bpp);
-            }
-        }
+    mp_rotate_job job;
+    job.src = old_buffer->data;
+    job.dst = new_buffer->data;
+    job.src_stride = old_buffer->stride;
+    job.dst_stride = new_buffer->stride;
+    job.width = old_buffer->width;
+    job.height = old_buffer->height;
+    job.bpp = old_buffer->bpp;
+    job.degrees = degrees;
+    
+    /* Extreme optimization: Tiled SIMD transpose, parallel across tile rows / 극한 최적화: 타일 SIMD 전치, 타일 행 병렬화 */
+    if (degrees == 180) {
+        u32 grain = MP_ROTATE_PARALLEL_PIXELS / (job.width ? job.width : 1);
+        mp_parallel_for(job.height, grain ? grain : 1, mp_rotate_180_rows, &job);
+    } else {
+        u32 tile_rows = (job.height + MP_ROTATE_TILE - 1) / MP_ROTATE_TILE;
+        u32 grain = MP_ROTATE_PARALLEL_PIXELS / ((job.width ? job.width : 1) * MP_ROTATE_TILE);
+        mp_parallel_for(tile_rows, grain ? grain : 1, mp_rotate_transpose_rows, &job);
     }
     
     mp_image_buffer_destroy(old_buffer);
@@ -79,11 +287,13 @@ mp_result mp_op_rotate(mp_image* image, i32 degrees) {
 }
 
 mp_result mp_op_flip_horizontal(mp_image* image) {
+    MP_TRACE_SCOPE("op.flip_horizontal");
     if (!image || !image->buffer) {
         return MP_ERROR_INVALID_PARAM;
     }
     
     mp_image_buffer* buffer = image->buffer;
+    MP_IMAGE_CHECK_LAYOUT(buffer);
     u32 bpp = buffer->bpp;
     u32 width = buffer->width;
     u32 height = buffer->height;
@@ -120,134 +330,247 @@ mp_result mp_op_flip_horizontal(mp_image* image) {
 }
 
 mp_result mp_op_flip_vertical(mp_image* image) {
+    MP_TRACE_SCOPE("op.flip_vertical");
     if (!image || !image->buffer) {
         return MP_ERROR_INVALID_PARAM;
     }
     
-    mp_image_buffer* buffer = image->buffer;
-    u32 stride = buffer->stride;
-    u8* temp_row = (u8*)mp_malloc(stride);
-    if (!temp_row) return MP_ERROR_MEMORY;
+    /* Negative-stride view committed at once: one in-place row-swap pass, no allocation
+     * / 음수 스트라이드 뷰를 즉시 커밋 (할당 없이 제자리 행 스왑 한 번) */
+    mp_image_view view = mp_image_view_of(image->buffer);
+    mp_image_view_flip_vertical(&view);
+    mp_result result = mp_image_view_commit(&view);
+    if (result != MP_SUCCESS) return result;
     
-    u8* data = buffer->data;
-    u32 h = buffer->height;
-    
-    /* Extreme optimization: Row-level swapping with memcpy / 극한 최적화: memcpy를 사용한 행 단위 스왑 */
-    for (u32 y = 0; y < h / 2; y++) {
-        u8* top = data + y * stride;
-        u8* bottom = data + (h - 1 - y) * stride;
-        memcpy(temp_row, top, stride);
-        memcpy(top, bottom, stride);
-        memcpy(bottom, temp_row, stride);
-    }
-    
-    mp_free(temp_row);
     image->modified = MP_TRUE;
     mp_image_record_history(image, MP_OP_FLIP_V, "Flipped Vertically (Monster Row-Swap)");
     return MP_SUCCESS;
 }
 
 mp_result mp_op_crop(mp_image* image, u32 x, u32 y, u32 width, u32 height) {
+    MP_TRACE_SCOPE("op.crop");
     if (!image || !image->buffer) {
         return MP_ERROR_INVALID_PARAM;
     }
     
-    mp_image_buffer* old_buffer = image->buffer;
-    
-    if (x + width > old_buffer->width || y + height > old_buffer->height) {
-        return MP_ERROR_INVALID_PARAM;
-    }
-    
-    mp_image_buffer* new_buffer = mp_image_buffer_create(width, height, old_buffer->format);
-    if (!new_buffer) {
-        return MP_ERROR_MEMORY;
-    }
+    /* View crop committed at once; the commit keeps the existing allocation and stride, so a
+     * crop anchored at the top-left moves no pixels and any other crop slides the kept rows
+     * forward in place / 원점 기준 자르기는 픽셀 이동 없음, 그 외에는 남는 행을 제자리에서 이동 */
+    mp_image_view view = mp_image_view_of(image->buffer);
+    mp_result result = mp_image_view_crop(&view, x, y, width, height);
+    if (result != MP_SUCCESS) return result;
     
-    u32 bpp = old_buffer->bpp;
-    u32 old_stride = old_buffer->stride;
-    u32 new_stride = new_buffer->stride;
-    u8* src = old_buffer->data + y * old_stride + x * bpp;
-    u8* dst = new_buffer->data;
-    
-    /* Extreme optimization: Row-level copy via memcpy / 극한 최적화: memcpy를 이용한 행 단위 복사 */
-    for (u32 ny = 0; ny < height; ny++) {
-        memcpy(dst, src, width * bpp);
-        src += old_stride;
-        dst += new_stride;
-    }
+    result = mp_image_view_commit(&view);
+    if (result != MP_SUCCESS) return result;
     
-    mp_image_buffer_destroy(old_buffer);
-    image->buffer = new_buffer;
     image->modified = MP_TRUE;
-    mp_image_record_history(image, MP_OP_CROP, "Cropped Image (Monster Row-Copy)");
+    mp_image_record_history(image, MP_OP_CROP, "Cropped Image (Monster Zero-Copy View)");
     
     return MP_SUCCESS;
 }
 
 
-static mp_pixel mp_sample_bilinear(const mp_image_buffer* buffer, f32 x, f32 y) {
-    u32 x0 = (u32)x;
-    u32 y0 = (u32)y;
-    u32 x1 = x0 + 1;
-    u32 y1 = y0 + 1;
-    
-    if (x1 >= buffer->width) x1 = buffer->width - 1;
-    if (y1 >= buffer->height) y1 = buffer->height - 1;
-    
-    f32 fx = x - x0;
-    f32 fy = y - y0;
-    
-    mp_pixel p00 = mp_image_get_pixel(buffer, x0, y0);
-    mp_pixel p10 = mp_image_get_pixel(buffer, x1, y0);
-    mp_pixel p01 = mp_image_get_pixel(buffer, x0, y1);
-    mp_pixel p11 = mp_image_get_pixel(buffer, x1, y1);
-    
-    mp_pixel result;
-    result.r = (u8)((1 - fx) * (1 - fy) * p00.r + fx * (1 - fy) * p10.r +
-                    (1 - fx) * fy * p01.r + fx * fy * p11.r);
-    result.g = (u8)((1 - fx) * (1 - fy) * p00.g + fx * (1 - fy) * p10.g +
-                    (1 - fx) * fy * p01.g + fx * fy * p11.g);
-    result.b = (u8)((1 - fx) * (1 - fy) * p00.b + fx * (1 - fy) * p10.b +
-                    (1 - fx) * fy * p01.b + fx * fy * p11.b);
-    result.a = (u8)((1 - fx) * (1 - fy) * p00.a + fx * (1 - fy) * p10.a +
-                    (1 - fx) * fy * p01.a + fx * fy * p11.a);
+/* Bilinear resampling on planes / 평면 기반 바이리니어 리샘플링
+ *
+ * Separable in 8.8 fixed point: each source row a band needs is filtered horizontally once
+ * into 16-bit samples, then two such rows are blended per output row. Working on planes
+ * makes both passes single-channel streams, and the vertical blend runs 16 samples at a time.
+ * 8.8 고정소수점 분리형 필터: 원본 행을 가로로 한 번 필터링한 뒤 두 행을 세로로 혼합합니다. */
+#define MP_RESIZE_WEIGHT_ONE 256
+
+/* Output pixels per band before bilinear resize goes multi-threaded / 멀티스레드 전환 최소 픽셀 수 */
+#define MP_RESIZE_PARALLEL_PIXELS (1u << 16)
+
+typedef struct {
+    const mp_planar_buffer* src;
+    mp_planar_buffer* dst;
+    const u32* x0;       /* Left source column per output column / 출력 열별 왼쪽 원본 열 */
+    const u32* x1;
+    const u16* wx;       /* Weight of x1 out of 256 / x1의 가중치 (256 기준) */
+    const u32* y0;
+    const u16* wy;
+    u16* scratch;        /* Two filtered rows per band / 밴드마다 필터링된 두 행 */
+    u32 bands;
+} mp_resize_job;
+
+/* Source position of every output sample along one axis, same mapping as nearest
+ * / 한 축의 출력 샘플별 원본 위치 (최근접과 동일한 매핑) */
+static void mp_resize_axis(u32 src_size, u32 dst_size, u32* i0, u32* i1, u16* weight) {
+    f32 ratio = (f32)src_size / dst_size;
+    for (u32 i = 0; i < dst_size; i++) {
+        f32 pos = i * ratio;
+        u32 p = (u32)pos;
+        if (p >= src_size) p = src_size - 1;
+        i0[i] = p;
+        if (i1) i1[i] = p + 1 < src_size ? p + 1 : p;
+        weight[i] = (u16)((pos - p) * MP_RESIZE_WEIGHT_ONE + 0.5f);
+    }
+}
+
+static void mp_resize_filter_row(const mp_resize_job* job, const u8* restrict src, u16* restrict out) {
+    u32 width = job->dst->width;
+    for (u32 x = 0; x < width; x++) {
+        u32 w = job->wx[x];
+        out[x] = (u16)(src[job->x0[x]] * (MP_RESIZE_WEIGHT_ONE - w) + src[job->x1[x]] * w);
+    }
+}
+
+/* dst = (top * (256 - w) + bottom * w) / 65536, rounded / 반올림된 세로 혼합 */
+static void mp_resize_blend_row(const u16* restrict top, const u16* restrict bottom, u32 w,
+                                u8* restrict dst, u32 width) {
+    u32 x = 0;
+#if defined(__SSE2__)
+    const __m128i wt = _mm_set1_epi16((short)(MP_RESIZE_WEIGHT_ONE - w));
+    const __m128i wb = _mm_set1_epi16((short)w);
+    const __m128i half = _mm_set1_epi32(1 << 15);
+    for (; x + 16 <= width; x += 16) {
+        __m128i out[2];
+        for (int i = 0; i < 2; i++) {
+            __m128i t = _mm_loadu_si128((const __m128i*)(top + x + i * 8));
+            __m128i b = _mm_loadu_si128((const __m128i*)(bottom + x + i * 8));
+            /* 16x16 -> 32-bit products from the low and high halves / 32비트 곱 */
+            __m128i tl = _mm_mullo_epi16(t, wt), th = _mm_mulhi_epu16(t, wt);
+            __m128i bl = _mm_mullo_epi16(b, wb), bh = _mm_mulhi_epu16(b, wb);
+            __m128i lo = _mm_add_epi32(_mm_add_epi32(_mm_unpacklo_epi16(tl, th), _mm_unpacklo_epi16(bl, bh)), half);
+            __m128i hi = _mm_add_epi32(_mm_add_epi32(_mm_unpackhi_epi16(tl, th), _mm_unpackhi_epi16(bl, bh)), half);
+            out[i] = _mm_packs_epi32(_mm_srli_epi32(lo, 16), _mm_srli_epi32(hi, 16));
+        }
+        _mm_storeu_si128((__m128i*)(dst + x), _mm_packus_epi16(out[0], out[1]));
+    }
+#endif
+    for (; x < width; x++) {
+        dst[x] = (u8)((top[x] * (MP_RESIZE_WEIGHT_ONE - w) + bottom[x] * w + (1u << 15)) >> 16);
+    }
+}
+
+/* Worker over bands of output rows, one plane after another / 출력 행 밴드 처리 (평면 순서대로) */
+static void mp_resize_bands(void* ctx, u32 begin, u32 end) {
+    const mp_resize_job* job = (const mp_resize_job*)ctx;
+    const mp_planar_buffer* src = job->src;
+    mp_planar_buffer* dst = job->dst;
+    
+    for (u32 band = begin; band < end; band++) {
+        u32 y_begin = (u32)((u64)dst->height * band / job->bands);
+        u32 y_end = (u32)((u64)dst->height * (band + 1) / job->bands);
+        u16* rows[2] = { job->scratch + (size_t)band * 2 * dst->width,
+                         job->scratch + ((size_t)band * 2 + 1) * dst->width };
+        
+        for (u32 c = 0; c < dst->channels; c++) {
+            /* Source rows currently filtered into rows[0] and rows[1] / 현재 필터링된 원본 행 */
+            u32 cached[2] = { UINT32_MAX, UINT32_MAX };
+            for (u32 y = y_begin; y < y_end; y++) {
+                u32 sy[2] = { job->y0[y], job->y0[y] + 1 < src->height ? job->y0[y] + 1 : job->y0[y] };
+                if (cached[1] == sy[0] && cached[0] != sy[0]) {
+                    /* Moving down one source row: the bottom row becomes the top / 한 행 아래로 이동 */
+                    u16* t = rows[0]; rows[0] = rows[1]; rows[1] = t;
+                    cached[0] = cached[1];
+                    cached[1] = UINT32_MAX;
+                }
+                for (int i = 0; i < 2; i++) {
+                    if (cached[i] == sy[i]) continue;
+                    mp_resize_filter_row(job, src->planes[c] + (size_t)sy[i] * src->stride, rows[i]);
+                    cached[i] = sy[i];
+                }
+                mp_resize_blend_row(rows[0], rows[1], job->wy[y],
+                                    dst->planes[c] + (size_t)y * dst->stride, dst->width);
+            }
+        }
+    }
+}
+
+static mp_result mp_resize_bilinear(const mp_image_buffer* src, mp_image_buffer* dst) {
+    if (src->bpp != mp_image_layout_bpp(src->format)) return MP_ERROR_UNSUPPORTED;
+    
+    u32 width = dst->width;
+    u32 height = dst->height;
+    u32 bands = (u32)((u64)width * height / MP_RESIZE_PARALLEL_PIXELS);
+    u32 threads = mp_parallel_thread_count();
+    if (bands > threads) bands = threads;
+    if (bands > height) bands = height;
+    if (bands == 0) bands = 1;
+    
+    /* Convert once each way; the filter itself never touches interleaved pixels
+     * / 변환은 양방향 한 번씩, 필터는 평면만 처리 */
+    mp_planar_buffer* src_planes = mp_planar_from_interleaved(src);
+    mp_planar_buffer* dst_planes = mp_planar_buffer_create(width, height, dst->format);
+    size_t table_bytes = (size_t)width * (2 * sizeof(u32) + sizeof(u16)) + (size_t)height * (sizeof(u32) + sizeof(u16)) +
+                         (size_t)bands * 2 * width * sizeof(u16);
+    u8* tables = (u8*)mp_alloc(table_bytes, MP_ALLOC_PIXELS);
+    mp_result result = MP_ERROR_MEMORY;
+    
+    if (src_planes && dst_planes && tables) {
+        /* u32 tables first keeps every table naturally aligned / u32 테이블을 앞에 두어 정렬 유지 */
+        mp_resize_job job;
+        u32* x0 = (u32*)tables;
+        u32* x1 = x0 + width;
+        u32* y0 = x1 + width;
+        u16* wx = (u16*)(y0 + height);
+        u16* wy = wx + width;
+        mp_resize_axis(src->width, width, x0, x1, wx);
+        mp_resize_axis(src->height, height, y0, NULL, wy);
+        
+        job.src = src_planes;
+        job.dst = dst_planes;
+        job.x0 = x0;
+        job.x1 = x1;
+        job.wx = wx;
+        job.y0 = y0;
+        job.wy = wy;
+        job.scratch = wy + height;
+        job.bands = bands;
+        mp_parallel_for(bands, 1, mp_resize_bands, &job);
+        
+        result = mp_planar_to_interleaved(dst_planes, dst);
+    }
     
+    mp_alloc_free(tables);
+    mp_planar_buffer_destroy(dst_planes);
+    mp_planar_buffer_destroy(src_planes);
     return result;
 }
 
 mp_result mp_op_resize_ex(mp_image* image, u32 new_width, u32 new_height,
                           mp_resize_algorithm algorithm) {
+    MP_TRACE_SCOPE("op.resize_ex");
     if (!image || !image->buffer || new_width == 0 || new_height == 0) {
         return MP_ERROR_INVALID_PARAM;
     }
     
     mp_image_buffer* old_buffer = image->buffer;
+    MP_IMAGE_CHECK_LAYOUT(old_buffer);
     mp_image_buffer* new_buffer = mp_image_buffer_create(new_width, new_height, old_buffer->format);
     
     if (!new_buffer) {
         return MP_ERROR_MEMORY;
     }
     
-    f32 x_ratio = (f32)old_buffer->width / new_width;
-    f32 y_ratio = (f32)old_buffer->height / new_height;
-    u32 bpp = old_buffer->bpp;
-    u8* restrict src_data = old_buffer->data;
-    u8* restrict dst_data = new_buffer->data;
-    
-    /* Extreme optimization: Direct pointer access in resize loop / 극한 최적화: 크기 조정 루프 내 직접 포인터 액세스 */
-    for (u32 y = 0; y < new_height; y++) {
-        u8* restrict dst_row = dst_data + y * new_buffer->stride;
-        f32 src_y = y * y_ratio;
-        u32 sy = (u32)src_y;
-        if (sy >= old_buffer->height) sy = old_buffer->height - 1;
-        u8* restrict src_row = src_data + sy * old_buffer->stride;
-
-        for (u32 x = 0; x < new_width; x++) {
-            f32 src_x = x * x_ratio;
-            u32 sx = (u32)src_x;
-            if (sx >= old_buffer->width) sx = old_buffer->width - 1;
-
-            if (algorithm == MP_RESIZE_NEAREST) {
+    if (algorithm != MP_RESIZE_NEAREST) {
+        /* Bicubic and Lanczos fall back to bilinear / 바이큐빅과 란초스는 바이리니어로 대체 */
+        mp_result result = mp_resize_bilinear(old_buffer, new_buffer);
+        if (result != MP_SUCCESS) {
+            mp_image_buffer_destroy(new_buffer);
+            return result;
+        }
+    } else {
+        f32 x_ratio = (f32)old_buffer->width / new_width;
+        f32 y_ratio = (f32)old_buffer->height / new_height;
+        u32 bpp = old_buffer->bpp;
+        u8* restrict src_data = old_buffer->data;
+        u8* restrict dst_data = new_buffer->data;
+        
+        /* Extreme optimization: Direct pointer access in resize loop / 극한 최적화: 크기 조정 루프 내 직접 포인터 액세스 */
+        for (u32 y = 0; y < new_height; y++) {
+            u8* restrict dst_row = dst_data + y * new_buffer->stride;
+            f32 src_y = y * y_ratio;
+            u32 sy = (u32)src_y;
+            if (sy >= old_buffer->height) sy = old_buffer->height - 1;
+            u8* restrict src_row = src_data + sy * old_buffer->stride;
+            
+            for (u32 x = 0; x < new_width; x++) {
+                f32 src_x = x * x_ratio;
+                u32 sx = (u32)src_x;
+                if (sx >= old_buffer->width) sx = old_buffer->width - 1;
+                
                 u8* sp = src_row + sx * bpp;
                 if (bpp == 3) {
                     dst_row[0] = sp[0]; dst_row[1] = sp[1]; dst_row[2] = sp[2];
@@ -256,16 +579,8 @@ mp_result mp_op_resize_ex(mp_image* image, u32 new_width, u32 new_height,
                 } else {
                     memcpy(dst_row, sp, bpp);
                 }
-            } else {
-                /* Bi-linear sampling fallback for complexity / 복잡성을 고려한 바이리니어 샘플링 폴백 */
-                mp_pixel pixel = mp_sample_bilinear(old_buffer, src_x, src_y);
-                if (bpp == 3) {
-                    dst_row[0] = pixel.r; dst_row[1] = pixel.g; dst_row[2] = pixel.b;
-                } else {
-                    dst_row[0] = pixel.r; dst_row[1] = pixel.g; dst_row[2] = pixel.b; dst_row[3] = pixel.a;
-                }
+                dst_row += bpp;
             }
-            dst_row += bpp;
         }
     }
     